@@ -35,6 +35,8 @@ std::string const Account::EV_NEW_OP_UID = {"EV_NEW_OP_UID"};
 
 std::string const Account::EV_DELETED_OP_UID = {"EV_DELETED_OP_UID"};
 
+std::string const Account::EV_DELETED_OP_UIDS = {"EV_DELETED_OP_UIDS"};
+
 int32_t const Account::FLAG_TRANSACTION_IGNORED = 0;
 
 int32_t const Account::FLAG_NEW_TRANSACTION = 1;
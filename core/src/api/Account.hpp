@@ -91,6 +91,8 @@ public:
 
     static std::string const EV_DELETED_OP_UID;
 
+    static std::string const EV_DELETED_OP_UIDS;
+
     /**
      * Returned flag when a transaction is put in DB
      * Some of those are unrelevant for specific coins
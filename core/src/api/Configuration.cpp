@@ -29,6 +29,24 @@ std::string const Configuration::SYNCHRONIZATION_ENGINE = {"SYNCHRONIZATION_ENGI
 
 std::string const Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE = {"SYNCHRONIZATION_HALF_BATCH_SIZE"};
 
+std::string const Configuration::SYNCHRONIZATION_MAX_PARALLEL_BATCHES = {"SYNCHRONIZATION_MAX_PARALLEL_BATCHES"};
+
+std::string const Configuration::SYNCHRONIZATION_CHECKPOINT_PAGES = {"SYNCHRONIZATION_CHECKPOINT_PAGES"};
+
+std::string const Configuration::SYNCHRONIZATION_CHECKPOINT_INTERVAL = {"SYNCHRONIZATION_CHECKPOINT_INTERVAL"};
+
+std::string const Configuration::HTTP_MAX_CONCURRENT_REQUESTS = {"HTTP_MAX_CONCURRENT_REQUESTS"};
+
+std::string const Configuration::HTTP_MAX_RETRIES = {"HTTP_MAX_RETRIES"};
+
+std::string const Configuration::HTTP_RETRY_BASE_DELAY = {"HTTP_RETRY_BASE_DELAY"};
+
+std::string const Configuration::HTTP_RETRY_MAX_DELAY = {"HTTP_RETRY_MAX_DELAY"};
+
+std::string const Configuration::HTTP_HEDGE_DELAY = {"HTTP_HEDGE_DELAY"};
+
+std::string const Configuration::HTTP_COALESCE_REQUESTS = {"HTTP_COALESCE_REQUESTS"};
+
 std::string const Configuration::TRUST_LIMIT = {"TRUST_LIMIT"};
 
 std::string const Configuration::TTL_CACHE = {"TTL_CACHE"};
@@ -56,6 +56,33 @@ public:
     /** Sets the half batch size (default: 20). */
     static std::string const SYNCHRONIZATION_HALF_BATCH_SIZE;
 
+    /** Sets the maximum number of address batches of bitcoin like accounts fetched and interpreted at the same time (default: 1). */
+    static std::string const SYNCHRONIZATION_MAX_PARALLEL_BATCHES;
+
+    /** Sets the number of synchronized pages after which the synchronization state is saved (default: 10). */
+    static std::string const SYNCHRONIZATION_CHECKPOINT_PAGES;
+
+    /** Sets the maximum time in seconds after which the synchronization state is saved (default: 10). */
+    static std::string const SYNCHRONIZATION_CHECKPOINT_INTERVAL;
+
+    /** Sets the maximum number of requests in flight to an explorer host, shared by the clients of the pool (default: 0, no limit). */
+    static std::string const HTTP_MAX_CONCURRENT_REQUESTS;
+
+    /** Sets the number of retries of an explorer GET failing to reach the host (default: 0). */
+    static std::string const HTTP_MAX_RETRIES;
+
+    /** Sets the base delay in milliseconds of the exponential backoff between two retries (default: 250). */
+    static std::string const HTTP_RETRY_BASE_DELAY;
+
+    /** Sets the maximum delay in milliseconds between two retries (default: 4000). */
+    static std::string const HTTP_RETRY_MAX_DELAY;
+
+    /** Sets the delay in milliseconds after which a pending explorer GET is sent a second time (default: 0, disabled). */
+    static std::string const HTTP_HEDGE_DELAY;
+
+    /** Shares the response of identical explorer GETs in flight (default: false). */
+    static std::string const HTTP_COALESCE_REQUESTS;
+
     /** Operation trust. */
     static std::string const TRUST_LIMIT;
 
@@ -21,4 +21,10 @@ int32_t const ConfigurationDefaults::DEFAULT_TTL_CACHE = 30;
 
 int32_t const ConfigurationDefaults::DEFAULT_PG_CONNECTION_POOL_SIZE = 25;
 
+int32_t const ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_MAX_PARALLEL_BATCHES = 1;
+
+int32_t const ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_CHECKPOINT_PAGES = 10;
+
+int32_t const ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_CHECKPOINT_INTERVAL = 10;
+
 } } }  // namespace ledger::core::api
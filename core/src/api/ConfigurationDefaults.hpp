@@ -44,6 +44,15 @@ public:
 
     /** Default connection pool size for PostgreSQL */
     static int32_t const DEFAULT_PG_CONNECTION_POOL_SIZE;
+
+    /** Default number of address batches synchronized at the same time */
+    static int32_t const DEFAULT_SYNCHRONIZATION_MAX_PARALLEL_BATCHES;
+
+    /** Default number of synchronized pages between two saved state checkpoints */
+    static int32_t const DEFAULT_SYNCHRONIZATION_CHECKPOINT_PAGES;
+
+    /** Default maximum time between two saved state checkpoints (in seconds) */
+    static int32_t const DEFAULT_SYNCHRONIZATION_CHECKPOINT_INTERVAL;
 };
 
 } } }  // namespace ledger::core::api
@@ -53,6 +53,14 @@ public:
      */
     static std::shared_ptr<DatabaseBackend> getSqlite3Backend();
 
+    /**
+     * Create an instance of SQLite3 database journaling in WAL mode. Readers no longer wait behind the writer and the
+     * readonly connection pool can hold several connections.
+     * @param readonlyConnectionPoolSize, number of readonly connections opened on the database
+     * @return DatabaseBackend object
+     */
+    static std::shared_ptr<DatabaseBackend> getSqlite3WalBackend(int32_t readonlyConnectionPoolSize);
+
     /**
      * Create an instance of PostgreSQL database.
      * @return DatabaseBackend object
@@ -19,6 +19,7 @@ std::string to_string(const EventCode& eventCode) {
         case EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT: return "SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT";
         case EventCode::NEW_ERC20_OPERATION: return "NEW_ERC20_OPERATION";
         case EventCode::UPDATE_ERC20_OPERATIONS: return "UPDATE_ERC20_OPERATIONS";
+        case EventCode::DELETED_OPERATIONS: return "DELETED_OPERATIONS";
     };
 };
 template <>
@@ -33,7 +34,8 @@ EventCode from_string(const std::string& eventCode) {
     else if (eventCode == "SYNCHRONIZATION_SUCCEED") return EventCode::SYNCHRONIZATION_SUCCEED;
     else if (eventCode == "SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT") return EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT;
     else if (eventCode == "NEW_ERC20_OPERATION") return EventCode::NEW_ERC20_OPERATION;
-    else return EventCode::UPDATE_ERC20_OPERATIONS;
+    else if (eventCode == "UPDATE_ERC20_OPERATIONS") return EventCode::UPDATE_ERC20_OPERATIONS;
+    else return EventCode::DELETED_OPERATIONS;
 };
 
 std::ostream &operator<<(std::ostream &os, const EventCode &o)
@@ -50,6 +52,7 @@ std::ostream &operator<<(std::ostream &os, const EventCode &o)
         case EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT:  return os << "SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT";
         case EventCode::NEW_ERC20_OPERATION:  return os << "NEW_ERC20_OPERATION";
         case EventCode::UPDATE_ERC20_OPERATIONS:  return os << "UPDATE_ERC20_OPERATIONS";
+        case EventCode::DELETED_OPERATIONS:  return os << "DELETED_OPERATIONS";
     }
 }
 
@@ -40,6 +40,8 @@ enum class EventCode : int {
     NEW_ERC20_OPERATION,
     /** Emitted each time a batch of ERC20 is inserted in database */
     UPDATE_ERC20_OPERATIONS,
+    /** Emitted once with every operation deleted by a block reorganization */
+    DELETED_OPERATIONS,
 };
 LIBCORE_EXPORT  std::string to_string(const EventCode& eventCode);
 LIBCORE_EXPORT  std::ostream &operator<<(std::ostream &os, const EventCode &o);
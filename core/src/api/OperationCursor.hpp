@@ -0,0 +1,39 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from wallet.djinni
+
+#ifndef DJINNI_GENERATED_OPERATIONCURSOR_HPP
+#define DJINNI_GENERATED_OPERATIONCURSOR_HPP
+
+#include <memory>
+#ifndef LIBCORE_EXPORT
+    #if defined(_MSC_VER)
+       #include <libcore_export.h>
+    #else
+       #define LIBCORE_EXPORT
+    #endif
+#endif
+
+namespace ledger { namespace core { namespace api {
+
+class OperationListCallback;
+
+/**
+ * Cursor over the results of an operation query. The underlying statement stays open until the cursor is
+ * exhausted or closed.
+ */
+class LIBCORE_EXPORT OperationCursor {
+public:
+    virtual ~OperationCursor() {}
+
+    /**
+     * Fetch the next chunk of operations.
+     * @param callback, ListCallback object returning a List of Operation objects, empty once the cursor is exhausted
+     */
+    virtual void next(const std::shared_ptr<OperationListCallback> & callback) = 0;
+
+    /** Release the underlying statement and database connection. */
+    virtual void close() = 0;
+};
+
+} } }  // namespace ledger::core::api
+#endif //DJINNI_GENERATED_OPERATIONCURSOR_HPP
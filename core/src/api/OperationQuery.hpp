@@ -4,8 +4,10 @@
 #ifndef DJINNI_GENERATED_OPERATIONQUERY_HPP
 #define DJINNI_GENERATED_OPERATIONQUERY_HPP
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <string>
 #ifndef LIBCORE_EXPORT
     #if defined(_MSC_VER)
        #include <libcore_export.h>
@@ -16,6 +18,7 @@
 
 namespace ledger { namespace core { namespace api {
 
+class OperationCursor;
 class OperationListCallback;
 class QueryFilter;
 enum class OperationOrderKey;
@@ -60,11 +63,27 @@ public:
     /**TODO */
     virtual std::shared_ptr<OperationQuery> partial() = 0;
 
+    /**
+     * Keep only operations located strictly after the given operation in the query order (keyset pagination).
+     * The query must be ordered by date only, operations sharing a date are ordered by uid.
+     * @param date, date of the last operation of the previous page
+     * @param uid, uid of the last operation of the previous page
+     * @return OperationQuery object
+     */
+    virtual std::shared_ptr<OperationQuery> after(const std::chrono::system_clock::time_point & date, const std::string & uid) = 0;
+
     /**
      * Execute query to retrieve operations.
      * @param callback, if execute method succeed, ListCallback object returning a List of Operation objects
      */
     virtual void execute(const std::shared_ptr<OperationListCallback> & callback) = 0;
+
+    /**
+     * Open a cursor streaming the query results.
+     * @param chunkSize, 32-bit integer, maximum number of operations returned by each fetch
+     * @return OperationCursor object
+     */
+    virtual std::shared_ptr<OperationCursor> cursor(int32_t chunkSize) = 0;
 };
 
 } } }  // namespace ledger::core::api
@@ -31,15 +31,14 @@
 #ifndef LEDGER_CORE_DEFFERED_HPP
 #define LEDGER_CORE_DEFFERED_HPP
 
+#include <atomic>
 #include <memory>
 #include <functional>
 #include "../utils/Option.hpp"
 #include "../utils/Try.hpp"
-#include <mutex>
 #include "../utils/Exception.hpp"
-#include <queue>
 #include "../api/ExecutionContext.hpp"
-#include <tuple>
+#include "../utils/ImmediateExecutionContext.hpp"
 #include "../utils/LambdaRunnable.hpp"
 
 namespace ledger {
@@ -51,6 +50,13 @@ namespace ledger {
         template <typename T>
         class Promise;
 
+        /**
+         * Completion state shared by a promise and its futures.
+         *
+         * The result is written once by the completing thread and published through an atomic state, callbacks are
+         * pushed on an intrusive lock-free list which the completion closes and drains in registration order. A
+         * callback bound to ImmediateExecutionContext is invoked inline, any other context receives a runnable.
+         */
         template <typename T>
         class Deffered {
 
@@ -59,88 +65,137 @@ namespace ledger {
 
             friend class Future<T>;
             friend class Promise<T>;
-            Deffered() {
+            Deffered() : _state(PENDING), _callbacks(nullptr) {
 
             };
             Deffered(const Deffered&) = delete;
             Deffered(Deffered&&) = delete;
 
-            void setResult(const Try<T>& result) {
-                {
-                    std::lock_guard<std::recursive_mutex> lock(_lock);
-                    ensureNotCompleted();
-                    _value = result;
+            ~Deffered() {
+                auto node = _callbacks.load(std::memory_order_acquire);
+                if (node != closed()) {
+                    release(node);
                 }
-                trigger();
+            }
+
+            void setResult(const Try<T>& result) {
+                acquireCompletion();
+                _value = result;
+                complete();
             }
 
             void setValue(const T& value) {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                ensureNotCompleted();
+                acquireCompletion();
                 _value = Try<T>(value);
-                _trigger();
+                complete();
             };
 
             void setError(const Exception& exception) {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                ensureNotCompleted();
+                acquireCompletion();
                 Try<T> ex;
                 ex.fail(exception);
                 _value = ex;
-                _trigger();
+                complete();
             }
 
             void addCallback(Callback callback, std::shared_ptr<api::ExecutionContext> context) {
-                // Add to the queue
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                _callbacks.push(std::make_tuple(callback, context));
-                _trigger();
+                auto node = new Node(std::move(callback), std::move(context));
+                auto head = _callbacks.load(std::memory_order_acquire);
+                do {
+                    if (head == closed()) {
+                        // Already completed, the result is visible since the list was closed after it was written
+                        std::unique_ptr<Node> owned(node);
+                        dispatch(*owned);
+                        return;
+                    }
+                    node->next = head;
+                } while (!_callbacks.compare_exchange_weak(head, node, std::memory_order_acq_rel, std::memory_order_acquire));
             }
 
             Option<Try<T>> getValue() const {
-                Option<Try<T>> cpy = _value;
-                return cpy;
+                if (_state.load(std::memory_order_acquire) != COMPLETED) {
+                    return Option<Try<T>>();
+                }
+                return _value;
             }
 
             bool hasValue() const {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                return _value.hasValue();
+                return _state.load(std::memory_order_acquire) == COMPLETED;
             }
 
-            void trigger() {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                _trigger();
+        private:
+            enum State { PENDING, COMPLETING, COMPLETED };
+
+            struct Node {
+                Node(Callback&& cb, std::shared_ptr<api::ExecutionContext>&& ctx)
+                    : callback(std::move(cb)), context(std::move(ctx)), next(nullptr) {}
+                Callback callback;
+                std::shared_ptr<api::ExecutionContext> context;
+                Node* next;
+            };
+
+            // Marks the callback list once the result is published, no node is ever allocated at this address
+            static Node* closed() {
+                static char tag;
+                return reinterpret_cast<Node*>(&tag);
             }
 
-        private:
-            inline void ensureNotCompleted() {
-                if (_value.hasValue())
+            static void release(Node* node) {
+                while (node != nullptr) {
+                    auto next = node->next;
+                    delete node;
+                    node = next;
+                }
+            }
+
+            inline void acquireCompletion() {
+                auto expected = static_cast<int>(PENDING);
+                if (!_state.compare_exchange_strong(expected, COMPLETING, std::memory_order_acq_rel)) {
                     throw Exception(api::ErrorCode::ALREADY_COMPLETED, "This promise is already completed");
+                }
             };
 
-            inline void _trigger() {
-                if (_value.isEmpty() || _callbacks.empty()) {
-                    return ;
+            void complete() {
+                _state.store(COMPLETED, std::memory_order_release);
+                auto head = _callbacks.exchange(closed(), std::memory_order_acq_rel);
+                // The list is a stack, reverse it to run callbacks in registration order
+                Node* ordered = nullptr;
+                while (head != nullptr) {
+                    auto next = head->next;
+                    head->next = ordered;
+                    ordered = head;
+                    head = next;
                 }
-                while (!_callbacks.empty()) {
-                    std::tuple<Callback, std::shared_ptr<api::ExecutionContext>> callback = _callbacks.front();
-                    Callback cb = std::get<0>(callback);
-                    auto value = _value.getValue();
-                    std::get<1>(callback)->execute(make_runnable([cb, value] () {
-                        cb(value);
-                    }));
-                    _callbacks.pop();
+                while (ordered != nullptr) {
+                    std::unique_ptr<Node> node(ordered);
+                    ordered = ordered->next;
+                    try {
+                        dispatch(*node);
+                    } catch (...) {
+                        release(ordered);
+                        throw;
+                    }
                 }
             }
 
+            void dispatch(Node& node) {
+                const auto& value = _value.getValue();
+                if (node.context == ImmediateExecutionContext::INSTANCE) {
+                    node.callback(value);
+                    return;
+                }
+                auto cb = std::move(node.callback);
+                node.context->execute(make_runnable([cb, value] () {
+                    cb(value);
+                }));
+            }
+
         private:
-            mutable std::recursive_mutex _lock;
+            std::atomic<int> _state;
+            std::atomic<Node*> _callbacks;
             Option<Try<T>> _value;
-            std::queue<std::tuple<Callback, std::shared_ptr<api::ExecutionContext>>> _callbacks;
         };
 
-
-
     }
 }
 
@@ -196,7 +196,7 @@ namespace ledger {
             }
 
             bool isCompleted() const {
-                return getValue().hasValue();
+                return _defer->hasValue();
             }
 
             Future<Exception> failed() {
@@ -32,6 +32,9 @@
 #define LEDGER_CORE_ALGORITHM_H
 
 #include "Future.hpp"
+#include "Promise.hpp"
+#include <algorithm>
+#include <mutex>
 #include <utils/ImmediateExecutionContext.hpp>
 
 namespace ledger {
@@ -55,6 +58,154 @@ namespace ledger {
 
 }
 
+            namespace internals {
+
+                // Shared by every step of a bounded traversal. Items are started from `next` while less than the
+                // maximum are in flight, a single thread at a time starts them (`pumping`) so that futures
+                // completing inline do not recurse.
+                template <class T, class R>
+                struct Traversal {
+                    std::shared_ptr<api::ExecutionContext> context;
+                    std::vector<T> items;
+                    std::function<Future<R> (const T&)> f;
+                    std::size_t maxInFlight;
+                    bool ordered;
+
+                    std::mutex lock;
+                    std::size_t next = 0;
+                    std::size_t inFlight = 0;
+                    std::size_t done = 0;
+                    bool pumping = false;
+                    bool failed = false;
+                    std::vector<Option<R>> slots;
+                    std::vector<R> results;
+                    Promise<std::vector<R>> promise;
+                };
+
+                template <class T, class R>
+                void traverse_complete(const std::shared_ptr<Traversal<T, R>>& traversal) {
+                    if (traversal->ordered) {
+                        traversal->results.reserve(traversal->slots.size());
+                        for (auto& slot : traversal->slots) {
+                            traversal->results.push_back(slot.getValue());
+                        }
+                    }
+                    traversal->promise.success(traversal->results);
+                }
+
+                template <class T, class R>
+                void traverse_pump(const std::shared_ptr<Traversal<T, R>>& traversal) {
+                    {
+                        std::lock_guard<std::mutex> lock(traversal->lock);
+                        if (traversal->pumping) {
+                            return;
+                        }
+                        traversal->pumping = true;
+                    }
+                    while (true) {
+                        std::size_t index;
+                        {
+                            std::lock_guard<std::mutex> lock(traversal->lock);
+                            if (traversal->failed || traversal->next >= traversal->items.size() ||
+                                traversal->inFlight >= traversal->maxInFlight) {
+                                traversal->pumping = false;
+                                return;
+                            }
+                            index = traversal->next++;
+                            traversal->inFlight += 1;
+                        }
+                        auto future = Try<Future<R>>::from([&] () {
+                            return traversal->f(traversal->items[index]);
+                        });
+                        if (future.isFailure()) {
+                            {
+                                std::lock_guard<std::mutex> lock(traversal->lock);
+                                traversal->failed = true;
+                                traversal->pumping = false;
+                            }
+                            traversal->promise.tryFailure(future.getFailure());
+                            return;
+                        }
+                        Future<R> started = future.getValue();
+                        started.onComplete(traversal->context, [traversal, index] (const Try<R>& result) {
+                            bool completed = false;
+                            {
+                                std::lock_guard<std::mutex> lock(traversal->lock);
+                                traversal->inFlight -= 1;
+                                if (traversal->failed) {
+                                    return;
+                                }
+                                if (result.isSuccess()) {
+                                    if (traversal->ordered) {
+                                        traversal->slots[index] = result.getValue();
+                                    } else {
+                                        traversal->results.push_back(result.getValue());
+                                    }
+                                    traversal->done += 1;
+                                    completed = traversal->done == traversal->items.size();
+                                } else {
+                                    // Items not started yet never will be
+                                    traversal->failed = true;
+                                }
+                            }
+                            if (result.isFailure()) {
+                                traversal->promise.tryFailure(result.getFailure());
+                            } else if (completed) {
+                                traverse_complete(traversal);
+                            } else {
+                                traverse_pump(traversal);
+                            }
+                        });
+                    }
+                }
+
+                template <class T, class R>
+                Future<std::vector<R>> traverse_start(const std::shared_ptr<api::ExecutionContext>& context,
+                                                      const std::vector<T>& items,
+                                                      std::size_t maxInFlight,
+                                                      const std::function<Future<R> (const T&)>& f,
+                                                      bool ordered) {
+                    if (items.empty()) {
+                        return Future<std::vector<R>>::successful(std::vector<R>());
+                    }
+                    auto traversal = std::make_shared<Traversal<T, R>>();
+                    traversal->context = context;
+                    traversal->items = items;
+                    traversal->f = f;
+                    traversal->maxInFlight = std::max<std::size_t>(maxInFlight, 1);
+                    traversal->ordered = ordered;
+                    if (ordered) {
+                        traversal->slots.resize(items.size());
+                    }
+                    auto future = traversal->promise.getFuture();
+                    traverse_pump(traversal);
+                    return future;
+                }
+            }
+
+            /**
+             * Apply f to every item with at most maxInFlight futures running at once, the results are in the order
+             * of the items. The first failure fails the traversal and no further item is started.
+             */
+            template <class T, class R>
+            Future<std::vector<R>> traverse(const std::shared_ptr<api::ExecutionContext>& context,
+                                            const std::vector<T>& items,
+                                            std::size_t maxInFlight,
+                                            std::function<Future<R> (const T&)> f) {
+                return internals::traverse_start<T, R>(context, items, maxInFlight, f, true);
+            }
+
+            /**
+             * Same as traverse, the results are in completion order.
+             */
+            template <class T, class R>
+            Future<std::vector<R>> mapAsyncN(const std::shared_ptr<api::ExecutionContext>& context,
+                                             const std::vector<T>& items,
+                                             std::size_t maxInFlight,
+                                             std::function<Future<R> (const T&)> f) {
+                return internals::traverse_start<T, R>(context, items, maxInFlight, f, false);
+            }
+
             template <class T>
             Future< std::vector<T> > sequence(const std::shared_ptr<api::ExecutionContext>& context, const std::vector< Future<T> >& futures) {
             auto buffer = new std::vector<T>();
@@ -105,5 +105,9 @@ namespace ledger {
             return BitcoinExtendedPublicKey::deriveHash160(path);
         }
 
+        std::vector<uint8_t> BitcoinLikeExtendedPublicKey::deriveRange(uint32_t from, uint32_t to) const {
+            return _key.deriveRange(from, to);
+        }
+
     }
 }
@@ -56,6 +56,10 @@ namespace ledger {
 
             std::vector<uint8_t> deriveHash160(const std::string &path) override;
 
+            // Compressed public keys of children [from, to] of this key, contiguous in a single buffer
+            // (see DeterministicPublicKey::deriveRange).
+            std::vector<uint8_t> deriveRange(uint32_t from, uint32_t to) const;
+
             std::string toBase58() override;
 
             std::string getRootPath() override;
@@ -43,11 +43,24 @@
 #include "Keccak.h"
 #include <api/Secp256k1.hpp>
 #include <crypto/BLAKE.h>
+#include <utils/Concurrency.hpp>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <thread>
 
 namespace ledger {
     namespace core {
 
         static auto N = BigInt::fromHex("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+        static const uint8_t N_BYTES[32] = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+            0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41
+        };
+        // Under this number of children, deriveRange stays on the calling thread
+        static const uint32_t DERIVE_RANGE_CHUNK_SIZE = 64;
+
+        constexpr size_t DeterministicPublicKey::COMPRESSED_KEY_SIZE;
 
         DeterministicPublicKey::DeterministicPublicKey(const std::vector<uint8_t> &publicKey,
                                                        const std::vector<uint8_t> &chainCode, uint32_t childNum,
@@ -124,6 +137,62 @@ namespace ledger {
             );
         }
 
+        std::vector<uint8_t> DeterministicPublicKey::deriveRange(uint32_t from, uint32_t to) const {
+            if (to < from) {
+                throw Exception(api::ErrorCode::INVALID_ARGUMENT, "Cannot derive an empty range of keys");
+            }
+            if ((from & 0x80000000) || (to & 0x80000000)) {
+                throw Exception(api::ErrorCode::PRIVATE_DERIVATION_NOT_SUPPORTED, "Private derivation is not supported by DeterministicPublicKey");
+            }
+            const auto count = to - from + 1;
+            std::vector<uint8_t> keys(count * COMPRESSED_KEY_SIZE);
+            const SECP256k1Point parent(_key);
+            const HMACSHA512 hmac(_chainCode);
+
+            // Derives children [offset, offset + size) of the range, each chunk works with its own HMAC context
+            auto deriveChunk = [&] (uint32_t offset, uint32_t size) {
+                HMACSHA512 chunkHmac(hmac);
+                std::vector<uint8_t> data(_key);
+                data.resize(_key.size() + 4);
+                uint8_t I[HMACSHA512::DIGEST_LENGTH];
+                for (auto i = offset; i < offset + size; i++) {
+                    auto childIndex = from + i;
+                    data[_key.size()] = (uint8_t) (childIndex >> 24);
+                    data[_key.size() + 1] = (uint8_t) (childIndex >> 16);
+                    data[_key.size() + 2] = (uint8_t) (childIndex >> 8);
+                    data[_key.size() + 3] = (uint8_t) childIndex;
+                    chunkHmac.hash(data.data(), data.size(), I);
+                    if (std::memcmp(I, N_BYTES, sizeof(N_BYTES)) >= 0) {
+                        throw Exception(api::ErrorCode::UNSUPPORTED_OPERATION, "Cannot derive key - IL >= N");
+                    }
+                    parent.generatorMultiply(I, keys.data() + i * COMPRESSED_KEY_SIZE);
+                }
+            };
+
+            if (count <= DERIVE_RANGE_CHUNK_SIZE || std::thread::hardware_concurrency() < 2) {
+                deriveChunk(0, count);
+                return keys;
+            }
+            std::vector<std::pair<uint32_t, uint32_t>> chunks;
+            for (uint32_t offset = 0; offset < count; offset += DERIVE_RANGE_CHUNK_SIZE) {
+                chunks.emplace_back(offset, std::min(DERIVE_RANGE_CHUNK_SIZE, count - offset));
+            }
+            std::vector<std::exception_ptr> failures(chunks.size());
+            Concurrency::parallel_for_each(chunks.begin(), chunks.end(), [&] (const std::pair<uint32_t, uint32_t>& chunk) {
+                try {
+                    deriveChunk(chunk.first, chunk.second);
+                } catch (...) {
+                    failures[chunk.first / DERIVE_RANGE_CHUNK_SIZE] = std::current_exception();
+                }
+            });
+            for (const auto& failure : failures) {
+                if (failure) {
+                    std::rethrow_exception(failure);
+                }
+            }
+            return keys;
+        }
+
         std::vector<uint8_t> DeterministicPublicKey::toByteArray(const std::vector<uint8_t> &version) const {
             BytesWriter writer;
             writer.writeByteArray(version);
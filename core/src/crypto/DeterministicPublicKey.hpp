@@ -32,6 +32,8 @@
 #define LEDGER_CORE_DETERMINISTICPUBLICKEY_HPP
 
 #include <vector>
+#include <string>
+#include <cstdint>
 
 namespace ledger {
     namespace core {
@@ -47,6 +49,10 @@ namespace ledger {
             DeterministicPublicKey(const DeterministicPublicKey& key);
             uint32_t getFingerprint() const;
             DeterministicPublicKey derive(uint32_t childIndex) const;
+            // Derives the public keys of children [from, to] (non hardened). Compressed keys are returned
+            // one after the other in a single buffer of (to - from + 1) * COMPRESSED_KEY_SIZE bytes. The parent
+            // key is parsed and the HMAC key schedule computed only once, large ranges are split on several threads.
+            std::vector<uint8_t> deriveRange(uint32_t from, uint32_t to) const;
 
             const std::vector<uint8_t>& getPublicKey() const;
             std::vector<uint8_t> getUncompressedPublicKey() const;
@@ -55,7 +61,7 @@ namespace ledger {
             std::vector<uint8_t> getPublicKeyBlake2b(bool isED25519 = false) const;
             std::vector<uint8_t> toByteArray(const std::vector<uint8_t>& version = {}) const;
         public:
-
+            static constexpr size_t COMPRESSED_KEY_SIZE = 33;
 
         private:
             const std::vector<uint8_t> _key;
@@ -76,3 +76,46 @@ std::vector<uint8_t> ledger::core::HMAC::sha512(const std::vector<uint8_t>& key,
 #endif
     return hash;
 }
+
+constexpr size_t ledger::core::HMACSHA512::DIGEST_LENGTH;
+
+ledger::core::HMACSHA512::HMACSHA512(const std::vector<uint8_t>& key) {
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+    auto hmac = new HMAC_CTX();
+    HMAC_CTX_init(hmac);
+#else
+    auto hmac = HMAC_CTX_new();
+#endif
+    HMAC_Init_ex(hmac, key.data(), key.size(), EVP_sha512(), NULL);
+    _context = hmac;
+}
+
+ledger::core::HMACSHA512::HMACSHA512(const HMACSHA512& hmac) {
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+    auto copy = new HMAC_CTX();
+    HMAC_CTX_init(copy);
+#else
+    auto copy = HMAC_CTX_new();
+#endif
+    HMAC_CTX_copy(copy, static_cast<HMAC_CTX *>(hmac._context));
+    _context = copy;
+}
+
+ledger::core::HMACSHA512::~HMACSHA512() {
+    auto hmac = static_cast<HMAC_CTX *>(_context);
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+    HMAC_CTX_cleanup(hmac);
+    delete hmac;
+#else
+    HMAC_CTX_free(hmac);
+#endif
+}
+
+void ledger::core::HMACSHA512::hash(const uint8_t* data, size_t size, uint8_t* out) {
+    auto hmac = static_cast<HMAC_CTX *>(_context);
+    unsigned int len = DIGEST_LENGTH;
+    // A null key and digest restart from the key schedule computed at construction
+    HMAC_Init_ex(hmac, NULL, 0, NULL, NULL);
+    HMAC_Update(hmac, data, size);
+    HMAC_Final(hmac, out, &len);
+}
@@ -33,6 +33,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
 namespace ledger {
     namespace core {
@@ -45,6 +46,27 @@ namespace ledger {
             static std::vector<uint8_t> sha512(const std::vector<uint8_t>& key,
                                                const std::vector<uint8_t>& data);
         };
+
+        /**
+         * HMAC-SHA512 bound to a key. The key schedule is computed once at construction, then every
+         * call to hash reuses it; useful when the same key authenticates many messages (e.g. deriving
+         * many children of the same chain code). Instances are not thread safe, copy them instead.
+         */
+        class HMACSHA512 {
+        public:
+            static constexpr size_t DIGEST_LENGTH = 64;
+
+            explicit HMACSHA512(const std::vector<uint8_t>& key);
+            HMACSHA512(const HMACSHA512& hmac);
+            HMACSHA512& operator=(const HMACSHA512& hmac) = delete;
+            ~HMACSHA512();
+
+            // Writes the DIGEST_LENGTH bytes of the digest of data in out.
+            void hash(const uint8_t* data, size_t size, uint8_t* out);
+
+        private:
+            void* _context;
+        };
     }
 }
 
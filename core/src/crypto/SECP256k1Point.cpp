@@ -88,6 +88,16 @@ namespace ledger {
             return SECP256k1Point(serializedKey);
         }
 
+        void SECP256k1Point::generatorMultiply(const uint8_t *n, uint8_t *out) const {
+            ensurePubkeyIsNotNull();
+            secp256k1_pubkey pubKey;
+            memcpy(&pubKey, _pubKey, sizeof(pubKey));
+            if (secp256k1_ec_pubkey_tweak_add(_context.ptr, &pubKey, n) == 0)
+                throw Exception(api::ErrorCode::RUNTIME_ERROR, "void SECP256k1Point::generatorMultiply(const uint8_t *n, uint8_t *out) failed");
+            size_t len = 33;
+            secp256k1_ec_pubkey_serialize(_context.ptr, out, &len, &pubKey, SECP256K1_EC_COMPRESSED);
+        }
+
         std::vector<uint8_t> SECP256k1Point::toByteArray(bool compressed) const {
             ensurePubkeyIsNotNull();
             if (compressed) {
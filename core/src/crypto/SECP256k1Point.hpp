@@ -54,6 +54,9 @@ namespace ledger {
             SECP256k1Point(const std::vector<uint8_t>& p);
             SECP256k1Point operator+(const SECP256k1Point& p) const;
             SECP256k1Point generatorMultiply(const std::vector<uint8_t>& n) const;
+            // Adds n * G to this point without modifying it. n is a 32 bytes big endian number, the
+            // compressed result (33 bytes) is written in out. Does not allocate.
+            void generatorMultiply(const uint8_t* n, uint8_t* out) const;
             SECP256k1Point(const SECP256k1Point& p);
             std::vector<uint8_t> toByteArray(bool compressed = true) const;
             SECP256k1Point& operator=(const SECP256k1Point& p);
@@ -45,6 +45,13 @@ namespace ledger {
             return std::make_shared<SQLite3Backend>();
         }
 
+        std::shared_ptr<api::DatabaseBackend> api::DatabaseBackend::getSqlite3WalBackend(int32_t readonlyConnectionPoolSize) {
+            if (readonlyConnectionPoolSize < 1) {
+                throw make_exception(api::ErrorCode::ILLEGAL_ARGUMENT, "Readonly connection pool size should be at least 1, got {}.", readonlyConnectionPoolSize);
+            }
+            return std::make_shared<SQLite3Backend>(true, readonlyConnectionPoolSize);
+        }
+
         std::shared_ptr<api::DatabaseBackend> api::DatabaseBackend::getPostgreSQLBackend(int32_t connectionPoolSize, int32_t readonlyConnectionPoolSize) {
 #ifdef PG_SUPPORT
             return std::make_shared<PostgreSQLBackend>(connectionPoolSize, readonlyConnectionPoolSize);
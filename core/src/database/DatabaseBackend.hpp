@@ -50,6 +50,19 @@ namespace ledger {
                     soci::session &session
             ) = 0;
 
+            /**
+             * Initialize a session of the readonly pool. Backends may restrict or tune those connections, by default
+             * they are initialized like any other session.
+             */
+            virtual void initReadonly(
+                    const std::shared_ptr<api::PathResolver> &resolver,
+                    const std::string &dbName,
+                    const std::string &password,
+                    soci::session &session
+            ) {
+                init(resolver, dbName, password, session);
+            }
+
             virtual void setPassword(const std::string &password,
                                      soci::session &session) = 0;
 
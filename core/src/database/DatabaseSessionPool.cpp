@@ -32,6 +32,7 @@
 #include "DatabaseSessionPool.hpp"
 #include "migrations.hpp"
 #include "SQLite3Backend.hpp"
+#include "StatementCache.hpp"
 #ifdef PG_SUPPORT
     #include "PostgreSQLBackend.h"
 #endif
@@ -43,7 +44,8 @@ namespace ledger {
             const std::shared_ptr<api::PathResolver> &resolver,
             const std::shared_ptr<spdlog::logger>& logger,
             const std::string &dbName,
-            const std::string &password) :
+            const std::string &password,
+            const std::shared_ptr<api::ExecutionContext> &writerContext) :
             _pool((size_t) backend->getConnectionPoolSize()), _readonlyPool((size_t)backend->getReadonlyConnectionPoolSize()), _backend(backend), _buffer("SQL", logger) {
             if (logger != nullptr && backend->isLoggingEnabled()) {
                 _logger = new std::ostream(&_buffer);
@@ -71,17 +73,40 @@ namespace ledger {
             auto readonlyPoolSize = _backend->getReadonlyConnectionPoolSize();
             for (size_t i = 0; i < readonlyPoolSize; i++) {
                 auto& session = getReadonlyPool().at(i);
-                _backend->init(resolver, dbName, password, session);
+                _backend->initReadonly(resolver, dbName, password, session);
                 if (_logger != nullptr) {
                     session.set_log_stream(_logger);
                 }
             }
+            attachStatementCaches();
+            _writeQueue = std::make_shared<DatabaseWriteQueue>(_pool, writerContext);
         }
 
         DatabaseSessionPool::~DatabaseSessionPool() {
+            // Pending writes are committed before the connections go away
+            _writeQueue->stop();
+            detachStatementCaches();
             delete _logger;
         }
 
+        void DatabaseSessionPool::attachStatementCaches() {
+            for (size_t i = 0; i < _backend->getConnectionPoolSize(); i++) {
+                StatementCache::attach(getPool().at(i), std::make_shared<StatementCache>());
+            }
+            for (size_t i = 0; i < _backend->getReadonlyConnectionPoolSize(); i++) {
+                StatementCache::attach(getReadonlyPool().at(i), std::make_shared<StatementCache>());
+            }
+        }
+
+        void DatabaseSessionPool::detachStatementCaches() {
+            for (size_t i = 0; i < _backend->getConnectionPoolSize(); i++) {
+                StatementCache::detach(getPool().at(i));
+            }
+            for (size_t i = 0; i < _backend->getReadonlyConnectionPoolSize(); i++) {
+                StatementCache::detach(getReadonlyPool().at(i));
+            }
+        }
+
         FuturePtr<DatabaseSessionPool>
         DatabaseSessionPool::getSessionPool(const std::shared_ptr<api::ExecutionContext> &context,
                                             const std::shared_ptr<DatabaseBackend> &backend,
@@ -89,9 +114,9 @@ namespace ledger {
                                             const std::shared_ptr<spdlog::logger> &logger,
                                             const std::string &dbName,
                                             const std::string &password) {
-            return FuturePtr<DatabaseSessionPool>::async(context, [backend, resolver, dbName, logger, password] () {
+            return FuturePtr<DatabaseSessionPool>::async(context, [context, backend, resolver, dbName, logger, password] () {
                 auto pool = std::shared_ptr<DatabaseSessionPool>(new DatabaseSessionPool(
-                    backend, resolver, logger, dbName, password
+                    backend, resolver, logger, dbName, password, context
                 ));
 
                 return pool;
@@ -106,6 +131,10 @@ namespace ledger {
             return _readonlyPool;
         }
 
+        std::shared_ptr<DatabaseWriteQueue> DatabaseSessionPool::getWriteQueue() {
+            return _writeQueue;
+        }
+
         void DatabaseSessionPool::performDatabaseMigration() {
             soci::session sql(getPool());
             int version = getDatabaseMigrationVersion(sql);
@@ -116,6 +145,9 @@ namespace ledger {
         }
 
         void DatabaseSessionPool::performDatabaseRollback() {
+            // Cached statements may reference the dropped tables
+            detachStatementCaches();
+            attachStatementCaches();
             soci::session sql(getPool());
             int version = getDatabaseMigrationVersion(sql);
 
@@ -126,11 +158,14 @@ namespace ledger {
 
         void DatabaseSessionPool::performChangePassword(const std::string &oldPassword,
                                                         const std::string &newPassword) {
+            // Connections are reopened with the new password, their statements can't be reused
+            detachStatementCaches();
             auto poolSize = _backend->getConnectionPoolSize();
             for (size_t i = 0; i < poolSize; i++) {
                 auto& session = getPool().at(i);
                 _backend->changePassword(oldPassword, newPassword, session);
             }
+            attachStatementCaches();
         }
 
         bool DatabaseSessionPool::isSqlite() const {
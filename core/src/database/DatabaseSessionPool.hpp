@@ -38,6 +38,7 @@
 #include <database/DatabaseBackend.hpp>
 #include <debug/LoggerStreamBuffer.h>
 #include <api/DatabaseBackendType.hpp>
+#include <database/DatabaseWriteQueue.hpp>
 
 namespace ledger {
     namespace core {
@@ -47,9 +48,12 @@ namespace ledger {
                                 const std::shared_ptr<api::PathResolver> &resolver,
                                 const std::shared_ptr<spdlog::logger> &logger,
                                 const std::string &dbName,
-                                const std::string &password);
+                                const std::string &password,
+                                const std::shared_ptr<api::ExecutionContext> &writerContext);
             soci::connection_pool& getPool();
             soci::connection_pool& getReadonlyPool();
+            // Writes grouped in shared transactions on a serial writer context
+            std::shared_ptr<DatabaseWriteQueue> getWriteQueue();
             ~DatabaseSessionPool();
 
             static FuturePtr<DatabaseSessionPool> getSessionPool(
@@ -61,7 +65,7 @@ namespace ledger {
                 const std::string &password = ""
             );
 
-            static const int CURRENT_DATABASE_SCHEME_VERSION = 25;
+            static const int CURRENT_DATABASE_SCHEME_VERSION = 31;
 
             void performDatabaseMigration();
             void performDatabaseRollback();
@@ -71,12 +75,16 @@ namespace ledger {
             bool isPostgres() const;
 
         private:
+            void attachStatementCaches();
+            void detachStatementCaches();
+
             std::shared_ptr<DatabaseBackend> _backend;
             soci::connection_pool _pool;
             soci::connection_pool _readonlyPool;
             std::ostream* _logger;
             LoggerStreamBuffer _buffer;
             api::DatabaseBackendType _type;
+            std::shared_ptr<DatabaseWriteQueue> _writeQueue;
         };
     }
 }
@@ -0,0 +1,185 @@
+/*
+ *
+ * DatabaseWriteQueue.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "DatabaseWriteQueue.hpp"
+#include <utils/Exception.hpp>
+#include <utils/LambdaRunnable.hpp>
+
+namespace ledger {
+    namespace core {
+
+        const std::chrono::milliseconds DatabaseWriteQueue::DEFAULT_COMMIT_WINDOW = std::chrono::milliseconds(10);
+        const size_t DatabaseWriteQueue::DEFAULT_MAX_JOBS_PER_COMMIT = 64;
+
+        DatabaseWriteQueue::DatabaseWriteQueue(soci::connection_pool& pool,
+                                               const std::shared_ptr<api::ExecutionContext>& writerContext,
+                                               std::chrono::milliseconds commitWindow,
+                                               size_t maxJobsPerCommit)
+                : _pool(pool), _writerContext(writerContext), _commitWindow(commitWindow),
+                  _maxJobsPerCommit(std::max<size_t>(maxJobsPerCommit, 1)), _stopped(false), _drainScheduled(false),
+                  _commitCount(0), _executedJobCount(0) {
+
+        }
+
+        DatabaseWriteQueue::~DatabaseWriteQueue() {
+            stop();
+        }
+
+        Future<Unit> DatabaseWriteQueue::submit(const Job& job) {
+            PendingJob pending{job, Promise<Unit>()};
+            auto future = pending.promise.getFuture();
+            bool scheduleDelayed = false;
+            bool scheduleNow = false;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (_stopped) {
+                    return Future<Unit>::failure(make_exception(api::ErrorCode::ILLEGAL_STATE, "The database write queue is stopped."));
+                }
+                _jobs.push_back(std::move(pending));
+                if (!_drainScheduled) {
+                    // Leave other writers a chance to join the transaction
+                    _drainScheduled = true;
+                    scheduleDelayed = true;
+                } else if (_jobs.size() == _maxJobsPerCommit) {
+                    scheduleNow = true;
+                }
+            }
+            if (scheduleDelayed || scheduleNow) {
+                scheduleDrain(scheduleDelayed);
+            }
+            return future;
+        }
+
+        void DatabaseWriteQueue::stop() {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _stopped = true;
+                if (_committingThread == std::this_thread::get_id()) {
+                    // Stopped from a job, the writer context drains the remaining jobs
+                    return;
+                }
+            }
+            std::lock_guard<std::mutex> commitLock(_commitLock);
+            while (true) {
+                auto jobs = takeJobs();
+                if (jobs.empty()) {
+                    return;
+                }
+                commit(jobs);
+            }
+        }
+
+        uint64_t DatabaseWriteQueue::getCommitCount() const {
+            return _commitCount;
+        }
+
+        uint64_t DatabaseWriteQueue::getExecutedJobCount() const {
+            return _executedJobCount;
+        }
+
+        void DatabaseWriteQueue::scheduleDrain(bool delayed) {
+            std::weak_ptr<DatabaseWriteQueue> weakSelf = shared_from_this();
+            auto runnable = make_runnable([weakSelf] () {
+                if (auto self = weakSelf.lock()) {
+                    self->drain();
+                }
+            });
+            if (delayed) {
+                _writerContext->delay(runnable, _commitWindow.count());
+            } else {
+                _writerContext->execute(runnable);
+            }
+        }
+
+        void DatabaseWriteQueue::drain() {
+            bool remaining;
+            {
+                std::lock_guard<std::mutex> commitLock(_commitLock);
+                auto jobs = takeJobs();
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    _committingThread = std::this_thread::get_id();
+                }
+                if (!jobs.empty()) {
+                    commit(jobs);
+                }
+                std::lock_guard<std::mutex> lock(_lock);
+                _committingThread = std::thread::id();
+                remaining = !_jobs.empty();
+                _drainScheduled = remaining;
+            }
+            if (remaining) {
+                scheduleDrain(false);
+            }
+        }
+
+        std::vector<DatabaseWriteQueue::PendingJob> DatabaseWriteQueue::takeJobs() {
+            std::lock_guard<std::mutex> lock(_lock);
+            std::vector<PendingJob> jobs;
+            while (!_jobs.empty() && jobs.size() < _maxJobsPerCommit) {
+                jobs.push_back(std::move(_jobs.front()));
+                _jobs.pop_front();
+            }
+            return jobs;
+        }
+
+        void DatabaseWriteQueue::commit(std::vector<PendingJob>& jobs) {
+            std::vector<Option<Exception>> failures(jobs.size());
+            auto committed = Try<Unit>::from([&] () {
+                soci::session sql(_pool);
+                soci::transaction tr(sql);
+                for (size_t i = 0; i < jobs.size(); i++) {
+                    sql << "SAVEPOINT write_queue_job";
+                    auto result = Try<Unit>::from([&] () {
+                        jobs[i].job(sql);
+                        return unit;
+                    });
+                    if (result.isFailure()) {
+                        sql << "ROLLBACK TO SAVEPOINT write_queue_job";
+                        failures[i] = result.getFailure();
+                    }
+                    sql << "RELEASE SAVEPOINT write_queue_job";
+                }
+                tr.commit();
+                return unit;
+            });
+            _commitCount += 1;
+            _executedJobCount += jobs.size();
+            for (size_t i = 0; i < jobs.size(); i++) {
+                if (failures[i].nonEmpty()) {
+                    jobs[i].promise.failure(failures[i].getValue());
+                } else {
+                    jobs[i].promise.complete(committed);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ *
+ * DatabaseWriteQueue.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_DATABASEWRITEQUEUE_HPP
+#define LEDGER_CORE_DATABASEWRITEQUEUE_HPP
+
+#include <soci.h>
+#include <api/ExecutionContext.hpp>
+#include <async/Future.hpp>
+#include <async/Promise.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Group commit write queue. Jobs submitted within a short window (typically bulk inserts of
+         * different accounts) are executed on a serial writer context inside one shared transaction, so that
+         * concurrent writers don't fight over the database lock and only pay for one commit.
+         *
+         * Each job runs in its own savepoint: a failing job is rolled back and fails its future without
+         * affecting the others. Futures are completed once the shared transaction is committed. Jobs must
+         * not open their own transaction.
+         */
+        class DatabaseWriteQueue : public std::enable_shared_from_this<DatabaseWriteQueue> {
+        public:
+            using Job = std::function<void (soci::session&)>;
+
+            static const std::chrono::milliseconds DEFAULT_COMMIT_WINDOW;
+            static const size_t DEFAULT_MAX_JOBS_PER_COMMIT;
+
+            DatabaseWriteQueue(soci::connection_pool& pool,
+                               const std::shared_ptr<api::ExecutionContext>& writerContext,
+                               std::chrono::milliseconds commitWindow = DEFAULT_COMMIT_WINDOW,
+                               size_t maxJobsPerCommit = DEFAULT_MAX_JOBS_PER_COMMIT);
+            ~DatabaseWriteQueue();
+
+            Future<Unit> submit(const Job& job);
+
+            /**
+             * Commit the pending jobs on the calling thread. Jobs submitted afterwards fail.
+             */
+            void stop();
+
+            uint64_t getCommitCount() const;
+            uint64_t getExecutedJobCount() const;
+
+        private:
+            struct PendingJob {
+                Job job;
+                Promise<Unit> promise;
+            };
+
+            void scheduleDrain(bool delayed);
+            void drain();
+            std::vector<PendingJob> takeJobs();
+            void commit(std::vector<PendingJob>& jobs);
+
+            soci::connection_pool& _pool;
+            std::shared_ptr<api::ExecutionContext> _writerContext;
+            std::chrono::milliseconds _commitWindow;
+            size_t _maxJobsPerCommit;
+            std::mutex _lock;
+            // Held while committing so that stop() never commits concurrently with the writer context
+            std::mutex _commitLock;
+            std::deque<PendingJob> _jobs;
+            bool _stopped;
+            bool _drainScheduled;
+            std::thread::id _committingThread;
+            std::atomic<uint64_t> _commitCount;
+            std::atomic<uint64_t> _executedJobCount;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_DATABASEWRITEQUEUE_HPP
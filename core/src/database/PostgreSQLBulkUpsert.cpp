@@ -0,0 +1,230 @@
+/*
+ *
+ * PostgreSQLBulkUpsert.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "PostgreSQLBulkUpsert.hpp"
+#include <collections/strings.hpp>
+#include <utils/DateUtils.hpp>
+#include <utils/Exception.hpp>
+#include <fmt/format.h>
+#include <sstream>
+#ifdef PG_SUPPORT
+#include <soci-postgresql.h>
+#endif
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            const uint8_t COPY_SIGNATURE[] = {'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xFF, '\r', '\n', 0x00};
+            // Size of the slices handed to libpq while streaming a batch
+            const size_t COPY_CHUNK_SIZE = 1024 * 1024;
+
+            std::string columnType(PostgreSQLBulkUpsert::ColumnType type) {
+                return type == PostgreSQLBulkUpsert::ColumnType::BIGINT ? "BIGINT" : "TEXT";
+            }
+
+            std::string joined(const std::vector<std::string>& values, const std::string& separator) {
+                std::stringstream ss;
+                strings::join(values, ss, separator);
+                return ss.str();
+            }
+        }
+
+        BinaryCopyWriter::BinaryCopyWriter() : _rows(0), _finished(false) {
+            clear();
+        }
+
+        BinaryCopyWriter& BinaryCopyWriter::row(int16_t fieldCount) {
+            if (_finished) {
+                throw make_exception(api::ErrorCode::ILLEGAL_STATE, "Cannot add a row to a finished COPY stream.");
+            }
+            writeInt16(fieldCount);
+            _rows += 1;
+            return *this;
+        }
+
+        BinaryCopyWriter& BinaryCopyWriter::text(const std::string& value) {
+            writeInt32(static_cast<int32_t>(value.size()));
+            _buffer.insert(_buffer.end(), value.begin(), value.end());
+            return *this;
+        }
+
+        BinaryCopyWriter& BinaryCopyWriter::text(const Option<std::string>& value) {
+            return value.hasValue() ? text(value.getValue()) : null();
+        }
+
+        BinaryCopyWriter& BinaryCopyWriter::text(const std::chrono::system_clock::time_point& date) {
+            // Same representation as the soci date conversion
+            return text(DateUtils::toJSON(date));
+        }
+
+        BinaryCopyWriter& BinaryCopyWriter::bigint(int64_t value) {
+            writeInt32(sizeof(int64_t));
+            writeInt64(value);
+            return *this;
+        }
+
+        BinaryCopyWriter& BinaryCopyWriter::null() {
+            writeInt32(-1);
+            return *this;
+        }
+
+        const std::vector<uint8_t>& BinaryCopyWriter::finish() {
+            if (!_finished) {
+                writeInt16(-1);
+                _finished = true;
+            }
+            return _buffer;
+        }
+
+        size_t BinaryCopyWriter::getRowCount() const {
+            return _rows;
+        }
+
+        void BinaryCopyWriter::clear() {
+            _buffer.clear();
+            _buffer.insert(_buffer.end(), std::begin(COPY_SIGNATURE), std::end(COPY_SIGNATURE));
+            // Flags field and header extension length
+            writeInt32(0);
+            writeInt32(0);
+            _rows = 0;
+            _finished = false;
+        }
+
+        void BinaryCopyWriter::writeInt16(int16_t value) {
+            auto v = static_cast<uint16_t>(value);
+            _buffer.push_back(static_cast<uint8_t>(v >> 8));
+            _buffer.push_back(static_cast<uint8_t>(v));
+        }
+
+        void BinaryCopyWriter::writeInt32(int32_t value) {
+            auto v = static_cast<uint32_t>(value);
+            for (auto shift = 24; shift >= 0; shift -= 8) {
+                _buffer.push_back(static_cast<uint8_t>(v >> shift));
+            }
+        }
+
+        void BinaryCopyWriter::writeInt64(int64_t value) {
+            auto v = static_cast<uint64_t>(value);
+            for (auto shift = 56; shift >= 0; shift -= 8) {
+                _buffer.push_back(static_cast<uint8_t>(v >> shift));
+            }
+        }
+
+        PostgreSQLBulkUpsert::PostgreSQLBulkUpsert(const std::string& table,
+                                                   const std::vector<Column>& columns,
+                                                   const std::vector<std::string>& conflictKey,
+                                                   const std::vector<std::string>& updatedColumns)
+                : _table(table), _stagingTable(fmt::format("staging_{}", table)), _columns(columns), _sequence(0) {
+            std::vector<std::string> names, definitions, updates;
+            for (const auto& column : columns) {
+                names.push_back(column.name);
+                definitions.push_back(fmt::format("{} {}", column.name, columnType(column.type)));
+            }
+            for (const auto& column : updatedColumns) {
+                updates.push_back(fmt::format("{0} = EXCLUDED.{0}", column));
+            }
+            auto columnList = joined(names, ", ");
+            _createStaging = fmt::format("CREATE TEMP TABLE IF NOT EXISTS {} (seq BIGINT, {})",
+                                         _stagingTable, joined(definitions, ", "));
+            _copy = fmt::format("COPY {} (seq, {}) FROM STDIN (FORMAT binary)", _stagingTable, columnList);
+            if (updates.empty()) {
+                _merge = fmt::format("INSERT INTO {0} ({1}) SELECT {1} FROM {2} ORDER BY seq ON CONFLICT DO NOTHING",
+                                     _table, columnList, _stagingTable);
+            } else {
+                if (conflictKey.empty()) {
+                    throw make_exception(api::ErrorCode::ILLEGAL_ARGUMENT, "Updating {} on conflict requires a conflict key.", table);
+                }
+                // A single INSERT can't update the same row twice, keep the last staged row of each key
+                auto key = joined(conflictKey, ", ");
+                _merge = fmt::format("INSERT INTO {0} ({1}) SELECT {1} FROM ("
+                                     "SELECT DISTINCT ON ({2}) * FROM {3} ORDER BY {2}, seq DESC"
+                                     ") AS staged ON CONFLICT({2}) DO UPDATE SET {4}",
+                                     _table, columnList, key, _stagingTable, joined(updates, ", "));
+            }
+        }
+
+        BinaryCopyWriter& PostgreSQLBulkUpsert::row() {
+            return _writer.row(static_cast<int16_t>(_columns.size() + 1)).bigint(_sequence++);
+        }
+
+        size_t PostgreSQLBulkUpsert::size() const {
+            return _writer.getRowCount();
+        }
+
+        const std::string& PostgreSQLBulkUpsert::getMergeQuery() const {
+            return _merge;
+        }
+
+        void PostgreSQLBulkUpsert::execute(soci::session& sql) {
+            if (size() == 0) {
+                return;
+            }
+#ifdef PG_SUPPORT
+            auto backend = dynamic_cast<soci::postgresql_session_backend*>(sql.get_backend());
+            if (backend == nullptr) {
+                throw make_exception(api::ErrorCode::ILLEGAL_STATE, "COPY into {} requires a PostgreSQL session.", _table);
+            }
+            // Temporary tables live as long as the connection, only their content is reset per batch
+            sql << _createStaging;
+            sql << fmt::format("TRUNCATE {}", _stagingTable);
+
+            auto conn = backend->conn_;
+            auto result = PQexec(conn, _copy.c_str());
+            auto status = PQresultStatus(result);
+            PQclear(result);
+            if (status != PGRES_COPY_IN) {
+                throw make_exception(api::ErrorCode::DATABASE_EXCEPTION, "Failed to start COPY into {}: {}", _stagingTable, PQerrorMessage(conn));
+            }
+            const auto& data = _writer.finish();
+            auto sent = true;
+            for (size_t offset = 0; sent && offset < data.size(); offset += COPY_CHUNK_SIZE) {
+                auto length = std::min(COPY_CHUNK_SIZE, data.size() - offset);
+                sent = PQputCopyData(conn, reinterpret_cast<const char*>(data.data() + offset), static_cast<int>(length)) == 1;
+            }
+            auto ended = PQputCopyEnd(conn, sent ? nullptr : "Failed to stream COPY data") == 1;
+            auto succeeded = sent && ended;
+            while ((result = PQgetResult(conn)) != nullptr) {
+                succeeded = succeeded && PQresultStatus(result) == PGRES_COMMAND_OK;
+                PQclear(result);
+            }
+            if (!succeeded) {
+                throw make_exception(api::ErrorCode::DATABASE_EXCEPTION, "COPY into {} failed: {}", _stagingTable, PQerrorMessage(conn));
+            }
+            sql << _merge;
+            _writer.clear();
+            _sequence = 0;
+#else
+            throw make_exception(api::ErrorCode::IMPLEMENTATION_IS_MISSING, "Libcore should be compiled with PG_SUPPORT flag.");
+#endif
+        }
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ *
+ * PostgreSQLBulkUpsert.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_POSTGRESQLBULKUPSERT_HPP
+#define LEDGER_CORE_POSTGRESQLBULKUPSERT_HPP
+
+#include <soci.h>
+#include <utils/Option.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Encodes tuples in the PostgreSQL binary COPY format (signature, header, tuples and trailer).
+         * Integers are written in network byte order, texts as raw bytes.
+         */
+        class BinaryCopyWriter {
+        public:
+            BinaryCopyWriter();
+
+            BinaryCopyWriter& row(int16_t fieldCount);
+            BinaryCopyWriter& text(const std::string& value);
+            BinaryCopyWriter& text(const Option<std::string>& value);
+            BinaryCopyWriter& text(const std::chrono::system_clock::time_point& date);
+            BinaryCopyWriter& bigint(int64_t value);
+            BinaryCopyWriter& null();
+
+            template <typename T>
+            BinaryCopyWriter& bigint(const Option<T>& value) {
+                return value.hasValue() ? bigint(static_cast<int64_t>(value.getValue())) : null();
+            }
+
+            /**
+             * Append the trailer and return the encoded stream. No row can be added afterwards.
+             */
+            const std::vector<uint8_t>& finish();
+            size_t getRowCount() const;
+            void clear();
+
+        private:
+            void writeInt16(int16_t value);
+            void writeInt32(int32_t value);
+            void writeInt64(int64_t value);
+
+            std::vector<uint8_t> _buffer;
+            size_t _rows;
+            bool _finished;
+        };
+
+        /**
+         * Bulk upsert for PostgreSQL. Rows are streamed into a per connection temporary staging table
+         * with COPY FROM STDIN and merged into the target table with a single INSERT ... SELECT ... ON CONFLICT.
+         * When the conflict updates columns, only the last staged row of a key is merged (as sequential upserts
+         * would leave it); otherwise rows are merged in staging order and the first one wins.
+         */
+        class PostgreSQLBulkUpsert {
+        public:
+            enum class ColumnType {
+                TEXT,
+                BIGINT
+            };
+
+            struct Column {
+                std::string name;
+                ColumnType type;
+            };
+
+            PostgreSQLBulkUpsert(const std::string& table,
+                                 const std::vector<Column>& columns,
+                                 const std::vector<std::string>& conflictKey = {},
+                                 const std::vector<std::string>& updatedColumns = {});
+
+            /**
+             * Start a new staged row. Fields must then be written in column order.
+             */
+            BinaryCopyWriter& row();
+            size_t size() const;
+
+            /**
+             * Stage and merge the pending rows. Should be executed inside the caller transaction.
+             */
+            void execute(soci::session& sql);
+
+            const std::string& getMergeQuery() const;
+
+        private:
+            std::string _table;
+            std::string _stagingTable;
+            std::vector<Column> _columns;
+            std::string _createStaging;
+            std::string _copy;
+            std::string _merge;
+            BinaryCopyWriter _writer;
+            int64_t _sequence;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_POSTGRESQLBULKUPSERT_HPP
@@ -42,11 +42,12 @@ namespace ledger {
         class PreparedStatement {
         public:
             PreparedStatement() {};
-            void execute() {
+            // Returns true when a row was fetched into the into() bindings
+            bool execute() {
                 if (statement.isEmpty()) {
                     throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Cannot execute not prepared statement");
                 }
-                statement.getValue().execute(true);
+                return statement.getValue().execute(true);
             }
             Bindings bindings;
             Option<soci::statement> statement;
@@ -68,6 +69,10 @@ namespace ledger {
                 out.statement = (prepare);
             }
 
+            const std::string& getQuery() const {
+                return _query;
+            }
+
         private:
             std::string _query;
             BindFunction _binder;
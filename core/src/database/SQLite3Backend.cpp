@@ -35,15 +35,28 @@ using namespace soci;
 
 namespace ledger {
     namespace core {
-        SQLite3Backend::SQLite3Backend() : DatabaseBackend() {
+        // Negative values are expressed in KiB
+        static const int32_t WAL_CACHE_SIZE = -16384;
+        static const int64_t WAL_MMAP_SIZE = 256 * 1024 * 1024;
+
+        SQLite3Backend::SQLite3Backend() : SQLite3Backend(false, 1) {
+        }
+
+        SQLite3Backend::SQLite3Backend(bool walMode, int32_t readonlyConnectionPoolSize) : DatabaseBackend(),
+            _walMode(walMode), _readonlyConnectionPoolSize(walMode ? readonlyConnectionPoolSize : 1) {
         }
 
         int32_t SQLite3Backend::getConnectionPoolSize() {
+            // SQLite only ever allows a single writer
             return 1;
         }
 
         int32_t SQLite3Backend::getReadonlyConnectionPoolSize() {
-            return 1;
+            return _readonlyConnectionPoolSize;
+        }
+
+        bool SQLite3Backend::isWalModeEnabled() const {
+            return _walMode;
         }
 
         void SQLite3Backend::init(const std::shared_ptr<ledger::core::api::PathResolver> &resolver,
@@ -52,7 +65,39 @@ namespace ledger {
                                   soci::session &session) {
             _dbResolvedPath = resolver->resolveDatabasePath(dbName);
             setPassword(password, session);
+            if (_walMode) {
+                // Journal mode is persisted in the database file, readonly connections pick it up when opening
+                std::string journalMode;
+                session << "PRAGMA journal_mode = WAL", soci::into(journalMode);
+                if (journalMode != "wal") {
+                    throw make_exception(api::ErrorCode::DATABASE_EXCEPTION, "Unable to switch database to WAL mode (journal mode is '{}').", journalMode);
+                }
+            }
+            setupConnection(session, false);
+        }
+
+        void SQLite3Backend::initReadonly(const std::shared_ptr<api::PathResolver> &resolver,
+                                          const std::string &dbName,
+                                          const std::string &password,
+                                          soci::session &session) {
+            _dbResolvedPath = resolver->resolveDatabasePath(dbName);
+            setPassword(password, session);
+            setupConnection(session, true);
+        }
+
+        void SQLite3Backend::setupConnection(soci::session &session, bool readonly) {
             session << "PRAGMA foreign_keys = ON";
+            if (!_walMode) {
+                return;
+            }
+            // In WAL mode a NORMAL sync is durable against application crashes and only risks losing the last
+            // transactions on power loss, the database itself never gets corrupted.
+            session << "PRAGMA synchronous = NORMAL";
+            session << "PRAGMA cache_size = " << WAL_CACHE_SIZE;
+            session << "PRAGMA mmap_size = " << WAL_MMAP_SIZE;
+            if (readonly) {
+                session << "PRAGMA query_only = ON";
+            }
         }
 
         void SQLite3Backend::setPassword(const std::string &password,
@@ -89,6 +134,7 @@ namespace ledger {
             db_params = fmt::format("dbname=\"{}\" ", _dbResolvedPath) + fmt::format("key=\"{}\" ", newPassword);
             session.close();
             session.open(*soci::factory_sqlite3(), db_params);
+            setupConnection(session, false);
         }
     }
 }
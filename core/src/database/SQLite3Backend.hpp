@@ -40,6 +40,12 @@ namespace ledger {
      class SQLite3Backend : public DatabaseBackend {
      public:
          SQLite3Backend();
+         /**
+          * @param walMode Journal in WAL mode so that readers run concurrently with the writer
+          * @param readonlyConnectionPoolSize Number of readonly connections, only relevant in WAL mode since
+          * rollback journaling serializes readers and the writer anyway
+          */
+         SQLite3Backend(bool walMode, int32_t readonlyConnectionPoolSize);
          int32_t getConnectionPoolSize() override;
          int32_t getReadonlyConnectionPoolSize() override;
 
@@ -48,6 +54,13 @@ namespace ledger {
                    const std::string &password,
                    soci::session &session) override;
 
+         void initReadonly(const std::shared_ptr<api::PathResolver> &resolver,
+                           const std::string &dbName,
+                           const std::string &password,
+                           soci::session &session) override;
+
+         bool isWalModeEnabled() const;
+
          void setPassword(const std::string &password,
                           soci::session &session) override;
 
@@ -56,8 +69,13 @@ namespace ledger {
                              soci::session &session) override;
 
      private:
+         // Per-connection pragmas, they have to be applied again each time the session is reopened
+         void setupConnection(soci::session &session, bool readonly);
+
          // Resolved path to db
          std::string _dbResolvedPath;
+         bool _walMode;
+         int32_t _readonlyConnectionPoolSize;
      };
  }
 }
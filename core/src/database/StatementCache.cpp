@@ -0,0 +1,117 @@
+/*
+ *
+ * StatementCache.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "StatementCache.hpp"
+#include <mutex>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            // Pooled connections are identified by their backend, which is shared by every session leasing them
+            std::mutex registryLock;
+            std::unordered_map<soci::details::session_backend*, std::shared_ptr<StatementCache>> registry;
+        }
+
+        StatementCache::StatementCache(std::size_t capacity)
+            : _capacity(capacity), _pooledSession(nullptr), _hits(0), _misses(0) {
+        }
+
+        std::shared_ptr<void> StatementCache::find(const std::string &key) {
+            auto it = _index.find(key);
+            if (it == _index.end()) {
+                _misses += 1;
+                return nullptr;
+            }
+            _hits += 1;
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return it->second->second;
+        }
+
+        void StatementCache::insert(const std::string &key, const std::shared_ptr<void> &statement) {
+            if (_capacity == 0) {
+                return;
+            }
+            _entries.emplace_front(key, statement);
+            _index[key] = _entries.begin();
+            if (_entries.size() > _capacity) {
+                _index.erase(_entries.back().first);
+                _entries.pop_back();
+            }
+        }
+
+        void StatementCache::clear() {
+            _index.clear();
+            _entries.clear();
+        }
+
+        std::size_t StatementCache::size() const {
+            return _entries.size();
+        }
+
+        std::size_t StatementCache::getHits() const {
+            return _hits;
+        }
+
+        std::size_t StatementCache::getMisses() const {
+            return _misses;
+        }
+
+        void StatementCache::attach(soci::session &pooledSession, const std::shared_ptr<StatementCache> &cache) {
+            std::lock_guard<std::mutex> lock(registryLock);
+            cache->_pooledSession = &pooledSession;
+            registry[pooledSession.get_backend()] = cache;
+        }
+
+        void StatementCache::detach(soci::session &pooledSession) {
+            std::shared_ptr<StatementCache> cache;
+            {
+                std::lock_guard<std::mutex> lock(registryLock);
+                auto it = registry.find(pooledSession.get_backend());
+                if (it == registry.end()) {
+                    return;
+                }
+                cache = it->second;
+                registry.erase(it);
+            }
+            // Finalize the statements while the connection is still open
+            cache->clear();
+            cache->_pooledSession = nullptr;
+        }
+
+        std::shared_ptr<StatementCache> StatementCache::of(soci::session &sql) {
+            std::lock_guard<std::mutex> lock(registryLock);
+            auto it = registry.find(sql.get_backend());
+            return it == registry.end() ? nullptr : it->second;
+        }
+
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ *
+ * StatementCache.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_STATEMENTCACHE_HPP
+#define LEDGER_CORE_STATEMENTCACHE_HPP
+
+#include <soci.h>
+#include <database/PreparedStatement.hpp>
+#include <list>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * LRU cache of prepared statements for a single database connection, keyed by SQL text. Caches are attached
+         * to the pooled connections by DatabaseSessionPool and looked up from any session leasing them, so a
+         * statement is parsed and planned once per connection instead of once per call.
+         *
+         * Statements are prepared against the pooled session owning the connection, never against the leasing
+         * session: they outlive the lease and soci keeps a reference to the session a statement was prepared with.
+         *
+         * A cached statement keeps its bindings between calls: callers must set every binding (and clear bulk
+         * ones) before executing, and must not use it after the session is given back to the pool.
+         */
+        class StatementCache {
+        public:
+            static const std::size_t DEFAULT_CAPACITY = 64;
+
+            explicit StatementCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+            template <class Bindings>
+            std::shared_ptr<PreparedStatement<Bindings>> get(soci::session& sql,
+                                                             const StatementDeclaration<Bindings>& declaration) {
+                auto key = declaration.getQuery();
+                key.push_back('\0');
+                key.append(typeid(Bindings).name());
+                auto cached = find(key);
+                if (cached) {
+                    return std::static_pointer_cast<PreparedStatement<Bindings>>(cached);
+                }
+                auto statement = std::make_shared<PreparedStatement<Bindings>>();
+                declaration(_pooledSession != nullptr ? *_pooledSession : sql, *statement);
+                insert(key, statement);
+                return statement;
+            }
+
+            void clear();
+            std::size_t size() const;
+            std::size_t getHits() const;
+            std::size_t getMisses() const;
+
+            // Connection registry, maintained by DatabaseSessionPool
+            static void attach(soci::session& pooledSession, const std::shared_ptr<StatementCache>& cache);
+            static void detach(soci::session& pooledSession);
+            static std::shared_ptr<StatementCache> of(soci::session& sql);
+
+        private:
+            using Entry = std::pair<std::string, std::shared_ptr<void>>;
+
+            std::shared_ptr<void> find(const std::string& key);
+            void insert(const std::string& key, const std::shared_ptr<void>& statement);
+
+            std::size_t _capacity;
+            // Session owning the connection, set by attach
+            soci::session* _pooledSession;
+            std::list<Entry> _entries;
+            std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+            std::size_t _hits;
+            std::size_t _misses;
+        };
+
+        namespace db {
+            /**
+             * Get the declared statement from the cache of the connection leased by the session, or prepare a one
+             * shot statement when the connection has no cache.
+             */
+            template<class Bindings>
+            std::shared_ptr<PreparedStatement<Bindings>> cached(soci::session& sql,
+                                                                const StatementDeclaration<Bindings>& declaration) {
+                auto cache = StatementCache::of(sql);
+                if (cache) {
+                    return cache->get(sql, declaration);
+                }
+                auto statement = std::make_shared<PreparedStatement<Bindings>>();
+                declaration(sql, *statement);
+                return statement;
+            }
+        }
+    }
+}
+
+#endif //LEDGER_CORE_STATEMENTCACHE_HPP
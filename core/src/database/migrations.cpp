@@ -32,6 +32,9 @@
 #include "migrations.hpp"
 #include <api/BitcoinLikeNetworkParameters.hpp>
 #include <wallet/bitcoin/networks.hpp>
+#include <wallet/common/database/AmountLimbs.hpp>
+#include <database/soci-option.h>
+#include <math/BigInt.h>
 
 namespace ledger {
     namespace core {
@@ -1146,5 +1149,196 @@ namespace ledger {
          
             }
         }
+
+        template <> void migrate<26>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "CREATE TABLE keychain_addresses("
+                   "account_uid VARCHAR(255) NOT NULL REFERENCES accounts(uid) ON DELETE CASCADE ON UPDATE CASCADE,"
+                   "purpose INTEGER NOT NULL,"
+                   "idx INTEGER NOT NULL,"
+                   "address VARCHAR(255) NOT NULL,"
+                   "pubkey VARCHAR(255),"
+                   "PRIMARY KEY (account_uid, purpose, idx)"
+                   ")";
+            sql << "CREATE UNIQUE INDEX keychain_addresses_by_address ON keychain_addresses (account_uid, address)";
+        }
+
+        template <> void rollback<26>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP TABLE keychain_addresses";
+        }
+
+        template <> void migrate<27>(soci::session& sql, api::DatabaseBackendType type) {
+            // Common tables
+            sql << "CREATE INDEX operations_by_account_date ON operations (account_uid, date)";
+            sql << "CREATE INDEX operations_by_block ON operations (block_uid)";
+            sql << "CREATE INDEX blocks_by_currency_height ON blocks (currency_name, height)";
+
+            // Bitcoin
+            sql << "CREATE INDEX bitcoin_inputs_by_previous_output ON bitcoin_inputs (previous_tx_uid, previous_output_idx)";
+            sql << "CREATE INDEX bitcoin_outputs_by_account ON bitcoin_outputs (account_uid)";
+            sql << "CREATE INDEX bitcoin_transactions_by_block ON bitcoin_transactions (block_uid)";
+            sql << "CREATE INDEX bitcoin_operations_by_transaction ON bitcoin_operations (transaction_uid)";
+
+            // Ethereum
+            sql << "CREATE INDEX ethereum_operations_by_transaction ON ethereum_operations (transaction_uid)";
+            sql << "CREATE INDEX erc20_operations_by_ethereum_operation ON erc20_operations (ethereum_operation_uid)";
+            sql << "CREATE INDEX erc20_operations_by_account ON erc20_operations (account_uid)";
+            sql << "CREATE INDEX internal_operations_by_ethereum_operation ON internal_operations (ethereum_operation_uid)";
+
+            // Ripple
+            sql << "CREATE INDEX ripple_operations_by_transaction ON ripple_operations (transaction_uid)";
+
+            // Tezos
+            sql << "CREATE INDEX tezos_operations_by_transaction ON tezos_operations (transaction_uid)";
+            sql << "CREATE INDEX tezos_originated_operations_by_transaction ON tezos_originated_operations (transaction_uid)";
+            sql << "CREATE INDEX tezos_originated_operations_by_account ON tezos_originated_operations (originated_account_uid)";
+
+            // Stellar
+            sql << "CREATE INDEX stellar_account_operations_by_operation ON stellar_account_operations (operation_uid)";
+
+            // Cosmos
+            sql << "CREATE INDEX cosmos_operations_by_message ON cosmos_operations (message_uid)";
+
+            // Algorand
+            sql << "CREATE INDEX algorand_operations_by_transaction ON algorand_operations (transaction_uid)";
+        }
+
+        template <> void rollback<27>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP INDEX algorand_operations_by_transaction";
+            sql << "DROP INDEX cosmos_operations_by_message";
+            sql << "DROP INDEX stellar_account_operations_by_operation";
+            sql << "DROP INDEX tezos_originated_operations_by_account";
+            sql << "DROP INDEX tezos_originated_operations_by_transaction";
+            sql << "DROP INDEX tezos_operations_by_transaction";
+            sql << "DROP INDEX ripple_operations_by_transaction";
+            sql << "DROP INDEX internal_operations_by_ethereum_operation";
+            sql << "DROP INDEX erc20_operations_by_account";
+            sql << "DROP INDEX erc20_operations_by_ethereum_operation";
+            sql << "DROP INDEX ethereum_operations_by_transaction";
+            sql << "DROP INDEX bitcoin_operations_by_transaction";
+            sql << "DROP INDEX bitcoin_transactions_by_block";
+            sql << "DROP INDEX bitcoin_outputs_by_account";
+            sql << "DROP INDEX bitcoin_inputs_by_previous_output";
+            sql << "DROP INDEX blocks_by_currency_height";
+            sql << "DROP INDEX operations_by_block";
+            sql << "DROP INDEX operations_by_account_date";
+        }
+
+        template <> void migrate<28>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "ALTER TABLE operations ADD COLUMN amount_high BIGINT";
+            sql << "ALTER TABLE operations ADD COLUMN amount_low BIGINT";
+            sql << "ALTER TABLE operations ADD COLUMN fees_high BIGINT";
+            sql << "ALTER TABLE operations ADD COLUMN fees_low BIGINT";
+
+            // Backfill by chunks of operations ordered by uid, so that memory stays bounded on large databases
+            const int32_t chunkSize = 1000;
+            std::string lastUid;
+            while (true) {
+                std::vector<std::string> uids;
+                std::vector<Option<int64_t>> amountHigh, amountLow, feesHigh, feesLow;
+                {
+                    soci::rowset<soci::row> rows = (sql.prepare << "SELECT uid, amount, fees FROM operations"
+                                                                   " WHERE uid > :last_uid ORDER BY uid LIMIT :limit",
+                                                    soci::use(lastUid), soci::use(chunkSize));
+                    for (auto& row : rows) {
+                        auto amount = AmountLimbs::fromBigInt(BigInt::fromHex(row.get<std::string>(1)));
+                        auto fees = AmountLimbs::fromBigInt(BigInt::fromHex(row.get<std::string>(2)));
+                        uids.push_back(row.get<std::string>(0));
+                        amountHigh.push_back(amount.high);
+                        amountLow.push_back(amount.low);
+                        feesHigh.push_back(fees.high);
+                        feesLow.push_back(fees.low);
+                    }
+                }
+                if (uids.empty()) {
+                    break;
+                }
+                lastUid = uids.back();
+                sql << "UPDATE operations SET amount_high = :amount_high, amount_low = :amount_low,"
+                       " fees_high = :fees_high, fees_low = :fees_low WHERE uid = :uid",
+                       soci::use(amountHigh), soci::use(amountLow), soci::use(feesHigh), soci::use(feesLow), soci::use(uids);
+                if (uids.size() < chunkSize) {
+                    break;
+                }
+            }
+            sql << "CREATE INDEX operations_by_account_amount ON operations (account_uid, amount_high, amount_low)";
+        }
+
+        template <> void rollback<28>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP INDEX operations_by_account_amount";
+            // SQLite doesn't handle ALTER TABLE DROP
+            if (type != api::DatabaseBackendType::SQLITE3) {
+                sql << "ALTER TABLE operations DROP amount_high";
+                sql << "ALTER TABLE operations DROP amount_low";
+                sql << "ALTER TABLE operations DROP fees_high";
+                sql << "ALTER TABLE operations DROP fees_low";
+            }
+        }
+
+        template <> void migrate<29>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "CREATE TABLE bitcoin_utxos("
+                   "account_uid VARCHAR(255) NOT NULL REFERENCES accounts(uid) ON DELETE CASCADE,"
+                   "transaction_uid VARCHAR(255) NOT NULL,"
+                   "idx INTEGER NOT NULL,"
+                   "PRIMARY KEY (transaction_uid, idx),"
+                   "FOREIGN KEY (idx, transaction_uid) REFERENCES bitcoin_outputs(idx, transaction_uid) ON DELETE CASCADE"
+                   ")";
+            sql << "CREATE INDEX bitcoin_utxos_by_account ON bitcoin_utxos (account_uid)";
+            sql << "INSERT INTO bitcoin_utxos"
+                   " SELECT o.account_uid, o.transaction_uid, o.idx FROM bitcoin_outputs AS o"
+                   " JOIN accounts AS a ON a.uid = o.account_uid"
+                   " LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid"
+                   " AND i.previous_output_idx = o.idx"
+                   " WHERE i.previous_tx_uid IS NULL";
+        }
+
+        template <> void rollback<29>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP TABLE bitcoin_utxos";
+        }
+
+        template <> void migrate<30>(soci::session& sql, api::DatabaseBackendType type) {
+            // Operation uids break date ties for keyset pagination
+            sql << "DROP INDEX operations_by_account_date";
+            sql << "CREATE INDEX operations_by_account_date ON operations (account_uid, date, uid)";
+        }
+
+        template <> void rollback<30>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP INDEX operations_by_account_date";
+            sql << "CREATE INDEX operations_by_account_date ON operations (account_uid, date)";
+        }
+
+        template <> void migrate<31>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "CREATE TABLE balance_checkpoints("
+                   "account_uid VARCHAR(255) NOT NULL REFERENCES accounts(uid) ON DELETE CASCADE,"
+                   "day VARCHAR(255) NOT NULL,"
+                   "balance_high BIGINT,"
+                   "balance_low BIGINT,"
+                   "PRIMARY KEY (account_uid, day)"
+                   ")";
+            // Backfill the currencies reading checkpoints: the balance at the end of each UTC day with confirmed
+            // operations is the running sum of the daily changes, NULL once an amount doesn't fit the limbs
+            sql << "INSERT INTO balance_checkpoints"
+                   " SELECT account_uid, day,"
+                   " CASE WHEN SUM(wide) OVER (PARTITION BY account_uid ORDER BY day) > 0 THEN NULL"
+                   " ELSE SUM(change_high) OVER (PARTITION BY account_uid ORDER BY day) END,"
+                   " CASE WHEN SUM(wide) OVER (PARTITION BY account_uid ORDER BY day) > 0 THEN NULL"
+                   " ELSE SUM(change_low) OVER (PARTITION BY account_uid ORDER BY day) END"
+                   " FROM ("
+                   "SELECT op.account_uid AS account_uid, SUBSTR(op.date, 1, 10) || 'T00:00:00Z' AS day,"
+                   " SUM(CASE WHEN op.type = 'RECEIVE' THEN op.amount_high"
+                   " WHEN op.type = 'SEND' THEN -op.amount_high - COALESCE(op.fees_high, 0) ELSE 0 END) AS change_high,"
+                   " SUM(CASE WHEN op.type = 'RECEIVE' THEN op.amount_low"
+                   " WHEN op.type = 'SEND' THEN -op.amount_low - COALESCE(op.fees_low, 0) ELSE 0 END) AS change_low,"
+                   " SUM(CASE WHEN op.type IN ('RECEIVE', 'SEND') AND (op.amount_high IS NULL OR"
+                   " (op.type = 'SEND' AND op.fees IS NOT NULL AND op.fees_high IS NULL)) THEN 1 ELSE 0 END) AS wide"
+                   " FROM operations AS op"
+                   " JOIN currencies AS c ON c.name = op.currency_name"
+                   " WHERE op.block_uid IS NOT NULL AND c.type IN ('BITCOIN', 'RIPPLE', 'STELLAR', 'COSMOS')"
+                   " GROUP BY op.account_uid, SUBSTR(op.date, 1, 10)"
+                   ") AS days";
+        }
+
+        template <> void rollback<31>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP TABLE balance_checkpoints";
+        }
     }
 }
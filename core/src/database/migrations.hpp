@@ -202,6 +202,30 @@ namespace ledger {
         // Add bitcoin dust policy
         template <> void migrate<25>(soci::session& sql, api::DatabaseBackendType type);
         template <> void rollback<25>(soci::session& sql, api::DatabaseBackendType type);
+
+        // Keychain addresses
+        template <> void migrate<26>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<26>(soci::session& sql, api::DatabaseBackendType type);
+
+        // Secondary indexes for account, block and per coin operation lookups
+        template <> void migrate<27>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<27>(soci::session& sql, api::DatabaseBackendType type);
+
+        // Numeric amount and fees columns on operations
+        template <> void migrate<28>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<28>(soci::session& sql, api::DatabaseBackendType type);
+
+        // Bitcoin UTXO set
+        template <> void migrate<29>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<29>(soci::session& sql, api::DatabaseBackendType type);
+
+        // Operation keyset index
+        template <> void migrate<30>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<30>(soci::session& sql, api::DatabaseBackendType type);
+
+        // Daily balance checkpoints
+        template <> void migrate<31>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<31>(soci::session& sql, api::DatabaseBackendType type);
     }
 }
 
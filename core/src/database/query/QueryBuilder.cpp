@@ -30,6 +30,7 @@
  */
 #include "QueryBuilder.h"
 #include <fmt/format.h>
+#include <utils/Exception.hpp>
 
 namespace ledger {
     namespace core {
@@ -45,22 +46,63 @@ namespace ledger {
                 }
             }
 
-            if (_filter) {
+            auto descending = false;
+            if (_seek.nonEmpty()) {
+                auto& seek = _seek.getValue();
+                for (auto& order : _order) {
+                    if (std::get<0>(order) != seek.dateKey || std::get<2>(order) != seek.table) {
+                        throw make_exception(api::ErrorCode::ILLEGAL_STATE,
+                                             "Keyset pagination requires the query to be ordered by {} only", seek.dateKey);
+                    }
+                    descending = std::get<1>(order);
+                }
+            }
+
+            if (_filter || _seek.nonEmpty()) {
                 query << " WHERE ";
+            }
+            if (_filter) {
                 std::string sFilter = _filter->getHead()->toString();
-                query << sFilter;
+                if (_seek.nonEmpty()) {
+                    query << "(" << sFilter << ") AND ";
+                } else {
+                    query << sFilter;
+                }
+            }
+            if (_seek.nonEmpty()) {
+                // The first condition bounds the scan on the date index, the second one skips the rows of the
+                // boundary date already returned
+                auto& seek = _seek.getValue();
+                auto date = fmt::format("{}.{}", seek.table, seek.dateKey);
+                auto uid = fmt::format("{}.{}", seek.table, seek.uidKey);
+                auto symbol = descending ? "<" : ">";
+                query << fmt::format("{0} {2}= :seek_date AND ({0} {2} :seek_boundary OR {1} {2} :seek_uid)",
+                                     date, uid, symbol);
             }
 
-            if (!_order.empty()) {
+            if (!_order.empty() || _seek.nonEmpty()) {
                 query << " ORDER BY ";
                 for (auto it = _order.begin(); it != _order.end(); it++) {
                     auto& order = *it;
-                    query << std::get<2>(order) << "." << std::get<0>(order) << (std::get<1>(order) ? " DESC" : " ASC");
+                    if (!std::get<2>(order).empty()) {
+                        query << std::get<2>(order) << ".";
+                    }
+                    query << std::get<0>(order) << (std::get<1>(order) ? " DESC" : " ASC");
 
                     if (std::distance(it, _order.end()) > 1) {
                         query << ",";
                     }
                 }
+                if (_seek.nonEmpty()) {
+                    auto& seek = _seek.getValue();
+                    auto direction = descending ? " DESC" : " ASC";
+                    if (_order.empty()) {
+                        query << seek.table << "." << seek.dateKey << direction << ",";
+                    } else {
+                        query << ",";
+                    }
+                    query << seek.table << "." << seek.uidKey << direction;
+                }
             }
 
             if (_limit.nonEmpty()) {
@@ -75,6 +117,10 @@ namespace ledger {
             if (_filter) {
                 _filter->getHead()->bindValue(statement);
             }
+            if (_seek.nonEmpty()) {
+                auto& seek = _seek.getValue();
+                statement, soci::use(seek.date), soci::use(seek.date), soci::use(seek.uid);
+            }
             return statement;
         }
 
@@ -128,6 +174,12 @@ namespace ledger {
             return *this;
         }
 
+        QueryBuilder &QueryBuilder::seek(std::string &&dateKey, std::string &&uidKey, std::string &&table,
+                                         const std::string &date, const std::string &uid) {
+            _seek = Seek {dateKey, uidKey, table, date, uid};
+            return *this;
+        }
+
         QueryBuilder& QueryBuilder::outerJoin(const std::string &table, const std::string &condition) {
             _outerJoins.emplace_back(Option<LeftOuterJoin>(std::make_tuple(table, condition)));
             return *this;
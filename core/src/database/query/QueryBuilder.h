@@ -52,14 +52,32 @@ namespace ledger {
             QueryBuilder& to(std::string&& output);
             QueryBuilder& where(const std::shared_ptr<api::QueryFilter>& filter);
             QueryBuilder& outerJoin(const std::string& table, const std::string& condition);
+            /**
+             * Order by a column of the given table, or by a SQL expression when the table is empty.
+             */
             QueryBuilder& order(std::string&& keys, bool&& descending, std::string&& table);
             QueryBuilder& limit(int32_t limit);
             QueryBuilder& offset(int32_t offset);
+            /**
+             * Keyset pagination: only keep rows located strictly after the (date, uid) key in the query order. The
+             * query must be ordered by the date key only (ascending when no order is given), the uid key is
+             * appended to the order to break ties.
+             */
+            QueryBuilder& seek(std::string&& dateKey, std::string&& uidKey, std::string&& table,
+                               const std::string& date, const std::string& uid);
             soci::details::prepare_temp_type execute(soci::session& sql);
 
         private:
             using LeftOuterJoin = std::tuple<std::string, std::string>;
 
+            struct Seek {
+                std::string dateKey;
+                std::string uidKey;
+                std::string table;
+                std::string date;
+                std::string uid;
+            };
+
             std::string _keys;
             std::string _table;
             std::string _output;
@@ -68,6 +86,7 @@ namespace ledger {
             std::shared_ptr<QueryFilter> _filter;
             Option<int32_t> _limit;
             Option<int32_t> _offset;
+            Option<Seek> _seek;
         };
     }
 }
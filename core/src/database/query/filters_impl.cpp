@@ -34,10 +34,24 @@
 #include <cereal/external/base64.hpp>
 #include <api/TrustLevel.hpp>
 #include <api/OperationType.hpp>
+#include <wallet/common/Amount.h>
+#include <wallet/common/database/AmountLimbs.hpp>
 
 namespace ledger {
     namespace core {
 
+        // Amounts are stored as hexadecimal strings, canonical enough for (in)equality, and as numeric limbs for
+        // range comparisons.
+        static std::shared_ptr<api::QueryFilter> amountCondition(const std::string &column,
+                                                                 const std::string &symbol,
+                                                                 const std::shared_ptr<api::Amount> &amount) {
+            auto value = std::static_pointer_cast<ledger::core::Amount>(amount)->value();
+            if (symbol == "=" || symbol == "<>") {
+                return std::make_shared<ConditionQueryFilter<std::string>>(column, symbol, value->toHexString(), "o");
+            }
+            return std::make_shared<PlainTextConditionQueryFilter>(AmountLimbs::compare(fmt::format("o.{}", column), symbol, *value));
+        }
+
         std::shared_ptr<api::QueryFilter> api::QueryFilter::accountEq(const std::string &accountUid) {
             return std::make_shared<ConditionQueryFilter<std::string>>("account_uid", "=", accountUid, "o");
         }
@@ -103,51 +117,51 @@ namespace ledger {
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesEq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "=", amount->toLong(), "o");
+            return amountCondition("fees", "=", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesNeq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<>", amount->toLong(), "o");
+            return amountCondition("fees", "<>", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesGt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", ">", amount->toLong(), "o");
+            return amountCondition("fees", ">", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesLt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<", amount->toLong(), "o");
+            return amountCondition("fees", "<", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesGte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", ">=", amount->toLong(), "o");
+            return amountCondition("fees", ">=", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesLte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<=", amount->toLong(), "o");
+            return amountCondition("fees", "<=", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountEq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "=", amount->toLong(), "o");
+            return amountCondition("amount", "=", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountNeq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<>", amount->toLong(), "o");
+            return amountCondition("amount", "<>", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountGt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", ">", amount->toLong(), "o");
+            return amountCondition("amount", ">", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountGte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", ">=", amount->toLong(), "o");
+            return amountCondition("amount", ">=", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountLt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<", amount->toLong(), "o");
+            return amountCondition("amount", "<", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountLte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<=", amount->toLong(), "o");
+            return amountCondition("amount", "<=", amount);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::blockHeightEq(int64_t blockHeight) {
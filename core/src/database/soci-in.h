@@ -0,0 +1,57 @@
+/*
+ *
+ * soci-in
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ */
+#ifndef LEDGER_CORE_SOCI_IN_H
+#define LEDGER_CORE_SOCI_IN_H
+
+#include <soci.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        namespace db {
+
+            // Maximum number of values bound by a single IN clause, well under the SQLite parameter limit
+            static const std::size_t IN_CLAUSE_MAX_SIZE = 500;
+
+            /**
+             * Run a select whose "{}" placeholder is an IN clause over the given values, e.g.
+             * "SELECT ... WHERE uid IN ({})". Values are sent in slices of at most IN_CLAUSE_MAX_SIZE and the
+             * callback is called with every row of every slice.
+             */
+            template <typename Callback>
+            void selectIn(soci::session& sql, const std::string& query, const std::vector<std::string>& values,
+                          Callback callback) {
+                for (std::size_t offset = 0; offset < values.size(); offset += IN_CLAUSE_MAX_SIZE) {
+                    auto count = std::min(IN_CLAUSE_MAX_SIZE, values.size() - offset);
+                    std::string placeholders;
+                    for (std::size_t index = 0; index < count; index++) {
+                        placeholders += fmt::format(index == 0 ? ":in{}" : ", :in{}", index);
+                    }
+                    soci::details::prepare_temp_type statement = (sql.prepare << fmt::format(query, placeholders));
+                    for (std::size_t index = 0; index < count; index++) {
+                        statement, soci::use(values[offset + index]);
+                    }
+                    soci::rowset<soci::row> rows(statement);
+                    for (auto& row : rows) {
+                        callback(row);
+                    }
+                }
+            }
+
+        }
+    }
+}
+
+#endif //LEDGER_CORE_SOCI_IN_H
@@ -69,6 +69,15 @@ CJNIEXPORT jobject JNICALL Java_co_ledger_core_DatabaseBackend_getSqlite3Backend
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT jobject JNICALL Java_co_ledger_core_DatabaseBackend_getSqlite3WalBackend(JNIEnv* jniEnv, jobject /*this*/, jint j_readonlyConnectionPoolSize)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        auto r = ::ledger::core::api::DatabaseBackend::getSqlite3WalBackend(::djinni::I32::toCpp(jniEnv, j_readonlyConnectionPoolSize));
+        return ::djinni::release(::djinni_generated::DatabaseBackend::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
 CJNIEXPORT jobject JNICALL Java_co_ledger_core_DatabaseBackend_getPostgreSQLBackend(JNIEnv* jniEnv, jobject /*this*/, jint j_connectionPoolSize, jint j_readonlyConnectionPoolSize)
 {
     try {
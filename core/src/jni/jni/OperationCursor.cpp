@@ -0,0 +1,40 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from wallet.djinni
+
+#include "OperationCursor.hpp"  // my header
+#include "OperationListCallback.hpp"
+
+namespace djinni_generated {
+
+OperationCursor::OperationCursor() : ::djinni::JniInterface<::ledger::core::api::OperationCursor, OperationCursor>("co/ledger/core/OperationCursor$CppProxy") {}
+
+OperationCursor::~OperationCursor() = default;
+
+
+CJNIEXPORT void JNICALL Java_co_ledger_core_OperationCursor_00024CppProxy_nativeDestroy(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        delete reinterpret_cast<::djinni::CppProxyHandle<::ledger::core::api::OperationCursor>*>(nativeRef);
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+CJNIEXPORT void JNICALL Java_co_ledger_core_OperationCursor_00024CppProxy_native_1next(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_callback)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::ledger::core::api::OperationCursor>(nativeRef);
+        ref->next(::djinni_generated::OperationListCallback::toCpp(jniEnv, j_callback));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+CJNIEXPORT void JNICALL Java_co_ledger_core_OperationCursor_00024CppProxy_native_1close(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::ledger::core::api::OperationCursor>(nativeRef);
+        ref->close();
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
+}  // namespace djinni_generated
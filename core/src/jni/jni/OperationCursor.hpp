@@ -0,0 +1,34 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from wallet.djinni
+
+#ifndef DJINNI_GENERATED_OPERATIONCURSOR_HPP_JNI_
+#define DJINNI_GENERATED_OPERATIONCURSOR_HPP_JNI_
+
+#include "../../api/OperationCursor.hpp"
+#include "djinni_support.hpp"
+
+namespace djinni_generated {
+
+class OperationCursor final : ::djinni::JniInterface<::ledger::core::api::OperationCursor, OperationCursor> {
+public:
+    using CppType = std::shared_ptr<::ledger::core::api::OperationCursor>;
+    using CppOptType = std::shared_ptr<::ledger::core::api::OperationCursor>;
+    using JniType = jobject;
+
+    using Boxed = OperationCursor;
+
+    ~OperationCursor();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j) { return ::djinni::JniClass<OperationCursor>::get()._fromJava(jniEnv, j); }
+    static ::djinni::LocalRef<JniType> fromCppOpt(JNIEnv* jniEnv, const CppOptType& c) { return {jniEnv, ::djinni::JniClass<OperationCursor>::get()._toJava(jniEnv, c)}; }
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c) { return fromCppOpt(jniEnv, c); }
+
+private:
+    OperationCursor();
+    friend ::djinni::JniClass<OperationCursor>;
+    friend ::djinni::JniInterface<::ledger::core::api::OperationCursor, OperationCursor>;
+
+};
+
+}  // namespace djinni_generated
+#endif //DJINNI_GENERATED_OPERATIONCURSOR_HPP_JNI_
@@ -3,6 +3,7 @@
 
 #include "OperationQuery.hpp"  // my header
 #include "Marshal.hpp"
+#include "OperationCursor.hpp"
 #include "OperationListCallback.hpp"
 #include "OperationOrderKey.hpp"
 #include "QueryFilter.hpp"
@@ -83,6 +84,17 @@ CJNIEXPORT jobject JNICALL Java_co_ledger_core_OperationQuery_00024CppProxy_nati
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT jobject JNICALL Java_co_ledger_core_OperationQuery_00024CppProxy_native_1after(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_date, jstring j_uid)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::ledger::core::api::OperationQuery>(nativeRef);
+        auto r = ref->after(::djinni::Date::toCpp(jniEnv, j_date),
+                            ::djinni::String::toCpp(jniEnv, j_uid));
+        return ::djinni::release(::djinni_generated::OperationQuery::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
 CJNIEXPORT void JNICALL Java_co_ledger_core_OperationQuery_00024CppProxy_native_1execute(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_callback)
 {
     try {
@@ -92,4 +104,14 @@ CJNIEXPORT void JNICALL Java_co_ledger_core_OperationQuery_00024CppProxy_native_
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
 }
 
+CJNIEXPORT jobject JNICALL Java_co_ledger_core_OperationQuery_00024CppProxy_native_1cursor(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jint j_chunkSize)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::ledger::core::api::OperationQuery>(nativeRef);
+        auto r = ref->cursor(::djinni::I32::toCpp(jniEnv, j_chunkSize));
+        return ::djinni::release(::djinni_generated::OperationCursor::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
 }  // namespace djinni_generated
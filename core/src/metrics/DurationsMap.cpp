@@ -56,7 +56,18 @@ namespace ledger {
             }
         }
 
-        const std::unordered_map<std::string, api::DurationMetric>& DurationsMap::getMetrics() {
+        void DurationsMap::increment(const std::string &name, int32_t count) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto existing = _metrics.find(name);
+            if (existing != _metrics.end()) {
+                existing->second.count += count;
+            } else {
+                _metrics[name] = api::DurationMetric(0, count);
+            }
+        }
+
+        std::unordered_map<std::string, api::DurationMetric> DurationsMap::getMetrics() {
+            std::lock_guard<std::mutex> lock(_mutex);
             return _metrics;
         }
 
@@ -43,7 +43,9 @@ namespace ledger {
         public:
             void record(const std::string& name,
                     const std::chrono::high_resolution_clock::duration& duration);
-            const std::unordered_map<std::string, api::DurationMetric>& getMetrics();
+            // Add count occurrences of a zero duration event, for counters recorded in bulk.
+            void increment(const std::string& name, int32_t count);
+            std::unordered_map<std::string, api::DurationMetric> getMetrics();
 
             static DurationsMap& getInstance();
 
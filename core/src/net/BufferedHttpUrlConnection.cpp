@@ -0,0 +1,116 @@
+/*
+ *
+ * BufferedHttpUrlConnection.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "BufferedHttpUrlConnection.hpp"
+#include "../api/HttpReadBodyResult.hpp"
+#include "../utils/Exception.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace ledger {
+    namespace core {
+
+        const size_t BufferedHttpUrlConnection::DEFAULT_MAX_BODY_BYTES = 32 * 1024 * 1024;
+
+        BufferedHttpUrlConnection::BufferedHttpUrlConnection(int32_t statusCode,
+                                                             const std::string &statusText,
+                                                             const std::unordered_map<std::string, std::string> &headers,
+                                                             const std::shared_ptr<const std::vector<uint8_t>> &body)
+            : _statusCode(statusCode), _statusText(statusText), _headers(headers), _body(body), _read(false) {
+
+        }
+
+        int32_t BufferedHttpUrlConnection::getStatusCode() {
+            return _statusCode;
+        }
+
+        std::string BufferedHttpUrlConnection::getStatusText() {
+            return _statusText;
+        }
+
+        std::unordered_map<std::string, std::string> BufferedHttpUrlConnection::getHeaders() {
+            return _headers;
+        }
+
+        api::HttpReadBodyResult BufferedHttpUrlConnection::readBody() {
+            if (_read) {
+                return api::HttpReadBodyResult(std::experimental::nullopt, std::vector<uint8_t>());
+            }
+            _read = true;
+            return api::HttpReadBodyResult(std::experimental::nullopt, *_body);
+        }
+
+        std::vector<uint8_t> BufferedHttpUrlConnection::readAll(const std::shared_ptr<api::HttpUrlConnection> &connection,
+                                                                size_t maxBytes) {
+            std::vector<uint8_t> body;
+            auto length = getBodyLength(connection->getHeaders());
+            if (length.nonEmpty()) {
+                if (length.getValue() > maxBytes) {
+                    throw make_exception(api::ErrorCode::HTTP_ERROR, "Response body of {} bytes exceeds the limit of {} bytes",
+                                         length.getValue(), maxBytes);
+                }
+                body.reserve(length.getValue());
+            }
+            while (length.isEmpty() || body.size() < length.getValue()) {
+                auto chunk = connection->readBody();
+                if (chunk.error) {
+                    throw Exception(chunk.error->code, chunk.error->message);
+                }
+                if (!chunk.data || chunk.data->empty()) {
+                    break;
+                }
+                if (chunk.data->size() > maxBytes - body.size()) {
+                    throw make_exception(api::ErrorCode::HTTP_ERROR, "Response body exceeds the limit of {} bytes", maxBytes);
+                }
+                body.insert(body.end(), chunk.data->begin(), chunk.data->end());
+            }
+            return body;
+        }
+
+        Option<size_t> BufferedHttpUrlConnection::getBodyLength(const std::unordered_map<std::string, std::string> &headers) {
+            Option<size_t> length;
+            for (const auto& header : headers) {
+                std::string name = header.first;
+                std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+                if (name == "content-encoding" && header.second != "identity") {
+                    return Option<size_t>();
+                }
+                if (name == "content-length") {
+                    try {
+                        length = static_cast<size_t>(std::stoull(header.second));
+                    } catch (const std::exception&) {
+                        return Option<size_t>();
+                    }
+                }
+            }
+            return length;
+        }
+    }
+}
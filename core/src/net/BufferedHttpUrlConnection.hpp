@@ -0,0 +1,84 @@
+/*
+ *
+ * BufferedHttpUrlConnection.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_BUFFEREDHTTPURLCONNECTION_HPP
+#define LEDGER_CORE_BUFFEREDHTTPURLCONNECTION_HPP
+
+#include "../api/HttpUrlConnection.hpp"
+#include "../utils/Option.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Response held in memory, replayed by each instance sharing the same body.
+         */
+        class BufferedHttpUrlConnection : public api::HttpUrlConnection {
+        public:
+            BufferedHttpUrlConnection(int32_t statusCode,
+                                      const std::string& statusText,
+                                      const std::unordered_map<std::string, std::string>& headers,
+                                      const std::shared_ptr<const std::vector<uint8_t>>& body);
+
+            int32_t getStatusCode() override;
+            std::string getStatusText() override;
+            std::unordered_map<std::string, std::string> getHeaders() override;
+            api::HttpReadBodyResult readBody() override;
+
+            static const size_t DEFAULT_MAX_BODY_BYTES;
+
+            /**
+             * Read the whole body of a connection, throws when the engine reports a read error or when the body is
+             * larger than maxBytes.
+             */
+            static std::vector<uint8_t> readAll(const std::shared_ptr<api::HttpUrlConnection>& connection,
+                                                size_t maxBytes = DEFAULT_MAX_BODY_BYTES);
+
+            /**
+             * Length of the body as delivered by readBody, known when the response has a Content-Length and isn't
+             * content encoded (engines may decode the body, the header is then the length of the encoded one).
+             */
+            static Option<size_t> getBodyLength(const std::unordered_map<std::string, std::string>& headers);
+
+        private:
+            int32_t _statusCode;
+            std::string _statusText;
+            std::unordered_map<std::string, std::string> _headers;
+            std::shared_ptr<const std::vector<uint8_t>> _body;
+            bool _read;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_BUFFEREDHTTPURLCONNECTION_HPP
@@ -0,0 +1,315 @@
+/*
+ *
+ * HttpCache.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "HttpCache.hpp"
+#include "BufferedHttpUrlConnection.hpp"
+#include "../metrics/DurationsMap.hpp"
+#include "../preferences/Preferences.hpp"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <cereal/types/string.hpp>
+#include <cereal/types/unordered_map.hpp>
+#include <cereal/types/vector.hpp>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            int64_t now() {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+
+            void count(const std::string& counter) {
+                DurationsMap::getInstance().increment("HttpCache/" + counter, 1);
+            }
+
+            std::string toLower(std::string value) {
+                std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+                return value;
+            }
+
+            // Request headers a response may vary on, If-None-Match is a revalidation detail and is left out
+            bool isKeyHeader(const std::string& name) {
+                return name == "accept" || name == "authorization" || name == "proxy-authorization" || name == "cookie";
+            }
+
+            const std::string DISK_INDEX_KEY = "__index__";
+        }
+
+        const size_t HttpCache::DEFAULT_MAX_DISK_BYTES = 64 * 1024 * 1024;
+
+        HttpCachePolicy::HttpCachePolicy() : HttpCachePolicy(false, std::chrono::milliseconds::zero()) {
+
+        }
+
+        HttpCachePolicy::HttpCachePolicy(bool immutable, const std::chrono::milliseconds &ttl)
+            : _immutable(immutable), _ttl(ttl) {
+
+        }
+
+        HttpCachePolicy HttpCachePolicy::immutable() {
+            return HttpCachePolicy(true, std::chrono::milliseconds::zero());
+        }
+
+        HttpCachePolicy HttpCachePolicy::ttl(const std::chrono::milliseconds &ttl) {
+            return HttpCachePolicy(false, ttl);
+        }
+
+        bool HttpCachePolicy::isEnabled() const {
+            return _immutable || _ttl.count() > 0;
+        }
+
+        bool HttpCachePolicy::isImmutable() const {
+            return _immutable;
+        }
+
+        const std::chrono::milliseconds& HttpCachePolicy::getTtl() const {
+            return _ttl;
+        }
+
+        bool HttpCache::Entry::isFresh() const {
+            return immutable || now() < expiresAt;
+        }
+
+        HttpCache::HttpCache(size_t maxBytes, const std::shared_ptr<Preferences> &disk, size_t maxDiskBytes)
+            : _maxBytes(maxBytes), _size(0), _disk(disk), _maxDiskBytes(maxDiskBytes), _diskSize(0) {
+            if (_disk) {
+                loadDiskIndex();
+            }
+        }
+
+        std::string HttpCache::keyOf(const std::string &method,
+                                     const std::string &url,
+                                     const std::unordered_map<std::string, std::string> &headers) {
+            std::vector<std::pair<std::string, std::string>> varying;
+            for (const auto& header : headers) {
+                auto name = toLower(header.first);
+                if (isKeyHeader(name)) {
+                    varying.emplace_back(name, header.second);
+                }
+            }
+            std::sort(varying.begin(), varying.end());
+            auto key = method + " " + url;
+            for (const auto& header : varying) {
+                key += "\n" + header.first + ": " + header.second;
+            }
+            return key;
+        }
+
+        std::shared_ptr<const HttpCache::Entry> HttpCache::get(const std::string &key) {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto it = _entries.find(key);
+                if (it != _entries.end()) {
+                    _lru.splice(_lru.begin(), _lru, it->second);
+                    count("hits");
+                    return it->second->second;
+                }
+            }
+            if (_disk) {
+                auto stored = _disk->getObject<Entry>(key);
+                if (stored.nonEmpty()) {
+                    auto entry = std::make_shared<const Entry>(stored.getValue());
+                    touchOnDisk(key);
+                    std::lock_guard<std::mutex> lock(_lock);
+                    store(key, entry);
+                    count("disk_hits");
+                    return entry;
+                }
+            }
+            count("misses");
+            return nullptr;
+        }
+
+        std::shared_ptr<const HttpCache::Entry> HttpCache::put(const std::string &key,
+                                                               const std::shared_ptr<api::HttpUrlConnection> &connection,
+                                                               const HttpCachePolicy &policy) {
+            auto entry = std::make_shared<Entry>();
+            entry->statusCode = connection->getStatusCode();
+            entry->statusText = connection->getStatusText();
+            entry->headers = connection->getHeaders();
+            entry->body = BufferedHttpUrlConnection::readAll(connection);
+            for (const auto& header : entry->headers) {
+                if (toLower(header.first) == "etag") {
+                    entry->etag = header.second;
+                }
+            }
+            entry->immutable = policy.isImmutable();
+            entry->expiresAt = expiresAt(policy);
+            if (_disk && entry->immutable) {
+                storeOnDisk(key, *entry);
+            }
+            std::lock_guard<std::mutex> lock(_lock);
+            store(key, entry);
+            return entry;
+        }
+
+        std::shared_ptr<const HttpCache::Entry> HttpCache::renew(const std::string &key,
+                                                                 const std::shared_ptr<const Entry> &entry,
+                                                                 const HttpCachePolicy &policy) {
+            auto renewed = std::make_shared<Entry>(*entry);
+            renewed->expiresAt = expiresAt(policy);
+            count("revalidated");
+            std::lock_guard<std::mutex> lock(_lock);
+            store(key, renewed);
+            return renewed;
+        }
+
+        void HttpCache::clear() {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _lru.clear();
+                _entries.clear();
+                _size = 0;
+            }
+            std::lock_guard<std::mutex> lock(_diskLock);
+            _diskLru.clear();
+            _diskEntries.clear();
+            _diskSize = 0;
+        }
+
+        size_t HttpCache::getSize() const {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _size;
+        }
+
+        size_t HttpCache::getDiskSize() const {
+            std::lock_guard<std::mutex> lock(_diskLock);
+            return _diskSize;
+        }
+
+        void HttpCache::loadDiskIndex() {
+            auto index = _disk->getObject<DiskIndex>(DISK_INDEX_KEY);
+            if (index.isEmpty()) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_diskLock);
+            auto& stored = index.getValue();
+            for (size_t i = 0; i < stored.keys.size() && i < stored.sizes.size(); i++) {
+                _diskLru.emplace_back(stored.keys[i], static_cast<size_t>(stored.sizes[i]));
+                _diskEntries[stored.keys[i]] = std::prev(_diskLru.end());
+                _diskSize += static_cast<size_t>(stored.sizes[i]);
+            }
+        }
+
+        void HttpCache::touchOnDisk(const std::string &key) {
+            std::lock_guard<std::mutex> lock(_diskLock);
+            auto it = _diskEntries.find(key);
+            if (it == _diskEntries.end()) {
+                return;
+            }
+            // Recency is only kept in memory, it is persisted with the next store to keep writes off the read path
+            _diskLru.splice(_diskLru.end(), _diskLru, it->second);
+        }
+
+        void HttpCache::storeOnDisk(const std::string &key, Entry &entry) {
+            auto size = sizeOf(key, entry);
+            if (size > _maxDiskBytes) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_diskLock);
+            auto editor = _disk->editor();
+            auto existing = _diskEntries.find(key);
+            if (existing != _diskEntries.end()) {
+                _diskSize -= existing->second->second;
+                _diskLru.erase(existing->second);
+                _diskEntries.erase(existing);
+            }
+            editor->putObject(key, entry);
+            _diskLru.emplace_back(key, size);
+            _diskEntries[key] = std::prev(_diskLru.end());
+            _diskSize += size;
+            while (_diskSize > _maxDiskBytes) {
+                auto& first = _diskLru.front();
+                editor->remove(first.first);
+                _diskSize -= first.second;
+                _diskEntries.erase(first.first);
+                _diskLru.pop_front();
+                count("disk_evictions");
+            }
+            // The entries and the index are written in the same batch
+            commitDiskIndex(editor);
+        }
+
+        void HttpCache::commitDiskIndex(const std::shared_ptr<PreferencesEditor> &editor) {
+            DiskIndex index;
+            index.keys.reserve(_diskLru.size());
+            index.sizes.reserve(_diskLru.size());
+            for (const auto& item : _diskLru) {
+                index.keys.push_back(item.first);
+                index.sizes.push_back(item.second);
+            }
+            editor->putObject(DISK_INDEX_KEY, index)->commit();
+        }
+
+        std::shared_ptr<api::HttpUrlConnection> HttpCache::replay(const std::shared_ptr<const Entry> &entry) {
+            // The body is shared with the entry, replays never copy it.
+            return std::make_shared<BufferedHttpUrlConnection>(entry->statusCode, entry->statusText, entry->headers,
+                                                               std::shared_ptr<const std::vector<uint8_t>>(entry, &entry->body));
+        }
+
+        void HttpCache::store(const std::string &key, const std::shared_ptr<const Entry> &entry) {
+            auto existing = _entries.find(key);
+            if (existing != _entries.end()) {
+                _size -= sizeOf(key, *existing->second->second);
+                _lru.erase(existing->second);
+                _entries.erase(existing);
+            }
+            auto size = sizeOf(key, *entry);
+            if (size > _maxBytes) {
+                return;
+            }
+            _lru.emplace_front(key, entry);
+            _entries[key] = _lru.begin();
+            _size += size;
+            while (_size > _maxBytes) {
+                auto& last = _lru.back();
+                _size -= sizeOf(last.first, *last.second);
+                _entries.erase(last.first);
+                _lru.pop_back();
+                count("evictions");
+            }
+        }
+
+        int64_t HttpCache::expiresAt(const HttpCachePolicy &policy) {
+            return policy.isImmutable() ? std::numeric_limits<int64_t>::max() : now() + policy.getTtl().count();
+        }
+
+        size_t HttpCache::sizeOf(const std::string &key, const Entry &entry) {
+            auto size = key.size() + entry.body.size() + entry.statusText.size() + entry.etag.size();
+            for (const auto& header : entry.headers) {
+                size += header.first.size() + header.second.size();
+            }
+            return size;
+        }
+    }
+}
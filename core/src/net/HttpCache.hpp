@@ -0,0 +1,176 @@
+/*
+ *
+ * HttpCache.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_HTTPCACHE_HPP
+#define LEDGER_CORE_HTTPCACHE_HPP
+
+#include "../api/HttpUrlConnection.hpp"
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        class Preferences;
+        class PreferencesEditor;
+
+        /**
+         * How long a GET response may be served from the cache. Explorers opt in per endpoint with HttpRequest::cache.
+         */
+        class HttpCachePolicy {
+        public:
+            HttpCachePolicy();
+
+            /** The resource never changes once it exists: block by height, confirmed data. */
+            static HttpCachePolicy immutable();
+            /** The resource is fresh for the given duration, then revalidated with its ETag if any. */
+            static HttpCachePolicy ttl(const std::chrono::milliseconds& ttl);
+
+            bool isEnabled() const;
+            bool isImmutable() const;
+            const std::chrono::milliseconds& getTtl() const;
+
+        private:
+            HttpCachePolicy(bool immutable, const std::chrono::milliseconds& ttl);
+
+            bool _immutable;
+            std::chrono::milliseconds _ttl;
+        };
+
+        /**
+         * Cache of successful GET responses keyed by method, URL and the request headers the response depends on
+         * (see keyOf).
+         *
+         * Entries live in a memory LRU bounded by their size. Immutable entries are also written to an optional
+         * preferences tier (the pool LevelDB by default) so that they survive restarts. That tier is an LRU bounded
+         * by maxDiskBytes as well, its index is stored next to the entries on each write (recency of disk hits is
+         * persisted with the next write).
+         */
+        class HttpCache {
+        public:
+            struct Entry {
+                int32_t statusCode;
+                std::string statusText;
+                std::unordered_map<std::string, std::string> headers;
+                std::vector<uint8_t> body;
+                std::string etag;
+                bool immutable;
+                /** Milliseconds since epoch, ignored for immutable entries. */
+                int64_t expiresAt;
+
+                bool isFresh() const;
+
+                template <class Archive>
+                void serialize(Archive& archive) {
+                    archive(statusCode, statusText, headers, body, etag, immutable, expiresAt);
+                }
+            };
+
+            static const size_t DEFAULT_MAX_DISK_BYTES;
+
+            HttpCache(size_t maxBytes,
+                      const std::shared_ptr<Preferences>& disk = nullptr,
+                      size_t maxDiskBytes = DEFAULT_MAX_DISK_BYTES);
+
+            /**
+             * Key of a request: method, URL, and the content negotiation and credential headers.
+             */
+            static std::string keyOf(const std::string& method,
+                                     const std::string& url,
+                                     const std::unordered_map<std::string, std::string>& headers);
+
+            std::shared_ptr<const Entry> get(const std::string& key);
+            /**
+             * Store a successful response, its body is read entirely.
+             * @return The stored entry
+             */
+            std::shared_ptr<const Entry> put(const std::string& key,
+                                             const std::shared_ptr<api::HttpUrlConnection>& connection,
+                                             const HttpCachePolicy& policy);
+            /**
+             * Extend the freshness of an entry revalidated by a 304 response.
+             */
+            std::shared_ptr<const Entry> renew(const std::string& key,
+                                               const std::shared_ptr<const Entry>& entry,
+                                               const HttpCachePolicy& policy);
+
+            /**
+             * Drop the memory entries and forget the preferences tier, whose entries are cleared with its backend.
+             */
+            void clear();
+            size_t getSize() const;
+            size_t getDiskSize() const;
+
+            static std::shared_ptr<api::HttpUrlConnection> replay(const std::shared_ptr<const Entry>& entry);
+
+        private:
+            struct DiskIndex {
+                /** Least recently used first. */
+                std::vector<std::string> keys;
+                std::vector<uint64_t> sizes;
+
+                template <class Archive>
+                void serialize(Archive& archive) {
+                    archive(keys, sizes);
+                }
+            };
+            using DiskLru = std::list<std::pair<std::string, size_t>>;
+
+            void store(const std::string& key, const std::shared_ptr<const Entry>& entry);
+            void loadDiskIndex();
+            void touchOnDisk(const std::string& key);
+            void storeOnDisk(const std::string& key, Entry& entry);
+            void commitDiskIndex(const std::shared_ptr<PreferencesEditor>& editor);
+            static int64_t expiresAt(const HttpCachePolicy& policy);
+            static size_t sizeOf(const std::string& key, const Entry& entry);
+
+        private:
+            using Lru = std::list<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+            size_t _maxBytes;
+            size_t _size;
+            std::shared_ptr<Preferences> _disk;
+            Lru _lru;
+            std::unordered_map<std::string, Lru::iterator> _entries;
+            mutable std::mutex _lock;
+            size_t _maxDiskBytes;
+            size_t _diskSize;
+            DiskLru _diskLru;
+            std::unordered_map<std::string, DiskLru::iterator> _diskEntries;
+            mutable std::mutex _diskLock;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_HTTPCACHE_HPP
@@ -29,6 +29,7 @@
  *
  */
 #include "HttpClient.hpp"
+#include <algorithm>
 
 namespace ledger {
     namespace core {
@@ -104,7 +105,9 @@ namespace ledger {
                     _client,
                     _sequentialContext,
                     _threadpoolContext,
-                    _logger
+                    _logger,
+                    _schedulerOptions,
+                    _cache
             );
         }
 
@@ -112,13 +115,29 @@ namespace ledger {
             _logger = make_option(logger);
         }
 
+        HttpClient& HttpClient::setSchedulerOptions(const HttpRequestScheduler::Options &options) {
+            _schedulerOptions = options;
+            return *this;
+        }
+
+        const HttpRequestScheduler::Options& HttpClient::getSchedulerOptions() const {
+            return _schedulerOptions;
+        }
+
+        HttpClient& HttpClient::setCache(const std::shared_ptr<HttpCache> &cache) {
+            _cache = cache;
+            return *this;
+        }
+
         HttpRequest::HttpRequest(api::HttpMethod method, const std::string &url,
                                  const std::unordered_map<std::string, std::string> &headers,
                                  const std::experimental::optional<std::vector<uint8_t>>& body,
                                  const std::shared_ptr<api::HttpClient> &client,
                                  const std::shared_ptr<api::ExecutionContext> & sequentialContext,
                                  const std::shared_ptr<api::ExecutionContext> & threadpoolContext,
-                                 const Option<std::shared_ptr<spdlog::logger>>& logger) {
+                                 const Option<std::shared_ptr<spdlog::logger>>& logger,
+                                 const HttpRequestScheduler::Options& schedulerOptions,
+                                 const std::shared_ptr<HttpCache>& cache) {
             _method = method;
             _url = url;
             _headers = headers;
@@ -128,6 +147,13 @@ namespace ledger {
             _threadpoolContext = threadpoolContext;
             _context = _sequentialContext;
             _logger = logger;
+            _schedulerOptions = schedulerOptions;
+            _cache = cache;
+        }
+
+        HttpRequest& HttpRequest::cache(const HttpCachePolicy &policy) {
+            _cachePolicy = policy;
+            return *this;
         }
 
         HttpRequest::ApiRequest::ApiRequest(const std::shared_ptr<const ledger::core::HttpRequest>& self) {
@@ -138,25 +164,75 @@ namespace ledger {
             return std::make_shared<HttpRequest::ApiRequest>(std::make_shared<HttpRequest>(*this));
         }
 
+        std::string HttpRequest::getCoalescingKey() const {
+            std::vector<std::pair<std::string, std::string>> headers(_headers.begin(), _headers.end());
+            std::sort(headers.begin(), headers.end());
+            auto key = api::to_string(_method) + " " + _url;
+            for (const auto& header : headers) {
+                key += "\n" + header.first + ": " + header.second;
+            }
+            return key;
+        }
+
         Future<std::shared_ptr<api::HttpUrlConnection>> HttpRequest::operator()() const {
-            auto request = std::dynamic_pointer_cast<ApiRequest>(toApiRequest());
-            _client->execute(request);
-            _logger.foreach([&] (const std::shared_ptr<spdlog::logger>& logger) {
-                logger->info("{} {}", api::to_string(request->getMethod()), request->getUrl());
-            });
-            auto logger = _logger;
-            return  request->getFuture().map<std::shared_ptr<api::HttpUrlConnection>>(_context, [=] (const std::shared_ptr<api::HttpUrlConnection>& connection) {
-                logger.foreach([&] (const std::shared_ptr<spdlog::logger>& l) {
-                    l->info("{} {} - {} {}", api::to_string(request->getMethod()), request->getUrl(),  connection->getStatusCode(), connection->getStatusText());
+            auto self = std::make_shared<HttpRequest>(*this);
+            if (_method != api::HttpMethod::GET || !_cache || !_cachePolicy.isEnabled()) {
+                return send().map<std::shared_ptr<api::HttpUrlConnection>>(_context, [self] (const std::shared_ptr<api::HttpUrlConnection>& connection) {
+                    return self->checkStatus(connection);
                 });
-                if (connection->getStatusCode() < 200 || connection->getStatusCode() >= 300) {
-                    throw Exception(HttpRequest::getErrorCode(connection->getStatusCode()), connection->getStatusText(),
-                                    Option<std::shared_ptr<void>>(std::static_pointer_cast<void>(connection)));
+            }
+            auto key = HttpCache::keyOf(api::to_string(_method), _url, _headers);
+            auto entry = _cache->get(key);
+            if (entry && entry->isFresh()) {
+                return Future<std::shared_ptr<api::HttpUrlConnection>>::successful(HttpCache::replay(entry));
+            }
+            if (entry && !entry->etag.empty()) {
+                self->_headers["If-None-Match"] = entry->etag;
+            }
+            return self->send().map<std::shared_ptr<api::HttpUrlConnection>>(_context, [self, key, entry] (const std::shared_ptr<api::HttpUrlConnection>& connection) {
+                auto statusCode = connection->getStatusCode();
+                if (statusCode == 304 && entry) {
+                    return HttpCache::replay(self->_cache->renew(key, entry, self->_cachePolicy));
                 }
-                return connection;
+                if (statusCode >= 200 && statusCode < 300) {
+                    return HttpCache::replay(self->_cache->put(key, self->checkStatus(connection), self->_cachePolicy));
+                }
+                return self->checkStatus(connection);
             });
         }
 
+        Future<std::shared_ptr<api::HttpUrlConnection>> HttpRequest::send() const {
+            auto self = std::make_shared<HttpRequest>(*this);
+            auto send = [self] () {
+                auto request = std::make_shared<HttpRequest::ApiRequest>(self);
+                self->_client->execute(request);
+                self->_logger.foreach([&] (const std::shared_ptr<spdlog::logger>& logger) {
+                    logger->info("{} {}", api::to_string(self->_method), self->_url);
+                });
+                return request->getFuture();
+            };
+            // Only GET is considered idempotent, other methods are sent exactly once.
+            auto idempotent = _method == api::HttpMethod::GET;
+            return HttpRequestScheduler::forUrl(_url)->schedule(
+                    idempotent ? getCoalescingKey() : "",
+                    idempotent,
+                    send,
+                    _schedulerOptions,
+                    _sequentialContext
+            );
+        }
+
+        std::shared_ptr<api::HttpUrlConnection> HttpRequest::checkStatus(const std::shared_ptr<api::HttpUrlConnection> &connection) const {
+            _logger.foreach([&] (const std::shared_ptr<spdlog::logger>& l) {
+                l->info("{} {} - {} {}", api::to_string(_method), _url,  connection->getStatusCode(), connection->getStatusText());
+            });
+            if (connection->getStatusCode() < 200 || connection->getStatusCode() >= 300) {
+                throw Exception(HttpRequest::getErrorCode(connection->getStatusCode()), connection->getStatusText(),
+                                Option<std::shared_ptr<void>>(std::static_pointer_cast<void>(connection)));
+            }
+            return connection;
+        }
+
         Future<HttpRequest::JsonResult> HttpRequest::json(bool parseNumbersAsString, bool ignoreStatusCode, bool multiThread) const {
             _context = (multiThread ? _threadpoolContext : _sequentialContext);
             return operator()().recover(_context, [] (const Exception& exception) {
@@ -170,10 +246,11 @@ namespace ledger {
                         std::shared_ptr<api::HttpUrlConnection> connection = co;
                         auto doc = std::make_shared<rapidjson::Document>();
                         HttpUrlConnectionInputStream is(connection);
+                        // Stop at the end of the root value, engines returning the whole body on each read stay supported
                         if (parseNumbersAsString) {
-                            doc->ParseStream<rapidjson::kParseNumbersAsStringsFlag>(is);
+                            doc->ParseStream<rapidjson::kParseNumbersAsStringsFlag | rapidjson::kParseStopWhenDoneFlag>(is);
                         } else {
-                            doc->ParseStream(is);
+                            doc->ParseStream<rapidjson::kParseStopWhenDoneFlag>(is);
                         }
                         std::shared_ptr<JsonResult> result(new std::tuple<std::shared_ptr<api::HttpUrlConnection>, std::shared_ptr<rapidjson::Document>>(std::make_tuple(connection, doc)));
                         if (!ignoreStatusCode && (connection->getStatusCode() < 200 || connection->getStatusCode() >= 300)) {
@@ -184,6 +261,44 @@ namespace ledger {
             });
         }
 
+        Future<HttpRequest::JsonResult> HttpRequest::streamJsonArray(const std::string &arrayKey,
+                                                                     const JsonArrayStreamHandler::ElementCallback &onElement,
+                                                                     bool parseNumbersAsString,
+                                                                     bool multiThread) const {
+            _context = (multiThread ? _threadpoolContext : _sequentialContext);
+            auto url = _url;
+            return operator()().recover(_context, [] (const Exception& exception) {
+                if (HttpRequest::isHttpError(exception.getErrorCode()) &&
+                exception.getUserData().nonEmpty()) {
+                    return std::static_pointer_cast<api::HttpUrlConnection>(exception.getUserData().getValue());
+                }
+                throw exception;
+            }).map<JsonResult>
+                    (_context, [arrayKey, onElement, parseNumbersAsString, url] (const std::shared_ptr<api::HttpUrlConnection>& co) {
+                        std::shared_ptr<api::HttpUrlConnection> connection = co;
+                        auto doc = std::make_shared<rapidjson::Document>();
+                        JsonArrayStreamHandler handler(arrayKey, onElement, *doc);
+                        HttpUrlConnectionInputStream is(connection);
+                        rapidjson::Reader reader;
+                        auto parsed = parseNumbersAsString ?
+                                reader.Parse<rapidjson::kParseNumbersAsStringsFlag | rapidjson::kParseStopWhenDoneFlag>(is, handler) :
+                                reader.Parse<rapidjson::kParseStopWhenDoneFlag>(is, handler);
+                        if (parsed) {
+                            handler.finish();
+                        }
+                        if (connection->getStatusCode() < 200 || connection->getStatusCode() >= 300) {
+                            std::shared_ptr<JsonResult> result(new JsonResult(std::make_tuple(connection, doc)));
+                            throw Exception(HttpRequest::getErrorCode(connection->getStatusCode()), connection->getStatusText(),
+                                            Option<std::shared_ptr<void>>(std::static_pointer_cast<void>(result)));
+                        }
+                        if (!parsed) {
+                            throw make_exception(api::ErrorCode::API_ERROR, "Invalid JSON response from {} at offset {}",
+                                                 url, parsed.Offset());
+                        }
+                        return std::make_tuple(connection, doc);
+            });
+        }
+
         api::HttpMethod HttpRequest::ApiRequest::getMethod() {
             return _self->_method;
         }
@@ -44,6 +44,9 @@
 #include "../async/Promise.hpp"
 #include "../utils/Either.hpp"
 #include "HttpUrlConnectionInputStream.hpp"
+#include "HttpRequestScheduler.hpp"
+#include "HttpCache.hpp"
+#include "JsonArrayStreamHandler.hpp"
 
 #include "../debug/logger.hpp"
 #include "../utils/Option.hpp"
@@ -68,9 +71,16 @@ namespace ledger {
                         const std::shared_ptr<api::HttpClient> &client,
                         const std::shared_ptr<api::ExecutionContext> & sequentialContext,
                         const std::shared_ptr<api::ExecutionContext>& threadpoolContext,
-                        const Option<std::shared_ptr<spdlog::logger>>& logger);
+                        const Option<std::shared_ptr<spdlog::logger>>& logger,
+                        const HttpRequestScheduler::Options& schedulerOptions = HttpRequestScheduler::Options(),
+                        const std::shared_ptr<HttpCache>& cache = nullptr);
             Future<std::shared_ptr<api::HttpUrlConnection>> operator()() const;
 
+            /**
+             * Serve this GET from the client cache when the policy allows it, no-op when the client has no cache.
+             */
+            HttpRequest& cache(const HttpCachePolicy& policy);
+
             template <typename Success, typename Failure, typename Handler>
             Future<Either<Failure, std::shared_ptr<Success>>> json(Handler handler, bool multiThread = false) const {
                 _context = (multiThread ? _threadpoolContext : _sequentialContext);
@@ -86,12 +96,21 @@ namespace ledger {
                     h.attach(connection);
                     HttpUrlConnectionInputStream is(connection);
                     rapidjson::Reader reader;
-                    reader.Parse<rapidjson::ParseFlag::kParseNumbersAsStringsFlag>(is, h);
+                    reader.Parse<rapidjson::ParseFlag::kParseNumbersAsStringsFlag | rapidjson::ParseFlag::kParseStopWhenDoneFlag>(is, h);
                     return (Either<Failure, std::shared_ptr<Success>>) h.build();
                 });
             }
 
             Future<JsonResult> json(bool parseNumbersAsString = false, bool ignoreStatusCode = false, bool multiThread=false) const;
+            /**
+             * Like json(), with the elements of the root member arrayKey handed one at a time to onElement while the
+             * body is read instead of being kept in the document. The returned document holds the other members,
+             * arrayKey being an empty array.
+             */
+            Future<JsonResult> streamJsonArray(const std::string& arrayKey,
+                                               const JsonArrayStreamHandler::ElementCallback& onElement,
+                                               bool parseNumbersAsString = false,
+                                               bool multiThread = false) const;
             std::shared_ptr<api::HttpRequest> toApiRequest() const;
 
 
@@ -105,6 +124,13 @@ namespace ledger {
             std::shared_ptr<api::ExecutionContext> _threadpoolContext;
             mutable std::shared_ptr<api::ExecutionContext> _context;
             Option<std::shared_ptr<spdlog::logger>> _logger;
+            HttpRequestScheduler::Options _schedulerOptions;
+            std::shared_ptr<HttpCache> _cache;
+            HttpCachePolicy _cachePolicy;
+
+            std::string getCoalescingKey() const;
+            Future<std::shared_ptr<api::HttpUrlConnection>> send() const;
+            std::shared_ptr<api::HttpUrlConnection> checkStatus(const std::shared_ptr<api::HttpUrlConnection>& connection) const;
 
             static api::ErrorCode getErrorCode(int32_t statusCode) {
                 return statusCode >= 200 && statusCode < 300 ? api::ErrorCode::FUTURE_WAS_SUCCESSFULL :
@@ -163,6 +189,16 @@ namespace ledger {
             HttpClient& addHeader(const std::string& key, const std::string& value);
             HttpClient& removeHeader(const std::string& key);
             void setLogger(const std::shared_ptr<spdlog::logger>& logger);
+            /**
+             * Coalescing, retries and hedging of the requests created by this client. The concurrency limit is set
+             * once per host, with HttpRequestScheduler::setMaxConcurrentRequests.
+             */
+            HttpClient& setSchedulerOptions(const HttpRequestScheduler::Options& options);
+            const HttpRequestScheduler::Options& getSchedulerOptions() const;
+            /**
+             * Cache used by the requests opting in with HttpRequest::cache.
+             */
+            HttpClient& setCache(const std::shared_ptr<HttpCache>& cache);
 
         private:
             HttpRequest createRequest(api::HttpMethod method,
@@ -178,6 +214,8 @@ namespace ledger {
             std::shared_ptr<api::ExecutionContext> _threadpoolContext;
             std::unordered_map<std::string, std::string> _headers;
             Option<std::shared_ptr<spdlog::logger>> _logger;
+            HttpRequestScheduler::Options _schedulerOptions;
+            std::shared_ptr<HttpCache> _cache;
         };
     }
 }
@@ -0,0 +1,301 @@
+/*
+ *
+ * HttpRequestScheduler.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "HttpRequestScheduler.hpp"
+#include "BufferedHttpUrlConnection.hpp"
+#include "../metrics/DurationsMap.hpp"
+#include "../utils/LambdaRunnable.hpp"
+#include <algorithm>
+#include <random>
+#include <fmt/format.h>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            bool isRetryable(const Try<HttpRequestScheduler::Connection>& result) {
+                if (result.isFailure()) {
+                    auto code = result.getFailure().getErrorCode();
+                    return code == api::ErrorCode::UNABLE_TO_CONNECT_TO_HOST ||
+                           code == api::ErrorCode::NO_INTERNET_CONNECTIVITY ||
+                           code == api::ErrorCode::HTTP_TIMEOUT;
+                }
+                auto status = result.getValue()->getStatusCode();
+                return status == 429 || status >= 500;
+            }
+
+            int64_t backoff(int32_t attempt, int64_t baseDelayMs, int64_t maxDelayMs) {
+                static thread_local std::mt19937_64 generator(std::random_device{}());
+                auto ceiling = baseDelayMs;
+                for (auto i = 1; i < attempt && ceiling < maxDelayMs; i++) {
+                    ceiling *= 2;
+                }
+                ceiling = std::max<int64_t>(0, std::min(ceiling, maxDelayMs));
+                return std::uniform_int_distribution<int64_t>(0, ceiling)(generator);
+            }
+        }
+
+        struct HttpRequestScheduler::Call {
+            bool idempotent;
+            Send send;
+            Options options;
+            std::shared_ptr<api::ExecutionContext> context;
+            int32_t attempt;
+            Promise<Connection> promise;
+        };
+
+        struct HttpRequestScheduler::Flight {
+            std::vector<Promise<Connection>> waiters;
+        };
+
+        HttpRequestScheduler::HttpRequestScheduler(const std::string &host) : _host(host), _inFlight(0), _maxConcurrentRequests(0) {
+
+        }
+
+        const std::string& HttpRequestScheduler::getHost() const {
+            return _host;
+        }
+
+        void HttpRequestScheduler::setMaxConcurrentRequests(int32_t limit) {
+            std::lock_guard<std::mutex> guard(_lock);
+            _maxConcurrentRequests = std::max<int32_t>(limit, 0);
+        }
+
+        int32_t HttpRequestScheduler::getMaxConcurrentRequests() {
+            std::lock_guard<std::mutex> guard(_lock);
+            return _maxConcurrentRequests;
+        }
+
+        std::string HttpRequestScheduler::hostOf(const std::string &url) {
+            auto scheme = url.find("://");
+            auto authority = scheme == std::string::npos ? 0 : scheme + 3;
+            return url.substr(0, url.find_first_of("/?#", authority));
+        }
+
+        std::shared_ptr<HttpRequestScheduler> HttpRequestScheduler::forUrl(const std::string &url) {
+            static std::mutex lock;
+            static std::unordered_map<std::string, std::shared_ptr<HttpRequestScheduler>> schedulers;
+            auto host = hostOf(url);
+            std::lock_guard<std::mutex> guard(lock);
+            auto& scheduler = schedulers[host];
+            if (!scheduler) {
+                scheduler = std::make_shared<HttpRequestScheduler>(host);
+            }
+            return scheduler;
+        }
+
+        Future<HttpRequestScheduler::Connection> HttpRequestScheduler::schedule(const std::string &key,
+                                                                                bool idempotent,
+                                                                                const Send &send,
+                                                                                const Options &options,
+                                                                                const std::shared_ptr<api::ExecutionContext> &context) {
+            if (key.empty() || !idempotent || !options.coalesceRequests) {
+                return run(idempotent, send, options, context);
+            }
+            Promise<Connection> promise;
+            std::shared_ptr<Flight> flight;
+            auto leader = false;
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                auto& entry = _flights[key];
+                if (!entry) {
+                    entry = std::make_shared<Flight>();
+                    leader = true;
+                }
+                entry->waiters.push_back(promise);
+                flight = entry;
+            }
+            if (!leader) {
+                count("coalesced");
+                return promise.getFuture();
+            }
+            auto self = shared_from_this();
+            run(idempotent, send, options, context).onComplete(context, [self, key, flight] (const Try<Connection>& result) {
+                std::vector<Promise<Connection>> waiters;
+                {
+                    std::lock_guard<std::mutex> guard(self->_lock);
+                    // Requests arriving from now on are sent again, they may expect a fresher response.
+                    self->_flights.erase(key);
+                    waiters.swap(flight->waiters);
+                }
+                self->deliver(waiters, result);
+            });
+            return promise.getFuture();
+        }
+
+        void HttpRequestScheduler::deliver(std::vector<Promise<Connection>> &waiters, const Try<Connection> &result) {
+            if (waiters.size() == 1 || result.isFailure()) {
+                for (auto& waiter : waiters) {
+                    waiter.complete(result);
+                }
+                return;
+            }
+            // A connection body can only be read once, buffer it for the followers.
+            auto connection = result.getValue();
+            std::shared_ptr<const std::vector<uint8_t>> body;
+            try {
+                body = std::make_shared<const std::vector<uint8_t>>(BufferedHttpUrlConnection::readAll(connection));
+            } catch (const Exception& exception) {
+                for (auto& waiter : waiters) {
+                    waiter.failure(exception);
+                }
+                return;
+            }
+            auto statusCode = connection->getStatusCode();
+            auto statusText = connection->getStatusText();
+            auto headers = connection->getHeaders();
+            for (auto& waiter : waiters) {
+                waiter.success(std::make_shared<BufferedHttpUrlConnection>(statusCode, statusText, headers, body));
+            }
+        }
+
+        Future<HttpRequestScheduler::Connection> HttpRequestScheduler::run(bool idempotent,
+                                                                           const Send &send,
+                                                                           const Options &options,
+                                                                           const std::shared_ptr<api::ExecutionContext> &context) {
+            auto call = std::make_shared<Call>();
+            call->idempotent = idempotent;
+            call->send = send;
+            call->options = options;
+            call->context = context;
+            call->attempt = 0;
+            attempt(call);
+            return call->promise.getFuture();
+        }
+
+        void HttpRequestScheduler::attempt(const std::shared_ptr<Call> &call) {
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                if (_maxConcurrentRequests > 0 && (_inFlight >= _maxConcurrentRequests || !_waiting.empty())) {
+                    _waiting.push_back(call);
+                    return;
+                }
+                _inFlight += 1;
+            }
+            send(call);
+        }
+
+        void HttpRequestScheduler::send(const std::shared_ptr<Call> &call) {
+            auto settled = std::make_shared<std::atomic<bool>>(false);
+            dispatch(call, settled);
+            if (call->idempotent && call->options.hedgeDelayMs > 0 && !settled->load()) {
+                auto self = shared_from_this();
+                call->context->delay(make_runnable([self, call, settled] () {
+                    self->hedge(call, settled);
+                }), call->options.hedgeDelayMs);
+            }
+        }
+
+        void HttpRequestScheduler::hedge(const std::shared_ptr<Call> &call, const std::shared_ptr<std::atomic<bool>> &settled) {
+            // Hedging only uses spare capacity, it never queues behind other requests.
+            if (settled->load() || !tryAcquire()) {
+                return;
+            }
+            count("hedged");
+            dispatch(call, settled);
+        }
+
+        void HttpRequestScheduler::dispatch(const std::shared_ptr<Call> &call, const std::shared_ptr<std::atomic<bool>> &settled) {
+            auto self = shared_from_this();
+            auto start = std::chrono::steady_clock::now();
+            Future<Connection> response = Future<Connection>::failure(Exception(api::ErrorCode::RUNTIME_ERROR, "Request was not sent"));
+            try {
+                response = call->send();
+            } catch (const Exception& exception) {
+                response = Future<Connection>::failure(exception);
+            }
+            response.onComplete(call->context, [self, call, settled, start] (const Try<Connection>& result) {
+                self->release();
+                if (!settled->exchange(true)) {
+                    self->settle(call, result, start);
+                }
+            });
+        }
+
+        void HttpRequestScheduler::settle(const std::shared_ptr<Call> &call,
+                                          const Try<Connection> &result,
+                                          const std::chrono::steady_clock::time_point &start) {
+            record("requests", std::chrono::steady_clock::now() - start);
+            if (call->idempotent && call->attempt < call->options.maxRetries && isRetryable(result)) {
+                call->attempt += 1;
+                count("retries");
+                auto self = shared_from_this();
+                auto delay = backoff(call->attempt, call->options.retryBaseDelayMs, call->options.retryMaxDelayMs);
+                call->context->delay(make_runnable([self, call] () {
+                    self->attempt(call);
+                }), delay);
+                return;
+            }
+            if (result.isFailure()) {
+                count("failures");
+            }
+            call->promise.complete(result);
+        }
+
+        bool HttpRequestScheduler::tryAcquire() {
+            std::lock_guard<std::mutex> guard(_lock);
+            if (_maxConcurrentRequests > 0 && (_inFlight >= _maxConcurrentRequests || !_waiting.empty())) {
+                return false;
+            }
+            _inFlight += 1;
+            return true;
+        }
+
+        void HttpRequestScheduler::release() {
+            std::shared_ptr<Call> next;
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                if (_waiting.empty()) {
+                    _inFlight -= 1;
+                    return;
+                }
+                // The slot is handed over to the oldest waiting request.
+                next = _waiting.front();
+                _waiting.pop_front();
+            }
+            count("queued");
+            auto self = shared_from_this();
+            next->context->execute(make_runnable([self, next] () {
+                self->send(next);
+            }));
+        }
+
+        void HttpRequestScheduler::count(const std::string &counter) {
+            DurationsMap::getInstance().increment(fmt::format("HttpClient/{}/{}", _host, counter), 1);
+        }
+
+        void HttpRequestScheduler::record(const std::string &counter, const std::chrono::steady_clock::duration &duration) {
+            DurationsMap::getInstance().record(
+                    fmt::format("HttpClient/{}/{}", _host, counter),
+                    std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(duration)
+            );
+        }
+    }
+}
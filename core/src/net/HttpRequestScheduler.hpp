@@ -0,0 +1,145 @@
+/*
+ *
+ * HttpRequestScheduler.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_HTTPREQUESTSCHEDULER_HPP
+#define LEDGER_CORE_HTTPREQUESTSCHEDULER_HPP
+
+#include "../api/HttpUrlConnection.hpp"
+#include "../api/ExecutionContext.hpp"
+#include "../async/Future.hpp"
+#include "../async/Promise.hpp"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Middleware between HttpRequest and api::HttpClient, one instance per host (scheme and authority) shared by
+         * every HttpClient of the process.
+         *
+         * - When the host has a concurrency limit (setMaxConcurrentRequests), at most that many requests are sent
+         *   to it at once by all clients together, the others wait in FIFO order.
+         * - Identical idempotent requests in flight are coalesced: the followers wait for the leader response. When
+         *   the response has followers its body is read once and replayed to each of them.
+         * - Idempotent requests failing to reach the host (transport error, 429 or 5xx) are retried with a full
+         *   jitter exponential backoff.
+         * - When hedgeDelayMs is set, an idempotent request still pending after that delay is sent a second time if
+         *   the host has a free slot, the first response wins.
+         *
+         * Coalescing, retries and hedging are opted in per client through Options, everything is off by default.
+         *
+         * Counters are recorded in DurationsMap under "HttpClient/<host>/..." and exposed by api::DurationMetrics.
+         */
+        class HttpRequestScheduler : public std::enable_shared_from_this<HttpRequestScheduler> {
+        public:
+            using Connection = std::shared_ptr<api::HttpUrlConnection>;
+            using Send = std::function<Future<Connection>()>;
+
+            struct Options {
+                /** Retries of an idempotent request, 0 disables retries. */
+                int32_t maxRetries = 0;
+                int64_t retryBaseDelayMs = 250;
+                int64_t retryMaxDelayMs = 4000;
+                /** Delay before hedging an idempotent request, 0 disables hedging. */
+                int64_t hedgeDelayMs = 0;
+                bool coalesceRequests = false;
+            };
+
+            explicit HttpRequestScheduler(const std::string& host);
+
+            /**
+             * Send a request through the middleware.
+             * @param key Identity of the request for coalescing, empty when the request must not be coalesced.
+             * @param idempotent Whether the request may be sent more than once (retries and hedging).
+             * @param send Send the request once to the engine.
+             * @param context Context used for timers and for reading coalesced bodies.
+             */
+            Future<Connection> schedule(const std::string& key,
+                                        bool idempotent,
+                                        const Send& send,
+                                        const Options& options,
+                                        const std::shared_ptr<api::ExecutionContext>& context);
+
+            const std::string& getHost() const;
+
+            /**
+             * Limit the requests in flight to this host, shared by every client of the host. 0 disables the limit.
+             */
+            void setMaxConcurrentRequests(int32_t limit);
+            int32_t getMaxConcurrentRequests();
+
+            /**
+             * Scheduler of the host of the given URL.
+             */
+            static std::shared_ptr<HttpRequestScheduler> forUrl(const std::string& url);
+            static std::string hostOf(const std::string& url);
+
+        private:
+            struct Call;
+            struct Flight;
+
+            Future<Connection> run(bool idempotent,
+                                   const Send& send,
+                                   const Options& options,
+                                   const std::shared_ptr<api::ExecutionContext>& context);
+            void attempt(const std::shared_ptr<Call>& call);
+            void send(const std::shared_ptr<Call>& call);
+            void hedge(const std::shared_ptr<Call>& call, const std::shared_ptr<std::atomic<bool>>& settled);
+            void dispatch(const std::shared_ptr<Call>& call, const std::shared_ptr<std::atomic<bool>>& settled);
+            void settle(const std::shared_ptr<Call>& call,
+                        const Try<Connection>& result,
+                        const std::chrono::steady_clock::time_point& start);
+            void deliver(std::vector<Promise<Connection>>& waiters, const Try<Connection>& result);
+
+            bool tryAcquire();
+            void release();
+            void count(const std::string& counter);
+            void record(const std::string& counter, const std::chrono::steady_clock::duration& duration);
+
+        private:
+            std::string _host;
+            std::mutex _lock;
+            int32_t _inFlight;
+            int32_t _maxConcurrentRequests;
+            std::deque<std::shared_ptr<Call>> _waiting;
+            std::unordered_map<std::string, std::shared_ptr<Flight>> _flights;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_HTTPREQUESTSCHEDULER_HPP
@@ -29,6 +29,7 @@
  *
  */
 #include "HttpUrlConnectionInputStream.hpp"
+#include "BufferedHttpUrlConnection.hpp"
 #include "../utils/Exception.hpp"
 #include "../api/HttpReadBodyResult.hpp"
 
@@ -38,30 +39,15 @@ namespace ledger {
         HttpUrlConnectionInputStream::HttpUrlConnectionInputStream(
                 const std::shared_ptr<api::HttpUrlConnection> &connection) {
             _connection = connection;
-            _index = 0;
+            _cursor = nullptr;
+            _end = nullptr;
             _offset = 0;
-            refill();
-        }
-
-        HttpUrlConnectionInputStream::Ch HttpUrlConnectionInputStream::Peek() {
-            if (_index >= _buffer.size())
-                return '\0';
-            else
-                return (Ch)_buffer[_index];
-        }
-
-        HttpUrlConnectionInputStream::Ch HttpUrlConnectionInputStream::Take() {
-            if (_index >= _buffer.size())
-                return '\0';
-            else {
-                auto c = (Ch) _buffer[_index];
-                _index += 1;
-                return c;
-            }
+            _length = BufferedHttpUrlConnection::getBodyLength(connection->getHeaders());
+            _eof = _length.nonEmpty() && _length.getValue() == 0;
         }
 
         size_t HttpUrlConnectionInputStream::Tell() const {
-            return (size_t)(_index + _offset);
+            return _offset + (_buffer.size() - (size_t)(_end - _cursor));
         }
 
         HttpUrlConnectionInputStream::Ch *HttpUrlConnectionInputStream::PutBegin() {
@@ -82,19 +68,31 @@ namespace ledger {
             return 0;
         }
 
-        void HttpUrlConnectionInputStream::refill() {
-            if (_index >= _buffer.size()) {
-                auto result = _connection->readBody();
-                if (result.error) {
-                    throw Exception(result.error.value().code,
-                                    result.error.value().message,
-                                    std::static_pointer_cast<void>(_connection)
-                    );
-                }
-                _index = 0;
-                _offset += _buffer.size();
-               _buffer = result.data.value();
+        bool HttpUrlConnectionInputStream::refill() {
+            if (_eof) {
+                return false;
+            }
+            auto result = _connection->readBody();
+            if (result.error) {
+                throw Exception(result.error.value().code,
+                                result.error.value().message,
+                                std::static_pointer_cast<void>(_connection)
+                );
+            }
+            _offset += _buffer.size();
+            if (!result.data || result.data->empty()) {
+                // An empty chunk ends the body
+                _eof = true;
+                _buffer.clear();
+                _cursor = _end = nullptr;
+                return false;
             }
+            _buffer = std::move(result.data.value());
+            _cursor = reinterpret_cast<const Ch *>(_buffer.data());
+            _end = _cursor + _buffer.size();
+            // The whole body was received, the next refill ends the stream without calling the engine
+            _eof = _length.nonEmpty() && _offset + _buffer.size() >= _length.getValue();
+            return true;
         }
     }
 }
\ No newline at end of file
@@ -32,17 +32,31 @@
 #define LEDGER_CORE_HTTPURLCONNECTIONINPUTSTREAM_HPP
 
 #include "../api/HttpUrlConnection.hpp"
+#include "../utils/Option.hpp"
 #include <vector>
 #include <memory>
 
 namespace ledger {
  namespace core {
+     /**
+      * rapidjson input stream over the body of a connection. Chunks are pulled from readBody when the current one
+      * is consumed, so that the body is never held entirely in memory. Peek and Take are inlined, the engine is
+      * only called once per chunk. When the body length is known the engine is not asked for the final empty chunk.
+      */
      class HttpUrlConnectionInputStream {
      public:
          typedef char Ch;
          HttpUrlConnectionInputStream(const std::shared_ptr<api::HttpUrlConnection>& connection);
-         Ch Peek();
-         Ch Take();
+         inline Ch Peek() {
+             if (_cursor == _end && !refill())
+                 return '\0';
+             return *_cursor;
+         }
+         inline Ch Take() {
+             if (_cursor == _end && !refill())
+                 return '\0';
+             return *_cursor++;
+         }
          size_t Tell() const;
          Ch* PutBegin();
          void Put(Ch);
@@ -50,13 +64,16 @@ namespace ledger {
          size_t PutEnd(Ch*);
 
      private:
-         inline void refill();
+         bool refill();
 
      private:
          std::shared_ptr<api::HttpUrlConnection> _connection;
          std::vector<uint8_t> _buffer;
-         off_t _index;
-         off_t _offset;
+         const Ch* _cursor;
+         const Ch* _end;
+         size_t _offset;
+         Option<size_t> _length;
+         bool _eof;
      };
  }
 }
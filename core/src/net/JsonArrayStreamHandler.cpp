@@ -0,0 +1,168 @@
+/*
+ *
+ * JsonArrayStreamHandler.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "JsonArrayStreamHandler.hpp"
+#include <cstring>
+
+// Route a scalar event to the current element or to the envelope
+#define ROUTE_VALUE(call)                                    \
+    if (_streaming) {                                        \
+        return _element.call && elementValueDone();          \
+    }                                                        \
+    return _envelope.call;
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            // Events were already pushed to the document, only its root has to be popped.
+            struct NoEvents {
+                bool operator()(rapidjson::Document&) const {
+                    return true;
+                }
+            };
+        }
+
+        JsonArrayStreamHandler::JsonArrayStreamHandler(const std::string &arrayKey,
+                                                       const ElementCallback &onElement,
+                                                       rapidjson::Document &envelope)
+            : _arrayKey(arrayKey), _onElement(onElement), _envelope(envelope),
+              _depth(0), _elementDepth(0), _keyMatches(false), _streaming(false) {
+
+        }
+
+        bool JsonArrayStreamHandler::Null() {
+            ROUTE_VALUE(Null())
+        }
+
+        bool JsonArrayStreamHandler::Bool(bool b) {
+            ROUTE_VALUE(Bool(b))
+        }
+
+        bool JsonArrayStreamHandler::Int(int i) {
+            ROUTE_VALUE(Int(i))
+        }
+
+        bool JsonArrayStreamHandler::Uint(unsigned i) {
+            ROUTE_VALUE(Uint(i))
+        }
+
+        bool JsonArrayStreamHandler::Int64(int64_t i) {
+            ROUTE_VALUE(Int64(i))
+        }
+
+        bool JsonArrayStreamHandler::Uint64(uint64_t i) {
+            ROUTE_VALUE(Uint64(i))
+        }
+
+        bool JsonArrayStreamHandler::Double(double d) {
+            ROUTE_VALUE(Double(d))
+        }
+
+        bool JsonArrayStreamHandler::RawNumber(const Ch *str, rapidjson::SizeType length, bool copy) {
+            ROUTE_VALUE(RawNumber(str, length, copy))
+        }
+
+        bool JsonArrayStreamHandler::String(const Ch *str, rapidjson::SizeType length, bool copy) {
+            ROUTE_VALUE(String(str, length, copy))
+        }
+
+        bool JsonArrayStreamHandler::StartObject() {
+            if (_streaming) {
+                _elementDepth += 1;
+                return _element.StartObject();
+            }
+            _depth += 1;
+            return _envelope.StartObject();
+        }
+
+        bool JsonArrayStreamHandler::Key(const Ch *str, rapidjson::SizeType length, bool copy) {
+            if (_streaming) {
+                return _element.Key(str, length, copy);
+            }
+            if (_depth == 1) {
+                _keyMatches = length == _arrayKey.size() && std::memcmp(str, _arrayKey.data(), length) == 0;
+            }
+            return _envelope.Key(str, length, copy);
+        }
+
+        bool JsonArrayStreamHandler::EndObject(rapidjson::SizeType memberCount) {
+            if (_streaming) {
+                _elementDepth -= 1;
+                return _element.EndObject(memberCount) && elementValueDone();
+            }
+            _depth -= 1;
+            return _envelope.EndObject(memberCount);
+        }
+
+        bool JsonArrayStreamHandler::StartArray() {
+            if (_streaming) {
+                _elementDepth += 1;
+                return _element.StartArray();
+            }
+            _streaming = _depth == 1 && _keyMatches;
+            _depth += 1;
+            return _envelope.StartArray();
+        }
+
+        bool JsonArrayStreamHandler::EndArray(rapidjson::SizeType elementCount) {
+            if (_streaming && _elementDepth == 0) {
+                // End of the streamed array, its elements never reached the envelope
+                _streaming = false;
+                _depth -= 1;
+                return _envelope.EndArray(0);
+            }
+            if (_streaming) {
+                _elementDepth -= 1;
+                return _element.EndArray(elementCount) && elementValueDone();
+            }
+            _depth -= 1;
+            return _envelope.EndArray(elementCount);
+        }
+
+        void JsonArrayStreamHandler::finish() {
+            NoEvents noEvents;
+            _envelope.Populate(noEvents);
+        }
+
+        bool JsonArrayStreamHandler::elementValueDone() {
+            if (_elementDepth > 0) {
+                return true;
+            }
+            NoEvents noEvents;
+            _element.Populate(noEvents);
+            _onElement(_element);
+            // Release the element before reading the next one
+            _element.SetNull();
+            _element.GetAllocator().Clear();
+            return true;
+        }
+    }
+}
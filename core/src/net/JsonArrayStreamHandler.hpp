@@ -0,0 +1,97 @@
+/*
+ *
+ * JsonArrayStreamHandler.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_JSONARRAYSTREAMHANDLER_HPP
+#define LEDGER_CORE_JSONARRAYSTREAMHANDLER_HPP
+
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+#include <functional>
+#include <string>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * rapidjson SAX handler splitting a response on one array member of its root object.
+         *
+         * Each element of that array is built as a standalone DOM, handed to the callback and released before the
+         * next element is read, so that DOM parsers written for a single element can be reused while memory stays
+         * bounded by the largest element instead of the whole response. Every other member is kept in the envelope
+         * document, where the streamed array is left empty.
+         */
+        class JsonArrayStreamHandler {
+        public:
+            using Ch = rapidjson::UTF8<>::Ch;
+            using ElementCallback = std::function<void (const rapidjson::Value&)>;
+
+            JsonArrayStreamHandler(const std::string& arrayKey,
+                                   const ElementCallback& onElement,
+                                   rapidjson::Document& envelope);
+
+            bool Null();
+            bool Bool(bool b);
+            bool Int(int i);
+            bool Uint(unsigned i);
+            bool Int64(int64_t i);
+            bool Uint64(uint64_t i);
+            bool Double(double d);
+            bool RawNumber(const Ch* str, rapidjson::SizeType length, bool copy);
+            bool String(const Ch* str, rapidjson::SizeType length, bool copy);
+            bool StartObject();
+            bool Key(const Ch* str, rapidjson::SizeType length, bool copy);
+            bool EndObject(rapidjson::SizeType memberCount);
+            bool StartArray();
+            bool EndArray(rapidjson::SizeType elementCount);
+
+            /**
+             * Move the parsed envelope into its document, once the reader succeeded.
+             */
+            void finish();
+
+        private:
+            bool elementValueDone();
+
+        private:
+            std::string _arrayKey;
+            ElementCallback _onElement;
+            rapidjson::Document& _envelope;
+            rapidjson::Document _element;
+            // Containers open in the envelope
+            int _depth;
+            // Containers open in the current element, only meaningful while streaming
+            int _elementDepth;
+            bool _keyMatches;
+            bool _streaming;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_JSONARRAYSTREAMHANDLER_HPP
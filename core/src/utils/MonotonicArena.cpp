@@ -0,0 +1,83 @@
+/*
+ *
+ * MonotonicArena.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "MonotonicArena.hpp"
+#include <metrics/DurationsMap.hpp>
+
+namespace ledger {
+    namespace core {
+
+        MonotonicArena::MonotonicArena(size_t blockSize)
+            : _blockSize(blockSize), _cursor(nullptr), _end(nullptr), _allocations(0), _allocatedBytes(0) {
+        }
+
+        MonotonicArena::~MonotonicArena() {
+            release();
+        }
+
+        static uint8_t* align(uint8_t* address, size_t alignment) {
+            auto value = reinterpret_cast<uintptr_t>(address);
+            return reinterpret_cast<uint8_t*>((value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+        }
+
+        void* MonotonicArena::allocate(size_t size, size_t alignment) {
+            _allocations += 1;
+            _allocatedBytes += size;
+            if (size + alignment > _blockSize) {
+                // Oversized requests get a block of their own, the current block stays in use for the next ones
+                _blocks.emplace_back(new uint8_t[size + alignment]);
+                return align(_blocks.back().get(), alignment);
+            }
+            auto result = align(_cursor, alignment);
+            if (_cursor == nullptr || result + size > _end) {
+                _blocks.emplace_back(new uint8_t[_blockSize]);
+                _cursor = _blocks.back().get();
+                _end = _cursor + _blockSize;
+                result = align(_cursor, alignment);
+            }
+            _cursor = result + size;
+            return result;
+        }
+
+        void MonotonicArena::release() {
+            if (_allocations > 0) {
+                auto& metrics = DurationsMap::getInstance();
+                metrics.increment("MonotonicArena/allocations", static_cast<int32_t>(_allocations));
+                metrics.increment("MonotonicArena/blocks", static_cast<int32_t>(_blocks.size()));
+            }
+            _blocks.clear();
+            _cursor = nullptr;
+            _end = nullptr;
+            _allocations = 0;
+            _allocatedBytes = 0;
+        }
+    }
+}
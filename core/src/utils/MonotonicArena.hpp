@@ -0,0 +1,131 @@
+/*
+ *
+ * MonotonicArena.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_MONOTONICARENA_HPP
+#define LEDGER_CORE_MONOTONICARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Bump allocator handing out memory from large blocks which are only given back all at once, by release()
+         * or on destruction. Deallocating a single object is a no-op, so it suits batches of objects having the
+         * same lifetime such as the transactions of an explorer page. Not thread safe: allocations must be
+         * serialized by the owner.
+         *
+         * On release the number of allocations served and of heap blocks used are added to the
+         * "MonotonicArena/allocations" and "MonotonicArena/blocks" counters of DurationsMap.
+         */
+        class MonotonicArena {
+        public:
+            static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+            explicit MonotonicArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+            MonotonicArena(const MonotonicArena&) = delete;
+            MonotonicArena& operator=(const MonotonicArena&) = delete;
+            ~MonotonicArena();
+
+            void* allocate(size_t size, size_t alignment);
+            void release();
+
+            size_t getAllocations() const { return _allocations; };
+            size_t getBlocks() const { return _blocks.size(); };
+            size_t getAllocatedBytes() const { return _allocatedBytes; };
+
+        private:
+            size_t _blockSize;
+            std::vector<std::unique_ptr<uint8_t[]>> _blocks;
+            uint8_t* _cursor;
+            uint8_t* _end;
+            size_t _allocations;
+            size_t _allocatedBytes;
+        };
+
+        /**
+         * Standard allocator drawing from a MonotonicArena, or from the heap when built without arena.
+         * Copying a container yields a heap backed container, and assignments keep the storage of the
+         * destination, so that memory owned by an arena never leaks in objects outliving it. Moves keep the arena.
+         */
+        template <typename T>
+        class ArenaAllocator {
+        public:
+            typedef T value_type;
+            typedef std::false_type propagate_on_container_copy_assignment;
+            typedef std::false_type propagate_on_container_move_assignment;
+            typedef std::false_type propagate_on_container_swap;
+
+            ArenaAllocator() noexcept : _arena(nullptr) {};
+            explicit ArenaAllocator(MonotonicArena* arena) noexcept : _arena(arena) {};
+            template <typename U>
+            ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.getArena()) {};
+
+            T* allocate(size_t n) {
+                if (_arena != nullptr) {
+                    return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+                }
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            };
+
+            void deallocate(T* p, size_t) noexcept {
+                if (_arena == nullptr) {
+                    ::operator delete(p);
+                }
+            };
+
+            ArenaAllocator<T> select_on_container_copy_construction() const {
+                return ArenaAllocator<T>();
+            };
+
+            MonotonicArena* getArena() const { return _arena; };
+
+        private:
+            MonotonicArena* _arena;
+        };
+
+        template <typename T, typename U>
+        bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+            return a.getArena() == b.getArena();
+        }
+
+        template <typename T, typename U>
+        bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+            return !(a == b);
+        }
+    }
+}
+
+#endif //LEDGER_CORE_MONOTONICARENA_HPP
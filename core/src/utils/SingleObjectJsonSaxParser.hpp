@@ -33,6 +33,7 @@
 
 #include <rapidjson/reader.h>
 #include "ArrayJsonSaxParser.hpp"
+#include <wallet/common/explorers/api/LedgerApiKey.hpp>
 
 namespace ledger {
     namespace  core {
@@ -45,7 +46,7 @@ namespace ledger {
         class SingleObjectJsonSaxParser {
         public:
             typedef typename Parser::Result Result;
-            SingleObjectJsonSaxParser(std::string& lastKey) : _lastKey(lastKey) {};
+            SingleObjectJsonSaxParser(LedgerApiKey& lastKey) : _lastKey(lastKey) {};
             bool Null();
             bool Bool(bool b);
             bool Int(int i);
@@ -63,14 +64,14 @@ namespace ledger {
             void init(Result *result);
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
         };
 
         template<class Parser, class R/*Result*/>
         class SingleObjectJsonSaxParser <Parser, std::vector<R>> {
         public:
             typedef typename ArrayJsonSaxParser<Parser>::Result  Result;
-            SingleObjectJsonSaxParser(std::string& lastKey) : _lastKey(lastKey) {};
+            SingleObjectJsonSaxParser(LedgerApiKey& lastKey) : _lastKey(lastKey) {};
             bool Null();
             bool Bool(bool b);
             bool Int(int i);
@@ -88,7 +89,7 @@ namespace ledger {
             void init(std::vector<Result> *result);
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
         };
     }
 }
@@ -51,6 +51,9 @@ namespace algorand {
         const std::string purestakeTransactionEndpoint = "/idx2/v2/transactions?txid={}";
         const std::string purestakeAssetEndpoint = "/idx2/v2/assets/{}";
 
+        // Asset parameters only change on reconfiguration (manager, reserve, freeze and clawback addresses)
+        const auto assetCacheTtl = std::chrono::minutes(10);
+
         // Query parameters
         const std::string limitQueryParam = "{}?limit={}";
         const std::string minRoundQueryParam = "{}&min-round={}";
@@ -81,6 +84,7 @@ namespace algorand {
     Future<api::Block> BlockchainExplorer::getBlock(uint64_t blockHeight) const
     {
         return _http->GET(fmt::format(constants::purestakeBlockEndpoint, blockHeight))
+            .cache(HttpCachePolicy::immutable())
             .json(false)
             .map<api::Block>(getContext(), [](const HttpRequest::JsonResult& response) {
                 const auto& json = std::get<1>(response)->GetObject();
@@ -123,6 +127,7 @@ namespace algorand {
     Future<model::AssetParams> BlockchainExplorer::getAssetById(uint64_t id) const
     {
         return _http->GET(fmt::format(constants::purestakeAssetEndpoint, id))
+            .cache(HttpCachePolicy::ttl(constants::assetCacheTtl))
             .json(false)
             .map<model::AssetParams>(
                     getContext(),
@@ -175,16 +180,20 @@ namespace algorand {
             url = fmt::format(constants::maxRoundQueryParam, url, *lastRound);
         }
 
+        // Transactions are parsed one at a time while the page is read, the page is never held as a whole DOM.
+        auto parsed = std::make_shared<std::vector<model::Transaction>>();
         return _http->GET(url)
-            .json(false)
-            .map<model::TransactionsBulk>(getContext(), [](const HttpRequest::JsonResult& response) {
+            .streamJsonArray(constants::xTransactions, [parsed](const rapidjson::Value& node) {
+                    parsed->emplace_back();
+                    JsonParser::parseTransaction(node.GetObject(), parsed->back());
+            })
+            .map<model::TransactionsBulk>(getContext(), [parsed](const HttpRequest::JsonResult& response) {
                     const auto& json = std::get<1>(response)->GetObject();
                     if (!json.HasMember(constants::xTransactions.c_str())) {
                         throw make_exception(api::ErrorCode::NO_SUCH_ELEMENT, fmt::format("Missing '{}' field in JSON.", constants::xTransactions));
                     }
-                    const auto& jsonArray = json[constants::xTransactions.c_str()].GetArray();
                     auto txs = model::TransactionsBulk();
-                    JsonParser::parseTransactions(jsonArray, txs.transactions);
+                    txs.transactions = std::move(*parsed);
 
                     // Manage limit
                     txs.hasNext = txs.transactions.size() >= constants::EXPLORER_QUERY_LIMIT;
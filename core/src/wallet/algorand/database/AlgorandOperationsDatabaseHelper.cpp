@@ -555,8 +555,6 @@ namespace ledger {
                 PreparedStatement<AssetTransferTransactionBinding> assetTransferTransactionStmt;
                 PreparedStatement<AssetFreezeTransactionBinding> assetFreezeTransactionStmt;
 
-                BulkInsertDatabaseHelper::UPSERT_OPERATION(sql, operationStmt);
-                BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, blockStmt);
                 UPSERT_ALGORAND_OPERATION(sql, algorandOpStmt);     
                 
                 for (const auto& op : operations) {
@@ -603,10 +601,10 @@ namespace ledger {
                 }
                 //1- block
                 if (!blockStmt.bindings.uid.empty())
-                    blockStmt.execute();
+                    BulkInsertDatabaseHelper::upsertBlocks(sql, blockStmt);
 
                 //2- operations 
-                operationStmt.execute();
+                BulkInsertDatabaseHelper::upsertOperations(sql, operationStmt);
 
                 //3- algorand transactions 
                 if (!paymentTransactionStmt.bindings.empty())
@@ -42,6 +42,7 @@
 #include <wallet/bitcoin/database/BitcoinLikeUTXODatabaseHelper.h>
 #include <wallet/bitcoin/database/BitcoinLikeBlockDatabaseHelper.h>
 #include <wallet/common/database/OperationDatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <wallet/bitcoin/api_impl/BitcoinLikeOutputApi.h>
 #include <api/BitcoinLikeOutputListCallback.hpp>
 #include <api/BitcoinLikeInput.hpp>
@@ -92,7 +93,8 @@ namespace ledger {
                                              const BitcoinLikeBlockchainExplorerTransaction &tx) {
             out.accountUid = getAccountUid();
             out.block = tx.block;
-            out.bitcoinTransaction = Option<BitcoinLikeBlockchainExplorerTransaction>(tx);
+            // Operations derived from a page of the explorer share the arena of its transactions
+            out.bitcoinTransaction = Option<BitcoinLikeBlockchainExplorerTransaction>(BitcoinLikeBlockchainExplorerTransaction(tx, tx.getArena()));
             // Set accountUid of bitcoin outputs
             for (auto &output : out.bitcoinTransaction.getValue().outputs) {
                 if (output.address.hasValue() && getKeychain()->contains(output.address.getValue())) {
@@ -240,14 +242,41 @@ namespace ledger {
             return Try<int>::from([&] () {
                 soci::session sql(getWallet()->getDatabase()->getPool());
                 soci::transaction tr(sql);
-                BitcoinLikeOperationDatabaseHelper::bulkInsert(sql, ops);
-                tr.commit();
+                // Addresses must be stored before the outputs and operations that reference them, in the same
+                // transaction so that they are only dropped from the pending list when the page is committed
+                auto addresses = _keychain->putPendingAddresses(sql);
+                try {
+                    BitcoinLikeOperationDatabaseHelper::bulkInsert(sql, ops);
+                    tr.commit();
+                } catch (...) {
+                    _keychain->restorePendingAddresses(addresses);
+                    throw;
+                }
                 // Emit
                 emitNewOperationsEvent(ops);
                 return ops.size();
             });
         }
 
+        Future<int> BitcoinLikeAccount::enqueueBulkInsert(const std::vector<Operation> &operations) {
+            auto self = getSelf();
+            auto keychain = _keychain;
+            auto addresses = std::make_shared<std::vector<BitcoinLikeKeychainAddress>>();
+            return getWallet()->getDatabase()->getWriteQueue()->submit([keychain, addresses, operations] (soci::session& sql) {
+                // Addresses must be stored before the outputs and operations that reference them, in the same job
+                // so that the whole page is committed or rolled back at once
+                *addresses = keychain->putPendingAddresses(sql);
+                BitcoinLikeOperationDatabaseHelper::bulkInsert(sql, operations);
+            }).recoverWith(ImmediateExecutionContext::INSTANCE, [keychain, addresses] (const Exception& ex) {
+                // The page was not committed, its addresses are written with the next one
+                keychain->restorePendingAddresses(*addresses);
+                return Future<Unit>::failure(ex);
+            }).map<int>(getContext(), [self, operations] (const Unit&) {
+                self->emitNewOperationsEvent(operations);
+                return static_cast<int>(operations.size());
+            });
+        }
+
         void BitcoinLikeAccount::computeOperationTrust(Operation &operation,
                                                   const BitcoinLikeBlockchainExplorerTransaction &tx) {
             if (tx.block.nonEmpty()) {
@@ -347,12 +376,9 @@ namespace ledger {
         BitcoinLikeAccount::getUTXO(int32_t from, int32_t to) {
             auto self = getSelf();
             return async<std::vector<std::shared_ptr<api::BitcoinLikeOutput>>>([=] () -> std::vector<std::shared_ptr<api::BitcoinLikeOutput>> {
-                auto keychain = self->getKeychain();
                 soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
                 std::vector<BitcoinLikeBlockchainExplorerOutput> utxo;
-                BitcoinLikeUTXODatabaseHelper::queryUTXO(sql, self->getAccountUid(), from, to - from, utxo, [&keychain] (const std::string& addr) {
-                    return keychain->contains(addr);
-                });
+                BitcoinLikeUTXODatabaseHelper::queryUTXO(sql, self->getAccountUid(), from, to - from, utxo);
                 auto currency = self->getWallet()->getCurrency();
                 return functional::map<BitcoinLikeBlockchainExplorerOutput, std::shared_ptr<api::BitcoinLikeOutput>>(utxo, [&currency] (const BitcoinLikeBlockchainExplorerOutput& output) -> std::shared_ptr<api::BitcoinLikeOutput> {
                     return std::make_shared<BitcoinLikeOutputApi>(output, currency);
@@ -382,11 +408,8 @@ namespace ledger {
         Future<int32_t> BitcoinLikeAccount::getUTXOCount() {
             auto self = getSelf();
             return async<int32_t>([=] () -> int32_t {
-                auto keychain = self->getKeychain();
                 soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
-                return (int32_t) BitcoinLikeUTXODatabaseHelper::UTXOcount(sql, self->getAccountUid(), [keychain] (const std::string& addr) -> bool {
-                    return keychain->contains(addr);
-                });
+                return (int32_t) BitcoinLikeUTXODatabaseHelper::UTXOcount(sql, self->getAccountUid());
             });
         }
 
@@ -435,14 +458,10 @@ namespace ledger {
             auto self = std::dynamic_pointer_cast<BitcoinLikeAccount>(shared_from_this());
             return FuturePtr<Amount>::async(getWallet()->getPool()->getThreadPoolExecutionContext(), [=] () -> std::shared_ptr<Amount> {
                 const auto& uid = self->getAccountUid();
-                soci::session sql(self->getWallet()->getDatabase()->getPool());
+                soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
                 std::vector<BitcoinLikeBlockchainExplorerOutput> utxos;
                 BigInt sum(0);
-                auto keychain = self->getKeychain();
-                std::function<bool (const std::string&)> filter = [&keychain] (const std::string addr) -> bool {
-                    return keychain->contains(addr);
-                };
-                BitcoinLikeUTXODatabaseHelper::queryUTXO(sql, uid, 0, std::numeric_limits<int32_t>::max(), utxos, filter);
+                BitcoinLikeUTXODatabaseHelper::queryUTXO(sql, uid, 0, std::numeric_limits<int32_t>::max(), utxos);
                 switch (strategy) {
                     case api::BitcoinLikePickingStrategy::DEEP_OUTPUTS_FIRST:
                     case api::BitcoinLikePickingStrategy::MERGE_OUTPUTS:
@@ -484,13 +503,11 @@ namespace ledger {
             return FuturePtr<Amount>::async(getWallet()->getPool()->getThreadPoolExecutionContext(), [=] () -> std::shared_ptr<Amount> {
                 const auto& uid = self->getAccountUid();
                 soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
+                // The UTXO set is the authority on the balance, checkpoints sum operations and would drift from it
+                // when an input spends an output of a transaction the account never received
                 std::vector<BitcoinLikeBlockchainExplorerOutput> utxos;
                 BigInt sum(0);
-                auto keychain = self->getKeychain();
-                std::function<bool (const std::string&)> filter = [&keychain] (const std::string addr) -> bool {
-                    return keychain->contains(addr);
-                };
-                BitcoinLikeUTXODatabaseHelper::queryUTXO(sql, uid, 0, std::numeric_limits<int32_t>::max(), utxos, filter);
+                BitcoinLikeUTXODatabaseHelper::queryUTXO(sql, uid, 0, std::numeric_limits<int32_t>::max(), utxos);
                 for (const auto& utxo : utxos) {
                     sum = sum + utxo.value;
                 }
@@ -516,22 +533,32 @@ namespace ledger {
 
                 const auto &uid = self->getAccountUid();
                 soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
-                std::vector<Operation> operations;
+                std::vector<std::shared_ptr<api::Amount>> amounts;
 
-                auto keychain = self->getKeychain();
-                std::function<bool(const std::string &)> filter = [&keychain](const std::string addr) -> bool {
-                    return keychain->contains(addr);
-                };
+                auto checkpoints = BalanceCheckpointDatabaseHelper::getBalanceHistory(sql, uid, startDate, endDate, precision);
+                if (checkpoints.nonEmpty()) {
+                    for (const auto& value : checkpoints.getValue()) {
+                        amounts.emplace_back(std::make_shared<ledger::core::Amount>(self->getWallet()->getCurrency(), 0, value));
+                    }
+                    return amounts;
+                }
 
-                //Get operations related to an account
-                OperationDatabaseHelper::queryOperations(sql, uid, operations, filter);
+                std::vector<Operation> operations;
+                BigInt sum;
+
+                // Operations up to the start date all land in the first period, let the database sum them
+                auto openingBalance = BitcoinLikeOperationDatabaseHelper::sumBalance(sql, uid, startDate);
+                if (openingBalance.nonEmpty()) {
+                    sum = openingBalance.getValue();
+                    BitcoinLikeOperationDatabaseHelper::queryOperations(sql, uid, operations, Option<std::chrono::system_clock::time_point>(startDate));
+                } else {
+                    BitcoinLikeOperationDatabaseHelper::queryOperations(sql, uid, operations);
+                }
 
                 auto lowerDate = startDate;
                 auto upperDate = DateUtils::incrementDate(startDate, precision);
 
-                std::vector<std::shared_ptr<api::Amount>> amounts;
                 std::size_t operationsCount = 0;
-                BigInt sum;
                 while (lowerDate <= endDate && operationsCount < operations.size()) {
 
                     auto operation = operations[operationsCount];
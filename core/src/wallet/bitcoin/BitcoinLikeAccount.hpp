@@ -76,6 +76,13 @@ namespace ledger {
 
             Try<int> bulkInsert(const std::vector<Operation>& out);
 
+            /**
+             * Insert operations through the database write queue, in a transaction shared with the inserts
+             * of other accounts.
+             * @return The number of operations, once the shared transaction is committed.
+             */
+            Future<int> enqueueBulkInsert(const std::vector<Operation>& operations);
+
             /**
              *
              * @param block
@@ -151,6 +151,7 @@ namespace ledger {
                 AccountDatabaseHelper::createAccount(sql, self->getWalletUid(), index);
                 BitcoinLikeAccountDatabaseHelper::createAccount(sql, self->getWalletUid(), index, keychain->getRestoreKey());
                 tr.commit();
+                keychain->attachDatabase(sql, accountUid);
                 auto account = std::static_pointer_cast<api::Account>(std::make_shared<BitcoinLikeAccount>(
                         self->shared_from_this(),
                         index,
@@ -158,6 +159,7 @@ namespace ledger {
                         self->_synchronizerFactory(),
                         keychain
                 ));
+                keychain->persistAddresses(sql);
                 self->addAccountInstanceToInstanceCache(std::dynamic_pointer_cast<AbstractAccount>(account));
                 return account;
             });
@@ -218,11 +220,14 @@ namespace ledger {
             auto xpubPath = scheme.getSchemeTo(DerivationSchemeLevel::ACCOUNT_INDEX).getPath();
             auto keychain = _keychainFactory->restore(entry.index, xpubPath, getConfig(), entry.xpub,
             getAccountInternalPreferences(entry.index), getCurrency());
-            return std::make_shared<BitcoinLikeAccount>(shared_from_this(),
-                                                        entry.index,
-                                                        _explorer,
-                                                        _synchronizerFactory(),
-                                                        keychain);
+            keychain->attachDatabase(sql, accountUid);
+            auto account = std::make_shared<BitcoinLikeAccount>(shared_from_this(),
+                                                                entry.index,
+                                                                _explorer,
+                                                                _synchronizerFactory(),
+                                                                keychain);
+            keychain->persistAddresses(sql);
+            return account;
         }
 
         std::shared_ptr<BitcoinLikeBlockchainExplorer> BitcoinLikeWallet::getBlockchainExplorer() {
@@ -0,0 +1,99 @@
+/*
+ *
+ * BitcoinLikeKeychainDatabaseHelper.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "BitcoinLikeKeychainDatabaseHelper.h"
+#include <database/soci-number.h>
+#include <database/soci-option.h>
+#include <utils/hex.h>
+
+using namespace soci;
+
+namespace ledger {
+    namespace core {
+
+        const StatementDeclaration<KeychainAddressBinding> BitcoinLikeKeychainDatabaseHelper::UPSERT_ADDRESS =
+                db::stmt<KeychainAddressBinding>(
+                        "INSERT INTO keychain_addresses VALUES(:account_uid, :purpose, :idx, :address, :pubkey)"
+                        " ON CONFLICT DO NOTHING",
+                        [] (auto& s, auto& b) {
+                            s, use(b.accountUid), use(b.purpose), use(b.index), use(b.address),
+                                    use(b.publicKey);
+                        });
+
+        void KeychainAddressBinding::update(const std::string &uid, const BitcoinLikeKeychainAddress &a) {
+            accountUid.push_back(uid);
+            purpose.push_back(a.purpose);
+            index.push_back(static_cast<int32_t>(a.index));
+            address.push_back(a.address);
+            publicKey.push_back(a.publicKey.empty() ? Option<std::string>() : Option<std::string>(hex::toString(a.publicKey)));
+        }
+
+        void KeychainAddressBinding::clear() {
+            accountUid.clear();
+            purpose.clear();
+            index.clear();
+            address.clear();
+            publicKey.clear();
+        }
+
+        void BitcoinLikeKeychainDatabaseHelper::putAddresses(soci::session &sql,
+                                                             const std::string &accountUid,
+                                                             const std::vector<BitcoinLikeKeychainAddress> &addresses) {
+            if (addresses.empty()) {
+                return;
+            }
+            PreparedStatement<KeychainAddressBinding> stmt;
+            UPSERT_ADDRESS(sql, stmt);
+            for (const auto& address : addresses) {
+                stmt.bindings.update(accountUid, address);
+            }
+            stmt.execute();
+        }
+
+        std::vector<BitcoinLikeKeychainAddress>
+        BitcoinLikeKeychainDatabaseHelper::getAddresses(soci::session &sql, const std::string &accountUid) {
+            rowset<row> rows = (sql.prepare << "SELECT purpose, idx, address, pubkey FROM keychain_addresses "
+                                               "WHERE account_uid = :uid", use(accountUid));
+            std::vector<BitcoinLikeKeychainAddress> addresses;
+            for (auto& row : rows) {
+                BitcoinLikeKeychainAddress address;
+                address.purpose = get_number<int32_t>(row, 0);
+                address.index = get_number<uint32_t>(row, 1);
+                address.address = row.get<std::string>(2);
+                if (row.get_indicator(3) != i_null) {
+                    address.publicKey = hex::toByteArray(row.get<std::string>(3));
+                }
+                addresses.push_back(std::move(address));
+            }
+            return addresses;
+        }
+    }
+}
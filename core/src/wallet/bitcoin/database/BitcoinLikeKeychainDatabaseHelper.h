@@ -0,0 +1,74 @@
+/*
+ *
+ * BitcoinLikeKeychainDatabaseHelper.h
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_BITCOINLIKEKEYCHAINDATABASEHELPER_H
+#define LEDGER_CORE_BITCOINLIKEKEYCHAINDATABASEHELPER_H
+
+#include <soci.h>
+#include <database/PreparedStatement.hpp>
+#include <string>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        struct BitcoinLikeKeychainAddress {
+            int purpose;
+            uint32_t index;
+            std::string address;
+            // Compressed public key, empty when it was not computed at derivation time
+            std::vector<uint8_t> publicKey;
+        };
+
+        struct KeychainAddressBinding {
+            std::vector<std::string> accountUid;
+            std::vector<int32_t> purpose;
+            std::vector<int32_t> index;
+            std::vector<std::string> address;
+            std::vector<Option<std::string>> publicKey;
+
+            void update(const std::string& accountUid, const BitcoinLikeKeychainAddress& address);
+            void clear();
+        };
+
+        class BitcoinLikeKeychainDatabaseHelper {
+        public:
+            static const StatementDeclaration<KeychainAddressBinding> UPSERT_ADDRESS;
+
+            static void putAddresses(soci::session& sql,
+                                     const std::string& accountUid,
+                                     const std::vector<BitcoinLikeKeychainAddress>& addresses);
+            static std::vector<BitcoinLikeKeychainAddress> getAddresses(soci::session& sql,
+                                                                        const std::string& accountUid);
+        };
+    }
+}
+
+#endif //LEDGER_CORE_BITCOINLIKEKEYCHAINDATABASEHELPER_H
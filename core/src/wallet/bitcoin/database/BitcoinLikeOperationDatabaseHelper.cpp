@@ -40,11 +40,17 @@
 #include <database/soci-backend-utils.h>
 #include <debug/Benchmarker.h>
 #include <wallet/common/database/BulkInsertDatabaseHelper.hpp>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
+#include <api/enum_from_string.hpp>
+#include <utils/DateUtils.hpp>
+#include <wallet/common/database/AmountLimbs.hpp>
 
 using namespace soci;
 
 namespace {
     using namespace ledger::core;
+    using Column = PostgreSQLBulkUpsert::Column;
+    using ColumnType = PostgreSQLBulkUpsert::ColumnType;
 
     // Bitcoin operations
     struct BitcoinOperationBinding {
@@ -65,6 +71,11 @@ namespace {
             txHash.clear();
         }
 
+        void stage(PostgreSQLBulkUpsert& upsert) const {
+            for (size_t i = 0; i < uid.size(); i++) {
+                upsert.row().text(uid[i]).text(txUid[i]).text(txHash[i]);
+            }
+        }
     };
 
     const auto UPSERT_BITCOIN_OPERATION = db::stmt<BitcoinOperationBinding>(
@@ -74,6 +85,11 @@ namespace {
                 s, use(b.uid), use(b.txUid), use(b.txHash);
             });
 
+    const PostgreSQLBulkUpsert COPY_BITCOIN_OPERATION("bitcoin_operations", {
+        Column{"uid", ColumnType::TEXT}, Column{"transaction_uid", ColumnType::TEXT},
+        Column{"transaction_hash", ColumnType::TEXT}
+    });
+
     // Transaction
     struct TransactionBinding {
         std::vector<std::string> uid;
@@ -102,6 +118,13 @@ namespace {
             lockTime.clear();
             blockUid.clear();
         }
+
+        void stage(PostgreSQLBulkUpsert& upsert) const {
+            for (size_t i = 0; i < uid.size(); i++) {
+                upsert.row().text(uid[i]).text(hash[i]).bigint(version[i]).text(blockUid[i])
+                        .text(date[i]).bigint(static_cast<int64_t>(lockTime[i]));
+            }
+        }
     };
 
     const auto UPSERT_TRANSACTION = db::stmt<TransactionBinding>(
@@ -114,6 +137,12 @@ namespace {
                 use(b.lockTime, "locktime");
             });
 
+    const PostgreSQLBulkUpsert COPY_TRANSACTION("bitcoin_transactions", {
+        Column{"transaction_uid", ColumnType::TEXT}, Column{"hash", ColumnType::TEXT},
+        Column{"version", ColumnType::BIGINT}, Column{"block_uid", ColumnType::TEXT},
+        Column{"time", ColumnType::TEXT}, Column{"locktime", ColumnType::BIGINT}
+    }, {"transaction_uid"}, {"block_uid"});
+
     // Input
     struct InputBinding {
         std::vector<BitcoinLikeBlockchainExplorerInput> input;
@@ -153,6 +182,14 @@ namespace {
             coinbase.clear();
             sequence.clear();
         }
+
+        void stage(PostgreSQLBulkUpsert& upsert) const {
+            for (size_t i = 0; i < uid.size(); i++) {
+                upsert.row().text(uid[i]).bigint(previousTxOutputIndex[i]).text(previousTxHash[i])
+                        .text(prevBtcTxUid[i]).bigint(amount[i]).text(address[i]).text(coinbase[i])
+                        .bigint(sequence[i]);
+            }
+        }
     };
 
     const auto UPSERT_INPUT = db::stmt<InputBinding>(
@@ -163,6 +200,13 @@ namespace {
                 use(b.sequence);
             });
 
+    const PostgreSQLBulkUpsert COPY_INPUT("bitcoin_inputs", {
+        Column{"uid", ColumnType::TEXT}, Column{"previous_output_idx", ColumnType::BIGINT},
+        Column{"previous_tx_hash", ColumnType::TEXT}, Column{"previous_tx_uid", ColumnType::TEXT},
+        Column{"amount", ColumnType::BIGINT}, Column{"address", ColumnType::TEXT},
+        Column{"coinbase", ColumnType::TEXT}, Column{"sequence", ColumnType::BIGINT}
+    });
+
     // Transaction inputs
     struct TransactionInputBinding {
         std::vector<std::string> txUid;
@@ -185,6 +229,11 @@ namespace {
             inputIdx.clear();
         }
 
+        void stage(PostgreSQLBulkUpsert& upsert) const {
+            for (size_t i = 0; i < txUid.size(); i++) {
+                upsert.row().text(txUid[i]).text(txHash[i]).text(inputUid[i]).bigint(inputIdx[i]);
+            }
+        }
     };
 
     const auto UPSERT_TRANSACTION_INPUT = db::stmt<TransactionInputBinding>(
@@ -194,6 +243,11 @@ namespace {
                 s, use(b.txUid), use(b.txHash), use(b.inputUid), use(b.inputIdx);
             });
 
+    const PostgreSQLBulkUpsert COPY_TRANSACTION_INPUT("bitcoin_transaction_inputs", {
+        Column{"transaction_uid", ColumnType::TEXT}, Column{"transaction_hash", ColumnType::TEXT},
+        Column{"input_uid", ColumnType::TEXT}, Column{"input_idx", ColumnType::BIGINT}
+    });
+
     // Output
     struct OutputBinding {
         std::vector<uint64_t> amount;
@@ -232,6 +286,14 @@ namespace {
             accountUid.clear();
             address.clear();
         }
+
+        void stage(PostgreSQLBulkUpsert& upsert) const {
+            for (size_t i = 0; i < txUid.size(); i++) {
+                upsert.row().bigint(index[i]).text(txUid[i]).text(txHash[i])
+                        .bigint(static_cast<int64_t>(amount[i])).text(script[i]).text(address[i])
+                        .text(accountUid[i]).bigint(blockHeight[i]).bigint(replaceable[i]);
+            }
+        }
     };
 
     const auto UPSERT_OUTPUT = db::stmt<OutputBinding>(
@@ -242,6 +304,62 @@ namespace {
                 use(b.script), use(b.address), use(b.accountUid),
                 use(b.blockHeight), use(b.replaceable);
             });
+
+    const PostgreSQLBulkUpsert COPY_OUTPUT("bitcoin_outputs", {
+        Column{"idx", ColumnType::BIGINT}, Column{"transaction_uid", ColumnType::TEXT},
+        Column{"transaction_hash", ColumnType::TEXT}, Column{"amount", ColumnType::BIGINT},
+        Column{"script", ColumnType::TEXT}, Column{"address", ColumnType::TEXT},
+        Column{"account_uid", ColumnType::TEXT}, Column{"block_height", ColumnType::BIGINT},
+        Column{"replaceable", ColumnType::BIGINT}
+    });
+
+    // UTXO set
+    struct UTXOBinding {
+        std::vector<std::string> accountUid;
+        std::vector<std::string> txUid;
+        std::vector<int> index;
+
+        void update(const std::string& account, const std::string& tUid, int idx) {
+            accountUid.push_back(account);
+            txUid.push_back(tUid);
+            index.push_back(idx);
+        }
+
+        void clear() {
+            accountUid.clear();
+            txUid.clear();
+            index.clear();
+        }
+    };
+
+    // Outputs may be inserted after the input spending them
+    const auto INSERT_UTXO = db::stmt<UTXOBinding>(
+            "INSERT INTO bitcoin_utxos SELECT :account_uid, :tx_uid, CAST(:idx AS INTEGER) WHERE NOT EXISTS ("
+            "SELECT 1 FROM bitcoin_inputs WHERE previous_tx_uid = :tx_uid AND previous_output_idx = :idx"
+            ") ON CONFLICT DO NOTHING", [] (auto& s, auto& b) {
+                s, use(b.accountUid, "account_uid"), use(b.txUid, "tx_uid"), use(b.index, "idx");
+            });
+
+    struct SpentOutputBinding {
+        std::vector<std::string> txUid;
+        std::vector<int> index;
+
+        void update(const std::string& tUid, int idx) {
+            txUid.push_back(tUid);
+            index.push_back(idx);
+        }
+
+        void clear() {
+            txUid.clear();
+            index.clear();
+        }
+    };
+
+    const auto DELETE_SPENT_UTXO = db::stmt<SpentOutputBinding>(
+            "DELETE FROM bitcoin_utxos WHERE transaction_uid = :tx_uid AND idx = :idx",
+            [] (auto& s, auto& b) {
+                s, use(b.txUid), use(b.index);
+            });
 }
 
 namespace ledger {
@@ -260,14 +378,12 @@ namespace ledger {
             PreparedStatement<TransactionBinding> transactionStmt;
             PreparedStatement<InputBinding> inputStmt;
             PreparedStatement<OutputBinding> outputStmt;
+            PreparedStatement<UTXOBinding> utxoStmt;
+            PreparedStatement<SpentOutputBinding> spentOutputStmt;
 
-            BulkInsertDatabaseHelper::UPSERT_OPERATION(sql, operationStmt);
-            BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, blockStmt);
-            UPSERT_BITCOIN_OPERATION(sql, bitcoinOpStmt);
-            UPSERT_TRANSACTION(sql, transactionStmt);
-            UPSERT_TRANSACTION_INPUT(sql, transactionInputStmt);
-            UPSERT_INPUT(sql, inputStmt);
-            UPSERT_OUTPUT(sql, outputStmt);
+            // Plain upserts are prepared on execution, PostgreSQL streams them with COPY instead
+            INSERT_UTXO(sql, utxoStmt);
+            DELETE_SPENT_UTXO(sql, spentOutputStmt);
 
             for (const auto& op : operations) {
                 if (op.block.hasValue()) {
@@ -309,33 +425,101 @@ namespace ledger {
                         prevBtcTxUid = BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(op.accountUid, input.previousTxHash.getValue());
                     }
                     inputStmt.bindings.update(input, inputUid, prevBtcTxUid, op.accountUid);
+                    if (!prevBtcTxUid.empty() && input.previousTxOutputIndex.nonEmpty()) {
+                        spentOutputStmt.bindings.update(prevBtcTxUid, input.previousTxOutputIndex.getValue());
+                    }
                     transactionInputStmt.bindings.update(txUid, tx.hash, inputUid, input.index);
                 }
                 // Upsert output
                 for (const auto& output : tx.outputs) {
                     outputStmt.bindings.update(output, replaceable && tx.block.isEmpty(), txUid, tx.hash);
+                    if (output.accountUid.nonEmpty()) {
+                        utxoStmt.bindings.update(output.accountUid.getValue(), txUid, output.index);
+                    }
                 }
                 // Bitcoin operation
                 bitcoinOpStmt.bindings.update(op.uid, txUid, tx.hash);
             }
             // Bulk insert block (dependency for operation and bitcoin transaction)
             if (!blockStmt.bindings.uid.empty())
-                blockStmt.execute();
+                BulkInsertDatabaseHelper::upsertBlocks(sql, blockStmt);
             // Bulk insert transaction (dependency of bitcoin_input,
             // bitcoin_transaction_input and  bitcoin_output)
-            transactionStmt.execute();
+            BulkInsertDatabaseHelper::upsert(sql, UPSERT_TRANSACTION, transactionStmt, COPY_TRANSACTION);
             // Bulk insert outputs
-            outputStmt.execute();
+            BulkInsertDatabaseHelper::upsert(sql, UPSERT_OUTPUT, outputStmt, COPY_OUTPUT);
             // Bulk insert bitcoin_input (dependency of bitcoin_transaction_inputs)
-            inputStmt.execute();
+            BulkInsertDatabaseHelper::upsert(sql, UPSERT_INPUT, inputStmt, COPY_INPUT);
             // Bulk insert  bitcoin_transaction_inputs
-            transactionInputStmt.execute();
+            BulkInsertDatabaseHelper::upsert(sql, UPSERT_TRANSACTION_INPUT, transactionInputStmt, COPY_TRANSACTION_INPUT);
+            // Update UTXO set once both outputs and inputs are known
+            if (!utxoStmt.bindings.txUid.empty())
+                utxoStmt.execute();
+            if (!spentOutputStmt.bindings.txUid.empty())
+                spentOutputStmt.execute();
             // Bulk insert operations (dependency of  bitcoin operations)
-            operationStmt.execute();
+            BulkInsertDatabaseHelper::upsertOperations(sql, operationStmt);
+            BalanceCheckpointDatabaseHelper::update(sql, operationStmt.bindings);
             // Bulk insert bitcoin operations
-            bitcoinOpStmt.execute();
+            BulkInsertDatabaseHelper::upsert(sql, UPSERT_BITCOIN_OPERATION, bitcoinOpStmt, COPY_BITCOIN_OPERATION);
 
             rawInsert.stop();
         }
+
+        // Keep operations having an input (sends) or an output (receptions) on the account keychain
+        static const std::string KEYCHAIN_OPERATIONS =
+                " FROM operations AS op"
+                " JOIN bitcoin_operations AS bop ON bop.uid = op.uid"
+                " WHERE op.account_uid = :uid AND ("
+                "(op.type = 'SEND' AND EXISTS ("
+                "SELECT 1 FROM bitcoin_transaction_inputs AS ti"
+                " JOIN bitcoin_inputs AS i ON i.uid = ti.input_uid"
+                " JOIN keychain_addresses AS k ON k.account_uid = op.account_uid AND k.address = i.address"
+                " WHERE ti.transaction_uid = bop.transaction_uid))"
+                " OR (op.type = 'RECEIVE' AND EXISTS ("
+                "SELECT 1 FROM bitcoin_outputs AS o"
+                " JOIN keychain_addresses AS k ON k.account_uid = op.account_uid AND k.address = o.address"
+                " WHERE o.transaction_uid = bop.transaction_uid))"
+                ")";
+
+        std::size_t BitcoinLikeOperationDatabaseHelper::queryOperations(soci::session &sql,
+                                                                        const std::string &accountUid,
+                                                                        std::vector<Operation> &out,
+                                                                        const Option<std::chrono::system_clock::time_point> &after) {
+            // Without lower bound, every operation is after the epoch
+            auto from = after.getValueOr(std::chrono::system_clock::time_point());
+            rowset<row> rows = (sql.prepare <<
+                    "SELECT op.amount, op.fees, op.type, op.date" << KEYCHAIN_OPERATIONS <<
+                    " AND op.date > :date ORDER BY op.date",
+                    use(accountUid), use(from));
+
+            std::size_t count = 0;
+            for (auto& row : rows) {
+                Operation operation;
+                operation.amount = BigInt::fromHex(row.get<std::string>(0));
+                operation.fees = BigInt::fromHex(row.get<std::string>(1));
+                operation.type = api::from_string<api::OperationType>(row.get<std::string>(2));
+                operation.date = DateUtils::fromJSON(row.get<std::string>(3));
+                out.push_back(operation);
+                count += 1;
+            }
+            return count;
+        }
+
+        Option<BigInt> BitcoinLikeOperationDatabaseHelper::sumBalance(soci::session &sql,
+                                                                      const std::string &accountUid,
+                                                                      const std::chrono::system_clock::time_point &upTo) {
+            long long high = 0, low = 0, wide = 0;
+            sql << "SELECT"
+                   " COALESCE(SUM(CASE WHEN op.type = 'RECEIVE' THEN op.amount_high ELSE -op.amount_high - op.fees_high END), 0),"
+                   " COALESCE(SUM(CASE WHEN op.type = 'RECEIVE' THEN op.amount_low ELSE -op.amount_low - op.fees_low END), 0),"
+                   " COALESCE(SUM(CASE WHEN op.amount_high IS NULL OR (op.type = 'SEND' AND op.fees_high IS NULL) THEN 1 ELSE 0 END), 0)"
+                << KEYCHAIN_OPERATIONS << " AND op.date <= :date",
+                    use(accountUid), use(upTo), into(high), into(low), into(wide);
+            if (wide > 0) {
+                return Option<BigInt>();
+            }
+            return Option<BigInt>(AmountLimbs::toBigInt(high, low));
+        }
     }
 }
\ No newline at end of file
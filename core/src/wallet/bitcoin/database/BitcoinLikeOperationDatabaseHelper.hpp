@@ -40,6 +40,24 @@ namespace ledger {
         class BitcoinLikeOperationDatabaseHelper {
         public:
             static void bulkInsert(soci::session& sql, const std::vector<Operation>& operations);
+
+            /**
+             * Query the amount, fees, type and date of the account operations having at least one input (for sends)
+             * or output (for receptions) on an address of the account keychain, ordered by date. When a date is
+             * given, only operations strictly after it are returned.
+             */
+            static std::size_t queryOperations(soci::session& sql,
+                                               const std::string& accountUid,
+                                               std::vector<Operation>& out,
+                                               const Option<std::chrono::system_clock::time_point>& after = Option<std::chrono::system_clock::time_point>());
+
+            /**
+             * Sum in database the balance change of the operations selected by queryOperations up to the given
+             * date (inclusive). Empty if one of them is too wide to be summed by the database.
+             */
+            static Option<BigInt> sumBalance(soci::session& sql,
+                                             const std::string& accountUid,
+                                             const std::chrono::system_clock::time_point& upTo);
         };
     }
 }
@@ -31,11 +31,15 @@
 #include <crypto/SHA256.hpp>
 #include "BitcoinLikeTransactionDatabaseHelper.h"
 #include <wallet/common/database/BlockDatabaseHelper.h>
+#include <wallet/bitcoin/database/BitcoinLikeUTXODatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <database/soci-option.h>
 #include <database/soci-date.h>
 #include <database/soci-number.h>
+#include <database/soci-in.h>
 
 #include <iostream>
+#include <unordered_set>
 using namespace std;
 
 using namespace soci;
@@ -43,6 +47,60 @@ using namespace soci;
 namespace ledger {
     namespace core {
 
+        namespace {
+            const std::string TRANSACTION_COLUMNS = "tx.hash, tx.version, tx.time, tx.locktime, "
+                                                    "block.hash, block.height, block.time, block.currency_name ";
+            const std::string INPUT_COLUMNS = "ti.input_idx, i.previous_output_idx, i.previous_tx_hash, i.amount, "
+                                              "i.address, i.coinbase, i.sequence ";
+            const std::string OUTPUT_COLUMNS = "idx, amount, script, address, block_height, replaceable ";
+
+            void inflateTransactionHeader(const soci::row &row, BitcoinLikeBlockchainExplorerTransaction &out) {
+                out.hash = row.get<std::string>(0);
+                out.version = (uint32_t) row.get<int32_t>(1);
+                out.receivedAt = row.get<std::chrono::system_clock::time_point>(2);
+                out.lockTime = (uint64_t) row.get<int>(3);
+                if (row.get_indicator(4) != i_null) {
+                    BitcoinLikeBlockchainExplorer::Block block;
+                    block.hash = row.get<std::string>(4);
+                    block.height = get_number<uint64_t>(row, 5);
+                    block.time = row.get<std::chrono::system_clock::time_point>(6);
+                    block.currencyName = row.get<std::string>(7);
+                    out.block = block;
+                }
+            }
+
+            // Reads INPUT_COLUMNS starting at the given column
+            BitcoinLikeBlockchainExplorerInput inflateInput(const soci::row &inputRow, std::size_t offset) {
+                BitcoinLikeBlockchainExplorerInput input;
+                input.index = get_number<uint64_t>(inputRow, offset);
+                input.previousTxOutputIndex = inputRow.get<Option<int>>(offset + 1).map<uint32_t>([] (const int& v) {
+                    return (uint32_t) v;
+                });
+                input.previousTxHash = inputRow.get<Option<std::string>>(offset + 2);
+                input.value = inputRow.get<Option<long long>>(offset + 3).map<BigInt>([] (const unsigned long long& v) {
+                    return BigInt(v);
+                });
+                input.address = inputRow.get<Option<std::string>>(offset + 4);
+                input.coinbase = inputRow.get<Option<std::string>>(offset + 5);
+                input.sequence = get_number<uint32_t>(inputRow, offset + 6);
+                return input;
+            }
+
+            // Reads OUTPUT_COLUMNS starting at the given column
+            BitcoinLikeBlockchainExplorerOutput inflateOutput(const soci::row &outputRow, std::size_t offset) {
+                BitcoinLikeBlockchainExplorerOutput output;
+                output.index = (uint64_t) outputRow.get<int>(offset);
+                output.value.assignScalar(outputRow.get<long long>(offset + 1));
+                output.script = outputRow.get<std::string>(offset + 2);
+                output.address = outputRow.get<Option<std::string>>(offset + 3);
+                if (outputRow.get_indicator(offset + 4) != i_null) {
+                    output.blockHeight = soci::get_number<uint64_t>(outputRow, offset + 4);
+                }
+                output.replaceable = soci::get_number<int>(outputRow, offset + 5) == 1;
+                return output;
+            }
+        }
+
         bool BitcoinLikeTransactionDatabaseHelper::transactionExists(soci::session &sql, const std::string &btcTxUid) {
             int32_t count = 0;
             sql << "SELECT COUNT(*) FROM bitcoin_transactions WHERE transaction_uid = :btcTxUid", use(btcTxUid), into(count);
@@ -117,6 +175,10 @@ namespace ledger {
                         use(output.script), use(output.address),
                         use(accountUid), use(output.blockHeight),
                         use(replaceableInt);
+                int index = static_cast<int>(output.index);
+                sql << "INSERT INTO bitcoin_utxos SELECT :account_uid, :tx_uid, CAST(:idx AS INTEGER) WHERE NOT EXISTS ("
+                       "SELECT 1 FROM bitcoin_inputs WHERE previous_tx_uid = :tx_uid AND previous_output_idx = :idx"
+                       ") ON CONFLICT DO NOTHING", use(accountUid, "account_uid"), use(btcTxUid, "tx_uid"), use(index, "idx");
             } else {
                 sql << "INSERT INTO bitcoin_outputs VALUES(:idx, :tx_uid, :hash, :amount, :script, :address, NULL, "
                        ":block_height, :replaceable)",
@@ -166,6 +228,10 @@ namespace ledger {
                     use(input.address), use(input.coinbase), use(input.sequence);
             sql << "INSERT INTO bitcoin_transaction_inputs VALUES(:tx_uid, :tx_hash, :input_uid, :input_idx)",
                     use(btcTxUid), use(transactionHash), use(uid), use(input.index);
+            if (!prevBtcTxUid.empty() && input.previousTxOutputIndex.nonEmpty()) {
+                sql << "DELETE FROM bitcoin_utxos WHERE transaction_uid = :tx_uid AND idx = :idx",
+                        use(prevBtcTxUid), use(input.previousTxOutputIndex.getValue());
+            }
         }
 
         std::string BitcoinLikeTransactionDatabaseHelper::createInputUid(const std::string& accountUid,
@@ -180,8 +246,7 @@ namespace ledger {
                                                                         const std::string &accountUid,
                                                                         BitcoinLikeBlockchainExplorerTransaction &out) {
             rowset<row> rows = (sql.prepare <<
-                    "SELECT  tx.hash, tx.version, tx.time, tx.locktime, "
-                            "block.hash, block.height, block.time, block.currency_name "
+                    "SELECT " + TRANSACTION_COLUMNS +
                             "FROM bitcoin_transactions AS tx "
                             "LEFT JOIN blocks AS block ON tx.block_uid = block.uid "
                             "WHERE tx.hash = :hash", use(hash)
@@ -193,44 +258,80 @@ namespace ledger {
             return false;
         }
 
+        std::unordered_map<std::string, BitcoinLikeBlockchainExplorerTransaction>
+        BitcoinLikeTransactionDatabaseHelper::getTransactionsByHashes(
+                soci::session &sql,
+                const std::vector<std::pair<std::string, std::string>> &accountUidsAndHashes) {
+            std::unordered_map<std::string, BitcoinLikeBlockchainExplorerTransaction> result;
+            std::vector<std::string> hashes;
+            std::vector<std::string> btcTxUids;
+            std::unordered_map<std::string, std::string> hashByBtcTxUid;
+            for (const auto& accountUidAndHash : accountUidsAndHashes) {
+                auto btcTxUid = createBitcoinTransactionUid(accountUidAndHash.first, accountUidAndHash.second);
+                if (hashByBtcTxUid.emplace(btcTxUid, accountUidAndHash.second).second) {
+                    btcTxUids.push_back(btcTxUid);
+                }
+            }
+            std::unordered_map<std::string, BitcoinLikeBlockchainExplorerTransaction> byHash;
+            for (const auto& entry : hashByBtcTxUid) {
+                if (byHash.emplace(entry.second, BitcoinLikeBlockchainExplorerTransaction()).second) {
+                    hashes.push_back(entry.second);
+                }
+            }
+
+            // Transactions and inputs only depend on the hash, outputs depend on the account
+            std::unordered_set<std::string> found;
+            db::selectIn(sql, "SELECT " + TRANSACTION_COLUMNS +
+                              "FROM bitcoin_transactions AS tx "
+                              "LEFT JOIN blocks AS block ON tx.block_uid = block.uid "
+                              "WHERE tx.hash IN ({})", hashes, [&] (const soci::row& row) {
+                auto hash = row.get<std::string>(0);
+                if (found.insert(hash).second) {
+                    inflateTransactionHeader(row, byHash[hash]);
+                }
+            });
+            db::selectIn(sql, "SELECT ti.transaction_hash, " + INPUT_COLUMNS +
+                              "FROM bitcoin_transaction_inputs AS ti "
+                              "JOIN bitcoin_inputs AS i ON ti.input_uid = i.uid "
+                              "WHERE ti.transaction_hash IN ({}) ORDER BY ti.transaction_hash, ti.input_idx",
+                              hashes, [&] (const soci::row& row) {
+                auto tx = byHash.find(row.get<std::string>(0));
+                if (tx != byHash.end()) {
+                    tx->second.inputs.push_back(inflateInput(row, 1));
+                }
+            });
+
+            for (const auto& btcTxUid : btcTxUids) {
+                auto& hash = hashByBtcTxUid[btcTxUid];
+                if (found.find(hash) != found.end()) {
+                    result.emplace(btcTxUid, byHash[hash]);
+                }
+            }
+            db::selectIn(sql, "SELECT transaction_uid, " + OUTPUT_COLUMNS +
+                              "FROM bitcoin_outputs WHERE transaction_uid IN ({}) ORDER BY transaction_uid, idx",
+                              btcTxUids, [&] (const soci::row& row) {
+                auto tx = result.find(row.get<std::string>(0));
+                if (tx != result.end()) {
+                    tx->second.outputs.push_back(inflateOutput(row, 1));
+                }
+            });
+            return result;
+        }
+
         bool BitcoinLikeTransactionDatabaseHelper::inflateTransaction(soci::session &sql,
                                                                       const soci::row &row,
                                                                       const std::string &accountUid,
                                                                       BitcoinLikeBlockchainExplorerTransaction &out) {
-            out.hash = row.get<std::string>(0);
-            out.version = (uint32_t) row.get<int32_t>(1);
-            out.receivedAt = row.get<std::chrono::system_clock::time_point>(2);
-            out.lockTime = (uint64_t) row.get<int>(3);
-            if (row.get_indicator(4) != i_null) {
-                BitcoinLikeBlockchainExplorer::Block block;
-                block.hash = row.get<std::string>(4);
-                block.height = get_number<uint64_t>(row, 5);
-                block.time = row.get<std::chrono::system_clock::time_point>(6);
-                block.currencyName = row.get<std::string>(7);
-                out.block = block;
-            }
+            inflateTransactionHeader(row, out);
             // Fetch inputs
             rowset<soci::row> inputRows = (sql.prepare <<
-                "SELECT  ti.input_idx, i.previous_output_idx, i.previous_tx_hash, i.amount, i.address, i.coinbase,"
-                        "i.sequence "
+                "SELECT " + INPUT_COLUMNS +
                 "FROM bitcoin_transaction_inputs AS ti "
                 "JOIN bitcoin_inputs AS i ON ti.input_uid = i.uid "
                 "WHERE ti.transaction_hash = :hash ORDER BY ti.input_idx", use(out.hash)
             );
             for (auto& inputRow : inputRows) {
-                BitcoinLikeBlockchainExplorerInput input;
-                input.index = get_number<uint64_t>(inputRow, 0);
-                input.previousTxOutputIndex = inputRow.get<Option<int>>(1).map<uint32_t>([] (const int& v) {
-                    return (uint32_t) v;
-                });
-                input.previousTxHash = inputRow.get<Option<std::string>>(2);
-                input.value = inputRow.get<Option<long long>>(3).map<BigInt>([] (const unsigned long long& v) {
-                    return BigInt(v);
-                });
-                input.address = inputRow.get<Option<std::string>>(4);
-                input.coinbase = inputRow.get<Option<std::string>>(5);
-                input.sequence = get_number<uint32_t>(inputRow, 6);
-                out.inputs.push_back(input);
+                out.inputs.push_back(inflateInput(inputRow, 0));
             }
 
             // Fetch outputs
@@ -240,22 +341,13 @@ namespace ledger {
             //bitcoin_outputs going to external accounts have NULL account_uid)
             auto btcTxUid = BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(accountUid, out.hash);
             rowset<soci::row> outputRows = (sql.prepare <<
-                    "SELECT idx, amount, script, address, block_height, replaceable "
+                    "SELECT " + OUTPUT_COLUMNS +
                     "FROM bitcoin_outputs WHERE transaction_hash = :hash AND transaction_uid = :tx_uid "
                     "ORDER BY idx", use(out.hash), use(btcTxUid)
             );
 
             for (auto& outputRow : outputRows) {
-                BitcoinLikeBlockchainExplorerOutput output;
-                output.index = (uint64_t) outputRow.get<int>(0);
-                output.value.assignScalar(outputRow.get<long long>(1));
-                output.script = outputRow.get<std::string>(2);
-                output.address = outputRow.get<Option<std::string>>(3);
-                if (outputRow.get_indicator(4) != i_null) {
-                    output.blockHeight = soci::get_number<uint64_t>(outputRow, 4);
-                }
-                output.replaceable = soci::get_number<int>(outputRow, 5) == 1;
-                out.outputs.push_back(std::move(output));
+                out.outputs.push_back(inflateOutput(outputRow, 0));
             }
 
             // Enjoy the silence.
@@ -267,8 +359,7 @@ namespace ledger {
                                                                      std::vector<BitcoinLikeBlockchainExplorerTransaction> &out) {
             // Query all transaction
             rowset<row> txRows = (sql.prepare <<
-                    "SELECT  tx.hash, tx.version, tx.time, tx.locktime, "
-                    "block.hash, block.height, block.time, block.currency_name "
+                    "SELECT " + TRANSACTION_COLUMNS +
                     "FROM bitcoin_transactions AS tx "
                     "LEFT JOIN blocks AS block ON tx.block_uid = block.uid "
                     "WHERE tx.hash IN ("
@@ -294,6 +385,7 @@ namespace ledger {
             );
             std::vector<std::string> txToDelete(rows.begin(), rows.end());
             if (!txToDelete.empty()) {
+                BitcoinLikeUTXODatabaseHelper::restoreSpentUTXOs(sql, txToDelete);
                 sql << "DELETE FROM bitcoin_inputs WHERE uid IN ("
                        "SELECT input_uid FROM bitcoin_transaction_inputs "
                        "WHERE transaction_uid IN(:uids)"
@@ -301,6 +393,7 @@ namespace ledger {
                 sql << "DELETE FROM operations WHERE account_uid = :uid AND block_uid is NULL", use(accountUid);
                 sql << "DELETE FROM bitcoin_transactions "
                        "WHERE transaction_uid IN (:uids)", use(txToDelete);
+                BitcoinLikeUTXODatabaseHelper::removeSpentUTXOs(sql, accountUid);
             }
         }
 
@@ -319,12 +412,44 @@ namespace ledger {
             if (!txToDelete.empty()) {
                 sql << "DELETE FROM operations WHERE account_uid = :account_uid AND date >= :date", 
                     use(accountUid), use(date);
+                BitcoinLikeUTXODatabaseHelper::restoreSpentUTXOs(sql, txToDelete);
+                sql << "DELETE FROM bitcoin_inputs WHERE uid IN ("
+                       "SELECT input_uid FROM bitcoin_transaction_inputs "
+                       "WHERE transaction_uid IN(:uids)"
+                       ")", use(txToDelete);
+                sql << "DELETE FROM bitcoin_transactions "
+                       "WHERE transaction_uid IN (:uids)", use(txToDelete);
+                BitcoinLikeUTXODatabaseHelper::removeSpentUTXOs(sql, accountUid);
+                BalanceCheckpointDatabaseHelper::refresh(sql, accountUid, date);
+            }
+        }
+
+        void BitcoinLikeTransactionDatabaseHelper::eraseDataAboveHeight(
+                soci::session &sql,
+                const std::string &accountUid,
+                const std::string &currencyName,
+                int64_t blockHeight) {
+
+            rowset<std::string> rows = (sql.prepare <<
+                "SELECT transaction_uid FROM bitcoin_operations AS bop "
+                "JOIN operations AS op ON bop.uid = op.uid "
+                "JOIN blocks AS b ON b.uid = op.block_uid "
+                "WHERE op.account_uid = :uid AND b.currency_name = :currency AND b.height > :height",
+                use(accountUid), use(currencyName), use(blockHeight)
+            );
+            std::vector<std::string> txToDelete(rows.begin(), rows.end());
+            if (!txToDelete.empty()) {
+                BitcoinLikeUTXODatabaseHelper::restoreSpentUTXOs(sql, txToDelete);
                 sql << "DELETE FROM bitcoin_inputs WHERE uid IN ("
                        "SELECT input_uid FROM bitcoin_transaction_inputs "
                        "WHERE transaction_uid IN(:uids)"
                        ")", use(txToDelete);
+                sql << "DELETE FROM operations WHERE account_uid = :uid AND block_uid IN ("
+                       "SELECT uid FROM blocks WHERE currency_name = :currency AND height > :height"
+                       ")", use(accountUid), use(currencyName), use(blockHeight);
                 sql << "DELETE FROM bitcoin_transactions "
                        "WHERE transaction_uid IN (:uids)", use(txToDelete);
+                BitcoinLikeUTXODatabaseHelper::removeSpentUTXOs(sql, accountUid);
             }
         }
 
@@ -32,6 +32,7 @@
 #define LEDGER_CORE_BITCOINLIKETRANSACTIONDATABASEHELPER_H
 
 #include <soci.h>
+#include <unordered_map>
 #include <wallet/bitcoin/explorers/BitcoinLikeBlockchainExplorer.hpp>
 
 namespace ledger {
@@ -61,6 +62,14 @@ namespace ledger {
                                              const std::string &accountUid,
                                              BitcoinLikeBlockchainExplorerTransaction &out);
 
+            /**
+             * Batched version of getTransactionByHash, fetching each table once for all the given (account uid,
+             * transaction hash) pairs. Transactions are keyed by bitcoin transaction uid, missing ones are skipped.
+             */
+            static std::unordered_map<std::string, BitcoinLikeBlockchainExplorerTransaction> getTransactionsByHashes(
+                    soci::session &sql,
+                    const std::vector<std::pair<std::string, std::string>> &accountUidsAndHashes);
+
             static inline bool inflateTransaction(soci::session& sql,
                                                   const soci::row& row,
                                                   const std::string &accountUid,
@@ -93,6 +102,20 @@ namespace ledger {
                 soci::session &sql,
                 const std::string &accountUid,
                 const std::chrono::system_clock::time_point & date);
+
+            /**
+             * Remove the transactions of the given account stored in a block of the currency above the given height,
+             * with their operations. Fits BlockchainReorganization::CoinRollback.
+             * @param sql
+             * @param accountUid
+             * @param currencyName
+             * @param blockHeight
+             */
+            static void eraseDataAboveHeight(
+                soci::session &sql,
+                const std::string &accountUid,
+                const std::string &currencyName,
+                int64_t blockHeight);
         };
     }
 }
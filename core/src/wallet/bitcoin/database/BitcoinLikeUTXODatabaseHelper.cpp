@@ -34,43 +34,51 @@
 #include <database/soci-number.h>
 #include <database/soci-option.h>
 #include <utils/Option.hpp>
+#include <database/StatementCache.hpp>
 
 using namespace soci;
 
 namespace ledger {
     namespace core {
 
-        std::size_t BitcoinLikeUTXODatabaseHelper::UTXOcount(soci::session &sql, const std::string &accountUid,
-                                                             std::function<bool(const std::string &address)> filter) {
-            rowset<row> rows = (sql.prepare <<
-                                            "SELECT o.address FROM bitcoin_outputs AS o "
-                                                    " LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid "
-                                                    " AND i.previous_output_idx = o.idx"
-                                                    " WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid", use(accountUid));
-            std::size_t count = 0;
-            for (auto& row : rows) {
-                if (row.get_indicator(0) != i_null && filter(row.get<std::string>(0)))
-                    count += 1;
-            }
-            return count;
+        namespace {
+            struct UTXOCountBinding {
+                std::string accountUid;
+                int32_t count;
+            };
+
+            const auto COUNT_UTXO = db::stmt<UTXOCountBinding>(
+                    "SELECT COUNT(*) FROM bitcoin_utxos AS u"
+                    " JOIN bitcoin_outputs AS o ON o.transaction_uid = u.transaction_uid AND o.idx = u.idx"
+                    " JOIN keychain_addresses AS k ON k.account_uid = o.account_uid AND k.address = o.address"
+                    " WHERE u.account_uid = :uid", [] (auto& s, auto& b) {
+                        s, use(b.accountUid), into(b.count);
+                    });
+        }
+
+        std::size_t BitcoinLikeUTXODatabaseHelper::UTXOcount(soci::session &sql, const std::string &accountUid) {
+            auto stmt = db::cached(sql, COUNT_UTXO);
+            stmt->bindings.accountUid = accountUid;
+            stmt->bindings.count = 0;
+            stmt->execute();
+            return static_cast<std::size_t>(stmt->bindings.count);
         }
 
         std::size_t
         BitcoinLikeUTXODatabaseHelper::queryUTXO(soci::session &sql, const std::string &accountUid, int32_t offset,
-                                                 int32_t count, std::vector<BitcoinLikeBlockchainExplorerOutput> &out,
-                                                 std::function<bool(const std::string &address)> filter) {
+                                                 int32_t count, std::vector<BitcoinLikeBlockchainExplorerOutput> &out) {
             rowset<row> rows = (sql.prepare <<
                                             "SELECT o.address, o.idx, o.transaction_hash, o.amount, o.script, o.block_height,"
                                                     "replaceable"
-                                                    " FROM bitcoin_outputs AS o "
-                                                    " LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid "
-                                                    " AND i.previous_output_idx = o.idx"
-                                                    " WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid"
+                                                    " FROM bitcoin_utxos AS u"
+                                                    " JOIN bitcoin_outputs AS o ON o.transaction_uid = u.transaction_uid AND o.idx = u.idx"
+                                                    " JOIN keychain_addresses AS k ON k.account_uid = o.account_uid AND k.address = o.address"
+                                                    " WHERE u.account_uid = :uid"
                                                     " ORDER BY block_height LIMIT :count OFFSET :off",
                                                     use(accountUid), use(count), use(offset));
 
             for (auto& row : rows) {
-                if (row.get_indicator(0) != i_null && filter(row.get<std::string>(0))) {
+                if (row.get_indicator(0) != i_null) {
                     BitcoinLikeBlockchainExplorerOutput output;
                    
                     output.address = row.get<Option<std::string>>(0);
@@ -94,9 +102,9 @@ namespace ledger {
             soci::rowset<soci::row> rows = (
                 session.prepare <<
                     "SELECT o.address, o.idx, o.transaction_hash, o.amount, o.script, o.block_height "
-                    "FROM bitcoin_outputs AS o "
-                    "LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid AND i.previous_output_idx = o.idx "
-                    "WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid "
+                    "FROM bitcoin_utxos AS u "
+                    "JOIN bitcoin_outputs AS o ON o.transaction_uid = u.transaction_uid AND o.idx = u.idx "
+                    "WHERE u.account_uid = :uid "
                     "ORDER BY o.block_height",
                 use(accountUid));
 
@@ -120,5 +128,43 @@ namespace ledger {
 
             return utxos;
         }
+
+        void BitcoinLikeUTXODatabaseHelper::restoreSpentUTXOs(soci::session &sql,
+                                                              const std::vector<std::string> &transactionUids) {
+            if (transactionUids.empty()) {
+                return;
+            }
+            sql << "INSERT INTO bitcoin_utxos"
+                   " SELECT o.account_uid, o.transaction_uid, o.idx FROM bitcoin_transaction_inputs AS ti"
+                   " JOIN bitcoin_inputs AS i ON i.uid = ti.input_uid"
+                   " JOIN bitcoin_outputs AS o ON o.transaction_uid = i.previous_tx_uid AND o.idx = i.previous_output_idx"
+                   " WHERE ti.transaction_uid = :uid AND o.account_uid IS NOT NULL"
+                   " ON CONFLICT DO NOTHING", use(transactionUids);
+        }
+
+        void BitcoinLikeUTXODatabaseHelper::restoreSpentUTXOsOfBlocks(soci::session &sql,
+                                                                      const std::string &accountUid,
+                                                                      const std::vector<std::string> &blockUids) {
+            if (blockUids.empty()) {
+                return;
+            }
+            std::vector<std::string> accountUids(blockUids.size(), accountUid);
+            sql << "INSERT INTO bitcoin_utxos"
+                   " SELECT o.account_uid, o.transaction_uid, o.idx FROM bitcoin_transaction_inputs AS ti"
+                   " JOIN bitcoin_operations AS bop ON bop.transaction_uid = ti.transaction_uid"
+                   " JOIN operations AS op ON op.uid = bop.uid"
+                   " JOIN bitcoin_inputs AS i ON i.uid = ti.input_uid"
+                   " JOIN bitcoin_outputs AS o ON o.transaction_uid = i.previous_tx_uid AND o.idx = i.previous_output_idx"
+                   " WHERE op.account_uid = :uid AND op.block_uid = :b_uid AND o.account_uid IS NOT NULL"
+                   " ON CONFLICT DO NOTHING", use(accountUids), use(blockUids);
+        }
+
+        void BitcoinLikeUTXODatabaseHelper::removeSpentUTXOs(soci::session &sql, const std::string &accountUid) {
+            sql << "DELETE FROM bitcoin_utxos WHERE account_uid = :uid AND EXISTS ("
+                   "SELECT 1 FROM bitcoin_inputs AS i"
+                   " WHERE i.previous_tx_uid = bitcoin_utxos.transaction_uid"
+                   " AND i.previous_output_idx = bitcoin_utxos.idx"
+                   ")", use(accountUid);
+        }
     }
 }
@@ -48,15 +48,30 @@ namespace ledger {
             static std::size_t queryUTXO(soci::session &sql, const std::string &accountUid,
                            int32_t offset,
                            int32_t count,
-                           std::vector<BitcoinLikeBlockchainExplorerOutput>& out,
-                           std::function<bool (const std::string& address)> filter);
+                           std::vector<BitcoinLikeBlockchainExplorerOutput>& out);
 
-            static std::size_t UTXOcount(soci::session& sql, const std::string& accountUid,
-                                         std::function<bool (const std::string& address)> filter);
+            static std::size_t UTXOcount(soci::session& sql, const std::string& accountUid);
 
             static std::vector<BitcoinLikeUtxo> queryAllUtxos(
                 soci::session &session, std::string const &accountUid, api::Currency const &currency);
 
+            /**
+             * Put back in the bitcoin_utxos set the account outputs spent by the given transactions. Must be called
+             * before their inputs are deleted, then followed by removeSpentUTXOs once deletion is over since some of
+             * those outputs may still be spent by a transaction left in database.
+             */
+            static void restoreSpentUTXOs(soci::session& sql, const std::vector<std::string>& transactionUids);
+
+            /**
+             * Remove from the bitcoin_utxos set every output spent by an input in database.
+             */
+            static void removeSpentUTXOs(soci::session& sql, const std::string& accountUid);
+
+            /**
+             * Same as restoreSpentUTXOs for every transaction of the account operations stored in the given blocks.
+             */
+            static void restoreSpentUTXOsOfBlocks(soci::session& sql, const std::string& accountUid, const std::vector<std::string>& blockUids);
+
         };
     }
 }
@@ -42,6 +42,7 @@
 #include <collections/collections.hpp>
 #include <math/BigInt.h>
 #include <utils/ConfigurationMatchable.h>
+#include <utils/MonotonicArena.hpp>
 #include <utils/optional.hpp>
 #include <utils/Option.hpp>
 #include <wallet/common/explorers/AbstractBlockchainExplorer.h>
@@ -77,13 +78,16 @@ namespace ledger {
         };
 
         struct BitcoinLikeBlockchainExplorerTransaction {
+            typedef std::vector<BitcoinLikeBlockchainExplorerInput, ArenaAllocator<BitcoinLikeBlockchainExplorerInput>> Inputs;
+            typedef std::vector<BitcoinLikeBlockchainExplorerOutput, ArenaAllocator<BitcoinLikeBlockchainExplorerOutput>> Outputs;
+
             uint32_t  version;
             std::string hash;
             std::chrono::system_clock::time_point receivedAt;
             uint64_t lockTime;
             Option<Block> block;
-            std::vector<BitcoinLikeBlockchainExplorerInput> inputs;
-            std::vector<BitcoinLikeBlockchainExplorerOutput> outputs;
+            Inputs inputs;
+            Outputs outputs;
             Option<BigInt> fees;
             uint64_t confirmations;
 
@@ -92,7 +96,17 @@ namespace ledger {
                 confirmations = -1;
             }
 
-            BitcoinLikeBlockchainExplorerTransaction(const BitcoinLikeBlockchainExplorerTransaction &cpy) {
+            // Inputs and outputs are allocated from the given arena, which must outlive the transaction
+            explicit BitcoinLikeBlockchainExplorerTransaction(MonotonicArena* arena)
+                : inputs(Inputs::allocator_type(arena)), outputs(Outputs::allocator_type(arena)) {
+                version = 1;
+                confirmations = -1;
+            }
+
+            // Copies are heap allocated, unless an arena is given
+            BitcoinLikeBlockchainExplorerTransaction(const BitcoinLikeBlockchainExplorerTransaction &cpy,
+                                                     MonotonicArena* arena = nullptr)
+                : BitcoinLikeBlockchainExplorerTransaction(arena) {
                 this->confirmations = cpy.confirmations;
                 this->version = cpy.version;
                 this->outputs = cpy.outputs;
@@ -103,6 +117,19 @@ namespace ledger {
                 this->hash = cpy.hash;
                 this->block = cpy.block;
             }
+
+            // Moves keep the arena, so that growing a page of transactions does not copy them
+            BitcoinLikeBlockchainExplorerTransaction(BitcoinLikeBlockchainExplorerTransaction &&mov) noexcept
+                : version(mov.version), hash(std::move(mov.hash)), receivedAt(mov.receivedAt),
+                  lockTime(mov.lockTime), block(std::move(mov.block)), inputs(std::move(mov.inputs)),
+                  outputs(std::move(mov.outputs)), fees(std::move(mov.fees)), confirmations(mov.confirmations) {
+            }
+
+            BitcoinLikeBlockchainExplorerTransaction& operator=(const BitcoinLikeBlockchainExplorerTransaction &cpy) = default;
+
+            MonotonicArena* getArena() const {
+                return inputs.get_allocator().getArena();
+            }
         };
 
         class BitcoinLikeBlockchainExplorer : public ConfigurationMatchable,
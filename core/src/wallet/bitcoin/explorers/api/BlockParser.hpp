@@ -38,15 +38,15 @@ namespace ledger {
     namespace core {
         class BlockParser : public AbstractBlockParser<BitcoinLikeBlockchainExplorer::Block> {
         public:
-            BlockParser(std::string &lastKey) : _lastKey(lastKey) {};
+            BlockParser(LedgerApiKey &lastKey) : _lastKey(lastKey) {};
 
         protected:
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             };
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
         };
     }
 }
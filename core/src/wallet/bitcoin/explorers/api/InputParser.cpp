@@ -64,13 +64,13 @@ namespace ledger {
         bool InputParser::RawNumber(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
             std::string number(str, length);
             BigInt value = BigInt::fromString(number);
-            if (_lastKey == "input_index") {
+            if (_lastKey == LedgerApiKey::input_index) {
                 _input->index = value.toUint64();
-            } else if (_lastKey == "value") {
+            } else if (_lastKey == LedgerApiKey::value) {
                 _input->value = Option<BigInt>(value);
-            } else if (_lastKey == "output_index") {
+            } else if (_lastKey == LedgerApiKey::output_index) {
                 _input->previousTxOutputIndex = value.toUint64();
-            } else if (_lastKey == "sequence") {
+            } else if (_lastKey == LedgerApiKey::sequence) {
                 _input->sequence = value.toUint64();
             }
             return true;
@@ -78,15 +78,15 @@ namespace ledger {
 
         bool InputParser::String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
             std::string value = std::string(str, length);
-            if (_lastKey == "output_hash") {
+            if (_lastKey == LedgerApiKey::output_hash) {
                 _input->previousTxHash = value;
-            } else if (_lastKey == "address") {
+            } else if (_lastKey == LedgerApiKey::address) {
                 _input->address = Option<std::string>(value);
-            } else if (_lastKey == "script_signature") {
+            } else if (_lastKey == LedgerApiKey::script_signature) {
                 _input->signatureScript = Option<std::string>(value);
-            } else if (_lastKey == "coinbase") {
+            } else if (_lastKey == LedgerApiKey::coinbase) {
                 _input->coinbase = Option<std::string>(value);
-            } else if (_lastKey == "value") {
+            } else if (_lastKey == LedgerApiKey::value) {
                 _input->value = Option<BigInt>(BigInt::fromString(value));
             }
             return true;
@@ -34,6 +34,7 @@
 #include <rapidjson/reader.h>
 #include "../BitcoinLikeBlockchainExplorer.hpp"
 #include "../../../../net/HttpClient.hpp"
+#include <wallet/common/explorers/api/LedgerApiKey.hpp>
 
 namespace ledger {
     namespace core {
@@ -41,7 +42,7 @@ namespace ledger {
         public:
             typedef BitcoinLikeBlockchainExplorerInput Result;
 
-            InputParser(std::string& lastKey) : _lastKey(lastKey) {};
+            InputParser(LedgerApiKey& lastKey) : _lastKey(lastKey) {};
             void init(BitcoinLikeBlockchainExplorerInput* input);
             bool Null();
             bool Bool(bool b);
@@ -59,7 +60,7 @@ namespace ledger {
             bool EndArray(rapidjson::SizeType elementCount);
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
             BitcoinLikeBlockchainExplorerInput* _input;
 
         };
@@ -64,9 +64,9 @@ namespace ledger {
         bool OutputParser::RawNumber(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
             std::string number(str, length);
             BigInt value = BigInt::fromString(number);
-            if (_lastKey == "output_index") {
+            if (_lastKey == LedgerApiKey::output_index) {
                 _output->index = value.toUnsignedInt();
-            } else if (_lastKey == "value") {
+            } else if (_lastKey == LedgerApiKey::value) {
                 _output->value = value;
             }
             return true;
@@ -74,11 +74,11 @@ namespace ledger {
 
         bool OutputParser::String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
             std::string value = std::string(str, length);
-            if (_lastKey == "address") {
+            if (_lastKey == LedgerApiKey::address) {
                 _output->address = Option<std::string>(value);
-            } else if (_lastKey == "script_hex") {
+            } else if (_lastKey == LedgerApiKey::script_hex) {
                 _output->script = value;
-            } else if (_lastKey == "value") {
+            } else if (_lastKey == LedgerApiKey::value) {
                 _output->value = BigInt::fromString(value);
             }
             return true;
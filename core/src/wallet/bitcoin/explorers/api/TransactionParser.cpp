@@ -33,11 +33,11 @@
 
 #define PROXY_PARSE(method, ...)                                    \
  auto& currentObject = _hierarchy.top();                            \
- if (currentObject == "block") {                                    \
+ if (currentObject == LedgerApiKey::block) {                        \
     return _blockParser.method(__VA_ARGS__);                        \
- } else if (currentObject == "inputs") {                            \
+ } else if (currentObject == LedgerApiKey::inputs) {                \
     return _inputParser.method(__VA_ARGS__);                        \
- } else if (currentObject == "outputs") {                           \
+ } else if (currentObject == LedgerApiKey::outputs) {               \
     return _outputParser.method(__VA_ARGS__);                        \
  } else                                                             \
 
@@ -45,7 +45,7 @@ namespace ledger {
     namespace core {
 
         bool TransactionParser::Key(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
-            _lastKey = std::string(str, length);
+            _lastKey = LedgerApiKeys::fromString(str, length);
             PROXY_PARSE(Key, str, length, copy) {
                 return true;
             }
@@ -58,12 +58,12 @@ namespace ledger {
 
             auto& currentObject = _hierarchy.top();
 
-            if (currentObject == "inputs") {
+            if (currentObject == LedgerApiKey::inputs) {
                 BitcoinLikeBlockchainExplorerInput input;
                 input.index = _transaction->inputs.size();
                 _transaction->inputs.push_back(input);
                 _inputParser.init(&_transaction->inputs.back());
-            } else if (currentObject == "outputs") {
+            } else if (currentObject == LedgerApiKey::outputs) {
                 BitcoinLikeBlockchainExplorerOutput output;
                 _transaction->outputs.push_back(output);
                 _outputParser.init(&_transaction->outputs.back());
@@ -71,7 +71,7 @@ namespace ledger {
                 if (_transaction->block.hasValue()) {
                     _transaction->outputs.back().blockHeight = _transaction->block.getValue().height;
                 }
-            } else if (currentObject == "block") {
+            } else if (currentObject == LedgerApiKey::block) {
                 BitcoinLikeBlockchainExplorer::Block block;
                 _transaction->block = Option<BitcoinLikeBlockchainExplorer::Block>(block);
                 _blockParser.init(&_transaction->block.getValue());
@@ -145,11 +145,11 @@ namespace ledger {
             PROXY_PARSE(RawNumber, str, length, copy) {
                 std::string number(str, length);
                 BigInt value = BigInt::fromString(number);
-                if (_lastKey == "lock_time") {
+                if (_lastKey == LedgerApiKey::lock_time) {
                     _transaction->lockTime = value.toUint64();
-                } else if (_lastKey == "fees") {
+                } else if (_lastKey == LedgerApiKey::fees) {
                     _transaction->fees = Option<BigInt>(value);
-                } else if (_lastKey == "confirmations") {
+                } else if (_lastKey == LedgerApiKey::confirmations) {
                     _transaction->confirmations = value.toUint64();
                 }
                 return true;
@@ -159,22 +159,22 @@ namespace ledger {
         bool TransactionParser::String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
             PROXY_PARSE(String, str, length, copy) {
                 std::string value(str, length);
-                if (_lastKey == "hash") {
+                if (_lastKey == LedgerApiKey::hash) {
                     if (_transaction->hash.empty()) {
                         _transaction->hash = value;
                     }
                 }
-                else if (_lastKey == "id") {
+                else if (_lastKey == LedgerApiKey::id) {
                     _transaction->hash = value;
                 }
-                else if (_lastKey == "received_at") {
+                else if (_lastKey == LedgerApiKey::received_at) {
                     _transaction->receivedAt = DateUtils::fromJSON(value);
                 }
                 return true;
             }
         }
 
-        TransactionParser::TransactionParser(std::string& lastKey) :
+        TransactionParser::TransactionParser(LedgerApiKey& lastKey) :
             _lastKey(lastKey), _blockParser(lastKey), _inputParser(lastKey), _outputParser(lastKey)
         {
             _arrayDepth = 0;
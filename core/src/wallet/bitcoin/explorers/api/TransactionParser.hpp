@@ -48,7 +48,7 @@ namespace ledger {
         public:
             typedef BitcoinLikeBlockchainExplorerTransaction Result;
 
-            TransactionParser(std::string& lastKey);
+            TransactionParser(LedgerApiKey& lastKey);
             void init(BitcoinLikeBlockchainExplorerTransaction* transaction);
             bool Null();
             bool Bool(bool b);
@@ -66,9 +66,9 @@ namespace ledger {
             bool EndArray(rapidjson::SizeType elementCount);
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
             BitcoinLikeBlockchainExplorerTransaction* _transaction;
-            std::stack<std::string> _hierarchy;
+            std::stack<LedgerApiKey> _hierarchy;
             uint32_t _arrayDepth;
             BlockParser _blockParser;
             InputParser _inputParser;
@@ -38,21 +38,30 @@ namespace ledger {
     namespace core {
         class TransactionsBulkParser : public AbstractTransactionsBulkParser<BitcoinLikeBlockchainExplorer::TransactionsBulk, TransactionsParser> {
         public:
-            TransactionsBulkParser(std::string& lastKey) : _lastKey(lastKey), _transactionsParser(lastKey) {
+            TransactionsBulkParser(LedgerApiKey& lastKey) : _lastKey(lastKey), _transactionsParser(lastKey) {
                 _depth = 0;
             };
+
+            // A page owns the arena its transactions are allocated from, it is freed in one go with the page
+            void init(BitcoinLikeBlockchainExplorer::TransactionsBulk *bulk) {
+                if (!bulk->arena) {
+                    bulk->arena = std::make_shared<MonotonicArena>();
+                }
+                _transactionsParser.setArena(bulk->arena.get());
+                AbstractTransactionsBulkParser::init(bulk);
+            }
         protected:
             TransactionsParser &getTransactionsParser() override {
                 return _transactionsParser;
             }
 
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             }
 
         private:
             TransactionsParser _transactionsParser;
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
         };
     }
 }
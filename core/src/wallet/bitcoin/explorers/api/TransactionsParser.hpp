@@ -39,18 +39,22 @@ namespace ledger {
     namespace core {
         class TransactionsParser : public AbstractTransactionsParser<BitcoinLikeBlockchainExplorerTransaction, TransactionParser>{
         public:
-            TransactionsParser(std::string& lastKey) : _transactionParser(lastKey) {
+            TransactionsParser(LedgerApiKey& lastKey) : _transactionParser(lastKey), _arena(nullptr) {
                 _arrayDepth = 0;
                 _objectDepth = 0;
             }
 
+            // Inputs and outputs of the parsed transactions are allocated from the given arena, if any
+            void setArena(MonotonicArena* arena) {
+                _arena = arena;
+            }
+
             bool StartObject() {
                 _objectDepth += 1;
                 // In v2 /transactions/${hash} endpoint returns an array of tx object => _arrayDepth == 0
                 // In v3 /transactions/${hash} endpoint returns a tx object => _arrayDepth == 1
                 if ((_arrayDepth == 1 || _arrayDepth == 0) && _objectDepth == 1) {
-                    BitcoinLikeBlockchainExplorerTransaction transaction;
-                    _transactions->push_back(transaction);
+                    _transactions->emplace_back(_arena);
                     getTransactionParser().init(&_transactions->back());
                 }
 
@@ -64,6 +68,7 @@ namespace ledger {
 
         private:
             TransactionParser _transactionParser;
+            MonotonicArena* _arena;
         };
     }
 }
@@ -49,14 +49,14 @@ namespace ledger {
         public:
 
 
-            explicit WebSocketNotificationParser(std::string& lastKey) : _lastKey(lastKey),
+            explicit WebSocketNotificationParser(LedgerApiKey& lastKey) : _lastKey(lastKey),
                                                                         _blockParser(lastKey),
                                                                         _transactionParser(lastKey) {
 
             }
 
             bool Key(const rapidjson::Reader::Ch* str, rapidjson::SizeType length, bool copy) override {
-                _lastKey = std::string(str, length);
+                _lastKey = LedgerApiKeys::fromString(str, length);
                 return AbstractWebSocketNotificationParser<BitcoinLikeBlockchainExplorerTransaction,
                         BitcoinLikeBlockchainExplorer::Block,
                         TransactionParser,
@@ -71,12 +71,12 @@ namespace ledger {
             BlockParser &getBlockParser() override {
                 return _blockParser;
             };
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             };
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
             BlockParser _blockParser;
             TransactionParser _transactionParser;
         };
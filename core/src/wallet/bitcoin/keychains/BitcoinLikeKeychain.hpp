@@ -43,8 +43,10 @@
 #include <api/AccountCreationInfo.hpp>
 #include <api/ExtendedKeyAccountCreationInfo.hpp>
 #include <api/Keychain.hpp>
+#include <soci.h>
 
 #include <bitcoin/BitcoinLikeAddress.hpp>
+#include <wallet/bitcoin/database/BitcoinLikeKeychainDatabaseHelper.h>
 
 namespace ledger {
     namespace core {
@@ -99,6 +101,24 @@ namespace ledger {
             virtual std::vector<Address> getAllAddresses() = 0;
             virtual int32_t getOutputSizeAsSignedTxInput() const = 0;
 
+            /**
+             * Bind the keychain to the addresses stored in database for the given account. Stored addresses are
+             * loaded, addresses only known by the keychain are written to database and addresses derived from now
+             * on are kept pending until the next call to persistAddresses.
+             */
+            virtual void attachDatabase(soci::session& sql, const std::string& accountUid) {};
+            /**
+             * Write the addresses derived since the last call to database. Must not be called within a transaction.
+             */
+            virtual void persistAddresses(soci::session& sql) {};
+            /**
+             * Write the addresses derived since the last call within the transaction already opened on sql. The
+             * written addresses are returned so that they can be handed back to restorePendingAddresses when that
+             * transaction doesn't commit.
+             */
+            virtual std::vector<BitcoinLikeKeychainAddress> putPendingAddresses(soci::session& sql) { return {}; };
+            virtual void restorePendingAddresses(const std::vector<BitcoinLikeKeychainAddress>& addresses) {};
+
             static bool isSegwit(const std::string &keychainEngine);
             static bool isNativeSegwit(const std::string &keychainEngine);
             std::shared_ptr<Preferences> getPreferences() const;
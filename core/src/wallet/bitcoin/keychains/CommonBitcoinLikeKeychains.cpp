@@ -40,8 +40,10 @@
 #include "utils/DerivationPath.hpp"
 #include "collections/strings.hpp"
 #include "bitcoin/BitcoinLikeAddress.hpp"
+#include "bitcoin/BitcoinLikeExtendedPublicKey.hpp"
 
 #include <iostream>
+#include <unordered_set>
 #include <api/KeychainEngines.hpp>
 #include <api/ConfigurationDefaults.hpp>
 
@@ -50,6 +52,9 @@ using namespace std;
 namespace ledger {
     namespace core {
 
+        // Set in preferences once the address cache has been moved to the keychain_addresses table
+        static const std::string ADDRESSES_IN_DATABASE_KEY = "addresses_in_database";
+
         CommonBitcoinLikeKeychains::CommonBitcoinLikeKeychains(const std::shared_ptr<api::DynamicObject> &configuration,
                                                                const api::Currency &params,
                                                                int account,
@@ -87,6 +92,11 @@ namespace ledger {
             }
             _observableRange = (uint32_t) configuration->getInt(api::Configuration::KEYCHAIN_OBSERVABLE_RANGE)
                     .value_or(api::ConfigurationDefaults::KEYCHAIN_DEFAULT_OBSERVABLE_RANGE);
+            if (preferences->getBoolean(ADDRESSES_IN_DATABASE_KEY, false)) {
+                std::atomic_store(&_addressIndex, std::make_shared<const AddressIndex>());
+            } else {
+                loadAddressIndex();
+            }
         }
 
         bool CommonBitcoinLikeKeychains::markPathAsUsed(const DerivationPath &p, bool needExtendKeychain) {
@@ -131,71 +141,82 @@ namespace ledger {
             auto currency = getCurrency();
             std::vector<BitcoinLikeKeychain::Address> res;
             res.reserve((to - from + 1) * 2);
-            auto preferencesEdit = getPreferences()->edit();
-            bool hasDBChange = false;
+            std::vector<BitcoinLikeKeychainAddress> newAddresses;
             for (int iPurpose : {KeyPurpose::RECEIVE, KeyPurpose::CHANGE})
             {
-                for (int index = from; index <= to; index++)
+                std::vector<std::string> localPaths;
+                std::vector<std::string> addresses;
+                localPaths.reserve(to - from + 1);
+                addresses.reserve(to - from + 1);
+                Option<uint32_t> firstMissingIndex;
+                uint32_t lastMissingIndex = 0;
+                for (uint32_t index = from; index <= to; index++)
                 {
-                    auto localPath = getDerivationScheme()
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                    auto cacheKey = fmt::format("path:{}", localPath);
-                    auto address = getPreferences()->getString(cacheKey, "");
-
+                    auto localPath = getLocalPath(iPurpose, index);
+                    auto address = findAddressByPath(localPath).getValueOr("");
                     if (address.empty()) {
-                        auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
-                        auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
-                            .setAccountIndex(getAccountIndex())
-                            .setCoinType(currency.bip44CoinType)
-                            .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                        address = BitcoinLikeAddress::fromPublicKey(xpub, currency, p, _keychainEngine);
-                        preferencesEdit = preferencesEdit->putString(cacheKey, address)->putString(fmt::format("address:{}", address), localPath);
-                        hasDBChange = true;
+                        if (firstMissingIndex.isEmpty()) {
+                            firstMissingIndex = Option<uint32_t>(index);
+                        }
+                        lastMissingIndex = index;
                     }
-                    res.emplace_back(std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(address, getCurrency(), Option<std::string>(localPath))));
+                    localPaths.emplace_back(std::move(localPath));
+                    addresses.emplace_back(std::move(address));
+                }
+
+                if (firstMissingIndex.nonEmpty()) {
+                    auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
+                    // Derive all missing keys at once when addresses are direct children of the node
+                    std::vector<uint8_t> keys;
+                    if (isAddressIndexChildOfNode(iPurpose)) {
+                        keys = std::static_pointer_cast<BitcoinLikeExtendedPublicKey>(xpub)->deriveRange(firstMissingIndex.getValue(), lastMissingIndex);
+                    }
+                    for (uint32_t index = firstMissingIndex.getValue(); index <= lastMissingIndex; index++) {
+                        auto& address = addresses[index - from];
+                        if (!address.empty()) {
+                            continue;
+                        }
+                        if (!keys.empty()) {
+                            auto offset = (index - firstMissingIndex.getValue()) * DeterministicPublicKey::COMPRESSED_KEY_SIZE;
+                            BitcoinLikeKeychainAddress derived{iPurpose, index, "", std::vector<uint8_t>(keys.begin() + offset, keys.begin() + offset + DeterministicPublicKey::COMPRESSED_KEY_SIZE)};
+                            derived.address = BitcoinLikeAddress(currency,
+                                                                 BitcoinLikeAddress::fromPublicKeyToHash160(derived.publicKey, currency, _keychainEngine),
+                                                                 _keychainEngine).toString();
+                            newAddresses.push_back(std::move(derived));
+                        } else {
+                            newAddresses.push_back(deriveAddress(iPurpose, index));
+                        }
+                        address = newAddresses.back().address;
+                    }
+                }
+
+                for (size_t i = 0; i < addresses.size(); i++) {
+                    res.emplace_back(std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(addresses[i], getCurrency(), Option<std::string>(localPaths[i]))));
                 }
             }
-            if (hasDBChange) {
-                preferencesEdit->commit();
-            }
+            indexAddresses(newAddresses);
             return res;
         }
 
         std::vector<std::string> CommonBitcoinLikeKeychains::getAllObservableAddressString(uint32_t from, uint32_t to) {
-            auto currency = getCurrency();
             std::vector<std::string> res;
             res.reserve((to - from + 1) * 2);
-            auto preferencesEdit = getPreferences()->edit();
-            bool hasDBChange = false;
+            std::vector<BitcoinLikeKeychainAddress> newAddresses;
             for (int index = from; index <= to; index++)
             {
                 for (int iPurpose : {KeyPurpose::RECEIVE, KeyPurpose::CHANGE})
                 {
-                    auto localPath = getDerivationScheme()
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                    auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                    auto cacheKey = fmt::format("path:{}", localPath);
-                    auto address = getPreferences()->getString(cacheKey, "");
+                    auto localPath = getLocalPath(iPurpose, index);
+                    auto address = findAddressByPath(localPath).getValueOr("");
 
                     if (address.empty()) {
-                        auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
-                        address = BitcoinLikeAddress::fromPublicKey(xpub, currency, p, _keychainEngine);
-                        preferencesEdit = preferencesEdit->putString(cacheKey, address)->putString(fmt::format("address:{}", address), localPath);
-                        hasDBChange = true;
+                        newAddresses.push_back(deriveAddress(iPurpose, index));
+                        address = newAddresses.back().address;
                     }
                     res.emplace_back(address);
                 }
             }
-            if (hasDBChange) {
-                preferencesEdit->commit();
-            }
+            indexAddresses(newAddresses);
             return res;
         }
 
@@ -211,9 +232,11 @@ namespace ledger {
         CommonBitcoinLikeKeychains::getFreshAddresses(BitcoinLikeKeychain::KeyPurpose purpose, size_t n) {
             auto startOffset = (purpose == KeyPurpose::RECEIVE) ? _state.maxConsecutiveReceiveIndex : _state.maxConsecutiveChangeIndex;
             std::vector<BitcoinLikeKeychain::Address> result(n);
+            std::vector<BitcoinLikeKeychainAddress> newAddresses;
             for (auto i = 0; i < n; i++) {
-                result[i] = derive(purpose, startOffset + i);
+                result[i] = derive(purpose, startOffset + i, newAddresses);
             }
+            indexAddresses(newAddresses);
             return result;
         }
 
@@ -230,13 +253,10 @@ namespace ledger {
         }
 
         Option<std::string> CommonBitcoinLikeKeychains::getAddressDerivationPath(const std::string &address) const {
-            auto path = getPreferences()->getString(fmt::format("address:{}", address), "");
-            if (path.empty()) {
-                return Option<std::string>();
-            } else {
-                auto derivation = DerivationPath(getExtendedPublicKey()->getRootPath()) + DerivationPath(path);
-                return Option<std::string>(derivation.toString());
-            }
+            return findByAddress(address).map<std::string>([&] (const IndexedAddress& entry) {
+                auto derivation = DerivationPath(getExtendedPublicKey()->getRootPath()) + DerivationPath(entry.localPath);
+                return derivation.toString();
+            });
         }
 
         std::vector<BitcoinLikeKeychain::Address>
@@ -246,13 +266,15 @@ namespace ledger {
             auto length = std::min<size_t >(to - from, maxObservableIndex - from);
             std::vector<BitcoinLikeKeychain::Address> result;
             result.reserve(length + 1);
+            std::vector<BitcoinLikeKeychainAddress> newAddresses;
             for (auto i = 0; i <= length; i++) {
                 if (purpose == KeyPurpose::RECEIVE) {
-                    result.push_back(derive(KeyPurpose::RECEIVE, from + i));
+                    result.push_back(derive(KeyPurpose::RECEIVE, from + i, newAddresses));
                 } else {
-                    result.push_back(derive(KeyPurpose::CHANGE, from + i));
+                    result.push_back(derive(KeyPurpose::CHANGE, from + i, newAddresses));
                 }
             }
+            indexAddresses(newAddresses);
             return result;
         }
 
@@ -285,61 +307,223 @@ namespace ledger {
         }
 
         bool CommonBitcoinLikeKeychains::contains(const std::string &address) const {
-            return getAddressDerivationPath(address).nonEmpty();
+            return findByAddress(address).nonEmpty();
         }
 
         std::vector<BitcoinLikeKeychain::Address> CommonBitcoinLikeKeychains::getAllAddresses() {
             std::vector<BitcoinLikeKeychain::Address> addresses;
             addresses.reserve(_state.maxConsecutiveChangeIndex + 1 + _state.maxConsecutiveReceiveIndex + 1);
+            std::vector<BitcoinLikeKeychainAddress> newAddresses;
 
             auto fetchAddressesFrom = [&](auto const keyPurpose, auto const maxIndex) {
                   for (auto i = 0; i <= maxIndex; ++i) {
-                      addresses.push_back(derive(keyPurpose, i));
+                      addresses.push_back(derive(keyPurpose, i, newAddresses));
                   }
             };
 
             fetchAddressesFrom(KeyPurpose::CHANGE, _state.maxConsecutiveChangeIndex);
             fetchAddressesFrom(KeyPurpose::RECEIVE, _state.maxConsecutiveReceiveIndex);
+            indexAddresses(newAddresses);
 
             return addresses;
         }
 
         Option<std::vector<uint8_t>> CommonBitcoinLikeKeychains::getPublicKey(const std::string &address) const {
-            auto path = getPreferences()->getString(fmt::format("address:{}", address), "");
-            if (path.empty()) {
-                Option<std::vector<uint8_t>>();
+            auto entry = findByAddress(address);
+            if (entry.isEmpty()) {
+                return Option<std::vector<uint8_t>>();
             }
-            return Option<std::vector<uint8_t>>(_xpub->derivePublicKey(path));
+            if (!entry.getValue().address.publicKey.empty()) {
+                return Option<std::vector<uint8_t>>(entry.getValue().address.publicKey);
+            }
+            return Option<std::vector<uint8_t>>(_xpub->derivePublicKey(entry.getValue().localPath));
         }
 
-        BitcoinLikeKeychain::Address CommonBitcoinLikeKeychains::derive(KeyPurpose purpose, off_t index) {
+        bool CommonBitcoinLikeKeychains::isAddressIndexChildOfNode(int purpose) {
+            auto path = DerivationPath(getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
+                    .setAccountIndex(getAccountIndex())
+                    .setCoinType(getCurrency().bip44CoinType)
+                    .setNode(purpose).setAddressIndex(0).getPath().toString());
+            return path.getDepth() == 1 && !path.isHardened(0);
+        }
+
+        std::string CommonBitcoinLikeKeychains::getLocalPath(int purpose, uint32_t index) {
+            return getDerivationScheme()
+                    .setAccountIndex(getAccountIndex())
+                    .setCoinType(getCurrency().bip44CoinType)
+                    .setNode(purpose)
+                    .setAddressIndex(index).getPath().toString();
+        }
+
+        void CommonBitcoinLikeKeychains::loadAddressIndex() {
+            auto index = std::make_shared<AddressIndex>();
+            auto preferences = getPreferences();
+            // Addresses are always cached by contiguous ranges, starting from 0 or from a used index. Scan every
+            // index up to the highest used one, then keep going until a whole observable range is missing.
+            for (int iPurpose : {KeyPurpose::RECEIVE, KeyPurpose::CHANGE}) {
+                const auto& nonConsecutiveIndexes = iPurpose == KeyPurpose::RECEIVE ?
+                        _state.nonConsecutiveReceiveIndexes : _state.nonConsecutiveChangeIndexes;
+                uint32_t maxUsedIndex = iPurpose == KeyPurpose::RECEIVE ?
+                        _state.maxConsecutiveReceiveIndex : _state.maxConsecutiveChangeIndex;
+                if (!nonConsecutiveIndexes.empty()) {
+                    maxUsedIndex = std::max(maxUsedIndex, *nonConsecutiveIndexes.rbegin());
+                }
+                uint32_t consecutiveMisses = 0;
+                for (uint32_t addressIndex = 0; addressIndex <= maxUsedIndex || consecutiveMisses <= _observableRange; addressIndex++) {
+                    auto localPath = getLocalPath(iPurpose, addressIndex);
+                    auto address = preferences->getString(fmt::format("path:{}", localPath), "");
+                    if (address.empty()) {
+                        consecutiveMisses += 1;
+                        continue;
+                    }
+                    consecutiveMisses = 0;
+                    index->entryByAddress[address] = IndexedAddress{{iPurpose, addressIndex, address, {}}, localPath};
+                    index->addressByPath[std::move(localPath)] = std::move(address);
+                }
+            }
+            std::atomic_store(&_addressIndex, std::shared_ptr<const AddressIndex>(index));
+        }
+
+        Option<std::string> CommonBitcoinLikeKeychains::findAddressByPath(const std::string &localPath) const {
+            auto index = std::atomic_load(&_addressIndex);
+            auto it = index->addressByPath.find(localPath);
+            return it == index->addressByPath.end() ? Option<std::string>() : Option<std::string>(it->second);
+        }
+
+        Option<CommonBitcoinLikeKeychains::IndexedAddress> CommonBitcoinLikeKeychains::findByAddress(const std::string &address) const {
+            auto index = std::atomic_load(&_addressIndex);
+            auto it = index->entryByAddress.find(address);
+            return it == index->entryByAddress.end() ? Option<IndexedAddress>() : Option<IndexedAddress>(it->second);
+        }
+
+        BitcoinLikeKeychainAddress CommonBitcoinLikeKeychains::deriveAddress(int purpose, uint32_t index) {
             auto currency = getCurrency();
-            auto iPurpose = (purpose == KeyPurpose::RECEIVE) ? 0 : 1;
-            auto localPath = getDerivationScheme()
+            auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
                     .setAccountIndex(getAccountIndex())
                     .setCoinType(currency.bip44CoinType)
-                    .setNode(iPurpose)
-                    .setAddressIndex((int) index).getPath().toString();
+                    .setNode(purpose)
+                    .setAddressIndex(index).getPath().toString();
+            auto xpub = purpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
+            BitcoinLikeKeychainAddress derived{purpose, index, "", xpub->derivePublicKey(p)};
+            derived.address = BitcoinLikeAddress(currency,
+                                                 BitcoinLikeAddress::fromPublicKeyToHash160(derived.publicKey, currency, _keychainEngine),
+                                                 _keychainEngine).toString();
+            return derived;
+        }
 
-            auto cacheKey = fmt::format("path:{}", localPath);
-            auto address = getPreferences()->getString(cacheKey, "");
+        void CommonBitcoinLikeKeychains::indexAddresses(const std::vector<BitcoinLikeKeychainAddress> &addresses) {
+            if (addresses.empty()) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_addressIndexWriteLock);
+            auto index = std::make_shared<AddressIndex>(*std::atomic_load(&_addressIndex));
+            auto preferencesEdit = getPreferences()->edit();
+            for (const auto& address : addresses) {
+                auto localPath = getLocalPath(address.purpose, address.index);
+                if (_accountUid.isEmpty()) {
+                    // Feed path -> address cache
+                    // Feed address -> path cache
+                    preferencesEdit = preferencesEdit->putString(fmt::format("path:{}", localPath), address.address)
+                            ->putString(fmt::format("address:{}", address.address), localPath);
+                }
+                index->addressByPath[localPath] = address.address;
+                index->entryByAddress[address.address] = IndexedAddress{address, std::move(localPath)};
+            }
+            if (_accountUid.isEmpty()) {
+                preferencesEdit->commit();
+            } else {
+                _pendingAddresses.insert(_pendingAddresses.end(), addresses.begin(), addresses.end());
+            }
+            std::atomic_store(&_addressIndex, std::shared_ptr<const AddressIndex>(index));
+        }
 
-            if (address.empty()) {
+        void CommonBitcoinLikeKeychains::attachDatabase(soci::session &sql, const std::string &accountUid) {
+            auto stored = BitcoinLikeKeychainDatabaseHelper::getAddresses(sql, accountUid);
+            std::lock_guard<std::mutex> lock(_addressIndexWriteLock);
+            auto current = std::atomic_load(&_addressIndex);
+            auto index = std::make_shared<AddressIndex>(*current);
+            std::unordered_set<std::string> storedAddresses;
+            for (auto& address : stored) {
+                auto localPath = getLocalPath(address.purpose, address.index);
+                storedAddresses.insert(address.address);
+                index->addressByPath[localPath] = address.address;
+                index->entryByAddress[address.address] = IndexedAddress{std::move(address), std::move(localPath)};
+            }
+            // Addresses cached in preferences by previous versions
+            std::vector<BitcoinLikeKeychainAddress> missing;
+            for (const auto& entry : current->entryByAddress) {
+                if (storedAddresses.find(entry.first) == storedAddresses.end()) {
+                    missing.push_back(entry.second.address);
+                }
+            }
+            if (!missing.empty()) {
+                soci::transaction tr(sql);
+                BitcoinLikeKeychainDatabaseHelper::putAddresses(sql, accountUid, missing);
+                tr.commit();
+            }
+            if (!getPreferences()->getBoolean(ADDRESSES_IN_DATABASE_KEY, false)) {
+                getPreferences()->edit()->putBoolean(ADDRESSES_IN_DATABASE_KEY, true)->commit();
+            }
+            _accountUid = accountUid;
+            std::atomic_store(&_addressIndex, std::shared_ptr<const AddressIndex>(index));
+        }
 
-                auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose)
-                        .setAddressIndex((int) index).getPath().toString();
-                auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
-                address = BitcoinLikeAddress::fromPublicKey(xpub, currency, p, _keychainEngine);
-                // Feed path -> address cache
-                // Feed address -> path cache
-                    getPreferences()
-                        ->edit()
-                        ->putString(cacheKey, address)
-                        ->putString(fmt::format("address:{}", address), localPath)
-                        ->commit();
+        void CommonBitcoinLikeKeychains::persistAddresses(soci::session &sql) {
+            soci::transaction tr(sql);
+            auto pending = putPendingAddresses(sql);
+            try {
+                tr.commit();
+            } catch (...) {
+                restorePendingAddresses(pending);
+                throw;
+            }
+        }
+
+        std::vector<BitcoinLikeKeychainAddress> CommonBitcoinLikeKeychains::putPendingAddresses(soci::session &sql) {
+            std::vector<BitcoinLikeKeychainAddress> pending;
+            std::string accountUid;
+            {
+                std::lock_guard<std::mutex> lock(_addressIndexWriteLock);
+                if (_accountUid.isEmpty() || _pendingAddresses.empty()) {
+                    return pending;
+                }
+                pending.swap(_pendingAddresses);
+                accountUid = _accountUid.getValue();
+            }
+            try {
+                BitcoinLikeKeychainDatabaseHelper::putAddresses(sql, accountUid, pending);
+            } catch (...) {
+                restorePendingAddresses(pending);
+                throw;
+            }
+            return pending;
+        }
+
+        void CommonBitcoinLikeKeychains::restorePendingAddresses(const std::vector<BitcoinLikeKeychainAddress> &addresses) {
+            if (addresses.empty()) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_addressIndexWriteLock);
+            _pendingAddresses.insert(_pendingAddresses.begin(), addresses.begin(), addresses.end());
+        }
+
+        BitcoinLikeKeychain::Address CommonBitcoinLikeKeychains::derive(KeyPurpose purpose, off_t index) {
+            std::vector<BitcoinLikeKeychainAddress> newAddresses;
+            auto address = derive(purpose, index, newAddresses);
+            indexAddresses(newAddresses);
+            return address;
+        }
+
+        // Derive an address, collecting it in newAddresses when it is not indexed yet so that
+        // callers deriving many addresses index them all at once.
+        BitcoinLikeKeychain::Address CommonBitcoinLikeKeychains::derive(KeyPurpose purpose, off_t index, std::vector<BitcoinLikeKeychainAddress> &newAddresses) {
+            auto iPurpose = (purpose == KeyPurpose::RECEIVE) ? 0 : 1;
+            auto localPath = getLocalPath(iPurpose, (uint32_t) index);
+            auto address = findAddressByPath(localPath).getValueOr("");
+
+            if (address.empty()) {
+                newAddresses.push_back(deriveAddress(iPurpose, (uint32_t) index));
+                address = newAddresses.back().address;
             }
             return std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(address, getCurrency(), Option<std::string>(localPath)));
         }
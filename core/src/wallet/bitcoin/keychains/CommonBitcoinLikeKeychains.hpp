@@ -33,8 +33,11 @@
 
 #include "BitcoinLikeKeychain.hpp"
 #include <set>
+#include <mutex>
+#include <unordered_map>
 #include "../../../collections/DynamicObject.hpp"
 #include <bitcoin/BitcoinLikeAddress.hpp>
+#include <wallet/bitcoin/database/BitcoinLikeKeychainDatabaseHelper.h>
 
 namespace ledger {
     namespace core {
@@ -87,6 +90,11 @@ namespace ledger {
 
             Option<std::vector<uint8_t>> getPublicKey(const std::string &address) const override;
 
+            void attachDatabase(soci::session &sql, const std::string &accountUid) override;
+            void persistAddresses(soci::session &sql) override;
+            std::vector<BitcoinLikeKeychainAddress> putPendingAddresses(soci::session &sql) override;
+            void restorePendingAddresses(const std::vector<BitcoinLikeKeychainAddress> &addresses) override;
+
         protected:
             std::shared_ptr<api::BitcoinLikeExtendedPublicKey> _internalNodeXpub;
             std::shared_ptr<api::BitcoinLikeExtendedPublicKey> _publicNodeXpub;
@@ -94,9 +102,37 @@ namespace ledger {
             std::string _keychainEngine;
 
         private:
+            struct IndexedAddress {
+                BitcoinLikeKeychainAddress address;
+                std::string localPath;
+            };
+
+            /**
+             * In-memory index of every derived address. Snapshots are immutable and replaced as a whole on update,
+             * so lookups only synchronize to copy the snapshot pointer (std::atomic_load on a shared_ptr is guarded by
+             * a mutex in libstdc++) and never while searching. Writers build one new snapshot per batch of derivations.
+             */
+            struct AddressIndex {
+                std::unordered_map<std::string, std::string> addressByPath;
+                std::unordered_map<std::string, IndexedAddress> entryByAddress;
+            };
+
             BitcoinLikeKeychain::Address derive(KeyPurpose purpose, off_t index);
+            BitcoinLikeKeychain::Address derive(KeyPurpose purpose, off_t index, std::vector<BitcoinLikeKeychainAddress> &newAddresses);
+            bool isAddressIndexChildOfNode(int purpose);
             void saveState();
+            std::string getLocalPath(int purpose, uint32_t index);
+            void loadAddressIndex();
+            Option<std::string> findAddressByPath(const std::string &localPath) const;
+            Option<IndexedAddress> findByAddress(const std::string &address) const;
+            BitcoinLikeKeychainAddress deriveAddress(int purpose, uint32_t index);
+            void indexAddresses(const std::vector<BitcoinLikeKeychainAddress> &addresses);
             KeychainPersistentState _state;
+            std::shared_ptr<const AddressIndex> _addressIndex;
+            std::mutex _addressIndexWriteLock;
+            // Set once addresses are stored in database instead of preferences
+            Option<std::string> _accountUid;
+            std::vector<BitcoinLikeKeychainAddress> _pendingAddresses;
             std::shared_ptr<api::BitcoinLikeExtendedPublicKey> _xpub;
         };
     }
@@ -34,6 +34,7 @@
 #include <async/algorithm.h>
 #include <async/FutureUtils.hpp>
 #include <debug/Benchmarker.h>
+#include <wallet/common/synchronizers/BlockchainReorganization.h>
 
 #define NEW_BENCHMARK(x) std::make_shared<Benchmarker>(fmt::format(x"/{}", buddy->synchronizationTag), buddy->logger)
 
@@ -273,7 +274,7 @@ namespace ledger {
                 int to = (currentBatchIndex + 1) * buddy->halfBatchSize * 2;
                 auto batch = std::vector<std::string>(this->_addresses.begin() + from, this->_addresses.begin() + to);
                 auto blockhash = pair.second;
-                batches.emplace_back(_explorer->getTransactions(batch, blockhash, optional<void*>()));
+                batches.emplace_back(getTransactionsFromExplorer(batch, blockhash, buddy));
                 _hashkeys.emplace_back(key);
             }
             if (batches.size() == 0) { //return an empty std::vector if no need to request the explorer
@@ -387,9 +388,19 @@ namespace ledger {
             buddy->halfBatchSize = (uint32_t)buddy->configuration
                 ->getInt(api::Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE)
                 .value_or(api::ConfigurationDefaults::KEYCHAIN_DEFAULT_OBSERVABLE_RANGE);
+            buddy->maxParallelBatches = (uint32_t)std::max(1, buddy->configuration
+                ->getInt(api::Configuration::SYNCHRONIZATION_MAX_PARALLEL_BATCHES)
+                .value_or(api::ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_MAX_PARALLEL_BATCHES));
             buddy->keychain = account->getKeychain();
             buddy->savedState = buddy->preferences
                 ->template getObject<BlockchainExplorerAccountSynchronizationSavedState>("state");
+            buddy->checkpointer = BlockchainExplorerAccountSynchronizationCheckpointer(
+                (uint32_t)buddy->configuration
+                    ->getInt(api::Configuration::SYNCHRONIZATION_CHECKPOINT_PAGES)
+                    .value_or(api::ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_CHECKPOINT_PAGES),
+                std::chrono::seconds(buddy->configuration
+                    ->getInt(api::Configuration::SYNCHRONIZATION_CHECKPOINT_INTERVAL)
+                    .value_or(api::ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_CHECKPOINT_INTERVAL)));
             buddy->logger
                 ->info("Starting synchronization for account#{} ({}) of wallet {} at {}",
                     account->getIndex(),
@@ -437,7 +448,6 @@ namespace ledger {
             self->_addresses.clear();
             self->_cachedTransactionBulks.clear();
             self->_hashkeys.clear();
-            _explorerBenchmark = NEW_BENCHMARK("explorer_calls");
             return self->updateCurrentBlock(buddy).template flatMap<Unit>(account->getContext(), [self, buddy](std::shared_ptr <BitcoinLikeBlockchainExplorer::Block> block) {
                 soci::session sql(buddy->account->getWallet()->getDatabase()->getPool());
                 soci::transaction tr(sql);
@@ -450,10 +460,8 @@ namespace ledger {
                 }
                 return self->extendKeychain(0, buddy);
                 }).template flatMap<std::vector<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>>>(account->getContext(), [buddy, self](const Unit&) {
-                self->_explorerBenchmark->start();
                 return self->requestTransactionsFromExplorer(buddy);})
                 .template flatMap<Unit>(account->getContext(), [buddy, self](const std::vector<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>>& txBulks) {
-                    self->_explorerBenchmark->stop();
                     for (int i = 0; i < txBulks.size(); i++) {
                         self->_cachedTransactionBulks.insert(std::make_pair(self->_hashkeys[i], txBulks[i]));
                     }                    
@@ -466,6 +474,8 @@ namespace ledger {
                         buddy->logger->info("End synchronization for account#{} of wallet {} in {}", buddy->account->getIndex(),
                             buddy->account->getWallet()->getName(), DurationUtils::formatDuration(duration));
 
+                        buddy->checkpointer.flush(buddy->preferences, buddy->savedState.getValue());
+
                         auto const& batches = buddy->savedState.getValue().batches;
 
                         // get the last block height treated during the synchronization
@@ -491,6 +501,8 @@ namespace ledger {
                             buddy->logger->error("Error during during synchronization for account#{} of wallet {} in {} ms", buddy->account->getIndex(),
                                 buddy->account->getWallet()->getName(), duration.count());
                             buddy->logger->error("Due to {}, {}", api::to_string(ex.getErrorCode()), ex.getMessage());
+                            // Progress made before the failure is committed in database, keep it
+                            buddy->checkpointer.flush(buddy->preferences, buddy->savedState.getValue());
                             return buddy->context;
                             });
         };
@@ -506,11 +518,9 @@ namespace ledger {
             auto batch = buddy->keychain->getAllObservableAddressString(from, to);
             auto lastAddressesinBatch = std::vector<std::string>(batch.end() - 2 * buddy->halfBatchSize, batch.end());
             self->_addresses.insert(self->_addresses.end(), batch.begin(), batch.end());
-            self->_explorerBenchmark->start();
-            return _explorer->getTransactions(lastAddressesinBatch, optional<std::string>(), optional<void*>())
+            return getTransactionsFromExplorer(lastAddressesinBatch, Option<std::string>(), buddy)
                 .template flatMap<Unit>(buddy->account->getContext(), [self, currentBatchIndex, buddy, to](const std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>& bulk) -> Future<Unit> {
-                self->_explorerBenchmark->stop();
-                self->_cachedTransactionBulks[std::to_string(currentBatchIndex) + ","] = bulk;
+                self->_cachedTransactionBulks[getHashkey(currentBatchIndex, Option<std::string>())] = bulk;
                 if (bulk->transactions.size() > 0)
                 {
                     return self->extendKeychain((currentBatchIndex + 1) * 2, buddy);
@@ -530,19 +540,23 @@ namespace ledger {
         //
         // This function will synchronize all batches by iterating over batches and transactions
         // bulks. The input buddy can be used to customize the behavior of the synchronization.
+        // When SYNCHRONIZATION_MAX_PARALLEL_BATCHES is greater than 1, batches are synchronized
+        // by windows of that size (see synchronizeBatchWindow).
         Future<Unit> BlockchainExplorerAccountSynchronizer::synchronizeBatches(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy) {
             buddy->logger->info("SYNC BATCHES");
+            if (buddy->maxParallelBatches > 1) {
+                return synchronizeBatchWindow(currentBatchIndex, buddy);
+            }
             auto done = currentBatchIndex >= buddy->savedState.getValue().batches.size() - 1;
             if (currentBatchIndex >= buddy->savedState.getValue().batches.size()) {
                 buddy->savedState.getValue().batches.push_back(BlockchainExplorerAccountSynchronizationBatchSavedState());
             }
 
             auto self = getSharedFromThis();
-            auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
 
             return synchronizeBatch(currentBatchIndex, buddy).template flatMap<Unit>(buddy->account->getContext(), [=](const bool& hadTransactions) -> Future<Unit> {
 
-                buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
+                buddy->checkpointer.checkpoint(buddy->preferences, buddy->savedState.getValue());
 
                 //Sync stops if there are no more batches in savedState and last batch has no transactions
                 //But we may want to force sync of accounts within KEYCHAIN_OBSERVABLE_RANGE
@@ -554,123 +568,219 @@ namespace ledger {
 
                 return Future<Unit>::successful(unit);
                 }).recoverWith(ImmediateExecutionContext::INSTANCE, [=](const Exception& exception) -> Future<Unit> {
-                    buddy->logger->info("Recovering from failing synchronization : {}", exception.getMessage());
-                    //A block reorganization happened
-                    if (exception.getErrorCode() == api::ErrorCode::BLOCK_NOT_FOUND &&
-                        buddy->savedState.nonEmpty()) {
-                        buddy->logger->info("Recovering from reorganization");
-                        auto startSession = Future<void*>::async(ImmediateExecutionContext::INSTANCE, [=]() {
-                            return Future<void*>::successful(nullptr);
-                            });
+                    return self->recoverFromFailedBatch(currentBatchIndex, buddy, exception);
+                });
+        };
 
-                        return startSession.template flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=](void* const session) {
-                            //Get its block/block height
-                            auto& failedBatch = buddy->savedState.getValue().batches[currentBatchIndex];
-                            auto const failedBlockHeight = failedBatch.blockHeight;
-                            auto const failedBlockHash = failedBatch.blockHash;
-
-                            if (failedBlockHeight > 0) {
-
-                                //Delete data related to failedBlock (and all blocks above it)
-                                buddy->logger->info("Deleting blocks above block height: {}", failedBlockHeight);
-
-                                soci::session sql(buddy->wallet->getDatabase()->getPool());
-                                {
-                                    soci::transaction tr(sql);
-                                    try {
-
-                                        soci::rowset<std::string> rows_block = (sql.prepare << "SELECT uid FROM blocks where height >= :failedBlockHeight",
-                                            soci::use(failedBlockHeight));
-
-                                        std::vector<std::string> blockToDelete(rows_block.begin(), rows_block.end());
-
-                                        // Fetch all operations which are deleted during reorganization
-                                        auto deletedOperationUIDs = OperationDatabaseHelper::fetchFromBlocks(sql, blockToDelete);
-
-                                        // Remove failed blocks and associated operations/transactions
-                                        AccountDatabaseHelper::removeBlockOperation(sql, buddy->account->getAccountUid(), blockToDelete);
-
-                                        //Get last block not part from reorg
-                                        auto lastBlock = BlockDatabaseHelper::getLastBlock(sql,
-                                            buddy->wallet->getCurrency().name);
-
-                                        //Resync from the "beginning" if no last block in DB
-                                        int64_t lastBlockHeight = 0;
-                                        std::string lastBlockHash;
-                                        if (lastBlock.nonEmpty()) {
-                                            lastBlockHeight = lastBlock.getValue().height;
-                                            lastBlockHash = lastBlock.getValue().blockHash;
-                                        }
-                                        // update reorganization block height until found the valid one
-                                        buddy->context.reorgBlockHeight = lastBlockHeight;
-
-                                        //Update savedState's batches
-                                        for (auto& batch : buddy->savedState.getValue().batches) {
-                                            if (batch.blockHeight > lastBlockHeight) {
-                                                batch.blockHeight = (uint32_t)lastBlockHeight;
-                                                batch.blockHash = lastBlockHash;
-                                            }
-                                        }
-                                        tr.commit();
-
-                                        // We can emit safely deleted operation UIDs
-                                        std::for_each(
-                                            deletedOperationUIDs.cbegin(),
-                                            deletedOperationUIDs.cend(),
-                                            [buddy](auto const& uid) {
-                                                buddy->account->emitDeletedOperationEvent(uid);
-                                            });
-                                    }
-                                    catch (...) {
-                                        tr.rollback();
-                                    }
-                                }
+        // Synchronize a window of batches at once.
+        //
+        // Batches [firstBatchIndex, firstBatchIndex + maxParallelBatches) are fetched, interpreted and
+        // inserted concurrently. Callbacks touching the buddy run on the account context, so batch states
+        // are updated one at a time and each of them only moves forward once its own page is inserted:
+        // the saved state stays consistent whatever the batch an interruption happens in.
+        // Once the window settles, the gap limit is evaluated batch by batch in index order, exactly
+        // as the serial mode does.
+        Future<Unit> BlockchainExplorerAccountSynchronizer::synchronizeBatchWindow(uint32_t firstBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy) {
+            auto lastBatchIndex = firstBatchIndex + buddy->maxParallelBatches - 1;
+            auto& batches = buddy->savedState.getValue().batches;
+            auto initialBatches = batches.size();
+            // Allocate all states of the window now, pages look their batch state up while other batches run.
+            // Those past the gap limit stop are dropped once the window settles
+            if (lastBatchIndex >= batches.size()) {
+                batches.resize(lastBatchIndex + 1);
+            }
+            buddy->logger->info("SYNC BATCH WINDOW {} to {}", firstBatchIndex, lastBatchIndex);
+
+            struct FailedBatch {
+                uint32_t batchIndex;
+                Exception exception;
+            };
+            auto failure = std::make_shared<Option<FailedBatch>>();
+            auto self = getSharedFromThis();
 
-                                //Save new savedState
-                                buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>(
-                                    "state", buddy->savedState.getValue())->commit();
+            std::vector<Future<bool>> window;
+            for (auto batchIndex = firstBatchIndex; batchIndex <= lastBatchIndex; batchIndex++) {
+                window.push_back(synchronizeBatch(batchIndex, buddy).recover(buddy->account->getContext(), [=](const Exception& ex) -> bool {
+                    // Keep the lowest failing batch, recovery resumes from it
+                    if (failure->isEmpty() || failure->getValue().batchIndex > batchIndex) {
+                        *failure = Option<FailedBatch>(FailedBatch {batchIndex, ex});
+                    }
+                    return false;
+                }));
+            }
 
-                                //Synchronize same batch now with an existing block (of hash lastBlockHash)
-                                //if failedBatch was not the deepest block part of that reorg, this recursive call
-                                //will ensure to get (and delete from DB) to the deepest failed block (part of reorg)
-                                buddy->logger->info("Relaunch synchronization after recovering from reorganization");
+            return executeAll(buddy->account->getContext(), window).template flatMap<Unit>(buddy->account->getContext(), [=](const std::vector<bool>& hadTransactions) -> Future<Unit> {
+                buddy->checkpointer.checkpoint(buddy->preferences, buddy->savedState.getValue());
+                if (failure->nonEmpty()) {
+                    return self->recoverFromFailedBatch(failure->getValue().batchIndex, buddy, failure->getValue().exception);
+                }
+
+                auto lastDiscoverableAddress = buddy->configuration->getInt(api::Configuration::KEYCHAIN_OBSERVABLE_RANGE).value_or(buddy->halfBatchSize);
+                for (auto batchIndex = firstBatchIndex; batchIndex <= lastBatchIndex; batchIndex++) {
+                    // Number of batches the serial mode would know when reaching this batch
+                    auto knownBatches = std::max<size_t>(initialBatches, batchIndex);
+                    auto done = knownBatches > 0 && batchIndex + 1 >= knownBatches;
+                    auto discoveredAddresses = batchIndex * buddy->halfBatchSize;
+                    if (done && !hadTransactions[batchIndex - firstBatchIndex] && lastDiscoverableAddress <= discoveredAddresses) {
+                        self->trimBatchWindow(batchIndex, lastBatchIndex, initialBatches, hadTransactions, buddy);
+                        return Future<Unit>::successful(unit);
+                    }
+                }
+                return self->synchronizeBatches(lastBatchIndex + 1, buddy);
+            });
+        };
 
-                                return self->synchronizeBatches(currentBatchIndex, buddy);
+        // Drop the batch states a window allocated past the batch the gap limit stopped at.
+        //
+        // The serial mode never creates them: they would be saved and counted as known batches on the
+        // next synchronization. Batches which found transactions are kept along with those before them,
+        // their operations are already inserted.
+        void BlockchainExplorerAccountSynchronizer::trimBatchWindow(uint32_t stopBatchIndex,
+                                                                   uint32_t lastBatchIndex,
+                                                                   size_t initialBatches,
+                                                                   const std::vector<bool>& hadTransactions,
+                                                                   const std::shared_ptr<SynchronizationBuddy>& buddy) {
+            auto firstBatchIndex = lastBatchIndex + 1 - hadTransactions.size();
+            auto size = std::max<size_t>(initialBatches, stopBatchIndex + 1);
+            for (auto batchIndex = lastBatchIndex; batchIndex > stopBatchIndex; batchIndex--) {
+                if (hadTransactions[batchIndex - firstBatchIndex]) {
+                    size = std::max<size_t>(size, batchIndex + 1);
+                    break;
+                }
+            }
+            auto& batches = buddy->savedState.getValue().batches;
+            if (size < batches.size()) {
+                batches.resize(size);
+            }
+        }
+
+        // Recover from a batch which failed to synchronize.
+        //
+        // Only block reorganizations are recovered: blocks above the fork point are removed and
+        // synchronization is relaunched from the failed batch.
+        Future<Unit> BlockchainExplorerAccountSynchronizer::recoverFromFailedBatch(uint32_t currentBatchIndex,
+                                                                                 std::shared_ptr<SynchronizationBuddy> buddy,
+                                                                                 const Exception& exception) {
+            auto self = getSharedFromThis();
+            buddy->logger->info("Recovering from failing synchronization : {}", exception.getMessage());
+            //A block reorganization happened
+            if (exception.getErrorCode() == api::ErrorCode::BLOCK_NOT_FOUND &&
+                buddy->savedState.nonEmpty()) {
+                buddy->logger->info("Recovering from reorganization");
+                auto startSession = Future<void*>::async(ImmediateExecutionContext::INSTANCE, [=]() {
+                    return Future<void*>::successful(nullptr);
+                    });
+
+                return startSession.template flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=](void* const session) {
+                    //Get its block/block height
+                    auto& failedBatch = buddy->savedState.getValue().batches[currentBatchIndex];
+                    auto const failedBlockHeight = failedBatch.blockHeight;
+                    auto const failedBlockHash = failedBatch.blockHash;
+
+                    if (failedBlockHeight > 0) {
+                        auto currencyName = buddy->wallet->getCurrency().name;
+                        std::vector<api::Block> candidates;
+                        {
+                            soci::session sql(buddy->wallet->getDatabase()->getPool());
+                            candidates = BlockDatabaseHelper::getBlocksBelowHeight(sql, currencyName, failedBlockHeight);
+                        }
+
+                        //Look the fork point up instead of walking back one batch at a time
+                        int from = currentBatchIndex * buddy->halfBatchSize * 2;
+                        auto probe = BlockchainReorganization::probeWith(self->_explorer, {self->_addresses[from]});
+                        buddy->logger->info("Looking for the fork point below block height: {}", failedBlockHeight);
+                        return BlockchainReorganization::findCommonAncestor(candidates, probe)
+                        .template flatMap<Unit>(buddy->account->getContext(), [=] (const Option<api::Block>& ancestor) {
+                            int64_t lastBlockHeight = 0;
+                            std::string lastBlockHash;
+                            if (ancestor.nonEmpty()) {
+                                lastBlockHeight = ancestor.getValue().height;
+                                lastBlockHash = ancestor.getValue().blockHash;
                             }
-                            return Future<Unit>::successful(unit);
-                            }).recover(ImmediateExecutionContext::INSTANCE, [buddy](const Exception& ex) -> Unit {
-                                buddy->logger->warn(
-                                    "Failed to recover from reorganisation for account#{} of wallet {}",
-                                    buddy->account->getIndex(),
-                                    buddy->account->getWallet()->getName());
-                                return unit;
-                                });
+
+                            //Delete data related to all blocks above the fork point
+                            buddy->logger->info("Deleting blocks above block height: {}", lastBlockHeight);
+
+                            soci::session sql(buddy->wallet->getDatabase()->getPool());
+                            soci::transaction tr(sql);
+                            auto deletedOperationUIDs = BlockchainReorganization::rollback(sql,
+                                buddy->account->getAccountUid(), currencyName, ancestor,
+                                &BitcoinLikeTransactionDatabaseHelper::eraseDataAboveHeight);
+                            buddy->context.reorgBlockHeight = lastBlockHeight;
+
+                            //Update savedState's batches
+                            for (auto& batch : buddy->savedState.getValue().batches) {
+                                if (batch.blockHeight > lastBlockHeight) {
+                                    batch.blockHeight = (uint32_t)lastBlockHeight;
+                                    batch.blockHash = lastBlockHash;
+                                }
+                            }
+                            tr.commit();
+
+                            // We can emit safely deleted operation UIDs
+                            buddy->account->emitDeletedOperationsEvent(deletedOperationUIDs);
+
+                            //Save new savedState
+                            buddy->checkpointer.flush(buddy->preferences, buddy->savedState.getValue());
+
+                            buddy->logger->info("Relaunch synchronization after recovering from reorganization");
+                            return self->synchronizeBatches(currentBatchIndex, buddy);
+                        });
                     }
                     return Future<Unit>::successful(unit);
-                    });
+                    }).recover(ImmediateExecutionContext::INSTANCE, [buddy](const Exception& ex) -> Unit {
+                        buddy->logger->warn(
+                            "Failed to recover from reorganisation for account#{} of wallet {}",
+                            buddy->account->getIndex(),
+                            buddy->account->getWallet()->getName());
+                        return unit;
+                        });
+            }
+            return Future<Unit>::successful(unit);
         };
 
         Future <std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> BlockchainExplorerAccountSynchronizer::getTransactionBulk(int currentBatchIndex, const std::shared_ptr<SynchronizationBuddy>& buddy) {
+            return getTransactionBulk(currentBatchIndex, buddy, getHashkeyAndBlockhash(currentBatchIndex, buddy).second);
+        }
+
+        // Get the page of a batch starting after the given block, from the pages already downloaded
+        // during this synchronization when possible.
+        Future <std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> BlockchainExplorerAccountSynchronizer::getTransactionBulk(int currentBatchIndex,
+                                                                                                                                         const std::shared_ptr<SynchronizationBuddy>& buddy,
+                                                                                                                                         const Option<std::string>& blockHash) {
             int from = currentBatchIndex * buddy->halfBatchSize * 2;
             int to = (currentBatchIndex + 1) * buddy->halfBatchSize * 2;
-            auto pair = getHashkeyAndBlockhash(currentBatchIndex, buddy);
-            auto it = this->_cachedTransactionBulks.find(pair.first);
+            auto it = this->_cachedTransactionBulks.find(getHashkey(currentBatchIndex, blockHash));
             if (it == this->_cachedTransactionBulks.end()) {
                 auto batch = std::vector<std::string>(this->_addresses.begin() + from, this->_addresses.begin() + to);
-                return _explorer->getTransactions(batch, pair.second, optional<void*>());
+                return getTransactionsFromExplorer(batch, blockHash, buddy);
             }
+            auto bulk = it->second;
             return Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>>::async(buddy->account->getContext(), 
                 [=]()-> std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk> {
-                    return it->second;
+                    return bulk;
                 }
                 );
         }
 
+        // Each request has its own benchmark, requests of concurrent pages and batches overlap.
+        Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> BlockchainExplorerAccountSynchronizer::getTransactionsFromExplorer(const std::vector<std::string>& addresses,
+                                                                                                                                                   const Option<std::string>& blockHash,
+                                                                                                                                                   const std::shared_ptr<SynchronizationBuddy>& buddy) {
+            auto benchmark = NEW_BENCHMARK("explorer_calls");
+            benchmark->start();
+            return _explorer->getTransactions(addresses, blockHash, optional<void*>())
+                .template map<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>>(ImmediateExecutionContext::INSTANCE, [benchmark](const std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>& bulk) {
+                    benchmark->stop();
+                    return bulk;
+                });
+        }
+
         // Synchronize a transactions batch.
         //
         // The currentBatchIndex is the currently synchronized batch. buddy is the
         // synchronization object used to accumulate a state. hadTransactions is used to check
-        // whether more data is needed. If a block doesn�t have any transaction, it means that
+        // whether more data is needed. If a block doesn't have any transaction, it means that
         // we must stop.
         Future<bool> BlockchainExplorerAccountSynchronizer::synchronizeBatch(uint32_t currentBatchIndex,
             std::shared_ptr<SynchronizationBuddy> buddy,
@@ -679,27 +789,50 @@ namespace ledger {
             auto self = getSharedFromThis();
             if (currentBatchIndex * buddy->halfBatchSize * 2 >= self->_addresses.size()) // current batch index is out of range
                 return Future<bool>::successful(false);
-            self->_explorerBenchmark->start();
-            return getTransactionBulk(currentBatchIndex, buddy)
+            return synchronizeBatchPage(currentBatchIndex, buddy, getTransactionBulk(currentBatchIndex, buddy), hadTransactions);
+        }
+
+        // Interpret and insert a page of transactions of a batch.
+        //
+        // Pages are processed as a pipeline: as soon as a page is received, the next page is requested
+        // to the explorer (its cursor is the last block of the current page) and downloads while the
+        // current page is interpreted and inserted. Only one page is prefetched at a time.
+        Future<bool> BlockchainExplorerAccountSynchronizer::synchronizeBatchPage(uint32_t currentBatchIndex,
+            std::shared_ptr<SynchronizationBuddy> buddy,
+            Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> page,
+            bool hadTransactions) {
+            auto self = getSharedFromThis();
+            return page
                 .template flatMap<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions](const std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>& bulk) -> Future<bool> {
-                self->_explorerBenchmark->stop();
                 auto interpretBenchmark = NEW_BENCHMARK("interpret_operations");
 
                 auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
                 buddy->logger->info("Got {} txs for account {}", bulk->transactions.size(), buddy->account->getAccountUid());
-                auto count = 0;
-                  
+
+                // Find the last block of the page first, it is the cursor of the next page
                 Option<Block> lastBlock = Option<Block>::NONE;
-                std::vector<Operation> operations;
-                interpretBenchmark->start();
-                // Interpret transactions to operations and update last block
                 for (const auto& tx : bulk->transactions) {
-                    // Update last block to chain query
                     if (lastBlock.isEmpty() ||
                         lastBlock.getValue().height < tx.block.getValue().height) {
                         lastBlock = tx.block;
                     }
+                }
+
+                Option<Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>>> nextPage;
+                if (bulk->hasNext) {
+                    Option<std::string> nextBlockHash;
+                    if (bulk->transactions.size() > 0 && lastBlock.nonEmpty()) {
+                        nextBlockHash = Option<std::string>(lastBlock.getValue().hash);
+                    } else if (batchState.blockHeight > 0) {
+                        nextBlockHash = Option<std::string>(batchState.blockHash);
+                    }
+                    nextPage = self->getTransactionBulk(currentBatchIndex, buddy, nextBlockHash);
+                }
 
+                std::vector<Operation> operations;
+                interpretBenchmark->start();
+                // Interpret transactions to operations
+                for (const auto& tx : bulk->transactions) {
                     self->interpretTransaction(tx, buddy, operations);
 
                     //Update first pendingTxHash in savedState
@@ -719,33 +852,35 @@ namespace ledger {
                 interpretBenchmark->stop();
                 auto insertionBenchmark = NEW_BENCHMARK("insert_operations");
                 insertionBenchmark->start();
-                Try<int> tryPutTx = buddy->account->bulkInsert(operations);
-                insertionBenchmark->stop();
-                if (tryPutTx.isFailure()) {
-                    buddy->logger->error("Failed to bulk insert for batch {} because: {}", currentBatchIndex, tryPutTx.getFailure().getMessage());
-                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Synchronization failed for batch {} ({})", currentBatchIndex, tryPutTx.exception().getValue().getMessage());
-                }
-                else {
-                    count += tryPutTx.getValue();
-                }
-
-                buddy->logger->info("Succeeded to insert {} txs on {} for account {}", count, bulk->transactions.size(), buddy->account->getAccountUid());
-                buddy->account->emitEventsNow();
-
-                // Get the last block
-                if (bulk->transactions.size() > 0 && lastBlock.nonEmpty()) {
-                    batchState.blockHeight = (uint32_t) lastBlock.getValue().height;
-                    batchState.blockHash = lastBlock.getValue().hash;
-                    buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
-                }
+                // Pages of accounts synchronizing concurrently are committed together by the write queue
+                return buddy->account->enqueueBulkInsert(operations)
+                .recover(buddy->account->getContext(), [buddy, currentBatchIndex] (const Exception& ex) -> int {
+                    buddy->logger->error("Failed to bulk insert for batch {} because: {}", currentBatchIndex, ex.getMessage());
+                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Synchronization failed for batch {} ({})", currentBatchIndex, ex.getMessage());
+                })
+                .template flatMap<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions, bulk, lastBlock, nextPage, insertionBenchmark] (const int& count) -> Future<bool> {
+                    insertionBenchmark->stop();
+                    // The state is looked up again, the reference of the enclosing page may be stale
+                    auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
+
+                    buddy->logger->info("Succeeded to insert {} txs on {} for account {}", count, bulk->transactions.size(), buddy->account->getAccountUid());
+                    buddy->account->emitEventsNow();
+
+                    // Get the last block, only once the page is inserted
+                    if (bulk->transactions.size() > 0 && lastBlock.nonEmpty()) {
+                        batchState.blockHeight = (uint32_t) lastBlock.getValue().height;
+                        batchState.blockHash = lastBlock.getValue().hash;
+                        buddy->checkpointer.checkpoint(buddy->preferences, buddy->savedState.getValue());
+                    }
 
-                auto hadTX = hadTransactions || bulk->transactions.size() > 0;
-                if (bulk->hasNext) {
-                    return self->synchronizeBatch(currentBatchIndex, buddy, hadTX);
-                }
-                else {
-                    return Future<bool>::successful(hadTX);
-                }
+                    auto hadTX = hadTransactions || bulk->transactions.size() > 0;
+                    if (nextPage.nonEmpty()) {
+                        return self->synchronizeBatchPage(currentBatchIndex, buddy, nextPage.getValue(), hadTX);
+                    }
+                    else {
+                        return Future<bool>::successful(hadTX);
+                    }
+                });
                 });
         }
         //Hashkey = currentBatchIndex + last blockHash in batch
@@ -757,11 +892,11 @@ namespace ledger {
                     blockHash = Option<std::string>(batchState.blockHash);
                 }
             }
-            auto key = std::to_string(currentBatchIndex) + ",";
-            if (!blockHash.isEmpty()) {
-                key += blockHash.getValue();
-            }
-            return std::make_pair(key, blockHash);
+            return std::make_pair(getHashkey(currentBatchIndex, blockHash), blockHash);
+        }
+
+        std::string BlockchainExplorerAccountSynchronizer::getHashkey(int currentBatchIndex, const Option<std::string>& blockHash) {
+            return std::to_string(currentBatchIndex) + "," + blockHash.getValueOr("");
         }
     }
 }
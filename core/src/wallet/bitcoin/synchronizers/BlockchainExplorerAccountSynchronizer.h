@@ -56,8 +56,10 @@ namespace ledger {
                 std::shared_ptr<AbstractWallet> wallet;
                 std::shared_ptr<DynamicObject> configuration;
                 uint32_t halfBatchSize;
+                uint32_t maxParallelBatches;
                 std::shared_ptr<BitcoinLikeKeychain> keychain;
                 Option<BlockchainExplorerAccountSynchronizationSavedState> savedState;
+                BlockchainExplorerAccountSynchronizationCheckpointer checkpointer;
                 std::shared_ptr<BitcoinLikeAccount> account;
                 std::map<std::string, std::string> transactionsToDrop;
                 BlockchainExplorerAccountSynchronizationResult context;
@@ -94,10 +96,21 @@ namespace ledger {
             Future<Unit> extendKeychain(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy);
             Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::Block>> updateCurrentBlock(std::shared_ptr<SynchronizationBuddy> buddy);
             Future<Unit> synchronizeBatches(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy);
+            Future<Unit> synchronizeBatchWindow(uint32_t firstBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy);
+            void trimBatchWindow(uint32_t stopBatchIndex,
+                                 uint32_t lastBatchIndex,
+                                 size_t initialBatches,
+                                 const std::vector<bool>& hadTransactions,
+                                 const std::shared_ptr<SynchronizationBuddy>& buddy);
+            Future<Unit> recoverFromFailedBatch(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy, const Exception& exception);
             Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> getTransactionBulk(int currentBatchIndex, const std::shared_ptr<SynchronizationBuddy>& buddy);
+            Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> getTransactionBulk(int currentBatchIndex, const std::shared_ptr<SynchronizationBuddy>& buddy, const Option<std::string>& blockHash);
+            Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> getTransactionsFromExplorer(const std::vector<std::string>& addresses, const Option<std::string>& blockHash, const std::shared_ptr<SynchronizationBuddy>& buddy);
             Future<bool> synchronizeBatch(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy, bool hadTransactions = false);
+            Future<bool> synchronizeBatchPage(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy, Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> page, bool hadTransactions);
             Future<std::vector<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>>> requestTransactionsFromExplorer(const std::shared_ptr<SynchronizationBuddy>& buddy);
             static std::pair<std::string, Option<std::string>> getHashkeyAndBlockhash(int currentBatchIndex, const std::shared_ptr<SynchronizationBuddy>& buddy);
+            static std::string getHashkey(int currentBatchIndex, const Option<std::string>& blockHash);
 
             std::shared_ptr<Preferences> _internalPreferences;
             std::shared_ptr<BitcoinLikeBlockchainExplorer> _explorer;
@@ -110,7 +123,6 @@ namespace ledger {
             std::map<std::string, std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> _cachedTransactionBulks;
             //A variable to save keys in _cachedTransactionBulks
             std::vector<std::string> _hashkeys;
-            std::shared_ptr<ledger::core::Benchmarker> _explorerBenchmark;
         };
     }
 }
@@ -85,21 +85,14 @@ namespace ledger {
 
         Future<BigInt> BitcoinLikeStrategyUtxoPicker::computeAggregatedAmount(
             const std::shared_ptr<BitcoinLikeUtxoPicker::Buddy> &buddy) {
-            // NOTE: We can turn that lambda to a free function and pass the context and the buddy as arguments
-            auto go = [context = getContext(), buddy] (auto go, auto it, auto v) {
-                if (it == buddy->request.inputs.end())
-                    return Future<BigInt>::successful(v);
-                const auto& i = *it;
-                const auto outputIndex = i.outputIndex;
-                // NOTE: why always 1 ?
-                buddy->logger->info("GET TX 1");
-                return buddy->getTransaction(i.transactionHash).template flatMap<BigInt>(context, [=] (auto const& tx) mutable {
-                    buddy->logger->info("GOT TX 1");
-                    return go(go, ++it, v + tx->outputs[outputIndex].value);
-                });
-            };
             // NOTE: we can now use buddy->transaction->inputs which is filled during fillInputs by user inputs
-            return go(go, buddy->request.inputs.begin(), BigInt());
+            return getInputTransactions(buddy).map<BigInt>(getContext(), [buddy] (auto const &txs) {
+                BigInt amount;
+                for (std::size_t index = 0; index < txs.size(); index++) {
+                    amount = amount + txs[index]->outputs[buddy->request.inputs[index].outputIndex].value;
+                }
+                return amount;
+            });
         }
 
         std::vector<BitcoinLikeUtxo>
@@ -31,6 +31,7 @@
 
 #include "BitcoinLikeUtxoPicker.h"
 #include <async/Promise.hpp>
+#include <async/algorithm.h>
 #include <api/BitcoinLikeScript.hpp>
 #include <api/BitcoinLikeScriptChunk.hpp>
 #include <wallet/bitcoin/api_impl/BitcoinLikeScriptApi.h>
@@ -39,6 +40,9 @@
 namespace ledger {
     namespace core {
 
+        // Transactions of the user-defined inputs requested at once
+        static const std::size_t MAX_CONCURRENT_TRANSACTION_FETCHES = 8;
+
         BitcoinLikeUtxoPicker::BitcoinLikeUtxoPicker(const std::shared_ptr<api::ExecutionContext> &context,
                                                      const api::Currency &currency) : DedicatedContext(context),
                                                                                       _currency(currency)
@@ -159,30 +163,30 @@ namespace ledger {
             });
         }
 
+        Future<std::vector<std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>>>
+        BitcoinLikeUtxoPicker::getInputTransactions(const std::shared_ptr<Buddy>& buddy) {
+            return async::traverse<BitcoinLikeTransactionInputDescriptor, std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>>(
+                getContext(), buddy->request.inputs, MAX_CONCURRENT_TRANSACTION_FETCHES,
+                [buddy] (const BitcoinLikeTransactionInputDescriptor &input) {
+                    return buddy->getTransaction(input.transactionHash);
+                });
+        }
+
         Future<Unit> BitcoinLikeUtxoPicker::fillInputs(const std::shared_ptr<Buddy>& buddy) {
             buddy->logger->info("Filling inputs");
 
             auto self = shared_from_this();
 
-            auto performFill = [self, buddy](auto performFill, auto index)
-            {
-                if (index >= buddy->request.inputs.size()) {
-                    return Future<Unit>::successful(unit);
-                }
-
-                auto const &input = buddy->request.inputs[index];
-
-                return buddy->getTransaction(input.transactionHash).template flatMap<Unit>(self->getContext(), [=](auto const &tx) {
-                    auto const utxo = makeUtxo(tx->outputs[input.outputIndex], self->getCurrency());
-
-                    self->fillInput(buddy, utxo, input.sequence);
-
-                    return performFill(performFill, index + 1);
-                });
-            };
-
             // first fill inputs from user-defined input descriptors
-            return performFill(performFill, 0)
+            return getInputTransactions(buddy).map<Unit>(getContext(), [self, buddy] (auto const &txs) {
+                    for (std::size_t index = 0; index < txs.size(); index++) {
+                        auto const &input = buddy->request.inputs[index];
+                        auto const utxo = makeUtxo(txs[index]->outputs[input.outputIndex], self->getCurrency());
+
+                        self->fillInput(buddy, utxo, input.sequence);
+                    }
+                    return unit;
+                })
                 .filter(getContext(), [buddy](auto const&) {
                     return buddy->request.utxoPicker.nonEmpty();
                 })
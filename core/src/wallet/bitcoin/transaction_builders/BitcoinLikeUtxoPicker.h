@@ -100,6 +100,10 @@ namespace ledger {
             virtual Future<std::vector<BitcoinLikeUtxo>> filterInputs(const std::shared_ptr<Buddy>& buddy) = 0;
             virtual Future<Unit> fillOutputs(const std::shared_ptr<Buddy>& buddy);
             virtual Future<Unit> fillTransactionInfo(const std::shared_ptr<Buddy>& buddy);
+            /**
+             * Transactions spent by the user-defined inputs of the request, in input order. A few are fetched at once.
+             */
+            Future<std::vector<std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>>> getInputTransactions(const std::shared_ptr<Buddy>& buddy);
 
         private:
             void fillInput(const std::shared_ptr<Buddy>& buddy, const BitcoinLikeUtxo& utxo, const uint32_t sequence);
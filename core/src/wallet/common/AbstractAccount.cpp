@@ -228,6 +228,21 @@ namespace ledger {
             pushEvent(event);
         }
 
+        void AbstractAccount::emitDeletedOperationsEvent(const std::vector<std::string>& uids) {
+            if (uids.empty()) {
+                return;
+            }
+            auto payload = DynamicObject::newInstance();
+            auto array = DynamicArray::newInstance();
+            for (const auto& uid : uids) {
+                array->pushString(uid);
+            }
+            payload->putArray(api::Account::EV_DELETED_OP_UIDS, array);
+            payload->putString(api::Account::EV_NEW_OP_WALLET_NAME, getWallet()->getName());
+            payload->putLong(api::Account::EV_NEW_OP_ACCOUNT_INDEX, getIndex());
+            pushEvent(Event::newInstance(api::EventCode::DELETED_OPERATIONS, payload));
+        }
+
         void AbstractAccount::emitEventsNow() {
             auto self = shared_from_this();
             run([self] () {
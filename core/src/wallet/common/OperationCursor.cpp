@@ -0,0 +1,95 @@
+/*
+ *
+ * OperationCursor
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "OperationCursor.h"
+#include "OperationQuery.h"
+#include <api/OperationListCallback.hpp>
+
+namespace ledger {
+    namespace core {
+
+        OperationCursor::OperationCursor(const std::shared_ptr<OperationQuery> &query, int32_t chunkSize)
+            : DedicatedContext(query->getContext()), _query(query), _chunkSize(chunkSize), _exhausted(false) {
+        }
+
+        void OperationCursor::next(const std::shared_ptr<api::OperationListCallback> &callback) {
+            next().callback(_query->_mainContext, callback);
+        }
+
+        Future<std::vector<std::shared_ptr<api::Operation>>> OperationCursor::next() {
+            auto self = shared_from_this();
+            return async<std::vector<std::shared_ptr<api::Operation>>>([=] () {
+                return self->fetch();
+            });
+        }
+
+        void OperationCursor::close() {
+            std::lock_guard<std::mutex> lock(_lock);
+            _exhausted = true;
+            release();
+        }
+
+        std::vector<std::shared_ptr<api::Operation>> OperationCursor::fetch() {
+            std::lock_guard<std::mutex> lock(_lock);
+            std::vector<std::shared_ptr<api::Operation>> operations;
+            if (_exhausted) {
+                return operations;
+            }
+            if (!_rows) {
+                _sql.reset(new soci::session(_query->_pool->getReadonlyPool()));
+                _rows.reset(new soci::rowset<soci::row>(_query->performExecute(*_sql)));
+                _it = _rows->begin();
+            }
+            std::vector<std::shared_ptr<OperationApi>> chunk;
+            chunk.reserve(static_cast<size_t>(_chunkSize));
+            while (chunk.size() < static_cast<size_t>(_chunkSize) && _it != _rows->end()) {
+                chunk.push_back(_query->inflateOperation(*_sql, *_it));
+                ++_it;
+            }
+            if (_query->_fetchCompleteOperation) {
+                _query->inflateCompleteTransactions(*_sql, chunk);
+            }
+            operations.assign(chunk.begin(), chunk.end());
+            if (_it == _rows->end()) {
+                // Give the connection back as soon as the last row is read
+                _exhausted = true;
+                release();
+            }
+            return operations;
+        }
+
+        void OperationCursor::release() {
+            _it = soci::rowset<soci::row>::const_iterator();
+            _rows.reset();
+            _sql.reset();
+        }
+
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ *
+ * OperationCursor
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_OPERATIONCURSOR_H
+#define LEDGER_CORE_OPERATIONCURSOR_H
+
+#include <api/OperationCursor.hpp>
+#include <api/Operation.hpp>
+#include <async/DedicatedContext.hpp>
+#include <soci.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        class OperationQuery;
+
+        /**
+         * Streams the results of an operation query. The statement is prepared on the first fetch and stays open,
+         * together with its read connection, until the cursor is exhausted or closed.
+         */
+        class OperationCursor : public api::OperationCursor, public std::enable_shared_from_this<OperationCursor>,
+                                public DedicatedContext {
+        public:
+            OperationCursor(const std::shared_ptr<OperationQuery>& query, int32_t chunkSize);
+
+            void next(const std::shared_ptr<api::OperationListCallback> &callback) override;
+            Future<std::vector<std::shared_ptr<api::Operation>>> next();
+            void close() override;
+
+        private:
+            std::vector<std::shared_ptr<api::Operation>> fetch();
+            void release();
+
+            std::shared_ptr<OperationQuery> _query;
+            int32_t _chunkSize;
+            std::mutex _lock;
+            bool _exhausted;
+            // Declared in destruction order: the rowset must go before its session
+            std::unique_ptr<soci::session> _sql;
+            std::unique_ptr<soci::rowset<soci::row>> _rows;
+            soci::rowset<soci::row>::const_iterator _it;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_OPERATIONCURSOR_H
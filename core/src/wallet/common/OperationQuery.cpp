@@ -31,9 +31,12 @@
 #include "OperationQuery.h"
 #include <api/OperationListCallback.hpp>
 #include "Operation.h"
+#include "OperationCursor.h"
+#include <utils/DateUtils.hpp>
 #include <database/soci-date.h>
 #include <database/soci-option.h>
 #include <database/soci-number.h>
+#include <database/soci-in.h>
 #include <wallet/bitcoin/database/BitcoinLikeTransactionDatabaseHelper.h>
 #include <wallet/cosmos/database/CosmosLikeTransactionDatabaseHelper.hpp>
 #include <wallet/ethereum/database/EthereumLikeTransactionDatabaseHelper.h>
@@ -59,7 +62,7 @@ namespace ledger {
         std::shared_ptr<api::OperationQuery> OperationQuery::addOrder(api::OperationOrderKey key, bool descending) {
             switch (key) {
                 case api::OperationOrderKey::AMOUNT:
-                    _builder.order("amount", std::move(descending), "o");
+                    orderByAmount("amount", descending);
                     break;
                 case api::OperationOrderKey::DATE:
                     _builder.order("date", std::move(descending), "o");
@@ -77,7 +80,7 @@ namespace ledger {
                     _builder.order("currency_name", std::move(descending), "o");
                     break;
                 case api::OperationOrderKey::FEES:
-                    _builder.order("fees", std::move(descending), "o");
+                    orderByAmount("fees", descending);
                     break;
                 case api::OperationOrderKey::BLOCK_HEIGHT:
                     _builder.order("height", std::move(descending), "b");
@@ -86,6 +89,17 @@ namespace ledger {
             return shared_from_this();
         }
 
+        // Amounts wider than the numeric limbs have NULL limbs (see AmountLimbs), they are greater than all others and
+        // ordered by their hexadecimal form: without leading zeros, a longer string is a larger value. Missing fees
+        // keep the database's NULL ordering.
+        void OperationQuery::orderByAmount(const std::string &column, bool descending) {
+            _builder.order(fmt::format("o.{0}_high IS NULL AND o.{0} IS NOT NULL", column), bool(descending), "");
+            _builder.order(fmt::format("{}_high", column), bool(descending), "o");
+            _builder.order(fmt::format("{}_low", column), bool(descending), "o");
+            _builder.order(fmt::format("LENGTH(o.{})", column), bool(descending), "");
+            _builder.order(std::string(column), bool(descending), "o");
+        }
+
         std::shared_ptr<api::QueryFilter> OperationQuery::filter() {
             return _headFilter;
         }
@@ -110,6 +124,12 @@ namespace ledger {
             return shared_from_this();
         }
 
+        std::shared_ptr<api::OperationQuery> OperationQuery::after(const std::chrono::system_clock::time_point &date,
+                                                                   const std::string &uid) {
+            _builder.seek("date", "uid", "o", DateUtils::toJSON(date), uid);
+            return shared_from_this();
+        }
+
         void OperationQuery::execute(const std::shared_ptr<api::OperationListCallback> &callback) {
            execute().callback(_mainContext, callback);
         }
@@ -124,6 +144,13 @@ namespace ledger {
             });
         }
 
+        std::shared_ptr<api::OperationCursor> OperationQuery::cursor(int32_t chunkSize) {
+            if (chunkSize <= 0) {
+                throw make_exception(api::ErrorCode::ILLEGAL_ARGUMENT, "Cursor chunk size must be positive (got {})", chunkSize);
+            }
+            return std::make_shared<OperationCursor>(shared_from_this(), chunkSize);
+        }
+
         soci::rowset<soci::row> OperationQuery::performExecute(soci::session &sql) {
             return _builder.select(
                             "o.account_uid, o.uid, o.wallet_uid, o.type, o.date, o.senders, o.recipients,"
@@ -135,57 +162,63 @@ namespace ledger {
         }
 
         void OperationQuery::performExecute(std::vector<std::shared_ptr<api::Operation>> &operations) {
-            soci::session sql(_pool->getPool());
+            soci::session sql(_pool->getReadonlyPool());
             soci::rowset<soci::row> rows = performExecute(sql);
 
+            std::vector<std::shared_ptr<OperationApi>> inflated;
             for (auto& row : rows) {
-                auto accountUid = row.get<std::string>(0);
-                auto account = _accounts.find(accountUid);
-                if (account == _accounts.end())
-                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Account {} is not registered.", accountUid);
-
-                std::shared_ptr<OperationApi> operationApi;
-                if(account->second->getWalletType() == api::WalletType::ALGORAND)
-                {
-                    operationApi = std::make_shared<algorand::Operation>(account->second);
-                }
-                else
-                {
-                    operationApi = std::make_shared<OperationApi>(account->second);
-                }
+                inflated.push_back(inflateOperation(sql, row));
+            }
+            if (_fetchCompleteOperation) {
+                inflateCompleteTransactions(sql, inflated);
+            }
+            operations.insert(operations.end(), inflated.begin(), inflated.end());
+        }
 
-                auto& operation = operationApi->getBackend();
-
-                // Inflate abstract operation
-
-                operation.uid = row.get<std::string>(1);
-                operation.walletUid = row.get<std::string>(2);
-                operation.type = api::from_string<api::OperationType >(row.get<std::string>(3));
-                operation.date = row.get<std::chrono::system_clock::time_point>(4);
-                operation.senders = strings::split(row.get<std::string>(5), ",");
-                operation.recipients = strings::split(row.get<std::string>(6), ",");
-                operation.amount = BigInt::fromHex(row.get<std::string>(7));
-                operation.fees = BigInt::fromHex(row.get<std::string>(8));
-                operation.currencyName = row.get<std::string>(9);
-                operation.trust = nullptr;
-                operation.walletType = account->second->getWalletType();
-
-                if (row.get_indicator(11) != soci::i_null) {
-                    // The operation has a block, inflate the block
-                    Block block;
-                    block.hash = row.get<std::string>(11);
-                    block.height = soci::get_number<uint64_t>(row, 12);
-                    block.time = row.get<std::chrono::system_clock::time_point>(13);
-                    block.currencyName = operation.currencyName;
-                    operation.block = Option<Block>(std::move(block));
-                }
+        std::shared_ptr<OperationApi> OperationQuery::inflateOperation(soci::session &sql, const soci::row &row) {
+            auto accountUid = row.get<std::string>(0);
+            auto account = _accounts.find(accountUid);
+            if (account == _accounts.end())
+                throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Account {} is not registered.", accountUid);
 
-                // End of inflate
-                if (_fetchCompleteOperation) {
-                    inflateCompleteTransaction(sql, accountUid, *operationApi);
-                }
-                operations.push_back(operationApi);
+            std::shared_ptr<OperationApi> operationApi;
+            if(account->second->getWalletType() == api::WalletType::ALGORAND)
+            {
+                operationApi = std::make_shared<algorand::Operation>(account->second);
+            }
+            else
+            {
+                operationApi = std::make_shared<OperationApi>(account->second);
+            }
+
+            auto& operation = operationApi->getBackend();
+
+            // Inflate abstract operation
+
+            operation.uid = row.get<std::string>(1);
+            operation.walletUid = row.get<std::string>(2);
+            operation.type = api::from_string<api::OperationType >(row.get<std::string>(3));
+            operation.date = row.get<std::chrono::system_clock::time_point>(4);
+            operation.senders = strings::split(row.get<std::string>(5), ",");
+            operation.recipients = strings::split(row.get<std::string>(6), ",");
+            operation.amount = BigInt::fromHex(row.get<std::string>(7));
+            operation.fees = BigInt::fromHex(row.get<std::string>(8));
+            operation.currencyName = row.get<std::string>(9);
+            operation.trust = nullptr;
+            operation.walletType = account->second->getWalletType();
+
+            if (row.get_indicator(11) != soci::i_null) {
+                // The operation has a block, inflate the block
+                Block block;
+                block.hash = row.get<std::string>(11);
+                block.height = soci::get_number<uint64_t>(row, 12);
+                block.time = row.get<std::chrono::system_clock::time_point>(13);
+                block.currencyName = operation.currencyName;
+                operation.block = Option<Block>(std::move(block));
             }
+
+            // End of inflate
+            return operationApi;
         }
 
         std::shared_ptr<OperationQuery>
@@ -194,6 +227,26 @@ namespace ledger {
             return shared_from_this();
         }
 
+        void OperationQuery::inflateCompleteTransactions(soci::session &sql,
+                                                         const std::vector<std::shared_ptr<OperationApi>> &operations) {
+            // Coins with a batched path fetch their transactions with one query per table for the whole page
+            std::vector<std::shared_ptr<OperationApi>> bitcoinOperations;
+            std::vector<std::shared_ptr<OperationApi>> ethereumOperations;
+            for (const auto& operation : operations) {
+                switch (operation->getAccount()->getWalletType()) {
+                    case (api::WalletType::BITCOIN): bitcoinOperations.push_back(operation); break;
+                    case (api::WalletType::ETHEREUM): ethereumOperations.push_back(operation); break;
+                    default: inflateCompleteTransaction(sql, operation->getAccount()->getAccountUid(), *operation);
+                }
+            }
+            if (!bitcoinOperations.empty()) {
+                inflateBitcoinLikeTransactions(sql, bitcoinOperations);
+            }
+            if (!ethereumOperations.empty()) {
+                inflateEthereumLikeTransactions(sql, ethereumOperations);
+            }
+        }
+
         void OperationQuery::inflateCompleteTransaction(soci::session &sql, const std::string &accountUid, OperationApi &operation) {
             switch (operation.getAccount()->getWalletType()) {
                 case (api::WalletType::BITCOIN): return inflateBitcoinLikeTransaction(sql, accountUid, operation);
@@ -215,6 +268,44 @@ namespace ledger {
             BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, transactionHash, accountUid, operation.getBackend().bitcoinTransaction.getValue());
         }
 
+        void OperationQuery::inflateBitcoinLikeTransactions(soci::session &sql,
+                                                            const std::vector<std::shared_ptr<OperationApi>> &operations) {
+            std::vector<std::string> uids;
+            for (const auto& operation : operations) {
+                uids.push_back(operation->getBackend().uid);
+            }
+            std::unordered_map<std::string, std::string> hashes;
+            db::selectIn(sql, "SELECT uid, transaction_hash FROM bitcoin_operations WHERE uid IN ({})", uids,
+                         [&] (const soci::row& row) {
+                hashes[row.get<std::string>(0)] = row.get<std::string>(1);
+            });
+            std::vector<std::pair<std::string, std::string>> keys;
+            for (const auto& operation : operations) {
+                keys.emplace_back(operation->getAccount()->getAccountUid(), hashes[operation->getBackend().uid]);
+            }
+            auto transactions = BitcoinLikeTransactionDatabaseHelper::getTransactionsByHashes(sql, keys);
+            for (std::size_t index = 0; index < operations.size(); index++) {
+                auto tx = transactions.find(BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(
+                        keys[index].first, keys[index].second));
+                operations[index]->getBackend().bitcoinTransaction = Option<BitcoinLikeBlockchainExplorerTransaction>(
+                        tx != transactions.end() ? tx->second : BitcoinLikeBlockchainExplorerTransaction());
+            }
+        }
+
+        void OperationQuery::inflateEthereumLikeTransactions(soci::session &sql,
+                                                             const std::vector<std::shared_ptr<OperationApi>> &operations) {
+            std::vector<std::string> uids;
+            for (const auto& operation : operations) {
+                uids.push_back(operation->getBackend().uid);
+            }
+            auto transactions = EthereumLikeTransactionDatabaseHelper::getTransactionsByOperationUids(sql, uids);
+            for (const auto& operation : operations) {
+                auto tx = transactions.find(operation->getBackend().uid);
+                operation->getBackend().ethereumTransaction = Option<EthereumLikeBlockchainExplorerTransaction>(
+                        tx != transactions.end() ? tx->second : EthereumLikeBlockchainExplorerTransaction());
+            }
+        }
+
         void OperationQuery::inflateCosmosLikeTransaction(
             soci::session &sql, const std::string &accountUid, OperationApi &operation)
         {
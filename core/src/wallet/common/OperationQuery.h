@@ -66,15 +66,25 @@ namespace ledger {
             std::shared_ptr<api::OperationQuery> limit(int32_t count) override;
             std::shared_ptr<api::OperationQuery> complete() override;
             std::shared_ptr<api::OperationQuery> partial() override;
+            std::shared_ptr<api::OperationQuery> after(const std::chrono::system_clock::time_point &date,
+                                                       const std::string &uid) override;
 
             void execute(const std::shared_ptr<api::OperationListCallback> &callback) override;
             Future<std::vector<std::shared_ptr<api::Operation>>> execute();
+            std::shared_ptr<api::OperationCursor> cursor(int32_t chunkSize) override;
 
             std::shared_ptr<OperationQuery> registerAccount(const  std::shared_ptr<AbstractAccount>& account);
 
         private:
+            friend class OperationCursor;
+
             void performExecute(std::vector<std::shared_ptr<api::Operation>>& operations);
+            void orderByAmount(const std::string& column, bool descending);
+            std::shared_ptr<OperationApi> inflateOperation(soci::session& sql, const soci::row& row);
+            void inflateCompleteTransactions(soci::session& sql, const std::vector<std::shared_ptr<OperationApi>>& operations);
             void inflateCompleteTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
+            void inflateBitcoinLikeTransactions(soci::session& sql, const std::vector<std::shared_ptr<OperationApi>>& operations);
+            void inflateEthereumLikeTransactions(soci::session& sql, const std::vector<std::shared_ptr<OperationApi>>& operations);
             void inflateBitcoinLikeTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
             void inflateCosmosLikeTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
             void inflateRippleLikeTransaction(soci::session& sql, OperationApi& operation);
@@ -35,6 +35,7 @@
 #include <database/soci-date.h>
 #include <database/soci-number.h>
 #include <utils/DateUtils.hpp>
+#include <wallet/bitcoin/database/BitcoinLikeUTXODatabaseHelper.h>
 
 using namespace soci;
 
@@ -126,30 +127,43 @@ namespace ledger {
         {
             if (!blocks.empty())
             {
+                // Every statement selects the rows of the account in the removed blocks by subquery, nothing is read back
+                std::vector<std::string> accountUids(blocks.size(), accountUid);
+                BitcoinLikeUTXODatabaseHelper::restoreSpentUTXOsOfBlocks(sql, accountUid, blocks);
+                sql << "DELETE FROM bitcoin_inputs WHERE uid IN ("
+                       "SELECT ti.input_uid FROM bitcoin_transaction_inputs AS ti "
+                       "JOIN bitcoin_operations AS bop ON bop.transaction_uid = ti.transaction_uid "
+                       "JOIN operations AS op ON op.uid = bop.uid "
+                       "WHERE op.account_uid = :uid AND op.block_uid = :b_uid"
+                       ")",
+                    soci::use(accountUids), soci::use(blocks);
+                sql << "DELETE FROM operations WHERE account_uid = :uid AND block_uid = :b_uid",
+                    soci::use(accountUids), soci::use(blocks);
+                // Transaction uids are per account, the ones left without operation were the account's
+                sql << "DELETE FROM bitcoin_transactions WHERE block_uid = :b_uid AND NOT EXISTS ("
+                       "SELECT 1 FROM bitcoin_operations AS bop "
+                       "WHERE bop.transaction_uid = bitcoin_transactions.transaction_uid"
+                       ")",
+                    soci::use(blocks);
                 sql << "DELETE FROM blocks where uid IN (:uids)",
                     soci::use(blocks);
-
-                soci::rowset<std::string> rows_tx = (sql.prepare << "SELECT transaction_uid FROM bitcoin_operations AS bop "
-                                                                    "JOIN operations AS op ON bop.uid = op.uid "
-                                                                    "WHERE op.account_uid = :uid AND op.block_uid IN (:b_uids)",
-                                                     soci::use(accountUid), soci::use(blocks));
-
-                std::vector<std::string> txToDelete(rows_tx.begin(), rows_tx.end());
-                if (!txToDelete.empty())
-                {
-                    sql << "DELETE FROM bitcoin_inputs WHERE uid IN ("
-                           "SELECT input_uid FROM bitcoin_transaction_inputs "
-                           "WHERE transaction_uid IN(:uids)"
-                           ")",
-                        soci::use(txToDelete);
-                    sql << "DELETE FROM operations WHERE account_uid = :uid AND block_uid is IN (:b_uids)",
-                        soci::use(accountUid), soci::use(blocks);
-                    sql << "DELETE FROM bitcoin_transactions "
-                           "WHERE transaction_uid IN (:uids)",
-                        soci::use(txToDelete);
-                }
+                BitcoinLikeUTXODatabaseHelper::removeSpentUTXOs(sql, accountUid);
             }
         }
 
+        void AccountDatabaseHelper::removeBlocksAboveHeight(soci::session& sql, const std::string& accountUid, const std::string& currencyName, int64_t blockHeight)
+        {
+            // Every statement is a range on blocks (currency_name, height), no uid is sent back and forth
+            sql << "DELETE FROM operations WHERE account_uid = :uid AND block_uid IN ("
+                   "SELECT uid FROM blocks WHERE currency_name = :currency AND height > :height"
+                   ")",
+                soci::use(accountUid), soci::use(currencyName), soci::use(blockHeight);
+            // Blocks still holding operations of other accounts are left to their own synchronization
+            sql << "DELETE FROM blocks WHERE currency_name = :currency AND height > :height AND NOT EXISTS ("
+                   "SELECT 1 FROM operations AS op WHERE op.block_uid = blocks.uid"
+                   ")",
+                soci::use(currencyName), soci::use(blockHeight);
+        }
+
     }
 }
\ No newline at end of file
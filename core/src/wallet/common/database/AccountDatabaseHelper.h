@@ -46,6 +46,8 @@ namespace ledger {
             static void createAccount(soci::session& sql, const std::string& walletUid, int32_t index);
             static void removeAccount(soci::session& sql, const std::string& walletUid, int32_t index);
             static void removeBlockOperation(soci::session& sql, const std::string& accountUid,  const std::vector<std::string> blocks);
+            // Remove the operations of the account above the given height, then the blocks of the currency no operation refers to
+            static void removeBlocksAboveHeight(soci::session& sql, const std::string& accountUid, const std::string& currencyName, int64_t blockHeight);
             static std::string createAccountUid(const std::string& walletUid, int32_t accountIndex);
             static std::string createERC20AccountUid(const std::string &ethAccountUid, const std::string &contractAddress);
             static int32_t computeNextAccountIndex(soci::session& sql, const std::string& walletUid);
@@ -0,0 +1,101 @@
+/*
+ *
+ * AmountLimbs.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "AmountLimbs.hpp"
+#include <fmt/format.h>
+#include <api/ErrorCode.hpp>
+#include <utils/Exception.hpp>
+
+namespace ledger {
+    namespace core {
+
+        bool AmountLimbs::isEmpty() const {
+            return high.isEmpty() || low.isEmpty();
+        }
+
+        AmountLimbs AmountLimbs::fromBigInt(const BigInt &value) {
+            AmountLimbs limbs;
+            if (value.isNegative()) {
+                return limbs;
+            }
+            auto bytes = value.toByteArray();
+            auto it = bytes.begin();
+            while (it != bytes.end() && *it == 0) {
+                it++;
+            }
+            const auto lowBytes = LOW_BITS / 8;
+            auto significant = static_cast<size_t>(std::distance(it, bytes.end()));
+            if (significant > sizeof(int64_t) + lowBytes ||
+                (significant == sizeof(int64_t) + lowBytes && (*it & 0x80) != 0)) {
+                return limbs;
+            }
+            uint64_t high = 0;
+            uint64_t low = 0;
+            for (; it != bytes.end(); it++, significant--) {
+                if (significant > lowBytes) {
+                    high = (high << 8) | *it;
+                } else {
+                    low = (low << 8) | *it;
+                }
+            }
+            limbs.high = static_cast<int64_t>(high);
+            limbs.low = static_cast<int64_t>(low);
+            return limbs;
+        }
+
+        BigInt AmountLimbs::toBigInt(int64_t high, int64_t low) {
+            static const BigInt BASE(static_cast<int64_t>(1) << LOW_BITS);
+            return BigInt(high) * BASE + BigInt(low);
+        }
+
+        std::string AmountLimbs::compare(const std::string &column, const std::string &symbol, const BigInt &value) {
+            if (symbol != "<" && symbol != "<=" && symbol != ">" && symbol != ">=") {
+                throw make_exception(api::ErrorCode::ILLEGAL_ARGUMENT, "Unsupported amount comparison '{}'", symbol);
+            }
+            const auto greater = symbol[0] == '>';
+            if (value.isNegative()) {
+                // Stored amounts are never negative
+                return greater ? "1 = 1" : "1 = 0";
+            }
+            auto limbs = fromBigInt(value);
+            if (limbs.isEmpty()) {
+                // Only wide amounts may compare greater than a value that doesn't fit the limbs
+                return fmt::format(greater ? "{}_high IS NULL" : "{}_high IS NOT NULL", column);
+            }
+            auto condition = fmt::format("{0}_high {1} {2} OR ({0}_high = {2} AND {0}_low {3} {4})",
+                                         column, symbol.substr(0, 1), limbs.high.getValue(), symbol, limbs.low.getValue());
+            if (greater) {
+                condition += fmt::format(" OR {}_high IS NULL", column);
+            }
+            return fmt::format("({})", condition);
+        }
+    }
+}
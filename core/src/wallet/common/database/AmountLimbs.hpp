@@ -0,0 +1,77 @@
+/*
+ *
+ * AmountLimbs.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_AMOUNTLIMBS_HPP
+#define LEDGER_CORE_AMOUNTLIMBS_HPP
+
+#include <cstdint>
+#include <string>
+#include <math/BigInt.h>
+#include <utils/Option.hpp>
+
+namespace ledger {
+    namespace core {
+        /**
+         * Numeric representation of an amount stored next to its hexadecimal form, so that the database is able to
+         * order, filter and sum amounts by itself.
+         *
+         * A value is split as high * 2^32 + low. Keeping the low limb on 32 bits lets SUM() add billions of rows
+         * without overflowing a 64-bit integer, while the 63-bit high limb covers amounts up to 95 bits (every
+         * native coin and 18-decimal tokens). Wider or negative values are stored with empty limbs and only
+         * exist as hexadecimal.
+         */
+        struct AmountLimbs {
+            static const int LOW_BITS = 32;
+
+            Option<int64_t> high;
+            Option<int64_t> low;
+
+            bool isEmpty() const;
+
+            static AmountLimbs fromBigInt(const BigInt& value);
+
+            /**
+             * Rebuild a value from its limbs. Limbs may come from SUM() and therefore be negative or larger than
+             * 32 bits for the low one.
+             */
+            static BigInt toBigInt(int64_t high, int64_t low);
+
+            /**
+             * SQL condition comparing the limbs of the given column with a value. Supported symbols are
+             * <, <=, > and >=.
+             * @param column Prefixed column name without limb suffix (e.g. "o.amount")
+             */
+            static std::string compare(const std::string& column, const std::string& symbol, const BigInt& value);
+        };
+    }
+}
+
+#endif //LEDGER_CORE_AMOUNTLIMBS_HPP
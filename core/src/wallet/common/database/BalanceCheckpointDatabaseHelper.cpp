@@ -0,0 +1,346 @@
+/*
+ *
+ * BalanceCheckpointDatabaseHelper.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "BalanceCheckpointDatabaseHelper.h"
+#include "BalanceHistoryDatabaseHelper.h"
+#include <database/soci-date.h>
+#include <database/soci-number.h>
+#include <database/soci-option.h>
+#include <database/StatementCache.hpp>
+#include <utils/DateUtils.hpp>
+#include <wallet/common/database/AmountLimbs.hpp>
+#include <set>
+#include <unordered_map>
+
+using namespace soci;
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            // Signed sum of amounts kept as limbs
+            struct Delta {
+                int64_t high = 0;
+                int64_t low = 0;
+                bool wide = false;
+
+                void add(const Delta& other) {
+                    high += other.high;
+                    low += other.low;
+                    wide = wide || other.wide;
+                }
+
+                Delta minus(const Delta& other) const {
+                    Delta result = *this;
+                    result.high -= other.high;
+                    result.low -= other.low;
+                    result.wide = wide || other.wide;
+                    return result;
+                }
+
+                Option<BigInt> toBigInt() const {
+                    if (wide) {
+                        return Option<BigInt>();
+                    }
+                    return Option<BigInt>(AmountLimbs::toBigInt(high, low));
+                }
+            };
+
+            bool isNull(const row& r, std::size_t pos) {
+                return r.get_indicator(pos) == i_null;
+            }
+
+            // Columns: date, type, amount_high, amount_low, fees, fees_high, fees_low
+            const std::string SIGNED_OPERATIONS =
+                    "SELECT op.date, op.type, op.amount_high, op.amount_low, op.fees, op.fees_high, op.fees_low"
+                    " FROM operations AS op WHERE op.account_uid = :uid";
+
+            Delta operationDelta(const row& r) {
+                Delta delta;
+                auto type = r.get<std::string>(1);
+                if (type != "RECEIVE" && type != "SEND") {
+                    return delta;
+                }
+                if (isNull(r, 2) || isNull(r, 3)) {
+                    delta.wide = true;
+                    return delta;
+                }
+                delta.high = get_number<int64_t>(r, 2);
+                delta.low = get_number<int64_t>(r, 3);
+                if (type == "SEND") {
+                    delta.high = -delta.high;
+                    delta.low = -delta.low;
+                    if (!isNull(r, 4)) {
+                        if (isNull(r, 5) || isNull(r, 6)) {
+                            delta.wide = true;
+                            return delta;
+                        }
+                        delta.high -= get_number<int64_t>(r, 5);
+                        delta.low -= get_number<int64_t>(r, 6);
+                    }
+                }
+                return delta;
+            }
+
+            Delta checkpointBalance(const row& r) {
+                Delta balance;
+                if (isNull(r, 1) || isNull(r, 2)) {
+                    balance.wide = true;
+                } else {
+                    balance.high = get_number<int64_t>(r, 1);
+                    balance.low = get_number<int64_t>(r, 2);
+                }
+                return balance;
+            }
+
+            struct ConfirmedSumBinding {
+                std::string uid;
+                std::chrono::system_clock::time_point from;
+                std::chrono::system_clock::time_point to;
+                long long high;
+                long long low;
+                long long wide;
+                long long count;
+            };
+
+            const auto CONFIRMED_SUM = db::stmt<ConfirmedSumBinding>(
+                    "SELECT"
+                    " COALESCE(SUM(CASE WHEN op.type = 'RECEIVE' THEN op.amount_high"
+                    " WHEN op.type = 'SEND' THEN -op.amount_high - COALESCE(op.fees_high, 0) ELSE 0 END), 0),"
+                    " COALESCE(SUM(CASE WHEN op.type = 'RECEIVE' THEN op.amount_low"
+                    " WHEN op.type = 'SEND' THEN -op.amount_low - COALESCE(op.fees_low, 0) ELSE 0 END), 0),"
+                    " COALESCE(SUM(CASE WHEN op.type IN ('RECEIVE', 'SEND') AND (op.amount_high IS NULL OR"
+                    " (op.type = 'SEND' AND op.fees IS NOT NULL AND op.fees_high IS NULL)) THEN 1 ELSE 0 END), 0),"
+                    " COUNT(*)"
+                    " FROM operations AS op WHERE op.account_uid = :uid AND op.block_uid IS NOT NULL"
+                    " AND op.date >= :from AND op.date <= :to", [] (auto& s, auto& b) {
+                        s, use(b.uid), use(b.from), use(b.to), into(b.high), into(b.low), into(b.wide), into(b.count);
+                    });
+
+            // Sum of the confirmed operations between two dates, both included
+            Delta confirmedChange(soci::session& sql,
+                                  const std::string& accountUid,
+                                  const std::chrono::system_clock::time_point& from,
+                                  const std::chrono::system_clock::time_point& to,
+                                  long long& count) {
+                auto stmt = db::cached(sql, CONFIRMED_SUM);
+                stmt->bindings.uid = accountUid;
+                stmt->bindings.from = from;
+                stmt->bindings.to = to;
+                stmt->bindings.high = 0;
+                stmt->bindings.low = 0;
+                stmt->bindings.wide = 0;
+                stmt->bindings.count = 0;
+                stmt->execute();
+                Delta change;
+                change.high = stmt->bindings.high;
+                change.low = stmt->bindings.low;
+                change.wide = stmt->bindings.wide > 0;
+                count = stmt->bindings.count;
+                return change;
+            }
+
+            Option<Delta> findCheckpoint(soci::session& sql,
+                                         const std::string& accountUid,
+                                         const std::string& condition,
+                                         const std::chrono::system_clock::time_point& day) {
+                rowset<row> rows = (sql.prepare << "SELECT day, balance_high, balance_low FROM balance_checkpoints"
+                                                   " WHERE account_uid = :uid AND day " << condition << " :day"
+                                                   " ORDER BY day DESC LIMIT 1",
+                        use(accountUid), use(day));
+                for (auto& r : rows) {
+                    return Option<Delta>(checkpointBalance(r));
+                }
+                return Option<Delta>();
+            }
+
+            // Pending operations, oldest first
+            std::vector<std::pair<std::chrono::system_clock::time_point, Delta>> pendingDeltas(soci::session& sql,
+                                                                                                const std::string& accountUid) {
+                std::vector<std::pair<std::chrono::system_clock::time_point, Delta>> deltas;
+                rowset<row> rows = (sql.prepare << SIGNED_OPERATIONS << " AND op.block_uid IS NULL ORDER BY op.date",
+                        use(accountUid));
+                for (auto& r : rows) {
+                    deltas.emplace_back(DateUtils::fromJSON(r.get<std::string>(0)), operationDelta(r));
+                }
+                return deltas;
+            }
+        }
+
+        std::chrono::system_clock::time_point BalanceCheckpointDatabaseHelper::startOfDay(const std::chrono::system_clock::time_point& date) {
+            auto hours = std::chrono::duration_cast<std::chrono::hours>(date.time_since_epoch()).count();
+            return std::chrono::system_clock::time_point(std::chrono::hours(hours - hours % 24));
+        }
+
+        void BalanceCheckpointDatabaseHelper::update(soci::session& sql, const OperationBinding& operations) {
+            // A mined operation keeps the date it was first seen with in the mempool, the previous day is touched too
+            std::unordered_map<std::string, std::set<std::chrono::system_clock::time_point>> touchedDays;
+            for (std::size_t i = 0; i < operations.uid.size(); i++) {
+                auto& days = touchedDays[operations.accountUid[i]];
+                days.insert(startOfDay(operations.date[i]));
+                days.insert(startOfDay(operations.date[i] - std::chrono::hours(24)));
+            }
+            for (const auto& account : touchedDays) {
+                // Days are updated in order, each one relies on the checkpoint of the previous one
+                for (const auto& day : account.second) {
+                    if (!updateDay(sql, account.first, day)) {
+                        rebuild(sql, account.first, day);
+                        break;
+                    }
+                }
+            }
+        }
+
+        bool BalanceCheckpointDatabaseHelper::updateDay(soci::session& sql,
+                                                        const std::string& accountUid,
+                                                        const std::chrono::system_clock::time_point& day) {
+            auto previous = findCheckpoint(sql, accountUid, "<", day).getValueOr(Delta());
+            auto current = findCheckpoint(sql, accountUid, "=", day);
+            long long count = 0;
+            auto change = confirmedChange(sql, accountUid, day, day + std::chrono::hours(24) - std::chrono::seconds(1), count);
+            if (previous.wide || change.wide || (current.nonEmpty() && current.getValue().wide)) {
+                // Limbs can't tell the change, the caller rebuilds from this day
+                return false;
+            }
+
+            // Shift of the following checkpoints
+            Delta shift;
+            if (count == 0) {
+                if (current.isEmpty()) {
+                    return true;
+                }
+                sql << "DELETE FROM balance_checkpoints WHERE account_uid = :uid AND day = :day", use(accountUid), use(day);
+                shift = previous.minus(current.getValue());
+            } else {
+                auto balance = previous;
+                balance.add(change);
+                sql << "INSERT INTO balance_checkpoints VALUES(:uid, :day, :balance_high, :balance_low)"
+                       " ON CONFLICT(account_uid, day) DO UPDATE SET balance_high = :balance_high, balance_low = :balance_low",
+                    use(accountUid, "uid"), use(day, "day"), use(balance.high, "balance_high"), use(balance.low, "balance_low");
+                shift = current.nonEmpty() ? balance.minus(current.getValue()) : change;
+            }
+            if (shift.high != 0 || shift.low != 0) {
+                sql << "UPDATE balance_checkpoints SET balance_high = balance_high + :high, balance_low = balance_low + :low"
+                       " WHERE account_uid = :uid AND day > :day",
+                    use(shift.high), use(shift.low), use(accountUid), use(day);
+            }
+            return true;
+        }
+
+        void BalanceCheckpointDatabaseHelper::refresh(soci::session& sql,
+                                                      const std::string& accountUid,
+                                                      const std::chrono::system_clock::time_point& from) {
+            int count = 0;
+            sql << "SELECT COUNT(*) FROM balance_checkpoints WHERE account_uid = :uid", use(accountUid), into(count);
+            if (count > 0) {
+                rebuild(sql, accountUid, from);
+            }
+        }
+
+        void BalanceCheckpointDatabaseHelper::rebuild(soci::session& sql,
+                                                      const std::string& accountUid,
+                                                      const std::chrono::system_clock::time_point& from) {
+            auto day = startOfDay(from);
+            sql << "DELETE FROM balance_checkpoints WHERE account_uid = :uid AND day >= :day", use(accountUid), use(day);
+
+            auto balance = findCheckpoint(sql, accountUid, "<", day).getValueOr(Delta());
+
+            std::vector<std::string> uids;
+            std::vector<std::string> days;
+            std::vector<Option<int64_t>> highs;
+            std::vector<Option<int64_t>> lows;
+            auto checkpoint = [&] (const std::chrono::system_clock::time_point& checkpointDay) {
+                uids.push_back(accountUid);
+                days.push_back(DateUtils::toJSON(checkpointDay));
+                highs.push_back(balance.wide ? Option<int64_t>() : Option<int64_t>(balance.high));
+                lows.push_back(balance.wide ? Option<int64_t>() : Option<int64_t>(balance.low));
+            };
+
+            Option<std::chrono::system_clock::time_point> currentDay;
+            rowset<row> rows = (sql.prepare << SIGNED_OPERATIONS << " AND op.block_uid IS NOT NULL AND op.date >= :day"
+                                               " ORDER BY op.date", use(accountUid), use(day));
+            for (auto& r : rows) {
+                auto operationDay = startOfDay(DateUtils::fromJSON(r.get<std::string>(0)));
+                if (currentDay.nonEmpty() && currentDay.getValue() != operationDay) {
+                    checkpoint(currentDay.getValue());
+                }
+                currentDay = operationDay;
+                balance.add(operationDelta(r));
+            }
+            if (currentDay.nonEmpty()) {
+                checkpoint(currentDay.getValue());
+            }
+            if (!uids.empty()) {
+                sql << "INSERT INTO balance_checkpoints VALUES(:uid, :day, :balance_high, :balance_low)",
+                    use(uids), use(days), use(highs), use(lows);
+            }
+        }
+
+        Option<BigInt> BalanceCheckpointDatabaseHelper::getBalance(soci::session& sql, const std::string& accountUid) {
+            Delta balance;
+            rowset<row> rows = (sql.prepare << "SELECT day, balance_high, balance_low FROM balance_checkpoints"
+                                               " WHERE account_uid = :uid ORDER BY day DESC LIMIT 1", use(accountUid));
+            for (auto& r : rows) {
+                balance = checkpointBalance(r);
+            }
+            for (const auto& pending : pendingDeltas(sql, accountUid)) {
+                balance.add(pending.second);
+            }
+            return balance.toBigInt();
+        }
+
+        Option<std::vector<BigInt>> BalanceCheckpointDatabaseHelper::getBalanceHistory(soci::session& sql,
+                                                                                       const std::string& accountUid,
+                                                                                       const std::chrono::system_clock::time_point& start,
+                                                                                       const std::chrono::system_clock::time_point& end,
+                                                                                       api::TimePeriod precision) {
+            // Balance at the start date: checkpoint of the preceding day, confirmed operations of the day so far
+            // and pending operations
+            auto day = startOfDay(start);
+            auto opening = findCheckpoint(sql, accountUid, "<", day).getValueOr(Delta());
+            long long count = 0;
+            opening.add(confirmedChange(sql, accountUid, day, start, count));
+            for (const auto& pending : pendingDeltas(sql, accountUid)) {
+                if (pending.first <= start) {
+                    opening.add(pending.second);
+                }
+            }
+            auto openingBalance = opening.toBigInt();
+            if (openingBalance.isEmpty()) {
+                return Option<std::vector<BigInt>>();
+            }
+
+            // Confirmed and pending operations of the window are bucketed by the database
+            return BalanceHistoryDatabaseHelper::getBalanceHistory(sql, " FROM operations AS op WHERE op.account_uid = :uid",
+                                                                   accountUid, openingBalance.getValue(),
+                                                                   start, end, precision);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ *
+ * BalanceCheckpointDatabaseHelper.h
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_BALANCECHECKPOINTDATABASEHELPER_H
+#define LEDGER_CORE_BALANCECHECKPOINTDATABASEHELPER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <soci.h>
+#include <api/TimePeriod.hpp>
+#include <math/BigInt.h>
+#include <utils/Option.hpp>
+#include <wallet/common/database/BulkInsertDatabaseHelper.hpp>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Per account balance at the end of each UTC day having confirmed operations, stored in balance_checkpoints.
+         * A RECEIVE adds its amount, a SEND removes its amount and fees.
+         *
+         * Only currencies reading checkpoints write them (bitcoin, ripple, stellar and cosmos), from their bulk
+         * insert. Written operations update the checkpoint of their days and shift the following ones by the same
+         * change, erased data and reorganizations rebuild the checkpoints of the account from the first removed day.
+         * Pending operations are never part of a checkpoint and are added by readers, so that dropping them from the
+         * mempool needs no maintenance. Balances relying on amounts too wide for numeric columns are stored as NULL
+         * and readers answer none, callers then fall back to summing operations.
+         *
+         * Checkpoints follow the operations table, so they are not written for ethereum (internal operations and
+         * token fees), tezos (operations shared with originated accounts) and algorand (balances built from its own
+         * transactions table, with rewards and close amounts), whose history does not follow the rule above.
+         */
+        class BalanceCheckpointDatabaseHelper {
+        public:
+            /**
+             * Update the checkpoints of the days of freshly upserted operations.
+             */
+            static void update(soci::session& sql, const OperationBinding& operations);
+
+            /**
+             * Rebuild the checkpoints of an account from the day of the given date, after operations were removed.
+             * Accounts without checkpoints, those of currencies not reading them, are left untouched.
+             */
+            static void refresh(soci::session& sql,
+                                const std::string& accountUid,
+                                const std::chrono::system_clock::time_point& from);
+
+            /**
+             * Current balance: last checkpoint and pending operations. Bitcoin accounts keep answering their balance
+             * from the UTXO set, which stays right when the history of spent outputs is incomplete.
+             */
+            static Option<BigInt> getBalance(soci::session& sql, const std::string& accountUid);
+
+            /**
+             * Balance at the end of each period between start and end, with the layout of
+             * AbstractAccount::getBalanceHistory.
+             */
+            static Option<std::vector<BigInt>> getBalanceHistory(soci::session& sql,
+                                                                 const std::string& accountUid,
+                                                                 const std::chrono::system_clock::time_point& start,
+                                                                 const std::chrono::system_clock::time_point& end,
+                                                                 api::TimePeriod precision);
+
+            static std::chrono::system_clock::time_point startOfDay(const std::chrono::system_clock::time_point& date);
+
+        private:
+            static bool updateDay(soci::session& sql,
+                                  const std::string& accountUid,
+                                  const std::chrono::system_clock::time_point& day);
+            static void rebuild(soci::session& sql,
+                                const std::string& accountUid,
+                                const std::chrono::system_clock::time_point& from);
+        };
+    }
+}
+
+#endif //LEDGER_CORE_BALANCECHECKPOINTDATABASEHELPER_H
@@ -0,0 +1,154 @@
+/*
+ *
+ * BalanceHistoryDatabaseHelper.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "BalanceHistoryDatabaseHelper.h"
+#include <fmt/format.h>
+#include <database/soci-date.h>
+#include <database/soci-number.h>
+#include <utils/DateUtils.hpp>
+#include <wallet/common/database/AmountLimbs.hpp>
+
+using namespace soci;
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            // Dates are stored as YYYY-MM-DDTHH:MM:SSZ, a group is every date sharing its first `length` characters
+            struct Granularity {
+                std::size_t length;
+                std::string suffix;
+            };
+
+            const Granularity DAY_GROUP{10, "T00:00:00Z"};
+            const Granularity HOUR_GROUP{13, ":00:00Z"};
+            const Granularity MINUTE_GROUP{16, ":00Z"};
+            const Granularity SECOND_GROUP{19, "Z"};
+
+            // Widest group never straddling a period end, given a period end and the precision
+            Granularity granularityFor(const std::chrono::system_clock::time_point& point, api::TimePeriod precision) {
+                auto date = DateUtils::toJSON(point);
+                auto alignedOn = [&] (const Granularity& granularity) {
+                    return date.compare(granularity.length, std::string::npos, granularity.suffix) == 0;
+                };
+                if (precision != api::TimePeriod::HOUR && alignedOn(DAY_GROUP)) {
+                    return DAY_GROUP;
+                } else if (alignedOn(HOUR_GROUP)) {
+                    return HOUR_GROUP;
+                } else if (alignedOn(MINUTE_GROUP)) {
+                    return MINUTE_GROUP;
+                }
+                return SECOND_GROUP;
+            }
+
+            const std::string SIGNED_HIGH =
+                    "CASE WHEN op.type = 'RECEIVE' THEN op.amount_high"
+                    " WHEN op.type = 'SEND' THEN -op.amount_high - COALESCE(op.fees_high, 0) ELSE 0 END";
+            const std::string SIGNED_LOW =
+                    "CASE WHEN op.type = 'RECEIVE' THEN op.amount_low"
+                    " WHEN op.type = 'SEND' THEN -op.amount_low - COALESCE(op.fees_low, 0) ELSE 0 END";
+            const std::string WIDE =
+                    "CASE WHEN op.type IN ('RECEIVE', 'SEND') AND (op.amount_high IS NULL OR"
+                    " (op.type = 'SEND' AND op.fees IS NOT NULL AND op.fees_high IS NULL)) THEN 1 ELSE 0 END";
+
+            // Balance change of a group, split between the operations dated at its very start and the others
+            struct Group {
+                std::chrono::system_clock::time_point start;
+                int64_t startHigh;
+                int64_t startLow;
+                int64_t restHigh;
+                int64_t restLow;
+            };
+        }
+
+        Option<std::vector<BigInt>> BalanceHistoryDatabaseHelper::getBalanceHistory(soci::session& sql,
+                                                                                    const std::string& operations,
+                                                                                    const std::string& accountUid,
+                                                                                    const BigInt& opening,
+                                                                                    const std::chrono::system_clock::time_point& start,
+                                                                                    const std::chrono::system_clock::time_point& end,
+                                                                                    api::TimePeriod precision) {
+            // A value for the end of each period starting before the end date
+            std::vector<std::chrono::system_clock::time_point> points;
+            for (auto lowerDate = start; lowerDate < end; lowerDate = DateUtils::incrementDate(lowerDate, precision)) {
+                points.push_back(DateUtils::incrementDate(lowerDate, precision));
+            }
+            std::vector<BigInt> values;
+            if (points.empty()) {
+                return Option<std::vector<BigInt>>(values);
+            }
+
+            auto granularity = granularityFor(points.front(), precision);
+            auto key = fmt::format("SUBSTR(op.date, 1, {})", granularity.length);
+            auto atStart = fmt::format("SUBSTR(op.date, {}) = '{}'", granularity.length + 1, granularity.suffix);
+            std::vector<Group> groups;
+            rowset<row> rows = (sql.prepare <<
+                    "SELECT " << key << ","
+                    " SUM(CASE WHEN " << atStart << " THEN " << SIGNED_HIGH << " ELSE 0 END),"
+                    " SUM(CASE WHEN " << atStart << " THEN " << SIGNED_LOW << " ELSE 0 END),"
+                    " SUM(CASE WHEN " << atStart << " THEN 0 ELSE " << SIGNED_HIGH << " END),"
+                    " SUM(CASE WHEN " << atStart << " THEN 0 ELSE " << SIGNED_LOW << " END),"
+                    " SUM(" << WIDE << ")"
+                    << operations << " AND op.date > :start AND op.date <= :last"
+                    " GROUP BY " << key << " ORDER BY " << key,
+                    use(accountUid), use(start), use(points.back()));
+            for (auto& r : rows) {
+                if (get_number<int64_t>(r, 5) > 0) {
+                    return Option<std::vector<BigInt>>();
+                }
+                groups.push_back(Group {
+                    DateUtils::fromJSON(r.get<std::string>(0) + granularity.suffix),
+                    get_number<int64_t>(r, 1), get_number<int64_t>(r, 2),
+                    get_number<int64_t>(r, 3), get_number<int64_t>(r, 4)
+                });
+            }
+
+            // Points are aligned on groups: a group starting at a point ends its period, the remainder of the
+            // group belongs to the following periods
+            int64_t high = 0;
+            int64_t low = 0;
+            std::size_t startIndex = 0;
+            std::size_t restIndex = 0;
+            values.reserve(points.size());
+            for (const auto& point : points) {
+                for (; startIndex < groups.size() && groups[startIndex].start <= point; startIndex++) {
+                    high += groups[startIndex].startHigh;
+                    low += groups[startIndex].startLow;
+                }
+                for (; restIndex < groups.size() && groups[restIndex].start < point; restIndex++) {
+                    high += groups[restIndex].restHigh;
+                    low += groups[restIndex].restLow;
+                }
+                values.push_back(opening + AmountLimbs::toBigInt(high, low));
+            }
+            return Option<std::vector<BigInt>>(values);
+        }
+    }
+}
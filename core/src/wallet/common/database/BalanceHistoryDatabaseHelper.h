@@ -0,0 +1,71 @@
+/*
+ *
+ * BalanceHistoryDatabaseHelper.h
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_BALANCEHISTORYDATABASEHELPER_H
+#define LEDGER_CORE_BALANCEHISTORYDATABASEHELPER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <soci.h>
+#include <api/TimePeriod.hpp>
+#include <math/BigInt.h>
+#include <utils/Option.hpp>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Balance history summed by the database: operations are grouped on a prefix of their date, which is
+         * the date truncated to the day, hour, minute or second on every backend, and only the groups are
+         * walked to build the periods.
+         */
+        class BalanceHistoryDatabaseHelper {
+        public:
+            /**
+             * Balance at the end of each period between start and end, with the layout of
+             * AbstractAccount::getBalanceHistory. A RECEIVE adds its amount, a SEND removes its amount and fees.
+             * Empty if one of the operations is too wide to be summed by the database.
+             * @param operations FROM and WHERE clauses selecting the operations as "op", binding the account
+             * uid as :uid
+             * @param opening Balance at the start date (inclusive)
+             */
+            static Option<std::vector<BigInt>> getBalanceHistory(soci::session& sql,
+                                                                 const std::string& operations,
+                                                                 const std::string& accountUid,
+                                                                 const BigInt& opening,
+                                                                 const std::chrono::system_clock::time_point& start,
+                                                                 const std::chrono::system_clock::time_point& end,
+                                                                 api::TimePeriod precision);
+        };
+    }
+}
+
+#endif //LEDGER_CORE_BALANCEHISTORYDATABASEHELPER_H
@@ -33,17 +33,47 @@
 #include <fmt/format.h>
 #include <database/soci-date.h>
 #include <database/soci-number.h>
+#include <database/StatementCache.hpp>
 
 using namespace soci;
 
 namespace ledger {
     namespace core {
 
+        namespace {
+            struct BlockExistsBinding {
+                std::string uid;
+                int32_t count;
+            };
+
+            const auto BLOCK_EXISTS = db::stmt<BlockExistsBinding>(
+                    "SELECT COUNT(*) FROM blocks WHERE uid = :uid", [] (auto& s, auto& b) {
+                        s, use(b.uid), into(b.count);
+                    });
+
+            struct InsertBlockBinding {
+                std::string uid;
+                std::string hash;
+                uint64_t height;
+                std::chrono::system_clock::time_point time;
+                std::string currencyName;
+            };
+
+            const auto INSERT_BLOCK = db::stmt<InsertBlockBinding>(
+                    "INSERT INTO blocks VALUES(:uid, :hash, :height, :time, :currency_name)", [] (auto& s, auto& b) {
+                        s, use(b.uid), use(b.hash), use(b.height), use(b.time), use(b.currencyName);
+                    });
+        }
+
         bool BlockDatabaseHelper::putBlock(soci::session &sql, const Block &block) {
             if (!blockExists(sql, block.hash, block.currencyName)) {
-                auto uid = createBlockUid(block);
-                sql << "INSERT INTO blocks VALUES(:uid, :hash, :height, :time, :currency_name)",
-                        use(uid), use(block.hash), use(block.height), use(block.time), use(block.currencyName);
+                auto stmt = db::cached(sql, INSERT_BLOCK);
+                stmt->bindings.uid = createBlockUid(block);
+                stmt->bindings.hash = block.hash;
+                stmt->bindings.height = block.height;
+                stmt->bindings.time = block.time;
+                stmt->bindings.currencyName = block.currencyName;
+                stmt->execute();
                 return true;
             }
             return false;
@@ -56,10 +86,11 @@ namespace ledger {
 
         bool BlockDatabaseHelper::blockExists(soci::session &sql, const std::string &blockHash,
                                               const std::string &currencyName) {
-            auto count = 0;
-            auto uid = createBlockUid(blockHash, currencyName);
-            sql << "SELECT COUNT(*) FROM blocks WHERE uid = :uid", use(uid), into(count);
-            return count > 0;
+            auto stmt = db::cached(sql, BLOCK_EXISTS);
+            stmt->bindings.uid = createBlockUid(blockHash, currencyName);
+            stmt->bindings.count = 0;
+            stmt->execute();
+            return stmt->bindings.count > 0;
         }
 
         std::string BlockDatabaseHelper::createBlockUid(const std::string &blockhash, const std::string &currencyName) {
@@ -105,5 +136,17 @@ namespace ledger {
             }
             return Option<api::Block>();
         }
+
+        std::vector<api::Block> BlockDatabaseHelper::getBlocksBelowHeight(soci::session &sql, const std::string &currencyName, int64_t blockHeight) {
+            soci::rowset<soci::row> rows = (sql.prepare << "SELECT uid, hash, height, time FROM blocks WHERE "
+                    "currency_name = :name AND height < :blockHeight ORDER BY height DESC",
+                    soci::use(currencyName), soci::use(blockHeight));
+
+            std::vector<api::Block> blocks;
+            for (auto& row : rows) {
+                blocks.push_back(getBlockFromRow(row, currencyName).getValue());
+            }
+            return blocks;
+        }
     }
 }
\ No newline at end of file
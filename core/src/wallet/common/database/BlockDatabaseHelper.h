@@ -33,6 +33,7 @@
 
 #include <wallet/common/Block.h>
 #include <string>
+#include <vector>
 #include <soci.h>
 #include <api/Block.hpp>
 #include <utils/Option.hpp>
@@ -48,6 +49,8 @@ namespace ledger {
             static Option<api::Block> getLastBlock(soci::session& sql, const std::string& currencyName);
             static Option<api::Block> getPreviousBlockInDatabase(soci::session& sql, const std::string& currencyName, int64_t blockHeight);
             static Option<api::Block> getPreviousBlockInDatabase(soci::session &sql, const std::string &currencyName, std::chrono::system_clock::time_point date);
+            // Blocks strictly below the given height, highest first
+            static std::vector<api::Block> getBlocksBelowHeight(soci::session& sql, const std::string& currencyName, int64_t blockHeight);
         };
     }
 }
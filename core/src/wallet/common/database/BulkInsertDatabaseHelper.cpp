@@ -35,6 +35,7 @@
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <database/soci-date.h>
 #include <database/soci-option.h>
+#include <database/StatementCache.hpp>
 
 namespace ledger {
     namespace core {
@@ -44,16 +45,18 @@ namespace ledger {
                 db::stmt<OperationBinding>(
                         "INSERT INTO operations VALUES("
                         ":uid, :account_uid, :wallet_uid, :type, :date, :senders, :recipients, :amount,"
-                        ":fees, :block_uid, :currency_name, :trust"
+                        ":fees, :block_uid, :currency_name, :trust, :amount_high, :amount_low, :fees_high, :fees_low"
                         ") ON CONFLICT(uid) DO UPDATE SET block_uid = :block_uid, trust = :trust,"
-                        " amount = :amount", [] (auto& s, auto& b) {
+                        " amount = :amount, amount_high = :amount_high, amount_low = :amount_low", [] (auto& s, auto& b) {
                             s, use(b.uid, "uid"), use(b.accountUid, "account_uid"),
                                     use(b.walletUid, "wallet_uid"), use(b.type, "type"),
                                     use(b.date, "date"), use(b.senders, "senders"),
                                     use(b.receivers, "recipients"), use(b.amount, "amount"),
                                     use(b.fees, "fees"), use(b.blockUid, "block_uid"),
                                     use(b.currencyName, "currency_name"),
-                                    use(b.serializedTrust, "trust");
+                                    use(b.serializedTrust, "trust"),
+                                    use(b.amountHigh, "amount_high"), use(b.amountLow, "amount_low"),
+                                    use(b.feesHigh, "fees_high"), use(b.feesLow, "fees_low");
                         });
         const StatementDeclaration<BlockBinding> BulkInsertDatabaseHelper::UPSERT_BLOCK =
                 db::stmt<BlockBinding>(
@@ -64,11 +67,41 @@ namespace ledger {
                                     use(b.currencyName);
                         });
 
+        using Column = PostgreSQLBulkUpsert::Column;
+        using ColumnType = PostgreSQLBulkUpsert::ColumnType;
+
+        const PostgreSQLBulkUpsert BulkInsertDatabaseHelper::COPY_OPERATION(
+                "operations", {
+                    Column{"uid", ColumnType::TEXT}, Column{"account_uid", ColumnType::TEXT},
+                    Column{"wallet_uid", ColumnType::TEXT}, Column{"type", ColumnType::TEXT},
+                    Column{"date", ColumnType::TEXT}, Column{"senders", ColumnType::TEXT},
+                    Column{"recipients", ColumnType::TEXT}, Column{"amount", ColumnType::TEXT},
+                    Column{"fees", ColumnType::TEXT}, Column{"block_uid", ColumnType::TEXT},
+                    Column{"currency_name", ColumnType::TEXT}, Column{"trust", ColumnType::TEXT},
+                    Column{"amount_high", ColumnType::BIGINT}, Column{"amount_low", ColumnType::BIGINT},
+                    Column{"fees_high", ColumnType::BIGINT}, Column{"fees_low", ColumnType::BIGINT}
+                }, {"uid"}, {"block_uid", "trust", "amount", "amount_high", "amount_low"});
+
+        const PostgreSQLBulkUpsert BulkInsertDatabaseHelper::COPY_BLOCK(
+                "blocks", {
+                    Column{"uid", ColumnType::TEXT}, Column{"hash", ColumnType::TEXT},
+                    Column{"height", ColumnType::BIGINT}, Column{"time", ColumnType::TEXT},
+                    Column{"currency_name", ColumnType::TEXT}
+                });
+
         void BulkInsertDatabaseHelper::updateBlock(soci::session& sql, const Block &block) {
-            PreparedStatement<BlockBinding> stmt;
-            UPSERT_BLOCK(sql, stmt);
-            stmt.bindings.update(block);
-            stmt.execute();
+            auto stmt = db::cached(sql, UPSERT_BLOCK);
+            stmt->bindings.clear();
+            stmt->bindings.update(block);
+            stmt->execute();
+        }
+
+        void BulkInsertDatabaseHelper::upsertOperations(soci::session& sql, PreparedStatement<OperationBinding>& stmt) {
+            upsert(sql, UPSERT_OPERATION, stmt, COPY_OPERATION);
+        }
+
+        void BulkInsertDatabaseHelper::upsertBlocks(soci::session& sql, PreparedStatement<BlockBinding>& stmt) {
+            upsert(sql, UPSERT_BLOCK, stmt, COPY_BLOCK);
         }
 
 
@@ -87,7 +120,14 @@ namespace ledger {
             strings::join(operation.recipients, rcvrs, separator);
             senders.push_back(sndrs.str());
             receivers.push_back(rcvrs.str());
-            fees.push_back(operation.fees.getValueOr(BigInt::ZERO).toHexString());
+            auto operationFees = operation.fees.getValueOr(BigInt::ZERO);
+            fees.push_back(operationFees.toHexString());
+            auto amountLimbs = AmountLimbs::fromBigInt(operation.amount);
+            amountHigh.push_back(amountLimbs.high);
+            amountLow.push_back(amountLimbs.low);
+            auto feesLimbs = AmountLimbs::fromBigInt(operationFees);
+            feesHigh.push_back(feesLimbs.high);
+            feesLow.push_back(feesLimbs.low);
 
             uid.push_back(operation.uid);
             accountUid.push_back(operation.accountUid);
@@ -105,6 +145,10 @@ namespace ledger {
             fees.clear();
             blockUid.clear();
             serializedTrust.clear();
+            amountHigh.clear();
+            amountLow.clear();
+            feesHigh.clear();
+            feesLow.clear();
             uid.clear();
             accountUid.clear();
             walletUid.clear();
@@ -112,6 +156,15 @@ namespace ledger {
             currencyName.clear();
         }
 
+        void OperationBinding::stage(PostgreSQLBulkUpsert& upsert) const {
+            for (size_t i = 0; i < uid.size(); i++) {
+                upsert.row().text(uid[i]).text(accountUid[i]).text(walletUid[i]).text(type[i])
+                        .text(date[i]).text(senders[i]).text(receivers[i]).text(amount[i])
+                        .text(fees[i]).text(blockUid[i]).text(currencyName[i]).text(serializedTrust[i])
+                        .bigint(amountHigh[i]).bigint(amountLow[i]).bigint(feesHigh[i]).bigint(feesLow[i]);
+            }
+        }
+
         void BlockBinding::update(const Block &b) {
             auto u = BlockDatabaseHelper::createBlockUid(b);
             uid.push_back(u);
@@ -128,5 +181,12 @@ namespace ledger {
             time.clear();
             currencyName.clear();
         }
+
+        void BlockBinding::stage(PostgreSQLBulkUpsert& upsert) const {
+            for (size_t i = 0; i < uid.size(); i++) {
+                upsert.row().text(uid[i]).text(hash[i]).bigint(static_cast<int64_t>(height[i]))
+                        .text(time[i]).text(currencyName[i]);
+            }
+        }
     }
-}
\ No newline at end of file
+}
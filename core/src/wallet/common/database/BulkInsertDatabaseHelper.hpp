@@ -35,6 +35,9 @@
 #include <soci.h>
 #include <wallet/common/Operation.h>
 #include <database/PreparedStatement.hpp>
+#include <database/PostgreSQLBulkUpsert.hpp>
+#include <database/soci-backend-utils.h>
+#include <wallet/common/database/AmountLimbs.hpp>
 
 namespace ledger {
     namespace core {
@@ -46,6 +49,10 @@ namespace ledger {
             std::vector <std::string> fees;
             std::vector <Option<std::string>> blockUid;
             std::vector <std::string> serializedTrust;
+            std::vector <Option<int64_t>> amountHigh;
+            std::vector <Option<int64_t>> amountLow;
+            std::vector <Option<int64_t>> feesHigh;
+            std::vector <Option<int64_t>> feesLow;
 
             std::vector <std::string> uid;
             std::vector <std::string> accountUid;
@@ -55,6 +62,7 @@ namespace ledger {
 
             void update(const Operation& operation);
             void reset();
+            void stage(PostgreSQLBulkUpsert& upsert) const;
         };
 
         struct BlockBinding {
@@ -66,13 +74,37 @@ namespace ledger {
 
             void update(const Block &b);
             void clear();
+            void stage(PostgreSQLBulkUpsert& upsert) const;
         };
 
         class BulkInsertDatabaseHelper {
         public:
             static const StatementDeclaration<OperationBinding> UPSERT_OPERATION;
             static const StatementDeclaration<BlockBinding> UPSERT_BLOCK;
+            static const PostgreSQLBulkUpsert COPY_OPERATION;
+            static const PostgreSQLBulkUpsert COPY_BLOCK;
             static void updateBlock(soci::session& sql, const Block& block);
+
+            /**
+             * Execute a bulk upsert. On PostgreSQL the bindings are staged with COPY and merged in a single
+             * statement, other backends prepare the declaration and execute it with the vector bindings.
+             * The shared COPY definition is only copied on PostgreSQL, to get a staging buffer of its own.
+             */
+            template <class Binding>
+            static void upsert(soci::session& sql, const StatementDeclaration<Binding>& declaration,
+                               PreparedStatement<Binding>& stmt, const PostgreSQLBulkUpsert& definition) {
+                if (soci::is_postgres_backend(sql)) {
+                    auto copy = definition;
+                    stmt.bindings.stage(copy);
+                    copy.execute(sql);
+                } else {
+                    declaration(sql, stmt);
+                    stmt.execute();
+                }
+            }
+
+            static void upsertOperations(soci::session& sql, PreparedStatement<OperationBinding>& stmt);
+            static void upsertBlocks(soci::session& sql, PreparedStatement<BlockBinding>& stmt);
         };
     }
 }
@@ -30,6 +30,7 @@
  */
 #include "OperationDatabaseHelper.h"
 #include "BlockDatabaseHelper.h"
+#include "BalanceCheckpointDatabaseHelper.h"
 #include <crypto/SHA256.hpp>
 #include <api/Amount.hpp>
 #include <api/BigInt.hpp>
@@ -37,12 +38,14 @@
 #include <database/soci-number.h>
 #include <database/soci-date.h>
 #include <database/soci-option.h>
+#include <database/StatementCache.hpp>
 #include <wallet/ethereum/database/EthereumLikeTransactionDatabaseHelper.h>
 #include <wallet/ripple/database/RippleLikeTransactionDatabaseHelper.h>
 #include <wallet/tezos/database/TezosLikeTransactionDatabaseHelper.h>
 #include <bytes/serialization.hpp>
 #include <collections/strings.hpp>
 #include <wallet/common/TrustIndicator.h>
+#include <wallet/common/database/AmountLimbs.hpp>
 #include <wallet/stellar/database/StellarLikeTransactionDatabaseHelper.hpp>
 
 #include <algorithm>
@@ -52,6 +55,18 @@ using namespace soci;
 namespace ledger {
     namespace core {
 
+        namespace {
+            struct OperationExistsBinding {
+                std::string uid;
+                int32_t count;
+            };
+
+            const auto OPERATION_EXISTS = db::stmt<OperationExistsBinding>(
+                    "SELECT COUNT(*) FROM operations WHERE uid = :uid", [] (auto& s, auto& b) {
+                        s, use(b.uid), into(b.count);
+                    });
+        }
+
         std::vector<std::string> OperationDatabaseHelper::fetchFromBlocks(soci::session &sql, std::vector<std::string> const &blockUIDs) {
             rowset<std::string> rows = (
                 sql.prepare << "SELECT uid "
@@ -62,6 +77,20 @@ namespace ledger {
             return std::vector<std::string>(rows.begin(), rows.end());
         }
 
+        std::vector<std::string> OperationDatabaseHelper::fetchAboveHeight(soci::session &sql,
+                                                                           const std::string &accountUid,
+                                                                           const std::string &currencyName,
+                                                                           int64_t blockHeight) {
+            rowset<std::string> rows = (
+                sql.prepare << "SELECT op.uid "
+                               "FROM operations AS op "
+                               "JOIN blocks AS b ON b.uid = op.block_uid "
+                               "WHERE op.account_uid = :uid AND b.currency_name = :currency AND b.height > :height",
+                use(accountUid), use(currencyName), use(blockHeight));
+
+            return std::vector<std::string>(rows.begin(), rows.end());
+        }
+
 
         std::string OperationDatabaseHelper::createUid(const std::string &accountUid, const std::string &txId,
                                                        const api::OperationType type) {
@@ -70,7 +99,6 @@ namespace ledger {
 
         bool OperationDatabaseHelper::putOperation(soci::session &sql,
                                                    const Operation &operation) {
-            auto count = 0;
             std::string serializedTrust;
             serialization::saveBase64<TrustIndicator>(*operation.trust, serializedTrust);
             if (operation.block.nonEmpty()) {
@@ -79,14 +107,21 @@ namespace ledger {
             auto blockUid = operation.block.map<std::string>([] (const Block& block) {
                 return block.getUid();
             });
-            sql << "SELECT COUNT(*) FROM operations WHERE uid = :uid", use(operation.uid), into(count);
-            auto newOperation = count == 0;
+            auto exists = db::cached(sql, OPERATION_EXISTS);
+            exists->bindings.uid = operation.uid;
+            exists->bindings.count = 0;
+            exists->execute();
+            auto newOperation = exists->bindings.count == 0;
             auto hexAmount = operation.amount.toHexString();
+            auto amountLimbs = AmountLimbs::fromBigInt(operation.amount);
             if (!newOperation) {
-                sql << "UPDATE operations SET block_uid = :block_uid, trust = :trust, amount = :amount WHERE uid = :uid"
+                sql << "UPDATE operations SET block_uid = :block_uid, trust = :trust, amount = :amount,"
+                       " amount_high = :amount_high, amount_low = :amount_low WHERE uid = :uid"
                         , use(blockUid)
                         , use(serializedTrust)
                         , use(hexAmount)
+                        , use(amountLimbs.high)
+                        , use(amountLimbs.low)
                         , use(operation.uid);
                 updateCurrencyOperation(sql, operation, newOperation);
                 return false;
@@ -99,15 +134,19 @@ namespace ledger {
                 strings::join(operation.recipients, recipients, separator);
                 auto sndrs = senders.str();
                 auto rcvrs = recipients.str();
-                auto hexFees = operation.fees.getValueOr(BigInt::ZERO).toHexString();
+                auto fees = operation.fees.getValueOr(BigInt::ZERO);
+                auto hexFees = fees.toHexString();
+                auto feesLimbs = AmountLimbs::fromBigInt(fees);
                 sql << "INSERT INTO operations VALUES("
                             ":uid, :accout_uid, :wallet_uid, :type, :date, :senders, :recipients, :amount,"
-                            ":fees, :block_uid, :currency_name, :trust"
+                            ":fees, :block_uid, :currency_name, :trust, :amount_high, :amount_low, :fees_high, :fees_low"
                         ")"
                         , use(operation.uid), use(operation.accountUid), use(operation.walletUid), use(type), use(operation.date)
                         , use(sndrs), use(rcvrs), use(hexAmount)
                         , use(hexFees), use(blockUid)
-                        , use(operation.currencyName), use(serializedTrust);
+                        , use(operation.currencyName), use(serializedTrust)
+                        , use(amountLimbs.high), use(amountLimbs.low)
+                        , use(feesLimbs.high), use(feesLimbs.low);
 
                 updateCurrencyOperation(sql, operation, newOperation);
                 return true;
@@ -230,6 +269,7 @@ namespace ledger {
                     use(accountUid), use(date);
                 sql << "DELETE FROM " << specificTransactionsTableName <<
                     " WHERE transaction_uid IN (:uids)", use(txToDelete);
+                BalanceCheckpointDatabaseHelper::refresh(sql, accountUid, date);
             }
         }
 
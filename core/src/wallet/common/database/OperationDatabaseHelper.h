@@ -44,6 +44,10 @@ namespace ledger {
 
             static std::vector<std::string> fetchFromBlocks(soci::session &sql,
                                                             std::vector<std::string> const &blockUIDs);
+            static std::vector<std::string> fetchAboveHeight(soci::session &sql,
+                                                             const std::string &accountUid,
+                                                             const std::string &currencyName,
+                                                             int64_t blockHeight);
             static bool putOperation(soci::session& sql,
                                      const Operation& operation);
             static std::string createUid(const std::string& accountUid,
@@ -38,6 +38,7 @@
 
 #include <async/Future.hpp>
 #include <collections/collections.hpp>
+#include <utils/MonotonicArena.hpp>
 #include <utils/optional.hpp>
 #include <utils/Option.hpp>
 #include <wallet/common/Block.h>
@@ -48,6 +49,8 @@ namespace ledger {
         class AbstractBlockchainExplorer {
         public:
             struct TransactionsBulk {
+                // Optional storage of the page, declared first so that it outlives the transactions using it
+                std::shared_ptr<MonotonicArena> arena;
                 std::vector<Transaction> transactions;
                 bool hasNext;
                 std::string paginationMarker; //Needed for pagination for XRP: https://developers.ripple.com/markers-and-pagination.html
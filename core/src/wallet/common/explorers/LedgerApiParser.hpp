@@ -35,6 +35,7 @@
 #include <rapidjson/reader.h>
 #include <net/HttpClient.hpp>
 #include <collections/collections.hpp>
+#include <wallet/common/explorers/api/LedgerApiKey.hpp>
 
 namespace ledger {
     namespace core {
@@ -107,7 +108,7 @@ namespace ledger {
             }
 
             bool String(const rapidjson::Reader::Ch* str, rapidjson::SizeType length, bool copy) {
-                if (_depth == 1 && isFailure() && _lastKey == "error") {
+                if (_depth == 1 && isFailure() && _lastKey == LedgerApiKey::error) {
                     _error = std::string(str, length);
                 }
                 return delegate([&] () {
@@ -123,7 +124,7 @@ namespace ledger {
             }
 
             bool Key(const rapidjson::Reader::Ch* str, rapidjson::SizeType length, bool copy) {
-                _lastKey = std::string(str, length);
+                _lastKey = LedgerApiKeys::fromString(str, length);
                 delegate([&] () {
                     _parser.Key(str, length, copy);
                 });
@@ -199,7 +200,7 @@ namespace ledger {
             std::string _statusText;
             uint32_t _statusCode;
             std::string _error;
-            std::string _lastKey;
+            LedgerApiKey _lastKey = LedgerApiKey::NONE;
             Option<Exception> _exception;
         };
     }
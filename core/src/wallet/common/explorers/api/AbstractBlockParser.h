@@ -38,6 +38,7 @@
 #include <math/BigInt.h>
 #include <net/HttpClient.hpp>
 #include <utils/DateUtils.hpp>
+#include <wallet/common/explorers/api/LedgerApiKey.hpp>
 
 namespace ledger {
     namespace core {
@@ -74,7 +75,7 @@ namespace ledger {
             }
 
             bool RawNumber(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
-                if (getLastKey() == "height") {
+                if (getLastKey() == LedgerApiKey::height) {
                     std::string number(str, length);
                     BigInt value = BigInt::fromString(number);
                     _block->height = value.toUint64();
@@ -84,9 +85,9 @@ namespace ledger {
 
             bool String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
                 std::string value = std::string(str, length);
-                if (getLastKey() == "hash") {
+                if (getLastKey() == LedgerApiKey::hash) {
                     _block->hash = value;
-                } else if (getLastKey() == "time") {
+                } else if (getLastKey() == LedgerApiKey::time) {
                     _block->time = DateUtils::fromJSON(value);
                 }
                 return true;
@@ -117,7 +118,7 @@ namespace ledger {
             }
 
         protected:
-            virtual std::string &getLastKey() = 0;
+            virtual LedgerApiKey &getLastKey() = 0;
             BlockchainExplorerTransactionBlock* _block;
         };
     }
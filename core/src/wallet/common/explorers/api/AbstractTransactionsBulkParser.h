@@ -32,6 +32,8 @@
 #ifndef LEDGER_CORE_ABSTRACTTRANSACTIONSBULKPARSER_H
 #define LEDGER_CORE_ABSTRACTTRANSACTIONSBULKPARSER_H
 
+#include <wallet/common/explorers/api/LedgerApiKey.hpp>
+
 #define PROXY_PARSE_TXS(method, ...)                                            \
     if (_depth > 0) {                                                       \
         return getTransactionsParser().method(__VA_ARGS__);                     \
@@ -50,7 +52,7 @@ namespace ledger {
             }
 
             bool Bool(bool b) {
-                if (getLastKey() == "truncated" && _depth == 0) {
+                if (getLastKey() == LedgerApiKey::truncated && _depth == 0) {
                     _bulk->hasNext = b;
                 }
                 PROXY_PARSE_TXS(Bool, b)
@@ -97,7 +99,7 @@ namespace ledger {
             }
 
             bool StartArray() {
-                if (_depth >= 1 || getLastKey() == "txs") {
+                if (_depth >= 1 || getLastKey() == LedgerApiKey::txs) {
                     _depth += 1;
                 }
 
@@ -122,7 +124,7 @@ namespace ledger {
 
         protected:
             virtual TxsParser &getTransactionsParser() = 0;
-            virtual std::string &getLastKey() = 0;
+            virtual LedgerApiKey &getLastKey() = 0;
             int _depth;
             BlockchainExplorerTransactionsBulk* _bulk;
         };
@@ -32,11 +32,13 @@
 #ifndef LEDGER_CORE_ABSTRACTWEBSOCKETNOTIFICATIONPARSER_H
 #define LEDGER_CORE_ABSTRACTWEBSOCKETNOTIFICATIONPARSER_H
 
+#include <wallet/common/explorers/api/LedgerApiKey.hpp>
+
 #define PROXY_PARSE_WS(method, ...)                                         \
  auto& currentObject = _currentObject;                                   \
- if (currentObject == "block") {                                         \
+ if (currentObject == LedgerApiKey::block) {                                \
     return getBlockParser().method(__VA_ARGS__);                             \
- } else if (currentObject == "transaction") {                            \
+ } else if (currentObject == LedgerApiKey::transaction) {                   \
     return getTransactionParser().method(__VA_ARGS__);                       \
  } else                                                                  \
 
@@ -108,9 +110,9 @@ namespace ledger {
             bool
             String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
                 PROXY_PARSE_WS(String, str, length, copy) {
-                    if (getLastKey() == "type") {
+                    if (getLastKey() == LedgerApiKey::type) {
                         _result->type = std::string(str, length);
-                    } else if (getLastKey() == "block_chain") {
+                    } else if (getLastKey() == LedgerApiKey::block_chain) {
                         _result->blockchain = std::string(str, length);
                     }
                     return true;
@@ -125,9 +127,9 @@ namespace ledger {
                     }
                     auto& currentObject = _currentObject;
 
-                    if (currentObject == "transaction") {
+                    if (currentObject == LedgerApiKey::transaction) {
                         getTransactionParser().init(&_result->transaction);
-                    } else if (currentObject == "block") {
+                    } else if (currentObject == LedgerApiKey::block) {
                         getBlockParser().init(&_result->block);
                     }
                 }
@@ -146,7 +148,7 @@ namespace ledger {
             bool EndObject(rapidjson::SizeType memberCount) {
                 _depth -= 1;
                 if (_depth == 2)
-                    _currentObject = "";
+                    _currentObject = LedgerApiKey::NONE;
                 PROXY_PARSE_WS(EndObject, memberCount) {
                     return true;
                 }
@@ -167,8 +169,8 @@ namespace ledger {
         protected:
             virtual TransactionParser &getTransactionParser() = 0;
             virtual BlockParser &getBlockParser() = 0;
-            virtual std::string &getLastKey() = 0;
-            std::string _currentObject = "";
+            virtual LedgerApiKey &getLastKey() = 0;
+            LedgerApiKey _currentObject = LedgerApiKey::NONE;
             Result* _result;
             int32_t  _depth = 0;
         };
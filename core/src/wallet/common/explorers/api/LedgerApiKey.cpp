@@ -0,0 +1,54 @@
+/*
+ *
+ * LedgerApiKey.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "LedgerApiKey.hpp"
+#include <cstring>
+
+namespace ledger {
+    namespace core {
+
+        LedgerApiKey LedgerApiKeys::fromString(const char* str, size_t length) {
+            if (length == 0) {
+                return LedgerApiKey::NONE;
+            }
+            switch (hash(str, length)) {
+#define LEDGER_API_KEY_CASE(name)                                                                   \
+                case hash(#name, sizeof(#name) - 1):                                                \
+                    return length == sizeof(#name) - 1 && std::memcmp(str, #name, length) == 0 ?    \
+                           LedgerApiKey::name : LedgerApiKey::UNKNOWN;
+                LEDGER_API_KEYS(LEDGER_API_KEY_CASE)
+#undef LEDGER_API_KEY_CASE
+                default:
+                    return LedgerApiKey::UNKNOWN;
+            }
+        }
+
+    }
+}
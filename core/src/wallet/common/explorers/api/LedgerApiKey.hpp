@@ -0,0 +1,92 @@
+/*
+ *
+ * LedgerApiKey.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_LEDGERAPIKEY_HPP
+#define LEDGER_CORE_LEDGERAPIKEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Every key read by the Ledger API parsers. Keys are listed as they appear in payloads, so they must be valid
+// identifiers.
+#define LEDGER_API_KEYS(KEY)                                                                    \
+    KEY(Account) KEY(Amount) KEY(Destination) KEY(DestinationTag) KEY(Fee) KEY(Memo)            \
+    KEY(MemoData) KEY(MemoFormat) KEY(MemoType) KEY(Sequence) KEY(TransactionResult)            \
+    KEY(actions) KEY(address) KEY(amount) KEY(block) KEY(block_chain) KEY(block_hash)           \
+    KEY(block_height) KEY(burn_tez) KEY(burned) KEY(close_time) KEY(coinbase)                   \
+    KEY(confirmations) KEY(contract) KEY(count) KEY(data) KEY(date) KEY(delegatable)            \
+    KEY(delegate) KEY(destination) KEY(error) KEY(failed) KEY(fee) KEY(fees) KEY(from)          \
+    KEY(gas) KEY(gas_limit) KEY(gas_price) KEY(gas_used) KEY(hash) KEY(height) KEY(id)          \
+    KEY(input) KEY(input_index) KEY(inputs) KEY(is_delegatable) KEY(is_spendable)               \
+    KEY(is_success) KEY(kind) KEY(ledger) KEY(ledger_hash) KEY(ledger_index) KEY(level)         \
+    KEY(list) KEY(lock_time) KEY(marker) KEY(nonce) KEY(op_level) KEY(ops) KEY(output_hash)     \
+    KEY(output_index) KEY(outputs) KEY(public_key) KEY(received_at) KEY(receiver)               \
+    KEY(script_hex) KEY(script_signature) KEY(sender) KEY(seq) KEY(sequence) KEY(spendable)     \
+    KEY(src) KEY(status) KEY(storage_limit) KEY(time) KEY(timestamp) KEY(to) KEY(transaction)   \
+    KEY(transactions) KEY(truncated) KEY(tx) KEY(txs) KEY(type) KEY(tz) KEY(tz1) KEY(value)     \
+    KEY(volume)
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * JSON keys the Ledger API SAX parsers dispatch on, so that the last key and the object hierarchy are
+         * tracked without building a string per key.
+         */
+        enum class LedgerApiKey : uint8_t {
+            // No key read yet, or an empty key
+            NONE,
+            // A key none of the parsers reads
+            UNKNOWN,
+#define LEDGER_API_KEY_ENUM(name) name,
+            LEDGER_API_KEYS(LEDGER_API_KEY_ENUM)
+#undef LEDGER_API_KEY_ENUM
+        };
+
+        class LedgerApiKeys {
+        public:
+            /**
+             * 32 bits FNV-1a. Keys are dispatched with a switch over their hash, the compiler rejects the table if
+             * two keys collide, which makes the hash perfect over LEDGER_API_KEYS.
+             */
+            static constexpr uint32_t hash(const char* str, size_t length) {
+                uint32_t result = 2166136261u;
+                for (size_t i = 0; i < length; i++) {
+                    result = (result ^ static_cast<uint8_t>(str[i])) * 16777619u;
+                }
+                return result;
+            }
+
+            static LedgerApiKey fromString(const char* str, size_t length);
+        };
+    }
+}
+
+#endif //LEDGER_CORE_LEDGERAPIKEY_HPP
@@ -36,6 +36,7 @@
 #include <memory>
 #include <mutex>
 #include <array>
+#include <chrono>
 
 #include <api/Configuration.hpp>
 #include <api/ConfigurationDefaults.hpp>
@@ -54,6 +55,7 @@
 #include <wallet/common/database/AccountDatabaseHelper.h>
 #include <common/AccountHelper.hpp>
 #include <wallet/common/database/OperationDatabaseHelper.h>
+#include <wallet/common/synchronizers/BlockchainReorganization.h>
 #include <utils/Concurrency.hpp>
 
 #define NEW_BENCHMARK(x) std::make_shared<Benchmarker>(fmt::format(x"/{}", buddy->synchronizationTag), buddy->logger)
@@ -90,6 +92,45 @@ namespace ledger {
             }
         };
 
+        // Persists the synchronization saved state.
+        //
+        // Saving the state is a serialization plus a synced write in preferences, doing it for every page
+        // costs thousands of fsyncs on large accounts. The checkpointer coalesces writes: the state is saved
+        // every maxPages committed pages, when maxInterval elapsed since the last save or when explicitly
+        // flushed (end of synchronization, failure, reorganization). It must only be called once the SQL
+        // transaction of the page is committed, so a saved state never points past data in database and a
+        // resumed synchronization at worst fetches again the pages done since the last checkpoint.
+        class BlockchainExplorerAccountSynchronizationCheckpointer {
+        public:
+            BlockchainExplorerAccountSynchronizationCheckpointer() = default;
+
+            BlockchainExplorerAccountSynchronizationCheckpointer(uint32_t maxPages, std::chrono::seconds maxInterval)
+                : _maxPages(std::max<uint32_t>(1, maxPages)), _maxInterval(maxInterval),
+                  _lastCheckpoint(std::chrono::system_clock::now()) {
+            }
+
+            void checkpoint(const std::shared_ptr<Preferences>& preferences,
+                            BlockchainExplorerAccountSynchronizationSavedState& state) {
+                _pendingPages += 1;
+                if (_pendingPages >= _maxPages || std::chrono::system_clock::now() - _lastCheckpoint >= _maxInterval) {
+                    flush(preferences, state);
+                }
+            }
+
+            void flush(const std::shared_ptr<Preferences>& preferences,
+                       BlockchainExplorerAccountSynchronizationSavedState& state) {
+                preferences->editor()->putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", state)->commit();
+                _pendingPages = 0;
+                _lastCheckpoint = std::chrono::system_clock::now();
+            }
+
+        private:
+            uint32_t _maxPages = 1;
+            std::chrono::seconds _maxInterval = std::chrono::seconds(0);
+            uint32_t _pendingPages = 0;
+            std::chrono::system_clock::time_point _lastCheckpoint;
+        };
+
         struct BlockchainExplorerAccountSynchronizationResult {
             Option<uint32_t> reorgBlockHeight;
             uint32_t lastBlockHeight = 0;
@@ -133,6 +174,7 @@ namespace ledger {
                 uint32_t halfBatchSize;
                 std::shared_ptr<Keychain> keychain;
                 Option<BlockchainExplorerAccountSynchronizationSavedState> savedState;
+                BlockchainExplorerAccountSynchronizationCheckpointer checkpointer;
                 std::shared_ptr<Account> account;
                 std::unordered_map<std::string, std::string> transactionsToDrop;
                 BlockchainExplorerAccountSynchronizationResult context;
@@ -205,6 +247,13 @@ namespace ledger {
                 buddy->keychain = account->getKeychain();
                 buddy->savedState = buddy->preferences
                         ->template getObject<BlockchainExplorerAccountSynchronizationSavedState>("state");
+                buddy->checkpointer = BlockchainExplorerAccountSynchronizationCheckpointer(
+                        (uint32_t) buddy->configuration
+                                ->getInt(api::Configuration::SYNCHRONIZATION_CHECKPOINT_PAGES)
+                                .value_or(api::ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_CHECKPOINT_PAGES),
+                        std::chrono::seconds(buddy->configuration
+                                ->getInt(api::Configuration::SYNCHRONIZATION_CHECKPOINT_INTERVAL)
+                                .value_or(api::ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_CHECKPOINT_INTERVAL)));
                 buddy->logger
                         ->info("Starting synchronization for account#{} ({}) of wallet {} at {}",
                                account->getIndex(),
@@ -261,6 +310,8 @@ namespace ledger {
                     buddy->logger->info("End synchronization for account#{} of wallet {} in {}", buddy->account->getIndex(),
                                         buddy->account->getWallet()->getName(), DurationUtils::formatDuration(duration));
 
+                    buddy->checkpointer.flush(buddy->preferences, buddy->savedState.getValue());
+
                     auto const &batches = buddy->savedState.getValue().batches;
 
                     // get the last block height treated during the synchronization
@@ -286,6 +337,8 @@ namespace ledger {
                     buddy->logger->error("Error during during synchronization for account#{} of wallet {} in {} ms", buddy->account->getIndex(),
                                          buddy->account->getWallet()->getName(), duration.count());
                     buddy->logger->error("Due to {}, {}", api::to_string(ex.getErrorCode()), ex.getMessage());
+                    // Progress made before the failure is committed in database, keep it
+                    buddy->checkpointer.flush(buddy->preferences, buddy->savedState.getValue());
                     fullSyncBenchmarker->stop();
                     return buddy->context;
                 });
@@ -307,14 +360,13 @@ namespace ledger {
                 }
 
                 auto self = getSharedFromThis();
-                auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
 
                 auto benchmark = NEW_BENCHMARK("full_batch");
                 benchmark->start();
                 return synchronizeBatch(currentBatchIndex, buddy).template flatMap<Unit>(buddy->account->getContext(), [=] (const bool& hadTransactions) -> Future<Unit> {
                     benchmark->stop();
 
-                    buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
+                    buddy->checkpointer.checkpoint(buddy->preferences, buddy->savedState.getValue());
 
                     //Sync stops if there are no more batches in savedState and last batch has no transactions
                     //But we may want to force sync of accounts within KEYCHAIN_OBSERVABLE_RANGE
@@ -326,99 +378,98 @@ namespace ledger {
 
                     return Future<Unit>::successful(unit);
                 }).recoverWith(ImmediateExecutionContext::INSTANCE, [=] (const Exception &exception) -> Future<Unit> {
-                    buddy->logger->info("Recovering from failing synchronization : {}", exception.getMessage());
-                    //A block reorganization happened
-                    if (exception.getErrorCode() == api::ErrorCode::BLOCK_NOT_FOUND &&
-                        buddy->savedState.nonEmpty()) {
-                        buddy->logger->info("Recovering from reorganization");
-                        auto startSession = Future<void*>::async(ImmediateExecutionContext::INSTANCE, [=]() {
-                            return Future<void*>::successful(nullptr);
-                        });
+                    return self->recoverFromFailedBatch(currentBatchIndex, buddy, exception);
+                });
+            };
 
-                        return startSession.template flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=] (void * const session) {
-                            //Get its block/block height
-                            auto &failedBatch = buddy->savedState.getValue().batches[currentBatchIndex];
-                            auto const failedBlockHeight = failedBatch.blockHeight;
-                            auto const failedBlockHash = failedBatch.blockHash;
+            // Recover from a batch which failed to synchronize.
+            //
+            // Only block reorganizations are recovered: blocks above the failed batch state are removed
+            // and synchronization is relaunched from that batch.
+            Future<Unit> recoverFromFailedBatch(uint32_t currentBatchIndex,
+                                                std::shared_ptr<SynchronizationBuddy> buddy,
+                                                const Exception &exception) {
+                auto self = getSharedFromThis();
+                buddy->logger->info("Recovering from failing synchronization : {}", exception.getMessage());
+                //A block reorganization happened
+                if (exception.getErrorCode() == api::ErrorCode::BLOCK_NOT_FOUND &&
+                    buddy->savedState.nonEmpty()) {
+                    buddy->logger->info("Recovering from reorganization");
+                    auto startSession = Future<void*>::async(ImmediateExecutionContext::INSTANCE, [=]() {
+                        return Future<void*>::successful(nullptr);
+                    });
 
-                            if (failedBlockHeight > 0) {
+                    return startSession.template flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=] (void * const session) {
+                        //Get its block/block height
+                        auto &failedBatch = buddy->savedState.getValue().batches[currentBatchIndex];
+                        auto const failedBlockHeight = failedBatch.blockHeight;
+                        auto const failedBlockHash = failedBatch.blockHash;
 
-                                //Delete data related to failedBlock (and all blocks above it)
-                                buddy->logger->info("Deleting blocks above block height: {}", failedBlockHeight);
+                        if (failedBlockHeight > 0) {
+                            auto currencyName = buddy->wallet->getCurrency().name;
+                            std::vector<api::Block> candidates;
+                            {
+                                soci::session sql(buddy->wallet->getDatabase()->getPool());
+                                candidates = BlockDatabaseHelper::getBlocksBelowHeight(sql, currencyName, failedBlockHeight);
+                            }
+
+                            //Look the fork point up instead of walking back one batch at a time
+                            auto firstAddress = (uint32_t) (currentBatchIndex * buddy->halfBatchSize);
+                            auto addresses = vector::map<std::string, std::shared_ptr<AddressType>>(
+                                    buddy->keychain->getAllObservableAddresses(firstAddress, firstAddress),
+                                    [] (const std::shared_ptr<AddressType>& addr) -> std::string {
+                                        return addr->toString();
+                                    }
+                            );
+                            auto probe = BlockchainReorganization::probeWith(self->_explorer, addresses);
+                            buddy->logger->info("Looking for the fork point below block height: {}", failedBlockHeight);
+                            return BlockchainReorganization::findCommonAncestor(candidates, probe)
+                            .template flatMap<Unit>(buddy->account->getContext(), [=] (const Option<api::Block>& ancestor) {
+                                int64_t lastBlockHeight = 0;
+                                std::string lastBlockHash;
+                                if (ancestor.nonEmpty()) {
+                                    lastBlockHeight = ancestor.getValue().height;
+                                    lastBlockHash = ancestor.getValue().blockHash;
+                                }
+
+                                //Delete data related to all blocks above the fork point
+                                buddy->logger->info("Deleting blocks above block height: {}", lastBlockHeight);
 
                                 soci::session sql(buddy->wallet->getDatabase()->getPool());
-                                {
-                                    soci::transaction tr(sql);
-                                    try {
-
-                                        soci::rowset<std::string> rows_block =  (sql.prepare << "SELECT uid FROM blocks where height >= :failedBlockHeight",
-                                                                                    soci::use(failedBlockHeight));
-
-                                        std::vector<std::string> blockToDelete(rows_block.begin(), rows_block.end());
-
-                                        // Fetch all operations which are deleted during reorganization
-                                        auto deletedOperationUIDs = OperationDatabaseHelper::fetchFromBlocks(sql, blockToDelete);
-
-                                        // Remove failed blocks and associated operations/transactions
-                                        AccountDatabaseHelper::removeBlockOperation(sql, buddy->account->getAccountUid(), blockToDelete);
-
-                                        //Get last block not part from reorg
-                                        auto lastBlock = BlockDatabaseHelper::getLastBlock(sql,
-                                                                                           buddy->wallet->getCurrency().name);
-
-                                        //Resync from the "beginning" if no last block in DB
-                                        int64_t lastBlockHeight = 0;
-                                        std::string lastBlockHash;
-                                        if (lastBlock.nonEmpty()) {
-                                            lastBlockHeight = lastBlock.getValue().height;
-                                            lastBlockHash = lastBlock.getValue().blockHash;
-                                        }
-                                        // update reorganization block height until found the valid one
-                                        buddy->context.reorgBlockHeight = lastBlockHeight;
-
-                                        //Update savedState's batches
-                                        for (auto &batch : buddy->savedState.getValue().batches) {
-                                            if (batch.blockHeight > lastBlockHeight) {
-                                                batch.blockHeight = (uint32_t) lastBlockHeight;
-                                                batch.blockHash = lastBlockHash;
-                                            }
-                                        }
-                                        tr.commit();
-
-                                        // We can emit safely deleted operation UIDs
-                                        std::for_each(
-                                            deletedOperationUIDs.cbegin(),
-                                            deletedOperationUIDs.cend(),
-                                            [buddy](auto const &uid) {
-                                                buddy->account->emitDeletedOperationEvent(uid);
-                                            });
-                                    } catch(...) {
-                                        tr.rollback();
+                                soci::transaction tr(sql);
+                                auto deletedOperationUIDs = BlockchainReorganization::rollback(sql,
+                                    buddy->account->getAccountUid(), currencyName, ancestor);
+                                buddy->context.reorgBlockHeight = lastBlockHeight;
+
+                                //Update savedState's batches
+                                for (auto &batch : buddy->savedState.getValue().batches) {
+                                    if (batch.blockHeight > lastBlockHeight) {
+                                        batch.blockHeight = (uint32_t) lastBlockHeight;
+                                        batch.blockHash = lastBlockHash;
                                     }
                                 }
+                                tr.commit();
+
+                                // We can emit safely deleted operation UIDs
+                                buddy->account->emitDeletedOperationsEvent(deletedOperationUIDs);
 
                                 //Save new savedState
-                                buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>(
-                                        "state", buddy->savedState.getValue())->commit();
+                                buddy->checkpointer.flush(buddy->preferences, buddy->savedState.getValue());
 
-                                //Synchronize same batch now with an existing block (of hash lastBlockHash)
-                                //if failedBatch was not the deepest block part of that reorg, this recursive call
-                                //will ensure to get (and delete from DB) to the deepest failed block (part of reorg)
                                 buddy->logger->info("Relaunch synchronization after recovering from reorganization");
-
                                 return self->synchronizeBatches(currentBatchIndex, buddy);
-                            }
-                            return Future<Unit>::successful(unit);
-                        }).recover(ImmediateExecutionContext::INSTANCE, [buddy] (const Exception& ex) -> Unit {
-                            buddy->logger->warn(
-                                    "Failed to recover from reorganisation for account#{} of wallet {}",
-                                    buddy->account->getIndex(),
-                                    buddy->account->getWallet()->getName());
-                            return unit;
-                        });
-                    }
-                    return Future<Unit>::successful(unit);
-                });
+                            });
+                        }
+                        return Future<Unit>::successful(unit);
+                    }).recover(ImmediateExecutionContext::INSTANCE, [buddy] (const Exception& ex) -> Unit {
+                        buddy->logger->warn(
+                                "Failed to recover from reorganisation for account#{} of wallet {}",
+                                buddy->account->getIndex(),
+                                buddy->account->getWallet()->getName());
+                        return unit;
+                    });
+                }
+                return Future<Unit>::successful(unit);
             };
 
             // Synchronize a transactions batch.
@@ -434,7 +485,6 @@ namespace ledger {
                 buddy->logger->info("SYNC BATCH {}", currentBatchIndex);
 
                 Option<std::string> blockHash;
-                auto self = getSharedFromThis();
                 auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
 
                 if (batchState.blockHeight > 0) {
@@ -455,31 +505,66 @@ namespace ledger {
 
                 derivationBenchmark->stop();
 
+                return synchronizeBatchPage(currentBatchIndex, buddy, batch, requestTransactionsPage(batch, blockHash, buddy), hadTransactions);
+            };
+
+            // Request a page of transactions of a batch to the explorer.
+            Future<std::shared_ptr<typename Explorer::TransactionsBulk>> requestTransactionsPage(
+                    const std::vector<std::string>& batch,
+                    const Option<std::string>& blockHash,
+                    const std::shared_ptr<SynchronizationBuddy>& buddy) {
                 auto benchmark = NEW_BENCHMARK("explorer_calls");
                 benchmark->start();
                 return _explorer->getTransactions(batch, blockHash, optional<void*>())
-                    .template flatMap<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions, benchmark] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) -> Future<bool> {
+                    .template map<std::shared_ptr<typename Explorer::TransactionsBulk>>(ImmediateExecutionContext::INSTANCE, [benchmark] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) {
                         benchmark->stop();
+                        return bulk;
+                    });
+            };
 
-                        auto interpretBenchmark = NEW_BENCHMARK("interpret_operations");
-
+            // Interpret and insert a page of transactions of a batch.
+            //
+            // Pages are processed as a pipeline: as soon as a page is received, the request of the
+            // next page is sent to the explorer (its cursor is the last block of the current page),
+            // and the current page is interpreted and inserted while the next one is downloading.
+            // Only one page is prefetched at a time, so at most two pages of a batch are held in memory.
+            Future<bool> synchronizeBatchPage(
+                    uint32_t currentBatchIndex,
+                    std::shared_ptr<SynchronizationBuddy> buddy,
+                    const std::vector<std::string>& batch,
+                    Future<std::shared_ptr<typename Explorer::TransactionsBulk>> page,
+                    bool hadTransactions) {
+                auto self = getSharedFromThis();
+                return page.template flatMap<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, batch, hadTransactions] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) -> Future<bool> {
                         auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
-                        //self->transactions.insert(self->transactions.end(), bulk->transactions.begin(), bulk->transactions.end());
                         buddy->logger->info("Got {} txs for account {}", bulk->transactions.size(), buddy->account->getAccountUid());
                         auto count = 0;
 
-                        // NEW CODE
+                        // Find the last block of the page first, it is the cursor of the next page
                         Option<Block> lastBlock = Option<Block>::NONE;
-                        std::vector<Operation> operations;
-                        interpretBenchmark->start();
-                        // Interpret transactions to operations and update last block
                         for (const auto& tx : bulk->transactions) {
-                            // Update last block to chain query
                             if (tx.block.nonEmpty() && (lastBlock.isEmpty() ||
                                 lastBlock.getValue().height < tx.block.getValue().height)) {
                                 lastBlock = tx.block;
                             }
+                        }
 
+                        Option<Future<std::shared_ptr<typename Explorer::TransactionsBulk>>> nextPage;
+                        if (bulk->hasNext) {
+                            Option<std::string> nextBlockHash;
+                            if (bulk->transactions.size() > 0 && lastBlock.nonEmpty()) {
+                                nextBlockHash = Option<std::string>(lastBlock.getValue().hash);
+                            } else if (batchState.blockHeight > 0) {
+                                nextBlockHash = Option<std::string>(batchState.blockHash);
+                            }
+                            nextPage = self->requestTransactionsPage(batch, nextBlockHash, buddy);
+                        }
+
+                        auto interpretBenchmark = NEW_BENCHMARK("interpret_operations");
+                        std::vector<Operation> operations;
+                        interpretBenchmark->start();
+                        // Interpret transactions to operations
+                        for (const auto& tx : bulk->transactions) {
                             self->interpretTransaction(tx, buddy, operations);
 
                             //Update first pendingTxHash in savedState
@@ -510,18 +595,16 @@ namespace ledger {
                         buddy->logger->info("Succeeded to insert {} txs on {} for account {}", count, bulk->transactions.size(), buddy->account->getAccountUid());
                         buddy->account->emitEventsNow();
 
-                        // END NEW CODE
-
-                        // Get the last block
+                        // Get the last block, only once the page is inserted
                         if (bulk->transactions.size() > 0 && lastBlock.nonEmpty() ) {
                             batchState.blockHeight = (uint32_t) lastBlock.getValue().height;
                             batchState.blockHash = lastBlock.getValue().hash;
-                            buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
+                            buddy->checkpointer.checkpoint(buddy->preferences, buddy->savedState.getValue());
                         }
 
                         auto hadTX = hadTransactions || bulk->transactions.size() > 0;
-                        if (bulk->hasNext) {
-                            return self->synchronizeBatch(currentBatchIndex, buddy, hadTX);
+                        if (nextPage.nonEmpty()) {
+                            return self->synchronizeBatchPage(currentBatchIndex, buddy, batch, nextPage.getValue(), hadTX);
                         } else {
                             return Future<bool>::successful(hadTX);
                         }
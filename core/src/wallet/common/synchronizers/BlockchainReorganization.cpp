@@ -0,0 +1,123 @@
+/*
+ *
+ * BlockchainReorganization.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "BlockchainReorganization.h"
+#include <database/soci-date.h>
+#include <utils/DateUtils.hpp>
+#include <wallet/common/database/AccountDatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
+#include <wallet/common/database/OperationDatabaseHelper.h>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            using Candidates = std::shared_ptr<const std::vector<api::Block>>;
+
+            // Blocks in the chain form a suffix of the candidates. lo is not in the chain, hi is.
+            Future<Option<api::Block>> bisect(const Candidates& candidates,
+                                              const BlockchainReorganization::BlockProbe& isInChain,
+                                              size_t lo, size_t hi) {
+                if (lo + 1 >= hi) {
+                    return Future<Option<api::Block>>::successful(Option<api::Block>((*candidates)[hi]));
+                }
+                auto mid = lo + (hi - lo) / 2;
+                return isInChain((*candidates)[mid]).flatMap<Option<api::Block>>(ImmediateExecutionContext::INSTANCE, [=] (const bool& inChain) {
+                    return inChain ? bisect(candidates, isInChain, lo, mid) : bisect(candidates, isInChain, mid, hi);
+                });
+            }
+
+            // Probe candidates at exponentially growing distances from the last one out of the chain
+            Future<Option<api::Block>> gallop(const Candidates& candidates,
+                                              const BlockchainReorganization::BlockProbe& isInChain,
+                                              size_t outOfChain, size_t step) {
+                auto index = std::min(outOfChain + step, candidates->size() - 1);
+                return isInChain((*candidates)[index]).flatMap<Option<api::Block>>(ImmediateExecutionContext::INSTANCE, [=] (const bool& inChain) {
+                    if (inChain) {
+                        return bisect(candidates, isInChain, outOfChain, index);
+                    }
+                    if (index + 1 == candidates->size()) {
+                        return Future<Option<api::Block>>::successful(Option<api::Block>());
+                    }
+                    return gallop(candidates, isInChain, index, step * 2);
+                });
+            }
+        }
+
+        Future<Option<api::Block>> BlockchainReorganization::findCommonAncestor(const std::vector<api::Block>& candidates,
+                                                                                const BlockProbe& isInChain) {
+            if (candidates.empty()) {
+                return Future<Option<api::Block>>::successful(Option<api::Block>());
+            }
+            auto shared = std::make_shared<const std::vector<api::Block>>(candidates);
+            return isInChain(candidates.front()).flatMap<Option<api::Block>>(ImmediateExecutionContext::INSTANCE, [=] (const bool& inChain) {
+                if (inChain) {
+                    return Future<Option<api::Block>>::successful(Option<api::Block>(shared->front()));
+                }
+                if (shared->size() == 1) {
+                    return Future<Option<api::Block>>::successful(Option<api::Block>());
+                }
+                return gallop(shared, isInChain, 0, 1);
+            });
+        }
+
+        std::vector<std::string> BlockchainReorganization::rollback(soci::session& sql,
+                                                                    const std::string& accountUid,
+                                                                    const std::string& currencyName,
+                                                                    const Option<api::Block>& ancestor,
+                                                                    const CoinRollback& coinRollback) {
+            auto height = ancestor.map<int64_t>([] (const api::Block& block) {
+                return block.height;
+            }).getValueOr(-1);
+            auto deletedOperations = OperationDatabaseHelper::fetchAboveHeight(sql, accountUid, currencyName, height);
+
+            Option<std::chrono::system_clock::time_point> staleCheckpoints;
+            {
+                soci::rowset<soci::row> rows = (sql.prepare << "SELECT MIN(op.date) FROM operations AS op "
+                                                               "JOIN blocks AS b ON b.uid = op.block_uid "
+                                                               "WHERE op.account_uid = :uid AND b.currency_name = :currency AND b.height > :height "
+                                                               "GROUP BY op.account_uid",
+                        soci::use(accountUid), soci::use(currencyName), soci::use(height));
+                for (auto& row : rows) {
+                    staleCheckpoints = DateUtils::fromJSON(row.get<std::string>(0));
+                }
+            }
+
+            if (coinRollback) {
+                coinRollback(sql, accountUid, currencyName, height);
+            }
+            AccountDatabaseHelper::removeBlocksAboveHeight(sql, accountUid, currencyName, height);
+            if (staleCheckpoints.nonEmpty()) {
+                BalanceCheckpointDatabaseHelper::refresh(sql, accountUid, staleCheckpoints.getValue());
+            }
+            return deletedOperations;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ *
+ * BlockchainReorganization.h
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_BLOCKCHAINREORGANIZATION_H
+#define LEDGER_CORE_BLOCKCHAINREORGANIZATION_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <soci.h>
+#include <api/Block.hpp>
+#include <api/ErrorCode.hpp>
+#include <async/Future.hpp>
+#include <utils/Exception.hpp>
+#include <utils/ImmediateExecutionContext.hpp>
+#include <utils/Option.hpp>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Recovery from a block reorganization. The fork point is looked up with an exponential then a
+         * binary search over the blocks stored in database, so that a deep reorganization costs a logarithmic
+         * number of explorer calls. Everything above it is then deleted with range deletes on
+         * blocks (currency_name, height).
+         */
+        class BlockchainReorganization {
+        public:
+            // Resolves to true if the block is still part of the chain followed by the explorer
+            using BlockProbe = std::function<Future<bool> (const api::Block&)>;
+
+            /**
+             * Find the highest block still in the chain.
+             * @param candidates Stored blocks, highest first.
+             * @return The common ancestor, or none if every candidate was reorganized.
+             */
+            static Future<Option<api::Block>> findCommonAncestor(const std::vector<api::Block>& candidates,
+                                                                 const BlockProbe& isInChain);
+
+            // Deletes the coin specific data of the account above the given block height, called before its operations are deleted
+            using CoinRollback = std::function<void (soci::session&, const std::string& accountUid,
+                                                     const std::string& currencyName, int64_t blockHeight)>;
+
+            /**
+             * Delete the operations of the account above the common ancestor (every operation if there is none), then
+             * the blocks above it that no operation refers to anymore.
+             * @param coinRollback Optional coin specific cleanup, see CoinRollback.
+             * @return The deleted operations of the account.
+             */
+            static std::vector<std::string> rollback(soci::session& sql,
+                                                     const std::string& accountUid,
+                                                     const std::string& currencyName,
+                                                     const Option<api::Block>& ancestor,
+                                                     const CoinRollback& coinRollback = CoinRollback());
+
+            /**
+             * A block is in the chain if the explorer accepts it as the starting block of a transactions request.
+             */
+            template <typename Explorer>
+            static BlockProbe probeWith(const std::shared_ptr<Explorer>& explorer,
+                                        const std::vector<std::string>& addresses) {
+                return [explorer, addresses] (const api::Block& block) -> Future<bool> {
+                    return explorer->getTransactions(addresses, Option<std::string>(block.blockHash), Option<void*>())
+                        .template map<bool>(ImmediateExecutionContext::INSTANCE, [] (const std::shared_ptr<typename Explorer::TransactionsBulk>&) {
+                            return true;
+                        })
+                        .recover(ImmediateExecutionContext::INSTANCE, [] (const Exception& ex) -> bool {
+                            if (ex.getErrorCode() == api::ErrorCode::BLOCK_NOT_FOUND) {
+                                return false;
+                            }
+                            throw ex;
+                        });
+                };
+            }
+        };
+    }
+}
+
+#endif //LEDGER_CORE_BLOCKCHAINREORGANIZATION_H
@@ -48,6 +48,7 @@
 #include <wallet/common/Block.h>
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <wallet/common/database/OperationDatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <wallet/cosmos/CosmosLikeAccount.hpp>
 #include <wallet/cosmos/CosmosLikeConstants.hpp>
 #include <wallet/cosmos/CosmosLikeOperationQuery.hpp>
@@ -489,6 +490,16 @@ Future<std::vector<std::shared_ptr<api::Amount>>> CosmosLikeAccount::getBalanceH
 
             const auto &uid = self->getAccountUid();
             soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
+            std::vector<std::shared_ptr<api::Amount>> amounts;
+
+            auto checkpoints = BalanceCheckpointDatabaseHelper::getBalanceHistory(sql, uid, startDate, endDate, precision);
+            if (checkpoints.nonEmpty()) {
+                for (const auto& value : checkpoints.getValue()) {
+                    amounts.emplace_back(std::make_shared<ledger::core::Amount>(self->getWallet()->getCurrency(), 0, value));
+                }
+                return amounts;
+            }
+
             std::vector<Operation> operations;
 
             auto keychain = self->getKeychain();
@@ -503,7 +514,6 @@ Future<std::vector<std::shared_ptr<api::Amount>>> CosmosLikeAccount::getBalanceH
             auto lowerDate = startDate;
             auto upperDate = DateUtils::incrementDate(startDate, precision);
 
-            std::vector<std::shared_ptr<api::Amount>> amounts;
             std::size_t operationsCount = 0;
             BigInt sum;
             while (lowerDate <= endDate && operationsCount < operations.size()) {
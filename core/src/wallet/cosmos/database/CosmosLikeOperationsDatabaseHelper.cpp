@@ -36,6 +36,7 @@
 #include <api/BigInt.hpp>
 #include <debug/Benchmarker.h>
 #include <wallet/common/database/BulkInsertDatabaseHelper.hpp>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <wallet/cosmos/database/SociCosmosAmount.hpp>
 #include <wallet/cosmos/CosmosLikeMessage.hpp>
@@ -787,8 +788,6 @@ namespace ledger {
             PreparedStatement<MultiSendInputBinding> multisendInStmt;
             PreparedStatement<MultiSendOutputBinding> multisendOutStmt;
 
-            BulkInsertDatabaseHelper::UPSERT_OPERATION(sql, operationStmt);
-            BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, blockStmt);
             UPSERT_COSMOS_OPERATION(sql, cosmosOpStmt);
             UPSERT_TRANSACTION(sql, transactionStmt);
 
@@ -900,7 +899,7 @@ namespace ledger {
             
             // 1- block
             if (!blockStmt.bindings.uid.empty()) {
-                blockStmt.execute();
+                BulkInsertDatabaseHelper::upsertBlocks(sql, blockStmt);
             }
 
             // 2- cosmos_transaction 
@@ -962,7 +961,8 @@ namespace ledger {
             }
 
             // 5- operations
-            operationStmt.execute();
+            BulkInsertDatabaseHelper::upsertOperations(sql, operationStmt);
+            BalanceCheckpointDatabaseHelper::update(sql, operationStmt.bindings);
             
             // 6- cosmos_operations
             cosmosOpStmt.execute();
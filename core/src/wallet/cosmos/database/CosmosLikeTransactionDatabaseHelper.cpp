@@ -39,6 +39,7 @@
 #include <database/soci-number.h>
 #include <database/soci-option.h>
 #include <utils/Exception.hpp>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <wallet/common/database/OperationDatabaseHelper.h>
 #include <wallet/cosmos/CosmosLikeConstants.hpp>
@@ -439,6 +440,7 @@ void CosmosLikeTransactionDatabaseHelper::eraseDataSince(
             soci::use(accountUid), soci::use(date);
         sql << "DELETE FROM cosmos_transactions"
             " WHERE uid IN (:uids)", soci::use(txToDelete);
+        BalanceCheckpointDatabaseHelper::refresh(sql, accountUid, date);
     }
 }
 
@@ -79,6 +79,13 @@ namespace ledger {
 // Address at the end of the filter is...
         static const std::vector<CosmosLikeBlockchainExplorer::TransactionFilter> GAIA_FILTER{};
 
+        // Requests derived from a single call (block of each transaction, transactions of each address) running
+        // at once
+        static const std::size_t MAX_CONCURRENT_REQUESTS = 8;
+
+        // Validator descriptions and commissions change rarely, they are fetched for each delegation
+        static const auto VALIDATOR_INFO_CACHE_TTL = std::chrono::minutes(5);
+
         GaiaCosmosLikeBlockchainExplorer::GaiaCosmosLikeBlockchainExplorer(
                 const std::shared_ptr<api::ExecutionContext> &context,
                 const std::shared_ptr<HttpClient> &http,
@@ -101,6 +108,7 @@ namespace ledger {
         FuturePtr<cosmos::Block> GaiaCosmosLikeBlockchainExplorer::getBlock(uint64_t &blockHeight) const
         {
             return _http->GET(fmt::format(kGaiaBlocksEndpoint, blockHeight), ACCEPT_HEADER)
+                    .cache(HttpCachePolicy::immutable())
                     .json(true)
                     .mapPtr<cosmos::Block>(getContext(), [](const HttpRequest::JsonResult &response) {
                         auto result = std::make_shared<cosmos::Block>();
@@ -226,12 +234,15 @@ namespace ledger {
         FuturePtr<cosmos::TransactionsBulk> GaiaCosmosLikeBlockchainExplorer::getTransactions(
                 const CosmosLikeBlockchainExplorer::TransactionFilter &filter, int page, int limit) const
         {
-            // NOTE : the amount of memory involved here asks for a second pass to make
-            // sure that the least amount of copies is done.
+            // Transactions are parsed one at a time while the page is read, the page is never held as a whole DOM.
+            auto parsed = std::make_shared<std::vector<cosmos::Transaction>>();
             return _http->GET(fmt::format(kGaiaTransactionsWithPageLimitEnpoint, filter, page, limit), ACCEPT_HEADER)
-                    .json(true)
+                    .streamJsonArray(kTxArray, [this, parsed](const rapidjson::Value &node) {
+                        parsed->emplace_back();
+                        parseTransactionWithPosttreatment(node, parsed->back());
+                    }, true)
                     .flatMap<cosmos::TransactionsBulk>(
-                            getContext(), [this](const HttpRequest::JsonResult &response)
+                            getContext(), [parsed](const HttpRequest::JsonResult &response)
                                     -> Future<cosmos::TransactionsBulk> {
                                 cosmos::TransactionsBulk result;
                                 const auto &document = std::get<1>(response)->GetObject();
@@ -241,12 +252,7 @@ namespace ledger {
                                             "The API response from explorer is missing the {} key",
                                             kTxArray);
                                 }
-                                const auto &transactions = document[kTxArray].GetArray();
-                                for (const auto &node : transactions) {
-                                    auto tx = cosmos::Transaction();
-                                    parseTransactionWithPosttreatment(node, tx);
-                                    result.transactions.emplace_back(tx);
-                                }
+                                result.transactions = std::move(*parsed);
 
                                 if (!document.HasMember(kCount) ||
                                     !document[kCount].IsString() ||
@@ -266,17 +272,13 @@ namespace ledger {
                             getContext(),
                             [this](const cosmos::TransactionsBulk &inputBulk) mutable
                                     -> FuturePtr<cosmos::TransactionsBulk> {
-                                auto const &inputTxs = inputBulk.transactions;
-                                std::vector<FuturePtr<cosmos::Transaction>> filledTxsFutures;
-                                filledTxsFutures.reserve(inputTxs.size());
-                                std::transform(
-                                        inputTxs.cbegin(),
-                                        inputTxs.cend(),
-                                        std::back_inserter(filledTxsFutures),
+                                return async::traverse<cosmos::Transaction, std::shared_ptr<cosmos::Transaction>>(
+                                        getContext(),
+                                        inputBulk.transactions,
+                                        MAX_CONCURRENT_REQUESTS,
                                         [this](const cosmos::Transaction &inputTx) {
                                             return this->inflateTransactionWithBlockData(inputTx);
-                                        });
-                                return async::sequence(getContext(), filledTxsFutures)
+                                        })
                                         .flatMapPtr<cosmos::TransactionsBulk>(
                                                 getContext(),
                                                 [inputBulk = std::move(inputBulk)](
@@ -400,15 +402,13 @@ namespace ledger {
         FuturePtr<cosmos::TransactionsBulk> GaiaCosmosLikeBlockchainExplorer::getTransactionsForAddresses(
                 const std::vector<std::string> &addresses, uint32_t fromBlockHeight) const
         {
-            std::vector<FuturePtr<cosmos::TransactionsBulk>> address_transactions;
-            std::transform(
-                    addresses.begin(),
-                    addresses.end(),
-                    std::back_inserter(address_transactions),
-                    [&](const auto &address) {
+            return async::traverse<std::string, std::shared_ptr<cosmos::TransactionsBulk>>(
+                    getContext(),
+                    addresses,
+                    MAX_CONCURRENT_REQUESTS,
+                    [this, fromBlockHeight](const std::string &address) {
                         return this->getTransactionsForAddress(address, fromBlockHeight);
-                    });
-            return async::sequence(getContext(), address_transactions)
+                    })
                     .flatMapPtr<cosmos::TransactionsBulk>(getContext(), [](const auto &vector_of_bulks) {
                         return FuturePtr<cosmos::TransactionsBulk>::successful(
                                 concatenateBulks(vector_of_bulks));
@@ -736,11 +736,15 @@ namespace ledger {
         Future<cosmos::ValidatorList> GaiaCosmosLikeBlockchainExplorer::getActiveValidatorSet() const
         {
             const bool parseJsonNumbersAsStrings = true;
+            auto validators = std::make_shared<cosmos::ValidatorList>();
             auto basicValidatorList =
                     _http->GET("/staking/validators?status=bonded&page=1&limit=130")
-                            .json(parseJsonNumbersAsStrings)
-                            .map<cosmos::ValidatorList>(getContext(), [](const HttpRequest::JsonResult &response) {
-                                cosmos::ValidatorList result;
+                            .streamJsonArray(kResult, [validators](const rapidjson::Value &node) {
+                                cosmos::Validator val;
+                                rpcs_parsers::parseValidatorSetEntry(node.GetObject(), val);
+                                validators->emplace_back(std::move(val));
+                            }, parseJsonNumbersAsStrings)
+                            .map<cosmos::ValidatorList>(getContext(), [validators](const HttpRequest::JsonResult &response) {
                                 const auto &document = std::get<1>(response)->GetObject();
                                 if (!document.HasMember(kResult)) {
                                     throw make_exception(
@@ -748,17 +752,8 @@ namespace ledger {
                                             "The API response from explorer is missing the {} key",
                                             kResult);
                                 }
-                                // Handle null
-                                if (!document[kResult].IsArray()) {
-                                    return result;
-                                }
-                                const auto &validators = document[kResult].GetArray();
-                                for (const auto &node : validators) {
-                                    cosmos::Validator val;
-                                    rpcs_parsers::parseValidatorSetEntry(node.GetObject(), val);
-                                    result.emplace_back(std::move(val));
-                                }
-                                return result;
+                                // A null result streams no validator
+                                return std::move(*validators);
                             });
 
             return basicValidatorList;
@@ -770,6 +765,7 @@ namespace ledger {
             // Chain 3 explorer calls to get all the relevant information
             const bool parseJsonNumbersAsStrings = true;
             return _http->GET(fmt::format(kGaiaValidatorInfoEndpoint, valOperAddress))
+                    .cache(HttpCachePolicy::ttl(VALIDATOR_INFO_CACHE_TTL))
                     .json(parseJsonNumbersAsStrings)
                     .template flatMap<cosmos::Validator>(
                             getContext(),
@@ -823,11 +819,16 @@ namespace ledger {
         FuturePtr<std::vector<cosmos::Delegation>> GaiaCosmosLikeBlockchainExplorer::getDelegations(
                 const std::string &delegatorAddr) const
         {
+            auto delegations = std::make_shared<std::vector<cosmos::Delegation>>();
             return _http
                     ->GET(fmt::format(kGaiaDelegationsEndpoint, delegatorAddr), ACCEPT_HEADER)
-                    .json(true)
+                    .streamJsonArray(kResult, [delegations](const rapidjson::Value &result) {
+                        cosmos::Delegation delegation;
+                        rpcs_parsers::parseDelegation(result, delegation);
+                        delegations->push_back(delegation);
+                    }, true)
                     .mapPtr<std::vector<cosmos::Delegation>>(
-                            getContext(), [](const HttpRequest::JsonResult &response) {
+                            getContext(), [delegations](const HttpRequest::JsonResult &response) {
                                 const auto &document = std::get<1>(response)->GetObject();
                                 if (!document.HasMember(kResult)) {
                                     throw make_exception(
@@ -835,17 +836,7 @@ namespace ledger {
                                             "The API response from explorer is missing the {} key",
                                             kResult);
                                 }
-                                auto delegations = std::make_shared<std::vector<cosmos::Delegation>>();
-                                // Handle null
-                                if (!document[kResult].IsArray()) {
-                                    return delegations;
-                                }
-                                const auto &results = document[kResult].GetArray();
-                                for (auto &result : results) {
-                                    cosmos::Delegation delegation;
-                                    rpcs_parsers::parseDelegation(result, delegation);
-                                    delegations->push_back(delegation);
-                                }
+                                // A null result streams no delegation
                                 return delegations;
                             });
         }
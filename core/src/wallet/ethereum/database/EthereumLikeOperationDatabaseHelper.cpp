@@ -291,16 +291,19 @@ namespace {
     const auto UPSERT_OPERATION = db::stmt<OperationBinding>(
             "INSERT INTO operations VALUES("
             ":uid, :account_uid, :wallet_uid, :type, :date, :senders, :recipients, :amount,"
-            ":fees, :block_uid, :currency_name, :trust"
+            ":fees, :block_uid, :currency_name, :trust, :amount_high, :amount_low, :fees_high, :fees_low"
             ") ON CONFLICT(uid) DO UPDATE SET block_uid = :block_uid, trust = :trust,"
-            " amount = :amount, fees = :fees ", [] (auto& s, auto& b) {
+            " amount = :amount, fees = :fees, amount_high = :amount_high, amount_low = :amount_low,"
+            " fees_high = :fees_high, fees_low = :fees_low", [] (auto& s, auto& b) {
                 s, use(b.uid, "uid"), use(b.accountUid, "account_uid"),
                     use(b.walletUid, "wallet_uid"), use(b.type, "type"),
                     use(b.date, "date"), use(b.senders, "senders"),
                     use(b.receivers, "recipients"), use(b.amount, "amount"),
                     use(b.fees, "fees"), use(b.blockUid, "block_uid"),
                     use(b.currencyName, "currency_name"),
-                    use(b.serializedTrust, "trust");
+                    use(b.serializedTrust, "trust"),
+                    use(b.amountHigh, "amount_high"), use(b.amountLow, "amount_low"),
+                    use(b.feesHigh, "fees_high"), use(b.feesLow, "fees_low");
             });
 }
 
@@ -322,7 +325,6 @@ namespace ledger {
             PreparedStatement<ERC20TokenBinding> tokenStmt;
 
             UPSERT_OPERATION(sql, operationStmt);
-            BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, blockStmt);
             UPSERT_ERC20_ACCOUNT(sql, erc20AccountStmt);
             UPSERT_ERC20_OPERATION(sql, erc20OpStmt);
             UPSERT_ETHEREUM_OPERATION(sql, ethOpStmt);
@@ -364,7 +366,7 @@ namespace ledger {
             }
             // Block
             if (!blockStmt.bindings.uid.empty())
-                blockStmt.execute();
+                BulkInsertDatabaseHelper::upsertBlocks(sql, blockStmt);
             // ERC Token
             if (!tokenStmt.bindings.name.empty())
                 tokenStmt.execute();
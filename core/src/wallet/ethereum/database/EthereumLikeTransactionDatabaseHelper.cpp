@@ -35,6 +35,7 @@
 #include <database/soci-option.h>
 #include <database/soci-date.h>
 #include <database/soci-number.h>
+#include <database/soci-in.h>
 #include <crypto/SHA256.hpp>
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <wallet/common/database/OperationDatabaseHelper.h>
@@ -63,6 +64,23 @@ namespace ledger {
             return false;
         }
 
+        std::unordered_map<std::string, EthereumLikeBlockchainExplorerTransaction>
+        EthereumLikeTransactionDatabaseHelper::getTransactionsByOperationUids(soci::session &sql,
+                                                                              const std::vector<std::string> &operationUids) {
+            std::unordered_map<std::string, EthereumLikeBlockchainExplorerTransaction> result;
+            // The operation uid comes last so that rows keep the layout expected by inflateTransaction
+            db::selectIn(sql, "SELECT  tx.hash, tx.value, tx.nonce, tx.time, tx.input_data, tx.gas_price, "
+                              "tx.gas_limit, tx.gas_used, tx.sender, tx.receiver, tx.confirmations, tx.status, "
+                              "block.hash, block.height, block.time, block.currency_name, eop.uid "
+                              "FROM ethereum_operations AS eop "
+                              "JOIN ethereum_transactions AS tx ON tx.transaction_uid = eop.transaction_uid "
+                              "LEFT JOIN blocks AS block ON tx.block_uid = block.uid "
+                              "WHERE eop.uid IN ({})", operationUids, [&] (const soci::row& row) {
+                inflateTransaction(sql, row, result[row.get<std::string>(16)]);
+            });
+            return result;
+        }
+
         bool EthereumLikeTransactionDatabaseHelper::inflateTransaction(soci::session &sql,
                                                                        const soci::row &row,
                                                                        EthereumLikeBlockchainExplorerTransaction &tx) {
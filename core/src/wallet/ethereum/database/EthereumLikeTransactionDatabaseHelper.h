@@ -33,6 +33,8 @@
 #define LEDGER_CORE_ETHEREUMLIKETRANSACTIONDATABASEHELPER_H
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <soci.h>
 #include <wallet/ethereum/explorers/EthereumLikeBlockchainExplorer.h>
 
@@ -44,6 +46,13 @@ namespace ledger {
                                              const std::string &hash,
                                              EthereumLikeBlockchainExplorerTransaction &tx);
 
+            /**
+             * Fetch the transactions of the given ethereum operations with a single query per slice of operations.
+             * Transactions are keyed by operation uid.
+             */
+            static std::unordered_map<std::string, EthereumLikeBlockchainExplorerTransaction>
+            getTransactionsByOperationUids(soci::session &sql, const std::vector<std::string> &operationUids);
+
             static bool inflateTransaction(soci::session &sql,
                                            const soci::row &row,
                                            EthereumLikeBlockchainExplorerTransaction &tx);
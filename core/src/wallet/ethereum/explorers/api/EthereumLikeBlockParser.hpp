@@ -36,13 +36,13 @@ namespace ledger {
     namespace core {
         class EthereumLikeBlockParser : public AbstractBlockParser<EthereumLikeBlockchainExplorer::Block> {
         public:
-            EthereumLikeBlockParser(std::string &lastKey) : _lastKey(lastKey) {};
+            EthereumLikeBlockParser(LedgerApiKey &lastKey) : _lastKey(lastKey) {};
         protected:
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             };
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
         };
     }
 }
@@ -35,7 +35,7 @@
 
 #define PROXY_PARSE(method, ...)                                    \
  auto& currentObject = _hierarchy.top();                            \
- if (currentObject == "block") {                                    \
+ if (currentObject == LedgerApiKey::block) {                        \
     return _blockParser.method(__VA_ARGS__);                        \
  } else                                                             \
 
@@ -43,9 +43,9 @@ namespace ledger {
     namespace core {
 
         bool EthereumLikeTransactionParser::Key(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
-            _lastKey = std::string(str, length);
+            _lastKey = LedgerApiKeys::fromString(str, length);
 
-            if (_lastKey == "block" && _arrayDepth == 0) {
+            if (_lastKey == LedgerApiKey::block && _arrayDepth == 0) {
                 auto& top = _hierarchy.top();
             }
             PROXY_PARSE(Key, str, length, copy) {
@@ -60,13 +60,13 @@ namespace ledger {
 
             auto& currentObject = _hierarchy.top();
 
-            if (currentObject == "block") {
+            if (currentObject == LedgerApiKey::block) {
                 EthereumLikeBlockchainExplorer::Block block;
                 _transaction->block = Option<EthereumLikeBlockchainExplorer::Block>(block);
                 _blockParser.init(&_transaction->block.getValue());
-            } else if (currentObject == "list" && _arrayDepth == 1) {
+            } else if (currentObject == LedgerApiKey::list && _arrayDepth == 1) {
                 _transaction->erc20Transactions.emplace_back(ERC20Transaction());
-            } else if (currentObject == "actions") {
+            } else if (currentObject == LedgerApiKey::actions) {
                 _transaction->internalTransactions.emplace_back(InternalTx());
             }
 
@@ -75,7 +75,7 @@ namespace ledger {
 
         bool EthereumLikeTransactionParser::EndObject(rapidjson::SizeType memberCount) {
             auto& currentObject = _hierarchy.top();
-            if (_lastKey == "block") {
+            if (_lastKey == LedgerApiKey::block) {
                 return false;
             }
             if (_arrayDepth == 0) {
@@ -140,32 +140,32 @@ namespace ledger {
             PROXY_PARSE(RawNumber, str, length, copy) {
                 std::string number(str, length);
                 BigInt value = BigInt::fromString(number);
-                bool isInternalTx = currentObject == "actions" && !_transaction->internalTransactions.empty();
-                if (_lastKey == "gas_used") {
+                bool isInternalTx = currentObject == LedgerApiKey::actions && !_transaction->internalTransactions.empty();
+                if (_lastKey == LedgerApiKey::gas_used) {
                     if (isInternalTx) {
                         _transaction->internalTransactions.back().gasUsed = Option<BigInt>(value);
                     } else {
                         _transaction->gasUsed = Option<BigInt>(value);
                     }
-                }  else if (_lastKey == "gas") {
+                }  else if (_lastKey == LedgerApiKey::gas) {
                     if (isInternalTx) {
                         _transaction->internalTransactions.back().gasLimit = value;
                     } else {
                         _transaction->gasLimit = value;
                     }
-                } else if (_lastKey == "gas_price") {
+                } else if (_lastKey == LedgerApiKey::gas_price) {
                     _transaction->gasPrice = value;
-                } else if (_lastKey == "confirmations") {
+                } else if (_lastKey == LedgerApiKey::confirmations) {
                     _transaction->confirmations = value.toUint64();
-                } else if (_lastKey == "value") {
+                } else if (_lastKey == LedgerApiKey::value) {
                     if (isInternalTx) {
                         _transaction->internalTransactions.back().value = value;
                     } else {
                         _transaction->value = value;
                     }
-                } else if (_lastKey == "status") {
+                } else if (_lastKey == LedgerApiKey::status) {
                     _transaction->status = value.toUint64();
-                } else if (_lastKey == "count" && !_transaction->erc20Transactions.empty()) {
+                } else if (_lastKey == LedgerApiKey::count && !_transaction->erc20Transactions.empty()) {
                     _transaction->erc20Transactions.back().value = value;
                 }
                 return true;
@@ -186,18 +186,18 @@ namespace ledger {
                 };
 
                 //All addresses are lower cased, we get EIP55 format
-                if ((_lastKey == "from" || _lastKey == "to" || _lastKey == "contract") && value.size() > 2) {
+                if ((_lastKey == LedgerApiKey::from || _lastKey == LedgerApiKey::to || _lastKey == LedgerApiKey::contract) && value.size() > 2) {
                     value = Base58::encodeWithEIP55(value);
                 }
 
-                bool isInternalTx = currentObject == "actions" && !_transaction->internalTransactions.empty();
-                bool isERC20Event = currentObject == "list" && !_transaction->erc20Transactions.empty();
+                bool isInternalTx = currentObject == LedgerApiKey::actions && !_transaction->internalTransactions.empty();
+                bool isERC20Event = currentObject == LedgerApiKey::list && !_transaction->erc20Transactions.empty();
 
-                if (_lastKey == "hash") {
+                if (_lastKey == LedgerApiKey::hash) {
                     _transaction->hash = value;
-                } else if (_lastKey == "received_at") {
+                } else if (_lastKey == LedgerApiKey::received_at) {
                     _transaction->receivedAt = DateUtils::fromJSON(value);
-                } else if (_lastKey == "to") {
+                } else if (_lastKey == LedgerApiKey::to) {
                     if (isERC20Event) {
                         _transaction->erc20Transactions.back().to = value;
                     } else if (isInternalTx) {
@@ -205,7 +205,7 @@ namespace ledger {
                     } else {
                         _transaction->receiver = value;
                     }
-                } else if (_lastKey == "from") {
+                } else if (_lastKey == LedgerApiKey::from) {
                     if (isERC20Event) {
                         _transaction->erc20Transactions.back().from = value;
                     } else if (isInternalTx) {
@@ -213,10 +213,10 @@ namespace ledger {
                     } else {
                         _transaction->sender = value;
                     }
-                } else if (_lastKey == "nonce") {
+                } else if (_lastKey == LedgerApiKey::nonce) {
                     std::istringstream issNonce(value);
                     issNonce >> _transaction->nonce;
-                } else if (_lastKey == "input") {
+                } else if (_lastKey == LedgerApiKey::input) {
                     const auto inputData = fromStringToBytes(value);
                     if (value.size() <= ledger::core::MAX_LENGTH_VAR_CHAR) {
                         if (isInternalTx) {
@@ -225,14 +225,14 @@ namespace ledger {
                             _transaction->inputData = std::move(inputData);
                         }
                     }
-                } else if (_lastKey == "contract" && !_transaction->erc20Transactions.empty()) {
+                } else if (_lastKey == LedgerApiKey::contract && !_transaction->erc20Transactions.empty()) {
                     _transaction->erc20Transactions.back().contractAddress = value;
                 }
                 return true;
             }
         }
 
-        EthereumLikeTransactionParser::EthereumLikeTransactionParser(std::string& lastKey) :
+        EthereumLikeTransactionParser::EthereumLikeTransactionParser(LedgerApiKey& lastKey) :
             _lastKey(lastKey), _blockParser(lastKey)
         {
             _arrayDepth = 0;
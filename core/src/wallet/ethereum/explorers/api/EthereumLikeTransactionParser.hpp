@@ -45,7 +45,7 @@ namespace ledger {
         class EthereumLikeTransactionParser {
         public:
             typedef EthereumLikeBlockchainExplorerTransaction Result;
-            EthereumLikeTransactionParser(std::string& lastKey);
+            EthereumLikeTransactionParser(LedgerApiKey& lastKey);
             void init(EthereumLikeBlockchainExplorerTransaction* transaction);
             bool Null();
             bool Bool(bool b);
@@ -63,10 +63,10 @@ namespace ledger {
             bool EndArray(rapidjson::SizeType elementCount);
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
             EthereumLikeBlockchainExplorerTransaction* _transaction;
 
-            std::stack<std::string> _hierarchy;
+            std::stack<LedgerApiKey> _hierarchy;
             uint32_t _arrayDepth;
             EthereumLikeBlockParser _blockParser;
         };
@@ -40,7 +40,7 @@ namespace ledger {
         class EthereumLikeBlockchainExplorer;
         class EthereumLikeTransactionsBulkParser : public AbstractTransactionsBulkParser<EthereumLikeBlockchainExplorer::TransactionsBulk, EthereumLikeTransactionsParser> {
         public:
-            EthereumLikeTransactionsBulkParser(std::string& lastKey) : _lastKey(lastKey),
+            EthereumLikeTransactionsBulkParser(LedgerApiKey& lastKey) : _lastKey(lastKey),
                                                                        _transactionsParser(lastKey)
             {
                 _depth = 0;
@@ -51,12 +51,12 @@ namespace ledger {
                 return _transactionsParser;
             }
 
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             }
         private:
             EthereumLikeTransactionsParser _transactionsParser;
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
         };
     }
 }
@@ -41,7 +41,7 @@ namespace ledger {
     namespace core {
         class EthereumLikeTransactionsParser : public AbstractTransactionsParser<EthereumLikeBlockchainExplorerTransaction, EthereumLikeTransactionParser> {
         public:
-            EthereumLikeTransactionsParser(std::string& lastKey) : _transactionParser(lastKey)
+            EthereumLikeTransactionsParser(LedgerApiKey& lastKey) : _transactionParser(lastKey)
             {
                 _arrayDepth = 0;
                 _objectDepth = 0;
@@ -50,14 +50,14 @@ namespace ledger {
         public:
 
 
-            explicit EthereumLikeWebSocketNotificationParser(std::string& lastKey) : _lastKey(lastKey),
+            explicit EthereumLikeWebSocketNotificationParser(LedgerApiKey& lastKey) : _lastKey(lastKey),
                                                                                     _blockParser(lastKey),
                                                                                     _transactionParser(lastKey) {
 
             }
 
             bool Key(const rapidjson::Reader::Ch* str, rapidjson::SizeType length, bool copy) override {
-                _lastKey = std::string(str, length);
+                _lastKey = LedgerApiKeys::fromString(str, length);
                 return AbstractWebSocketNotificationParser<EthereumLikeBlockchainExplorerTransaction,
                         EthereumLikeBlockchainExplorer::Block,
                         EthereumLikeTransactionParser,
@@ -72,12 +72,12 @@ namespace ledger {
             EthereumLikeBlockParser &getBlockParser() override {
                 return _blockParser;
             };
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             };
 
         private:
-            std::string& _lastKey;
+            LedgerApiKey& _lastKey;
             EthereumLikeBlockParser _blockParser;
             EthereumLikeTransactionParser _transactionParser;
         };
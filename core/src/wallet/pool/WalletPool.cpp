@@ -30,6 +30,7 @@
  */
 #include "WalletPool.hpp"
 #include <api/PoolConfiguration.hpp>
+#include <api/Configuration.hpp>
 #include <api/ConfigurationDefaults.hpp>
 #include <preferences/Preferences.hpp>
 #include <wallet/currencies.hpp>
@@ -42,6 +43,25 @@
 
 namespace ledger {
     namespace core {
+        // Memory and disk budgets of the explorer responses cache
+        static const size_t HTTP_CACHE_MAX_BYTES = 8 * 1024 * 1024;
+        static const size_t HTTP_CACHE_MAX_DISK_BYTES = 64 * 1024 * 1024;
+
+        // Explorer requests middleware, everything stays off unless configured
+        static HttpRequestScheduler::Options getSchedulerOptions(const std::shared_ptr<api::DynamicObject> &configuration) {
+            HttpRequestScheduler::Options options;
+            options.maxRetries = configuration->getInt(api::Configuration::HTTP_MAX_RETRIES).value_or(options.maxRetries);
+            options.retryBaseDelayMs = configuration->getInt(api::Configuration::HTTP_RETRY_BASE_DELAY)
+                    .value_or(static_cast<int32_t>(options.retryBaseDelayMs));
+            options.retryMaxDelayMs = configuration->getInt(api::Configuration::HTTP_RETRY_MAX_DELAY)
+                    .value_or(static_cast<int32_t>(options.retryMaxDelayMs));
+            options.hedgeDelayMs = configuration->getInt(api::Configuration::HTTP_HEDGE_DELAY)
+                    .value_or(static_cast<int32_t>(options.hedgeDelayMs));
+            options.coalesceRequests = configuration->getBoolean(api::Configuration::HTTP_COALESCE_REQUESTS)
+                    .value_or(options.coalesceRequests);
+            return options;
+        }
+
         WalletPool::WalletPool(
             const std::string &name,
             const std::string &password,
@@ -93,6 +113,10 @@ namespace ledger {
                 );
             }
 
+            // Explorer responses cache, immutable entries are kept in the internal preferences
+            _httpCache = std::make_shared<HttpCache>(HTTP_CACHE_MAX_BYTES, getInternalPreferences()->getSubPreferences("http_cache"),
+                                                     HTTP_CACHE_MAX_DISK_BYTES);
+
             _rng = rng;
             // Encrypt the preferences, if needed
             _password = password;
@@ -119,7 +143,8 @@ namespace ledger {
                pathResolver,
                _logger,
                Option<std::string>(configuration->getString(api::PoolConfiguration::DATABASE_NAME)).getValueOr(name),
-               password
+               password,
+               dispatcher->getSerialExecutionContext(fmt::format("database_write_queue_{}", name))
             );
 
             // Threading management
@@ -265,6 +290,13 @@ namespace ledger {
                 );
                 _httpClients[baseUrl] = client;
                 client->setLogger(logger());
+                client->setCache(_httpCache);
+                client->setSchedulerOptions(getSchedulerOptions(_configuration));
+                // The limit is shared by every client of the host, it is only touched when configured
+                auto maxConcurrentRequests = _configuration->getInt(api::Configuration::HTTP_MAX_CONCURRENT_REQUESTS);
+                if (maxConcurrentRequests) {
+                    HttpRequestScheduler::forUrl(baseUrl)->setMaxConcurrentRequests(maxConcurrentRequests.value());
+                }
                 return client;
             }
             auto client = _httpClients[baseUrl].lock();
@@ -593,6 +625,7 @@ namespace ledger {
                 // then reset preferences
                 _externalPreferencesBackend->clear();
                 _internalPreferencesBackend->clear();
+                _httpCache->clear();
 
                 // and we’re done
                 return Future<api::ErrorCode>::successful(api::ErrorCode::FUTURE_WAS_SUCCESSFULL);
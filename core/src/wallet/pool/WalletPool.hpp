@@ -181,6 +181,7 @@ namespace ledger {
             // HTTP management
             std::shared_ptr<api::HttpClient> _httpEngine;
             std::unordered_map<std::string, std::weak_ptr<HttpClient>> _httpClients;
+            std::shared_ptr<HttpCache> _httpCache;
 
             // WS management
             std::shared_ptr<WebSocketClient> _wsClient;
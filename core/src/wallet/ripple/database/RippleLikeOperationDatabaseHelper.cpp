@@ -32,6 +32,7 @@
 #include "RippleLikeOperationDatabaseHelper.hpp"
 #include <database/PreparedStatement.hpp>
 #include <wallet/common/database/BulkInsertDatabaseHelper.hpp>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <wallet/ripple/database/RippleLikeTransactionDatabaseHelper.h>
 #include <database/soci-date.h>
 #include <database/soci-option.h>
@@ -158,8 +159,6 @@ namespace ledger {
             PreparedStatement<RippleOperationBinding> rippleOpStmt;
             PreparedStatement<MemoBinding> memoStmt;
 
-            BulkInsertDatabaseHelper::UPSERT_OPERATION(sql, opStmt);
-            BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, blockStmt);
             UPSERT_TRANSACTION(sql, txStmt);
             UPSERT_RIPPLE_OPERATION(sql, rippleOpStmt);
             UPSERT_MEMO(sql, memoStmt);
@@ -179,9 +178,10 @@ namespace ledger {
                 opStmt.bindings.update(op);
             }
             if (!blockStmt.bindings.hash.empty())
-                blockStmt.execute();
+                BulkInsertDatabaseHelper::upsertBlocks(sql, blockStmt);
             txStmt.execute();
-            opStmt.execute();
+            BulkInsertDatabaseHelper::upsertOperations(sql, opStmt);
+            BalanceCheckpointDatabaseHelper::update(sql, opStmt.bindings);
             rippleOpStmt.execute();
         }
     }
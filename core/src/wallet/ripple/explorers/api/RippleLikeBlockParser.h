@@ -40,17 +40,17 @@ namespace ledger {
     namespace core {
         class RippleLikeBlockParser : public AbstractBlockParser<RippleLikeBlockchainExplorer::Block> {
         public:
-            RippleLikeBlockParser(std::string &lastKey) : _lastKey(lastKey) {};
+            RippleLikeBlockParser(LedgerApiKey &lastKey) : _lastKey(lastKey) {};
 
             bool RawNumber(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
-                if (getLastKey() == "ledger_index") {
+                if (getLastKey() == LedgerApiKey::ledger_index) {
                     std::string number(str, length);
                     BigInt value = BigInt::fromString(number);
                     _block->height = value.toUint64();
                     // Ledger index is not really a hash but since XRP doesn't have reorg
                     // it's safe to use ledger index as a unique hash.
                     _block->hash = number;
-                } else if (getLastKey() == "close_time") {
+                } else if (getLastKey() == LedgerApiKey::close_time) {
                     std::string number(str, length);
                     BigInt value = BigInt::fromString(number);
                     _block->time = xrp_utils::toTimePoint<std::chrono::system_clock>(value.toUint64());
@@ -59,11 +59,11 @@ namespace ledger {
             }
 
         protected:
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             };
         private:
-            std::string &_lastKey;
+            LedgerApiKey &_lastKey;
         };
     }
 }
@@ -34,7 +34,7 @@
 
 #define PROXY_PARSE(method, ...)                                    \
  auto& currentObject = _hierarchy.top();                            \
- if (currentObject == "block") {                                    \
+ if (currentObject == LedgerApiKey::block) {                        \
     return _blockParser.method(__VA_ARGS__);                        \
  } else                                                             \
 
@@ -54,7 +54,7 @@ namespace ledger {
                 _hierarchy.push(_lastKey);
             }
 
-            if (_lastKey == "Memo") {
+            if (_lastKey == LedgerApiKey::Memo) {
                 // add a new empty RippleLikeMemo to the transaction (it’ll be filled in later by
                 // the parser)
                 _transaction->memos.push_back(api::RippleLikeMemo());
@@ -129,9 +129,9 @@ namespace ledger {
 
                 std::string number(str, length);
                 BigInt value = BigInt::fromString(number);
-                if (_lastKey == "confirmations") {
+                if (_lastKey == LedgerApiKey::confirmations) {
                     _transaction->confirmations = value.toUint64();
-                } else if (_lastKey == "ledger_index") {
+                } else if (_lastKey == LedgerApiKey::ledger_index) {
                     RippleLikeBlockchainExplorer::Block block;
                     block.height = value.toUint64();
                     block.currencyName = currencies::RIPPLE.name;
@@ -139,9 +139,9 @@ namespace ledger {
                     // it's safe to use ledger index as a unique hash.
                     block.hash = number;
                     _transaction->block = block;
-                } else if (_lastKey == "DestinationTag") {
+                } else if (_lastKey == LedgerApiKey::DestinationTag) {
                   _transaction->destinationTag = Option<uint64_t>(value.toUint64());
-                } else if (_lastKey == "date" && currentObject != "transaction") {
+                } else if (_lastKey == LedgerApiKey::date && currentObject != LedgerApiKey::transaction) {
                   _transaction->receivedAt = xrp_utils::toTimePoint<std::chrono::system_clock>(value.toUint64());
                   if (_transaction->block.hasValue()) {
                       _transaction->block.getValue().time = _transaction->receivedAt;
@@ -157,34 +157,34 @@ namespace ledger {
             PROXY_PARSE(String, str, length, copy) {
                 std::string value(str, length);
 
-                if (_lastKey == "hash") {
+                if (_lastKey == LedgerApiKey::hash) {
                     _transaction->hash = value;
-                } else if (_lastKey == "Account" && (currentObject == "tx" || currentObject == "transaction")){
+                } else if (_lastKey == LedgerApiKey::Account && (currentObject == LedgerApiKey::tx || currentObject == LedgerApiKey::transaction)){
                     _transaction->sender = value;
-                } else if (_lastKey == "Destination") {
+                } else if (_lastKey == LedgerApiKey::Destination) {
                     _transaction->receiver = value;
-                } else if (_lastKey == "Amount") {
+                } else if (_lastKey == LedgerApiKey::Amount) {
                     BigInt valueBigInt = BigInt::fromString(value);
                     _transaction->value = valueBigInt;
-                } else if (_lastKey == "Fee") {
+                } else if (_lastKey == LedgerApiKey::Fee) {
                     BigInt valueBigInt = BigInt::fromString(value);
                     _transaction->fees = value;
-                } else if (_lastKey == "Sequence") {
+                } else if (_lastKey == LedgerApiKey::Sequence) {
                     _transaction->sequence = BigInt::fromString(value);
-                } else if (_lastKey == "MemoData" && !_transaction->memos.empty()) {
+                } else if (_lastKey == LedgerApiKey::MemoData && !_transaction->memos.empty()) {
                     _transaction->memos.back().data = value;
-                } else if (_lastKey == "MemoFormat" && !_transaction->memos.empty()) {
+                } else if (_lastKey == LedgerApiKey::MemoFormat && !_transaction->memos.empty()) {
                     _transaction->memos.back().fmt = value;
-                } else if (_lastKey == "MemoType" && !_transaction->memos.empty()) {
+                } else if (_lastKey == LedgerApiKey::MemoType && !_transaction->memos.empty()) {
                     _transaction->memos.back().ty = value;
-                } else if (_lastKey == "TransactionResult") {
+                } else if (_lastKey == LedgerApiKey::TransactionResult) {
                     _transaction->status = value == "tesSUCCESS" ? 1 : 0;
                 }
                 return true;
             }
         }
 
-        RippleLikeTransactionParser::RippleLikeTransactionParser(std::string &lastKey) :
+        RippleLikeTransactionParser::RippleLikeTransactionParser(LedgerApiKey &lastKey) :
                 _lastKey(lastKey), _blockParser(lastKey) {
             _arrayDepth = 0;
         }
@@ -50,7 +50,7 @@ namespace ledger {
         public:
             typedef RippleLikeBlockchainExplorerTransaction Result;
 
-            RippleLikeTransactionParser(std::string &lastKey);
+            RippleLikeTransactionParser(LedgerApiKey &lastKey);
 
             void init(RippleLikeBlockchainExplorerTransaction *transaction);
 
@@ -82,14 +82,14 @@ namespace ledger {
 
             bool EndArray(rapidjson::SizeType elementCount);
 
-            std::string &getLastKey() {
+            LedgerApiKey &getLastKey() {
                 return _lastKey;
             };
         private:
-            std::string &_lastKey;
+            LedgerApiKey &_lastKey;
             RippleLikeBlockchainExplorerTransaction *_transaction;
 
-            std::stack<std::string> _hierarchy;
+            std::stack<LedgerApiKey> _hierarchy;
             uint32_t _arrayDepth;
             RippleLikeBlockParser _blockParser;
         };
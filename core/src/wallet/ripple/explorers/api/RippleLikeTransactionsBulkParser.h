@@ -43,7 +43,7 @@ namespace ledger {
         class RippleLikeTransactionsBulkParser
                 : public AbstractTransactionsBulkParser<RippleLikeBlockchainExplorer::TransactionsBulk, RippleLikeTransactionsParser> {
         public:
-            RippleLikeTransactionsBulkParser(std::string &lastKey):
+            RippleLikeTransactionsBulkParser(LedgerApiKey &lastKey):
                 _lastKey(lastKey),
                 _transactionsParser(lastKey),
                 _inPaginationMarker(false) {
@@ -51,7 +51,7 @@ namespace ledger {
             };
 
             bool StartArray() {
-                if (_depth >= 1 || getLastKey() == "transactions") {
+                if (_depth >= 1 || getLastKey() == LedgerApiKey::transactions) {
                     _depth += 1;
                 }
 
@@ -67,7 +67,7 @@ namespace ledger {
             }
 
             bool StartObject() {
-                if (_lastKey == "marker") {
+                if (_lastKey == LedgerApiKey::marker) {
                     _inPaginationMarker = true;
                 }
 
@@ -90,9 +90,9 @@ namespace ledger {
 
             bool RawNumber(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
                 if (_inPaginationMarker) {
-                    if (_lastKey == "ledger") {
+                    if (_lastKey == LedgerApiKey::ledger) {
                         _paginationMarkerLedger = std::string(str, length);
-                    } else if (_lastKey == "seq") {
+                    } else if (_lastKey == LedgerApiKey::seq) {
                         _paginationMarkerSeq = std::string(str, length);
                     }
                 }
@@ -110,13 +110,13 @@ namespace ledger {
                 return _transactionsParser;
             }
 
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             }
 
         private:
             RippleLikeTransactionsParser _transactionsParser;
-            std::string &_lastKey;
+            LedgerApiKey &_lastKey;
             bool _inPaginationMarker;
             std::string _paginationMarkerLedger;
             std::string _paginationMarkerSeq;
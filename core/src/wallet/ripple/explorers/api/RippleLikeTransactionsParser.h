@@ -41,7 +41,7 @@ namespace ledger {
         class RippleLikeTransactionsParser
                 : public AbstractTransactionsParser<RippleLikeBlockchainExplorerTransaction, RippleLikeTransactionParser> {
         public:
-            RippleLikeTransactionsParser(std::string &lastKey) : _transactionParser(lastKey) {
+            RippleLikeTransactionsParser(LedgerApiKey &lastKey) : _transactionParser(lastKey) {
                 _arrayDepth = 0;
                 _objectDepth = 0;
             }
@@ -42,6 +42,7 @@
 #include <wallet/common/database/AccountDatabaseHelper.h>
 #include <common/AccountHelper.hpp>
 #include <wallet/common/database/OperationDatabaseHelper.h>
+#include <wallet/common/synchronizers/BlockchainReorganization.h>
 #include <wallet/ripple/RippleLikeAccount.h>
 #include <wallet/ripple/synchronizers/RippleLikeAccountSynchronizer.hpp>
 
@@ -298,70 +299,61 @@ Future<Unit> RippleLikeAccountSynchronizer::synchronizeBatches(
                             auto const failedBlockHash = failedBatch.blockHash;
 
                             if (failedBlockHeight > 0) {
-
-                                //Delete data related to failedBlock (and all blocks above it)
-                                buddy->logger->info(
-                                    "Deleting blocks above block height: {}", failedBlockHeight);
-
-                                soci::session sql(buddy->wallet->getDatabase()->getPool());
+                                auto currencyName = buddy->wallet->getCurrency().name;
+                                std::vector<api::Block> candidates;
                                 {
-                                    soci::transaction tr(sql);
-                                    try {
-                                        soci::rowset<std::string> rows_block = (sql.prepare << "SELECT uid FROM blocks where height >= :failedBlockHeight",
-                                                                                soci::use(failedBlockHeight));
-
-                                        std::vector<std::string> blockToDelete(rows_block.begin(), rows_block.end());
-
-                                        // Fetch all operations which are deleted during reorganization
-                                        auto deletedOperationUIDs = OperationDatabaseHelper::fetchFromBlocks(sql, blockToDelete);
+                                    soci::session sql(buddy->wallet->getDatabase()->getPool());
+                                    candidates = BlockDatabaseHelper::getBlocksBelowHeight(sql, currencyName, failedBlockHeight);
+                                }
 
-                                        // Remove failed blocks and associated operations/transactions
-                                        AccountDatabaseHelper::removeBlockOperation(sql, buddy->account->getAccountUid(), blockToDelete);
+                                //Look the fork point up instead of walking back one batch at a time
+                                auto firstAddress = static_cast<uint32_t>(currentBatchIndex * buddy->halfBatchSize);
+                                auto addresses = vector::map<std::string, std::shared_ptr<RippleLikeAddress>>(
+                                    buddy->keychain->getAllObservableAddresses(firstAddress, firstAddress),
+                                    [](const std::shared_ptr<RippleLikeAddress>& addr) {
+                                        return addr->toString();
+                                    });
+                                auto probe = BlockchainReorganization::probeWith(self->_explorer, addresses);
+                                buddy->logger->info(
+                                    "Looking for the fork point below block height: {}", failedBlockHeight);
+                                return BlockchainReorganization::findCommonAncestor(candidates, probe)
+                                .flatMap<Unit>(buddy->account->getContext(), [=](const Option<api::Block>& ancestor) {
+                                    int64_t lastBlockHeight = 0;
+                                    std::string lastBlockHash;
+                                    if (ancestor.nonEmpty()) {
+                                        lastBlockHeight = ancestor.getValue().height;
+                                        lastBlockHash = ancestor.getValue().blockHash;
+                                    }
 
-                                        //Get last block not part from reorg
-                                        auto lastBlock = BlockDatabaseHelper::getLastBlock(sql, buddy->wallet->getCurrency().name);
+                                    //Delete data related to all blocks above the fork point
+                                    buddy->logger->info(
+                                        "Deleting blocks above block height: {}", lastBlockHeight);
 
-                                        //Resync from the "beginning" if no last block in DB
-                                        int64_t lastBlockHeight = 0;
-                                        std::string lastBlockHash;
-                                        if (lastBlock.nonEmpty()) {
-                                            lastBlockHeight = lastBlock.getValue().height;
-                                            lastBlockHash = lastBlock.getValue().blockHash;
-                                        }
-                                        // update reorganization block height until found the valid one
-                                        buddy->context.reorgBlockHeight = lastBlockHeight;
-
-                                        //Update savedState's batches
-                                        for (auto& batch : buddy->savedState.getValue().batches) {
-                                            if (batch.blockHeight > lastBlockHeight) {
-                                                batch.blockHeight = static_cast<uint32_t>(lastBlockHeight);
-                                                batch.blockHash = lastBlockHash;
-                                            }
+                                    soci::session sql(buddy->wallet->getDatabase()->getPool());
+                                    soci::transaction tr(sql);
+                                    auto deletedOperationUIDs = BlockchainReorganization::rollback(sql,
+                                        buddy->account->getAccountUid(), currencyName, ancestor);
+                                    buddy->context.reorgBlockHeight = lastBlockHeight;
+
+                                    //Update savedState's batches
+                                    for (auto& batch : buddy->savedState.getValue().batches) {
+                                        if (batch.blockHeight > lastBlockHeight) {
+                                            batch.blockHeight = static_cast<uint32_t>(lastBlockHeight);
+                                            batch.blockHash = lastBlockHash;
                                         }
-                                        tr.commit();
-
-                                        // We can emit safely deleted operation UIDs
-                                        std::for_each(
-                                            deletedOperationUIDs.cbegin(),
-                                            deletedOperationUIDs.cend(),
-                                            [buddy](auto const& uid) {
-                                                buddy->account->emitDeletedOperationEvent(uid);
-                                            });
-                                    } catch(...) {
-                                        tr.rollback();
                                     }
-                                }
+                                    tr.commit();
 
-                                //Save new savedState
-                                buddy->preferences->editor()->putObject<AccountSynchronizationSavedState>(
-                                        "state", buddy->savedState.getValue())->commit();
+                                    // We can emit safely deleted operation UIDs
+                                    buddy->account->emitDeletedOperationsEvent(deletedOperationUIDs);
 
-                                //Synchronize same batch now with an existing block (of hash lastBlockHash)
-                                //if failedBatch was not the deepest block part of that reorg, this recursive call
-                                //will ensure to get (and delete from DB) to the deepest failed block (part of reorg)
-                                buddy->logger->info("Relaunch synchronization after recovering from reorganization");
+                                    //Save new savedState
+                                    buddy->preferences->editor()->putObject<AccountSynchronizationSavedState>(
+                                            "state", buddy->savedState.getValue())->commit();
 
-                                return self->synchronizeBatches(currentBatchIndex, buddy);
+                                    buddy->logger->info("Relaunch synchronization after recovering from reorganization");
+                                    return self->synchronizeBatches(currentBatchIndex, buddy);
+                                });
                             }
                             return Future<Unit>::successful(unit);
                         })
@@ -39,6 +39,7 @@
 #include "database/StellarLikeTransactionDatabaseHelper.hpp"
 #include "database/StellarLikeOperationDatabaseHelper.hpp"
 #include <wallet/common/database/OperationDatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <set>
 #include <wallet/common/BalanceHistory.hpp>
 #include <api/BoolCallback.hpp>
@@ -177,6 +178,16 @@ namespace ledger {
 
                 const auto &uid = self->getAccountUid();
                 soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
+                std::vector<std::shared_ptr<api::Amount>> amounts;
+
+                auto checkpoints = BalanceCheckpointDatabaseHelper::getBalanceHistory(sql, uid, startDate, endDate, precision);
+                if (checkpoints.nonEmpty()) {
+                    for (const auto& value : checkpoints.getValue()) {
+                        amounts.emplace_back(std::make_shared<ledger::core::Amount>(self->getWallet()->getCurrency(), 0, value));
+                    }
+                    return amounts;
+                }
+
                 std::vector<Operation> operations;
 
                 auto keychain = self->getKeychain();
@@ -190,7 +201,6 @@ namespace ledger {
                 auto lowerDate = startDate;
                 auto upperDate = DateUtils::incrementDate(startDate, precision);
 
-                std::vector<std::shared_ptr<api::Amount>> amounts;
                 std::size_t operationsCount = 0;
                 BigInt sum;
                 while (lowerDate <= endDate && operationsCount < operations.size()) {
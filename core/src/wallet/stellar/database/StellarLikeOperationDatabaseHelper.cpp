@@ -37,6 +37,7 @@
 #include <database/soci-backend-utils.h>
 #include <debug/Benchmarker.h>
 #include <wallet/common/database/BulkInsertDatabaseHelper.hpp>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <wallet/stellar/database/StellarLikeTransactionDatabaseHelper.hpp>
 #include <wallet/stellar/database/StellarLikeAssetDatabaseHelper.hpp>
 
@@ -249,8 +250,6 @@ namespace ledger {
             PreparedStatement<StellarOperationBinding> stellarOperationStmt;
             PreparedStatement<StellarAccountOperationBinding> stellarAccountOperationStmt;
             
-            BulkInsertDatabaseHelper::UPSERT_OPERATION(sql, operationStmt);
-            BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, blockStmt);
             UPSERT_TRANSACTION(sql, transactionStmt);
             UPSERT_ASSERT(sql, assetStmt);
             UPSERT_STELLAR_OPERATION(sql, stellarOperationStmt);
@@ -279,13 +278,14 @@ namespace ledger {
             }
             // block
             if (!blockStmt.bindings.uid.empty())
-                blockStmt.execute();
+                BulkInsertDatabaseHelper::upsertBlocks(sql, blockStmt);
             // transactions
             transactionStmt.execute();
             // assets
             assetStmt.execute();
             // operations
-            operationStmt.execute();
+            BulkInsertDatabaseHelper::upsertOperations(sql, operationStmt);
+            BalanceCheckpointDatabaseHelper::update(sql, operationStmt.bindings);
             // stellar operations
             stellarOperationStmt.execute(); 
             //stellar accounts operations
@@ -36,6 +36,7 @@
 #include <database/soci-date.h>
 #include <database/soci-option.h>
 #include <wallet/common/database/OperationDatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 
 using namespace soci;
 
@@ -196,6 +197,7 @@ namespace ledger {
                     use(accountUid), use(date);
                 sql << "DELETE FROM stellar_transactions"
                     " WHERE uid IN (:uids)", use(txToDelete);
+                BalanceCheckpointDatabaseHelper::refresh(sql, accountUid, date);
             }
         }
     }
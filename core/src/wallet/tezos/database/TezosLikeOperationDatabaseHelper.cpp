@@ -263,8 +263,6 @@ namespace ledger {
             PreparedStatement<TezosOriginatedAccountBinding> tezosOrigAccountStmt;
             PreparedStatement<TezosOriginatedOperationBinding> tezosOrigOpStmt;
 
-            BulkInsertDatabaseHelper::UPSERT_OPERATION(sql, operationStmt);
-            BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, blockStmt);
             UPSERT_TEZOS_OPERATION(sql, tezosOpStmt);
             UPSERT_TRANSACTION(sql, transactionStmt);
             UPSERT_TEZOS_ORIGINATED_ACCOUNT(sql, tezosOrigAccountStmt);
@@ -301,14 +299,14 @@ namespace ledger {
             
             // 1- Bulk insert block (dependency for operation and tezos transaction)
             if (!blockStmt.bindings.uid.empty()) {
-                blockStmt.execute();
+                BulkInsertDatabaseHelper::upsertBlocks(sql, blockStmt);
             }
 
             // 2- Bulk insert tezos_transaction 
             transactionStmt.execute();
 
             // 3- Bulk insert operations (dependency of  tezos_operations)
-            operationStmt.execute();
+            BulkInsertDatabaseHelper::upsertOperations(sql, operationStmt);
             
             // 4- Bulk insert tezos_operations
             tezosOpStmt.execute();
@@ -39,10 +39,10 @@ namespace ledger {
     namespace core {
         class TezosLikeBlockParser : public AbstractBlockParser<TezosLikeBlockchainExplorer::Block> {
         public:
-            TezosLikeBlockParser(std::string &lastKey) : _lastKey(lastKey) {};
+            TezosLikeBlockParser(LedgerApiKey &lastKey) : _lastKey(lastKey) {};
 
             bool RawNumber(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
-                if (getLastKey() == "level" || getLastKey() == "height") {
+                if (getLastKey() == LedgerApiKey::level || getLastKey() == LedgerApiKey::height) {
                     std::string number(str, length);
                     BigInt value = BigInt::fromString(number);
                     _block->height = value.toUint64();
@@ -52,20 +52,20 @@ namespace ledger {
 
             bool String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
                 std::string value = std::string(str, length);
-                if (getLastKey() == "hash" && _block->hash.empty()) {
+                if (getLastKey() == LedgerApiKey::hash && _block->hash.empty()) {
                     _block->hash = value;
-                } else if (getLastKey() == "timestamp" || getLastKey() == "time") {
+                } else if (getLastKey() == LedgerApiKey::timestamp || getLastKey() == LedgerApiKey::time) {
                     _block->time = DateUtils::fromJSON(value);
                 }
                 return true;
             }
 
         protected:
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             };
         private:
-            std::string &_lastKey;
+            LedgerApiKey &_lastKey;
         };
     }
 }
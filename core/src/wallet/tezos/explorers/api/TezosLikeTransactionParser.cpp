@@ -35,7 +35,7 @@
 #include <api/BigInt.hpp>
 #define PROXY_PARSE(method, ...)                                    \
  auto& currentObject = _hierarchy.top();                            \
- if (currentObject == "block") {                                    \
+ if (currentObject == LedgerApiKey::block) {                        \
     return _blockParser.method(__VA_ARGS__);                        \
  } else                                                             \
 
@@ -83,16 +83,16 @@ namespace ledger {
 
         bool TezosLikeTransactionParser::Bool(bool b) {
             PROXY_PARSE(Bool, b) {
-                if ((_lastKey == "spendable" || _lastKey == "is_spendable")
+                if ((_lastKey == LedgerApiKey::spendable || _lastKey == LedgerApiKey::is_spendable)
                     && _transaction->originatedAccount.hasValue()) {
                     _transaction->originatedAccount.getValue().spendable = b;
-                } else if ((_lastKey == "delegatable" || _lastKey == "is_delegatable")
+                } else if ((_lastKey == LedgerApiKey::delegatable || _lastKey == LedgerApiKey::is_delegatable)
                            && _transaction->originatedAccount.hasValue()) {
                     _transaction->originatedAccount.getValue().delegatable = b;
-                } else if (_lastKey == "failed") {
+                } else if (_lastKey == LedgerApiKey::failed) {
                     // For Tzscan
                     _transaction->status = static_cast<uint64_t>(!b);
-                } else if (_lastKey == "is_success") {
+                } else if (_lastKey == LedgerApiKey::is_success) {
                     // For Tzstats
                     _transaction->status = static_cast<uint64_t>(b);
                 }
@@ -134,18 +134,18 @@ namespace ledger {
                     }
                     return BigInt::fromString(v);
                 };
-                if ((_lastKey == "op_level" || _lastKey == "height")
+                if ((_lastKey == LedgerApiKey::op_level || _lastKey == LedgerApiKey::height)
                     && _transaction->block.hasValue()) {
                     _transaction->block.getValue().height = BigInt::fromString(number).toUint64();
-                } else if (_lastKey == "amount" || _lastKey == "volume") {
-                    _transaction->value = toValue(number, _lastKey == "volume");
-                } else if (_lastKey == "fee") {
+                } else if (_lastKey == LedgerApiKey::amount || _lastKey == LedgerApiKey::volume) {
+                    _transaction->value = toValue(number, _lastKey == LedgerApiKey::volume);
+                } else if (_lastKey == LedgerApiKey::fee) {
                     _transaction->fees = _transaction->fees + toValue(number, false);
-                } else if (_lastKey == "gas_limit") {
+                } else if (_lastKey == LedgerApiKey::gas_limit) {
                     _transaction->gas_limit = toValue(number, false);
-                } else if (_lastKey == "storage_limit") {
+                } else if (_lastKey == LedgerApiKey::storage_limit) {
                     _transaction->storage_limit = toValue(number, false);
-                } else if (_lastKey == "burned") {
+                } else if (_lastKey == LedgerApiKey::burned) {
                     _transaction->fees = _transaction->fees + toValue(number, true);
                 }
                 return true;
@@ -163,14 +163,14 @@ namespace ledger {
                     return BigInt::fromString(v);
                 };
 
-                if (_lastKey == "hash") {
+                if (_lastKey == LedgerApiKey::hash) {
                     _transaction->hash = value;
-                } else if (_lastKey == "block_hash" || _lastKey == "block") {
+                } else if (_lastKey == LedgerApiKey::block_hash || _lastKey == LedgerApiKey::block) {
                     TezosLikeBlockchainExplorer::Block block;
                     block.hash = value;
                     block.currencyName = currencies::TEZOS.name;
                     _transaction->block = block;
-                } else if (_lastKey == "timestamp" || _lastKey == "time") {
+                } else if (_lastKey == LedgerApiKey::timestamp || _lastKey == LedgerApiKey::time) {
                     auto pos = value.find('+');
                     if (pos != std::string::npos && pos > 0) {
                         value = value.substr(0, pos);
@@ -184,23 +184,23 @@ namespace ledger {
                     if (_transaction->block.hasValue()) {
                         _transaction->block.getValue().time = date;
                     }
-                } else if (_lastKey == "sender" ||
-                        (currentObject == "src" && _lastKey == "tz")) {
+                } else if (_lastKey == LedgerApiKey::sender ||
+                        (currentObject == LedgerApiKey::src && _lastKey == LedgerApiKey::tz)) {
                     _transaction->sender = value;
-                } else if (_lastKey == "receiver" || _lastKey == "delegate" ||
-                        ((currentObject == "destination" || currentObject == "delegate") && _lastKey == "tz")) {
+                } else if (_lastKey == LedgerApiKey::receiver || _lastKey == LedgerApiKey::delegate ||
+                        ((currentObject == LedgerApiKey::destination || currentObject == LedgerApiKey::delegate) && _lastKey == LedgerApiKey::tz)) {
                     _transaction->receiver = value;
-                    if (_lastKey == "receiver" &&
+                    if (_lastKey == LedgerApiKey::receiver &&
                             _transaction->type == api::TezosOperationTag::OPERATION_TAG_ORIGINATION) {
                         _transaction->originatedAccount.getValue().address = value;
                     }
-                } else if (currentObject == "tz1" && _lastKey == "tz") {
+                } else if (currentObject == LedgerApiKey::tz1 && _lastKey == LedgerApiKey::tz) {
                     _transaction->originatedAccount = TezosLikeBlockchainExplorerOriginatedAccount(value);
-                } else if (_lastKey == "gas_limit") {
+                } else if (_lastKey == LedgerApiKey::gas_limit) {
                     _transaction->gas_limit = BigInt::fromString(value);
-                } else if (_lastKey == "storage_limit") {
+                } else if (_lastKey == LedgerApiKey::storage_limit) {
                     _transaction->storage_limit = BigInt::fromString(value);
-                } else if ((_lastKey == "kind" || _lastKey == "type") && _transaction->type == api::TezosOperationTag::OPERATION_TAG_NONE) {
+                } else if ((_lastKey == LedgerApiKey::kind || _lastKey == LedgerApiKey::type) && _transaction->type == api::TezosOperationTag::OPERATION_TAG_NONE) {
                     static std::unordered_map<std::string, api::TezosOperationTag> opTags {
                             std::make_pair("reveal", api::TezosOperationTag::OPERATION_TAG_REVEAL),
                             std::make_pair("transaction", api::TezosOperationTag::OPERATION_TAG_TRANSACTION),
@@ -213,22 +213,22 @@ namespace ledger {
                         _transaction->type = api::TezosOperationTag::OPERATION_TAG_NONE;
                     }
 
-                    if (_lastKey == "type" &&
+                    if (_lastKey == LedgerApiKey::type &&
                             _transaction->type == api::TezosOperationTag::OPERATION_TAG_ORIGINATION) {
                         _transaction->originatedAccount = TezosLikeBlockchainExplorerOriginatedAccount();
                     }
 
-                } else if (_lastKey == "public_key" ||
-                        (_lastKey == "data" && _transaction->type == api::TezosOperationTag::OPERATION_TAG_REVEAL)) {
+                } else if (_lastKey == LedgerApiKey::public_key ||
+                        (_lastKey == LedgerApiKey::data && _transaction->type == api::TezosOperationTag::OPERATION_TAG_REVEAL)) {
                     _transaction->publicKey = value;
-                } else if (_lastKey == "burn_tez") {
+                } else if (_lastKey == LedgerApiKey::burn_tez) {
                     _transaction->fees = _transaction->fees + toValue(value, false);
                 }
                 return true;
             }
         }
 
-        TezosLikeTransactionParser::TezosLikeTransactionParser(std::string &lastKey) :
+        TezosLikeTransactionParser::TezosLikeTransactionParser(LedgerApiKey &lastKey) :
                 _lastKey(lastKey), _blockParser(lastKey) {
             _arrayDepth = 0;
         }
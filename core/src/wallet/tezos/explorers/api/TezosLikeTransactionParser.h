@@ -49,7 +49,7 @@ namespace ledger {
         public:
             typedef TezosLikeBlockchainExplorerTransaction Result;
 
-            TezosLikeTransactionParser(std::string &lastKey);
+            TezosLikeTransactionParser(LedgerApiKey &lastKey);
 
             void init(TezosLikeBlockchainExplorerTransaction *transaction);
 
@@ -81,14 +81,14 @@ namespace ledger {
 
             bool EndArray(rapidjson::SizeType elementCount);
 
-            std::string &getLastKey() {
+            LedgerApiKey &getLastKey() {
                 return _lastKey;
             };
         private:
-            std::string &_lastKey;
+            LedgerApiKey &_lastKey;
             TezosLikeBlockchainExplorerTransaction *_transaction;
 
-            std::stack<std::string> _hierarchy;
+            std::stack<LedgerApiKey> _hierarchy;
             uint32_t _arrayDepth;
             TezosLikeBlockParser _blockParser;
         };
@@ -43,14 +43,14 @@ namespace ledger {
         class TezosLikeTransactionsBulkParser
                 : public AbstractTransactionsBulkParser<TezosLikeBlockchainExplorer::TransactionsBulk, TezosLikeTransactionsParser> {
         public:
-            TezosLikeTransactionsBulkParser(std::string &lastKey) : _lastKey(lastKey),
+            TezosLikeTransactionsBulkParser(LedgerApiKey &lastKey) : _lastKey(lastKey),
                                                                     _transactionsParser(lastKey) {
                 _depth = 0;
             };
 
             bool StartArray() {
-                if (_depth >= 1 || getLastKey() == "" ||
-                        (_depth == 0 && getLastKey() == "ops")) {
+                if (_depth >= 1 || getLastKey() == LedgerApiKey::NONE ||
+                        (_depth == 0 && getLastKey() == LedgerApiKey::ops)) {
                     _depth += 1;
                 }
 
@@ -76,13 +76,13 @@ namespace ledger {
                 return _transactionsParser;
             }
 
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             }
 
         private:
             TezosLikeTransactionsParser _transactionsParser;
-            std::string &_lastKey;
+            LedgerApiKey &_lastKey;
         };
     }
 }
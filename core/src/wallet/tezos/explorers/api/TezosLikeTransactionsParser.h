@@ -40,7 +40,7 @@ namespace ledger {
         class TezosLikeTransactionsParser
                 : public AbstractTransactionsParser<TezosLikeBlockchainExplorerTransaction, TezosLikeTransactionParser> {
         public:
-            TezosLikeTransactionsParser(std::string &lastKey) : _transactionParser(lastKey) {
+            TezosLikeTransactionsParser(LedgerApiKey &lastKey) : _transactionParser(lastKey) {
                 _arrayDepth = 0;
                 _objectDepth = 0;
             }
@@ -46,7 +46,7 @@
 
 #define PROXY_PARSE_TEZOS_WS(method, ...)              \
  auto& currentObject = _currentObject;                  \
- if (currentObject == "transaction") {                  \
+ if (currentObject == LedgerApiKey::transaction) {     \
     return getTransactionParser().method(__VA_ARGS__);  \
  } else                                                 \
 
@@ -57,14 +57,14 @@ namespace ledger {
         public:
 
 
-            explicit TezosLikeWebSocketNotificationParser(std::string &lastKey) : _lastKey(lastKey),
+            explicit TezosLikeWebSocketNotificationParser(LedgerApiKey &lastKey) : _lastKey(lastKey),
                                                                                   _blockParser(lastKey),
                                                                                   _transactionParser(lastKey) {
 
             }
 
             bool Key(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) override {
-                _lastKey = std::string(str, length);
+                _lastKey = LedgerApiKeys::fromString(str, length);
                 return AbstractWebSocketNotificationParser<TezosLikeBlockchainExplorerTransaction,
                         TezosLikeBlockchainExplorer::Block,
                         TezosLikeTransactionParser,
@@ -75,7 +75,7 @@ namespace ledger {
                 {
                     _depth += 1;
                     auto lastKey = getLastKey();
-                    if (lastKey == "transaction") {
+                    if (lastKey == LedgerApiKey::transaction) {
                         _currentObject = lastKey;
                         getTransactionParser().init(&_result->transaction);
                     }
@@ -89,7 +89,7 @@ namespace ledger {
                            bool copy) {
                 PROXY_PARSE_TEZOS_WS(String, str, length, copy) {
                     auto value = std::string(str, length);
-                    if (getLastKey() == "block_height") {
+                    if (getLastKey() == LedgerApiKey::block_height) {
                         BigInt bigIntValue = BigInt::fromString(value);
                         _result->block.height = bigIntValue.toUint64();
                     }
@@ -101,12 +101,12 @@ namespace ledger {
             String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
 
                 auto value = std::string(str, length);
-                if (getLastKey() == "type") {
+                if (getLastKey() == LedgerApiKey::type) {
                     _result->type = value;
                 }
 
                 PROXY_PARSE_TEZOS_WS(String, str, length, copy) {
-                    if (getLastKey() == "block_hash") {
+                    if (getLastKey() == LedgerApiKey::block_hash) {
                         _result->block.hash = value;
                     }
                     return true;
@@ -116,7 +116,7 @@ namespace ledger {
             bool EndObject(rapidjson::SizeType memberCount) {
                 _depth -= 1;
                 if (_depth == 1)
-                    _currentObject = "";
+                    _currentObject = LedgerApiKey::NONE;
                 PROXY_PARSE_WS(EndObject, memberCount) {
                     return true;
                 }
@@ -132,12 +132,12 @@ namespace ledger {
                 return _blockParser;
             };
 
-            std::string &getLastKey() override {
+            LedgerApiKey &getLastKey() override {
                 return _lastKey;
             };
 
         private:
-            std::string &_lastKey;
+            LedgerApiKey &_lastKey;
             TezosLikeBlockParser _blockParser;
             TezosLikeTransactionParser _transactionParser;
         };
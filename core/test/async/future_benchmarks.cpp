@@ -0,0 +1,161 @@
+/*
+ *
+ * future_benchmarks
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <src/async/Future.hpp>
+#include <src/async/Promise.hpp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#undef foreach
+
+using namespace ledger::core;
+
+namespace {
+    const int CHAIN_LENGTH = 1000;
+    const int ITERATIONS = 200;
+
+    // Completion state as implemented before the lock-free Deffered: a recursive mutex and a queue of callbacks,
+    // each one wrapped in a runnable handed to its context.
+    template <typename T>
+    class LockedDeffered {
+    public:
+        using Callback = std::function<void (const Try<T>&)>;
+
+        void setResult(const Try<T>& result) {
+            std::lock_guard<std::recursive_mutex> lock(_lock);
+            _value = result;
+            trigger();
+        }
+
+        void addCallback(Callback callback, std::shared_ptr<api::ExecutionContext> context) {
+            std::lock_guard<std::recursive_mutex> lock(_lock);
+            _callbacks.push(std::make_tuple(callback, context));
+            trigger();
+        }
+
+        Option<Try<T>> getValue() const {
+            std::lock_guard<std::recursive_mutex> lock(_lock);
+            return _value;
+        }
+
+    private:
+        void trigger() {
+            while (_value.hasValue() && !_callbacks.empty()) {
+                auto callback = _callbacks.front();
+                Callback cb = std::get<0>(callback);
+                auto value = _value.getValue();
+                std::get<1>(callback)->execute(make_runnable([cb, value] () {
+                    cb(value);
+                }));
+                _callbacks.pop();
+            }
+        }
+
+        mutable std::recursive_mutex _lock;
+        Option<Try<T>> _value;
+        std::queue<std::tuple<Callback, std::shared_ptr<api::ExecutionContext>>> _callbacks;
+    };
+
+    std::shared_ptr<LockedDeffered<int>> lockedIncrement(const std::shared_ptr<LockedDeffered<int>>& source) {
+        auto next = std::make_shared<LockedDeffered<int>>();
+        source->addCallback([next] (const Try<int>& result) {
+            next->setResult(Try<int>(result.getValue() + 1));
+        }, ImmediateExecutionContext::INSTANCE);
+        return next;
+    }
+
+    long long elapsedMicroseconds(const std::chrono::steady_clock::time_point& start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Chains registered before the completion, then completed at once
+    long long timeLockedChains() {
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < ITERATIONS; i++) {
+            auto head = std::make_shared<LockedDeffered<int>>();
+            auto tail = head;
+            for (auto j = 0; j < CHAIN_LENGTH; j++) {
+                tail = lockedIncrement(tail);
+            }
+            head->setResult(Try<int>(0));
+            EXPECT_EQ(tail->getValue().getValue().getValue(), CHAIN_LENGTH);
+        }
+        return elapsedMicroseconds(start);
+    }
+
+    long long timeFutureChains() {
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < ITERATIONS; i++) {
+            Promise<int> head;
+            auto tail = head.getFuture();
+            for (auto j = 0; j < CHAIN_LENGTH; j++) {
+                tail = tail.map<int>(ImmediateExecutionContext::INSTANCE, [] (const int& value) {
+                    return value + 1;
+                });
+            }
+            head.success(0);
+            EXPECT_EQ(tail.getValue().getValue().getValue(), CHAIN_LENGTH);
+        }
+        return elapsedMicroseconds(start);
+    }
+}
+
+TEST(FutureBenchmarks, ImmediateChainsAgainstLockedDeffered) {
+    auto locked = timeLockedChains();
+    auto lockFree = timeFutureChains();
+    std::cout << "[locked] " << locked << "us for " << ITERATIONS << " chains of " << CHAIN_LENGTH << " maps" << std::endl;
+    std::cout << "[lock-free] " << lockFree << "us for " << ITERATIONS << " chains of " << CHAIN_LENGTH << " maps" << std::endl;
+}
+
+TEST(FutureBenchmarks, CallbacksRacingWithCompletion) {
+    // Every callback runs exactly once, whether it is registered before or after the completion
+    for (auto i = 0; i < ITERATIONS; i++) {
+        Promise<int> promise;
+        std::atomic<int> calls(0);
+        std::thread registering([&] () {
+            for (auto j = 0; j < CHAIN_LENGTH; j++) {
+                promise.getFuture().onComplete(ImmediateExecutionContext::INSTANCE, [&calls] (const Try<int>& result) {
+                    EXPECT_EQ(result.getValue(), 42);
+                    calls += 1;
+                });
+            }
+        });
+        promise.success(42);
+        registering.join();
+        EXPECT_EQ(calls, CHAIN_LENGTH);
+        EXPECT_THROW(promise.success(0), Exception);
+    }
+}
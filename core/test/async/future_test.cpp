@@ -32,6 +32,8 @@
 #include <gtest/gtest.h>
 #include <src/async/Future.hpp>
 #include <src/async/FutureUtils.hpp>
+#include <src/async/algorithm.h>
+#include <deque>
 #include <iostream>
 #include <UvThreadDispatcher.hpp>
 
@@ -494,4 +496,70 @@ TEST(Future, ExecuteAllThreadPoolFail) {
     res.callback(queue, std::make_shared<Callback>(dispatcher));
 
     dispatcher->waitUntilStopped();
-}
\ No newline at end of file
+}
+
+TEST(Future, TraverseKeepsOrderAndBoundsConcurrency) {
+    std::vector<int> items = {0, 1, 2, 3, 4, 5};
+    // A deque keeps promises in place while completions start new items
+    std::deque<Promise<int>> started;
+    auto result = async::traverse<int, int>(ImmediateExecutionContext::INSTANCE, items, 2, [&] (const int& item) {
+        started.emplace_back();
+        return started.back().getFuture();
+    });
+    EXPECT_EQ(started.size(), 2);
+    started[1].success(10);
+    EXPECT_EQ(started.size(), 3);
+    started[0].success(0);
+    EXPECT_EQ(started.size(), 4);
+    started[3].success(30);
+    EXPECT_EQ(started.size(), 5);
+    started[2].success(20);
+    EXPECT_EQ(started.size(), 6);
+    started[5].success(50);
+    EXPECT_FALSE(result.isCompleted());
+    started[4].success(40);
+    ASSERT_TRUE(result.isCompleted());
+    EXPECT_EQ(result.getValue().getValue().getValue(), std::vector<int>({0, 10, 20, 30, 40, 50}));
+}
+
+TEST(Future, TraverseStopsOnFirstFailure) {
+    std::vector<int> items = {0, 1, 2, 3, 4, 5};
+    std::deque<Promise<int>> started;
+    auto result = async::traverse<int, int>(ImmediateExecutionContext::INSTANCE, items, 2, [&] (const int& item) {
+        started.emplace_back();
+        return started.back().getFuture();
+    });
+    started[0].failure(Exception(api::ErrorCode::HTTP_ERROR, "Unreachable"));
+    ASSERT_TRUE(result.isCompleted());
+    EXPECT_EQ(result.getValue().getValue().getFailure().getErrorCode(), api::ErrorCode::HTTP_ERROR);
+    started[1].success(1);
+    EXPECT_EQ(started.size(), 2);
+}
+
+TEST(Future, MapAsyncNCompletesInCompletionOrder) {
+    std::vector<int> items = {0, 1, 2};
+    std::deque<Promise<int>> started;
+    auto result = async::mapAsyncN<int, int>(ImmediateExecutionContext::INSTANCE, items, 3, [&] (const int& item) {
+        started.emplace_back();
+        return started.back().getFuture();
+    });
+    started[2].success(2);
+    started[0].success(0);
+    started[1].success(1);
+    ASSERT_TRUE(result.isCompleted());
+    EXPECT_EQ(result.getValue().getValue().getValue(), std::vector<int>({2, 0, 1}));
+}
+
+TEST(Future, TraverseOfCompletedFuturesDoesNotRecurse) {
+    std::vector<int> items(100000);
+    for (std::size_t index = 0; index < items.size(); index++) {
+        items[index] = static_cast<int>(index);
+    }
+    auto result = async::traverse<int, int>(ImmediateExecutionContext::INSTANCE, items, 4, [] (const int& item) {
+        return Future<int>::successful(item * 2);
+    });
+    ASSERT_TRUE(result.isCompleted());
+    const auto& values = result.getValue().getValue().getValue();
+    ASSERT_EQ(values.size(), items.size());
+    EXPECT_EQ(values.back(), 199998);
+}
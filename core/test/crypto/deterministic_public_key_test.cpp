@@ -73,3 +73,24 @@ TEST(Derivation, UncompressedPublicKey) {
     auto k = createKeyFromXpub(XPUB_2);
     EXPECT_EQ(k.derive(0).getUncompressedPublicKey(), hex::toByteArray("04a8c9ce67e978e3d83a6366f15f2304ce21851ae030d8430b178b77280c4ec2be21bb6c082fb47db9d8982d40f6594efa5487f199e07635bcd041b7b7cf9bcad7"));
 }
+
+TEST(Derivation, DeriveRange) {
+    auto k = createKeyFromXpub(XPUB_1);
+    auto keys = k.deriveRange(0, 5);
+    EXPECT_EQ(keys.size(), 6 * DeterministicPublicKey::COMPRESSED_KEY_SIZE);
+    EXPECT_EQ(std::vector<uint8_t>(keys.begin(), keys.begin() + 33), hex::toByteArray("034526331989014305eeaaced584dcdb395f8498db0d621845869ce00cedaedf74"));
+    EXPECT_EQ(std::vector<uint8_t>(keys.begin() + 5 * 33, keys.end()), hex::toByteArray("03e185d94291ae80671c59ac522347a500d673b1302edd0c4eb6634cc850003034"));
+}
+
+TEST(Derivation, DeriveRangeMatchesDerive) {
+    auto k = createKeyFromXpub(XPUB_1);
+    // Large enough to be split in several chunks
+    const uint32_t from = 10, to = 209;
+    auto keys = k.deriveRange(from, to);
+    ASSERT_EQ(keys.size(), (to - from + 1) * DeterministicPublicKey::COMPRESSED_KEY_SIZE);
+    for (uint32_t index = from; index <= to; index++) {
+        auto offset = (index - from) * DeterministicPublicKey::COMPRESSED_KEY_SIZE;
+        EXPECT_EQ(std::vector<uint8_t>(keys.begin() + offset, keys.begin() + offset + DeterministicPublicKey::COMPRESSED_KEY_SIZE),
+                  k.derive(index).getPublicKey());
+    }
+}
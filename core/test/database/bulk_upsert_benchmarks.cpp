@@ -0,0 +1,166 @@
+/*
+ *
+ * bulk_upsert_benchmarks
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <UvThreadDispatcher.hpp>
+#include <NativePathResolver.hpp>
+#include <src/database/DatabaseSessionPool.hpp>
+#include <src/database/PostgreSQLBulkUpsert.hpp>
+#include <src/wallet/common/database/BulkInsertDatabaseHelper.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace ledger::core;
+
+namespace {
+    std::vector<uint8_t> bytes(const std::string& s) {
+        return std::vector<uint8_t>(s.begin(), s.end());
+    }
+}
+
+TEST(PostgreSQLBulkUpsert, EncodesBinaryCopyStream) {
+    BinaryCopyWriter writer;
+    writer.row(3).text(std::string("ab")).null().bigint(-2);
+    const auto& data = writer.finish();
+
+    std::vector<uint8_t> expected = {'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xFF, '\r', '\n', 0x00};
+    // Flags and header extension
+    expected.insert(expected.end(), {0, 0, 0, 0, 0, 0, 0, 0});
+    // Field count, text field, NULL field and bigint field
+    expected.insert(expected.end(), {0, 3});
+    expected.insert(expected.end(), {0, 0, 0, 2, 'a', 'b'});
+    expected.insert(expected.end(), {0xFF, 0xFF, 0xFF, 0xFF});
+    expected.insert(expected.end(), {0, 0, 0, 8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE});
+    // Trailer
+    expected.insert(expected.end(), {0xFF, 0xFF});
+    EXPECT_EQ(data, expected);
+    EXPECT_EQ(writer.getRowCount(), 1);
+    EXPECT_THROW(writer.row(1), Exception);
+
+    writer.clear();
+    writer.row(1).text(Option<std::string>("x"));
+    auto restarted = writer.finish();
+    EXPECT_EQ(std::vector<uint8_t>(restarted.end() - 9, restarted.end()),
+              std::vector<uint8_t>({0, 1, 0, 0, 0, 1, 'x', 0xFF, 0xFF}));
+}
+
+TEST(PostgreSQLBulkUpsert, MergeKeepsUpsertSemantics) {
+    // Updates merge the last staged row of each key, like consecutive upserts
+    EXPECT_NE(BulkInsertDatabaseHelper::COPY_OPERATION.getMergeQuery().find(
+            "SELECT DISTINCT ON (uid) * FROM staging_operations ORDER BY uid, seq DESC"), std::string::npos);
+    EXPECT_NE(BulkInsertDatabaseHelper::COPY_OPERATION.getMergeQuery().find(
+            "ON CONFLICT(uid) DO UPDATE SET block_uid = EXCLUDED.block_uid, trust = EXCLUDED.trust,"
+            " amount = EXCLUDED.amount, amount_high = EXCLUDED.amount_high, amount_low = EXCLUDED.amount_low"),
+              std::string::npos);
+    EXPECT_NE(BulkInsertDatabaseHelper::COPY_BLOCK.getMergeQuery().find("ORDER BY seq ON CONFLICT DO NOTHING"),
+              std::string::npos);
+    EXPECT_THROW(PostgreSQLBulkUpsert("blocks", {{"uid", PostgreSQLBulkUpsert::ColumnType::TEXT}}, {}, {"uid"}), Exception);
+}
+
+#ifdef PG_SUPPORT
+namespace {
+    const int BENCHMARK_ROWS = 20000;
+    const std::string BENCHMARK_CURRENCY = "copy_benchmark";
+
+    BlockBinding benchmarkBlocks(const std::string& suffix) {
+        BlockBinding blocks;
+        for (auto i = 0; i < BENCHMARK_ROWS; i++) {
+            Block block;
+            block.hash = "hash_" + std::to_string(i) + suffix;
+            block.height = i;
+            block.time = std::chrono::system_clock::now();
+            block.currencyName = BENCHMARK_CURRENCY;
+            blocks.update(block);
+        }
+        return blocks;
+    }
+
+    template <typename Insert>
+    long long timeInsert(soci::session& sql, Insert insert) {
+        auto start = std::chrono::steady_clock::now();
+        soci::transaction tr(sql);
+        insert();
+        tr.commit();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    int countBenchmarkBlocks(soci::session& sql) {
+        int count = 0;
+        sql << "SELECT COUNT(*) FROM blocks WHERE currency_name = :currency", soci::use(BENCHMARK_CURRENCY), soci::into(count);
+        return count;
+    }
+}
+
+TEST(PostgreSQLBulkUpsert, CopyThroughputBenchmark) {
+    auto dispatcher = std::make_shared<uv::UvThreadDispatcher>();
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getPostgreSQLBackend(1, 1));
+    DatabaseSessionPool::getSessionPool(dispatcher->getSerialExecutionContext("worker"), backend, resolver, nullptr,
+                                        "postgres://localhost:5432/test_db")
+    .onComplete(dispatcher->getMainExecutionContext(), [&] (const TryPtr<DatabaseSessionPool>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        if (result.isFailure()) {
+            std::cerr << result.getFailure().getMessage() << std::endl;
+            dispatcher->stop();
+            return;
+        }
+        soci::session sql(result.getValue()->getPool());
+        sql << "DELETE FROM blocks WHERE currency_name = :currency", soci::use(BENCHMARK_CURRENCY);
+
+        PreparedStatement<BlockBinding> vectorStmt;
+        vectorStmt.bindings = benchmarkBlocks("_vector");
+        auto vectorTime = timeInsert(sql, [&] () {
+            BulkInsertDatabaseHelper::UPSERT_BLOCK(sql, vectorStmt);
+            vectorStmt.execute();
+        });
+
+        PreparedStatement<BlockBinding> copyStmt;
+        copyStmt.bindings = benchmarkBlocks("_copy");
+        auto copyTime = timeInsert(sql, [&] () {
+            BulkInsertDatabaseHelper::upsertBlocks(sql, copyStmt);
+        });
+        std::cout << "[vector binds] " << BENCHMARK_ROWS << " rows in " << vectorTime << "us" << std::endl;
+        std::cout << "[binary COPY] " << BENCHMARK_ROWS << " rows in " << copyTime << "us" << std::endl;
+        EXPECT_EQ(countBenchmarkBlocks(sql), 2 * BENCHMARK_ROWS);
+
+        // Staging again the same rows must not insert duplicates
+        timeInsert(sql, [&] () {
+            BulkInsertDatabaseHelper::upsertBlocks(sql, copyStmt);
+        });
+        EXPECT_EQ(countBenchmarkBlocks(sql), 2 * BENCHMARK_ROWS);
+
+        sql << "DELETE FROM blocks WHERE currency_name = :currency", soci::use(BENCHMARK_CURRENCY);
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+    resolver->clean();
+}
+#endif
@@ -32,6 +32,7 @@
 #include <gtest/gtest.h>
 #include <UvThreadDispatcher.hpp>
 #include <src/database/DatabaseSessionPool.hpp>
+#include <src/database/StatementCache.hpp>
 #include <NativePathResolver.hpp>
 #include <unordered_set>
 #include <src/wallet/pool/WalletPool.hpp>
@@ -133,3 +134,177 @@ TEST(DatabaseSessionPool, InitializeCurrencies) {
 
     resolver->clean();
 }
+
+TEST(DatabaseSessionPool, ReadWhileWritingInWalMode) {
+    auto dispatcher = std::make_shared<uv::UvThreadDispatcher>();
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getSqlite3WalBackend(4));
+    EXPECT_EQ(backend->getConnectionPoolSize(), 1);
+    EXPECT_EQ(backend->getReadonlyConnectionPoolSize(), 4);
+    DatabaseSessionPool::getSessionPool(dispatcher->getSerialExecutionContext("worker"), backend, resolver, nullptr, "test")
+    .onComplete(dispatcher->getMainExecutionContext(), [&] (const TryPtr<DatabaseSessionPool>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        if (result.isFailure()) {
+            std::cerr << result.getFailure().getMessage() << std::endl;
+        } else {
+            soci::session sql(result.getValue()->getPool());
+            std::string journalMode;
+            sql << "PRAGMA journal_mode", soci::into(journalMode);
+            EXPECT_EQ(journalMode, "wal");
+
+            soci::transaction tr(sql);
+            sql << "INSERT INTO pools VALUES('wal_pool', '2026-10-16T00:00:00Z')";
+
+            // Every readonly connection reads the last committed snapshot while the writer holds its transaction
+            std::vector<std::unique_ptr<soci::session>> readers;
+            for (auto i = 0; i < 4; i++) {
+                readers.emplace_back(new soci::session(result.getValue()->getReadonlyPool()));
+                int count = -1;
+                *readers.back() << "SELECT COUNT(*) FROM pools WHERE name = 'wal_pool'", soci::into(count);
+                EXPECT_EQ(count, 0);
+            }
+            EXPECT_THROW(*readers.front() << "DELETE FROM pools", soci::soci_error);
+            tr.commit();
+
+            int count = 0;
+            *readers.back() << "SELECT COUNT(*) FROM pools WHERE name = 'wal_pool'", soci::into(count);
+            EXPECT_EQ(count, 1);
+        }
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+    resolver->clean();
+}
+
+namespace {
+    struct PoolCountBinding {
+        std::string name;
+        int32_t count;
+    };
+
+    const auto COUNT_POOLS = db::stmt<PoolCountBinding>("SELECT COUNT(*) FROM pools WHERE name = :name", [] (auto& s, auto& b) {
+        s, soci::use(b.name), soci::into(b.count);
+    });
+    const auto COUNT_OTHER_POOLS = db::stmt<PoolCountBinding>("SELECT COUNT(*) FROM pools WHERE name <> :name", [] (auto& s, auto& b) {
+        s, soci::use(b.name), soci::into(b.count);
+    });
+}
+
+TEST(DatabaseSessionPool, StatementCache) {
+    auto dispatcher = std::make_shared<uv::UvThreadDispatcher>();
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getSqlite3Backend());
+    DatabaseSessionPool::getSessionPool(dispatcher->getSerialExecutionContext("worker"), backend, resolver, nullptr, "test")
+    .onComplete(dispatcher->getMainExecutionContext(), [&] (const TryPtr<DatabaseSessionPool>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        if (result.isFailure()) {
+            std::cerr << result.getFailure().getMessage() << std::endl;
+        } else {
+            soci::session sql(result.getValue()->getPool());
+            auto cache = StatementCache::of(sql);
+            ASSERT_TRUE(cache != nullptr);
+
+            auto first = db::cached(sql, COUNT_POOLS);
+            first->bindings.name = "cached_pool";
+            first->execute();
+            EXPECT_EQ(first->bindings.count, 0);
+
+            sql << "INSERT INTO pools VALUES('cached_pool', '2026-10-16T00:00:00Z')";
+            auto second = db::cached(sql, COUNT_POOLS);
+            EXPECT_EQ(first.get(), second.get());
+            second->execute();
+            EXPECT_EQ(second->bindings.count, 1);
+            EXPECT_EQ(cache->getMisses(), 1);
+            EXPECT_EQ(cache->getHits(), 1);
+
+            // Least recently used statements are evicted
+            StatementCache small(1);
+            auto evicted = small.get(sql, COUNT_POOLS);
+            small.get(sql, COUNT_OTHER_POOLS);
+            EXPECT_EQ(small.size(), 1);
+            EXPECT_NE(small.get(sql, COUNT_POOLS).get(), evicted.get());
+            EXPECT_EQ(small.getMisses(), 3);
+        }
+        {
+            // A statement cached through one lease is executed by the next lease of the same connection, after the
+            // first session is gone
+            auto& pool = result.getValue()->getPool();
+            std::shared_ptr<StatementCache> cache;
+            std::size_t misses = 0;
+            {
+                soci::session lease(pool);
+                cache = StatementCache::of(lease);
+                ASSERT_TRUE(cache != nullptr);
+                misses = cache->getMisses();
+                db::cached(lease, COUNT_OTHER_POOLS)->bindings.name = "cached_pool";
+            }
+            soci::session lease(pool);
+            ASSERT_EQ(StatementCache::of(lease), cache);
+            auto hits = cache->getHits();
+            auto statement = db::cached(lease, COUNT_OTHER_POOLS);
+            EXPECT_EQ(cache->getHits(), hits + 1);
+            EXPECT_EQ(cache->getMisses(), misses + 1);
+            statement->bindings.name = "cached_pool";
+            statement->execute();
+            EXPECT_EQ(statement->bindings.count, 0);
+            lease << "INSERT INTO pools VALUES('other_pool', '2026-10-16T00:00:00Z')";
+            statement->execute();
+            EXPECT_EQ(statement->bindings.count, 1);
+        }
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+    resolver->clean();
+}
+
+TEST(DatabaseSessionPool, GroupCommitWriteQueue) {
+    auto dispatcher = std::make_shared<uv::UvThreadDispatcher>();
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getSqlite3Backend());
+    std::shared_ptr<DatabaseSessionPool> pool;
+    std::shared_ptr<DatabaseWriteQueue> queue;
+    auto completed = 0;
+    DatabaseSessionPool::getSessionPool(dispatcher->getSerialExecutionContext("worker"), backend, resolver, nullptr, "test")
+    .onComplete(dispatcher->getMainExecutionContext(), [&] (const TryPtr<DatabaseSessionPool>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        if (result.isFailure()) {
+            std::cerr << result.getFailure().getMessage() << std::endl;
+            dispatcher->stop();
+            return;
+        }
+        pool = result.getValue();
+        // A wide window so that every job joins the same transaction
+        queue = std::make_shared<DatabaseWriteQueue>(pool->getPool(), dispatcher->getSerialExecutionContext("write_queue"),
+                                                     std::chrono::milliseconds(500));
+        auto onJobComplete = [&] (bool expectSuccess) {
+            return [&, expectSuccess] (const Try<Unit>& r) {
+                EXPECT_EQ(r.isSuccess(), expectSuccess);
+                if (++completed == 3) {
+                    dispatcher->stop();
+                }
+            };
+        };
+        queue->submit([] (soci::session& sql) {
+            sql << "INSERT INTO pools VALUES('queued_pool_1', '2026-10-16T00:00:00Z')";
+        }).onComplete(dispatcher->getMainExecutionContext(), onJobComplete(true));
+        // The failing job is rolled back alone
+        queue->submit([] (soci::session& sql) {
+            sql << "INSERT INTO pools VALUES('queued_pool_failure', '2026-10-16T00:00:00Z')";
+            sql << "INSERT INTO pools VALUES('queued_pool_1', '2026-10-16T00:00:00Z')";
+        }).onComplete(dispatcher->getMainExecutionContext(), onJobComplete(false));
+        queue->submit([] (soci::session& sql) {
+            sql << "INSERT INTO pools VALUES('queued_pool_2', '2026-10-16T00:00:00Z')";
+        }).onComplete(dispatcher->getMainExecutionContext(), onJobComplete(true));
+    });
+    dispatcher->waitUntilStopped();
+
+    ASSERT_TRUE(queue != nullptr);
+    EXPECT_EQ(queue->getCommitCount(), 1);
+    EXPECT_EQ(queue->getExecutedJobCount(), 3);
+    soci::session sql(pool->getPool());
+    int count = 0;
+    sql << "SELECT COUNT(*) FROM pools WHERE name LIKE 'queued_pool%'", soci::into(count);
+    EXPECT_EQ(count, 2);
+    queue->stop();
+    resolver->clean();
+}
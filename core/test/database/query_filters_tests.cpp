@@ -32,6 +32,9 @@
 #include <gtest/gtest.h>
 #include <database/query/QueryFilter.h>
 #include <api/TrustLevel.hpp>
+#include <wallet/common/Amount.h>
+#include <wallet/common/database/AmountLimbs.hpp>
+#include <wallet/currencies.hpp>
 
 using namespace ledger::core;
 
@@ -51,4 +54,31 @@ TEST(QueryFilters, DoubleConditionWithCompoundFilter) {
             ->op_or_not(api::QueryFilter::trustEq(api::TrustLevel::TRUSTED)->op_and(api::QueryFilter::containsSender("toto")));
     EXPECT_EQ(std::dynamic_pointer_cast<QueryFilter>(filter)->getHead()->toString(),
               "o.account_uid = :account_uid AND b.height > :height OR NOT (o.trust LIKE :trust AND o.senders LIKE :senders)");
-}
\ No newline at end of file
+}
+
+TEST(QueryFilters, AmountRangeFilter) {
+    auto amount = std::make_shared<Amount>(currencies::BITCOIN, 0, BigInt(static_cast<int64_t>(5000000000LL)));
+    auto filter = api::QueryFilter::amountGt(amount)->op_and(api::QueryFilter::feesLte(amount));
+    EXPECT_EQ(std::dynamic_pointer_cast<QueryFilter>(filter)->getHead()->toString(),
+              "(o.amount_high > 1 OR (o.amount_high = 1 AND o.amount_low > 705032704) OR o.amount_high IS NULL)"
+              " AND (o.fees_high < 1 OR (o.fees_high = 1 AND o.fees_low <= 705032704))");
+}
+
+TEST(QueryFilters, AmountLimbs) {
+    auto limbs = AmountLimbs::fromBigInt(BigInt::fromHex("12a05f200"));
+    EXPECT_EQ(limbs.high.getValue(), 1);
+    EXPECT_EQ(limbs.low.getValue(), 705032704);
+    EXPECT_EQ(AmountLimbs::toBigInt(1, 705032704).toString(), "5000000000");
+
+    // 10^27, a billion ether in wei
+    auto wide = BigInt::fromDecimal("1000000000000000000000000000");
+    limbs = AmountLimbs::fromBigInt(wide);
+    EXPECT_FALSE(limbs.isEmpty());
+    EXPECT_EQ(AmountLimbs::toBigInt(limbs.high.getValue(), limbs.low.getValue()), wide);
+
+    EXPECT_TRUE(AmountLimbs::fromBigInt(BigInt::fromHex("800000000000000000000000")).isEmpty());
+    EXPECT_TRUE(AmountLimbs::fromBigInt(BigInt(-1)).isEmpty());
+
+    // Sums of limbs may be negative
+    EXPECT_EQ(AmountLimbs::toBigInt(-2, 705032704).toString(), "-7884901888");
+}
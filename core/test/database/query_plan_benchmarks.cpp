@@ -0,0 +1,156 @@
+/*
+ *
+ * query_plan_benchmarks
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <UvThreadDispatcher.hpp>
+#include <NativePathResolver.hpp>
+#include <src/database/DatabaseSessionPool.hpp>
+#include <src/database/migrations.hpp>
+#include <chrono>
+#include <iostream>
+
+using namespace ledger::core;
+
+namespace {
+    struct HotQuery {
+        std::string name;
+        std::string query;
+    };
+
+    const std::vector<HotQuery> HOT_QUERIES = {
+        {"UTXO anti-join",
+         "SELECT o.idx FROM bitcoin_outputs AS o"
+         " LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid AND i.previous_output_idx = o.idx"
+         " WHERE i.previous_tx_uid IS NULL AND o.account_uid = 'account'"},
+        {"Spending input", "SELECT uid FROM bitcoin_inputs WHERE previous_tx_uid = 'tx_42' AND previous_output_idx = 1"},
+        {"Account operations", "SELECT uid FROM operations WHERE account_uid = 'account' ORDER BY date"},
+        {"Block operations", "SELECT uid FROM operations WHERE block_uid = 'block'"},
+        {"Blocks since height", "SELECT uid FROM blocks WHERE currency_name = 'bitcoin' AND height >= 4200"},
+        {"Bitcoin operation by transaction", "SELECT uid FROM bitcoin_operations WHERE transaction_uid = 'tx_42'"},
+        {"Ethereum operation by transaction", "SELECT uid FROM ethereum_operations WHERE transaction_uid = 'tx_42'"},
+        {"Cosmos operation by message", "SELECT uid FROM cosmos_operations WHERE message_uid = 'msg_42'"}
+    };
+
+    const int SEED_ROWS = 20000;
+    const int QUERY_ITERATIONS = 200;
+
+    std::vector<std::string> explain(soci::session& sql, const std::string& query) {
+        std::vector<std::string> plan;
+        soci::rowset<soci::row> rows = (sql.prepare << "EXPLAIN QUERY PLAN " << query);
+        for (auto& row : rows) {
+            plan.push_back(row.get<std::string>(3));
+        }
+        return plan;
+    }
+
+    // A plan step scanning or searching a table without one of its indexes
+    bool isFullScan(const std::string& step) {
+        auto isTableAccess = step.find("SCAN") == 0 || step.find("SEARCH") == 0;
+        return isTableAccess && (step.find("INDEX") == std::string::npos || step.find("AUTOMATIC") != std::string::npos);
+    }
+
+    long long timeQuery(soci::session& sql, const std::string& query) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < QUERY_ITERATIONS; i++) {
+            soci::rowset<soci::row> rows = (sql.prepare << query);
+            for (auto& row : rows) {
+                (void) row;
+            }
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void seed(soci::session& sql) {
+        std::vector<std::string> uids, hashes, currencies, times, txUids;
+        std::vector<long long> heights;
+        std::vector<int> indexes;
+        for (auto i = 0; i < SEED_ROWS; i++) {
+            uids.push_back("uid_" + std::to_string(i));
+            hashes.push_back("hash_" + std::to_string(i));
+            currencies.push_back(i % 2 == 0 ? "bitcoin" : "ethereum");
+            times.push_back("2020-01-01T00:00:00Z");
+            heights.push_back(i);
+            txUids.push_back("tx_" + std::to_string(i));
+            indexes.push_back(i % 4);
+        }
+        soci::transaction tr(sql);
+        sql << "INSERT INTO blocks VALUES(:uid, :hash, :height, :time, :currency_name)",
+                soci::use(uids), soci::use(hashes), soci::use(heights), soci::use(times), soci::use(currencies);
+        sql << "INSERT INTO bitcoin_inputs(uid, previous_output_idx, previous_tx_hash, previous_tx_uid, sequence)"
+               " VALUES(:uid, :idx, :hash, :tx_uid, 0)",
+                soci::use(uids), soci::use(indexes), soci::use(hashes), soci::use(txUids);
+        tr.commit();
+    }
+
+    void report(soci::session& sql, const std::string& label, std::vector<std::vector<std::string>>& plans) {
+        for (const auto& query : HOT_QUERIES) {
+            auto plan = explain(sql, query.query);
+            std::cout << "[" << label << "] " << query.name << " (" << timeQuery(sql, query.query) << "us for "
+                      << QUERY_ITERATIONS << " runs)" << std::endl;
+            for (const auto& step : plan) {
+                std::cout << "    " << step << std::endl;
+            }
+            plans.push_back(plan);
+        }
+    }
+}
+
+TEST(DatabaseQueryPlans, SecondaryIndexesAvoidFullScans) {
+    auto dispatcher = std::make_shared<uv::UvThreadDispatcher>();
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getSqlite3Backend());
+    DatabaseSessionPool::getSessionPool(dispatcher->getSerialExecutionContext("worker"), backend, resolver, nullptr, "query_plans")
+    .onComplete(dispatcher->getMainExecutionContext(), [&] (const TryPtr<DatabaseSessionPool>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        if (result.isFailure()) {
+            std::cerr << result.getFailure().getMessage() << std::endl;
+            dispatcher->stop();
+            return;
+        }
+        soci::session sql(result.getValue()->getPool());
+        seed(sql);
+
+        std::vector<std::vector<std::string>> before, after;
+        rollback<27>(sql, api::DatabaseBackendType::SQLITE3);
+        report(sql, "before", before);
+        migrate<27>(sql, api::DatabaseBackendType::SQLITE3);
+        report(sql, "after", after);
+
+        for (size_t i = 0; i < after.size(); i++) {
+            for (const auto& step : after[i]) {
+                EXPECT_FALSE(isFullScan(step)) << HOT_QUERIES[i].name << ": " << step;
+            }
+        }
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+    resolver->clean();
+}
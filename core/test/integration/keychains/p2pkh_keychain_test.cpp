@@ -241,3 +241,16 @@ TEST_F(BitcoinKeychains, CheckIfEmpty) {
         EXPECT_FALSE(keychain.isEmpty());
     });
 }
+
+TEST_F(BitcoinKeychains, ContainsObservableAddresses) {
+    testKeychain(BTC_DATA, [] (P2PKHBitcoinLikeKeychain& keychain) {
+        auto addresses = keychain.getAllObservableAddresses(0, 40);
+        for (auto& address : addresses) {
+            EXPECT_TRUE(keychain.contains(address->toBase58()));
+            EXPECT_TRUE(keychain.getAddressDerivationPath(address->toBase58()).nonEmpty());
+        }
+        EXPECT_FALSE(keychain.contains("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa"));
+        EXPECT_TRUE(keychain.getAddressDerivationPath("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa").isEmpty());
+        EXPECT_TRUE(keychain.getPublicKey("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa").isEmpty());
+    });
+}
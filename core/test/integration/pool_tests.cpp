@@ -35,6 +35,8 @@
 #include <unordered_set>
 #include <src/wallet/pool/WalletPool.hpp>
 #include <wallet/common/CurrencyBuilder.hpp>
+#include <api/Configuration.hpp>
+#include <net/HttpRequestScheduler.hpp>
 
 class WalletPoolTest : public BaseFixture {
 
@@ -69,6 +71,34 @@ TEST_F(WalletPoolTest, InitializeCurrencies) {
     }
 }
 
+TEST_F(WalletPoolTest, AppliesHttpSchedulerConfiguration) {
+    auto configuration = api::DynamicObject::newInstance();
+    configuration->putInt(api::Configuration::HTTP_MAX_CONCURRENT_REQUESTS, 3);
+    configuration->putInt(api::Configuration::HTTP_MAX_RETRIES, 2);
+    configuration->putInt(api::Configuration::HTTP_RETRY_BASE_DELAY, 100);
+    configuration->putInt(api::Configuration::HTTP_RETRY_MAX_DELAY, 1000);
+    configuration->putInt(api::Configuration::HTTP_HEDGE_DELAY, 500);
+    configuration->putBoolean(api::Configuration::HTTP_COALESCE_REQUESTS, true);
+    auto pool = newDefaultPool("http_pool", "test", configuration);
+
+    auto client = pool->getHttpClient("http://scheduler-configuration.test");
+    const auto& options = client->getSchedulerOptions();
+    EXPECT_EQ(options.maxRetries, 2);
+    EXPECT_EQ(options.retryBaseDelayMs, 100);
+    EXPECT_EQ(options.retryMaxDelayMs, 1000);
+    EXPECT_EQ(options.hedgeDelayMs, 500);
+    EXPECT_TRUE(options.coalesceRequests);
+    EXPECT_EQ(HttpRequestScheduler::forUrl("http://scheduler-configuration.test")->getMaxConcurrentRequests(), 3);
+
+    // Without configuration the middleware stays transparent
+    auto defaultPool = newDefaultPool("default_http_pool");
+    auto defaultOptions = defaultPool->getHttpClient("http://scheduler-default.test")->getSchedulerOptions();
+    EXPECT_EQ(defaultOptions.maxRetries, 0);
+    EXPECT_EQ(defaultOptions.hedgeDelayMs, 0);
+    EXPECT_FALSE(defaultOptions.coalesceRequests);
+    EXPECT_EQ(HttpRequestScheduler::forUrl("http://scheduler-default.test")->getMaxConcurrentRequests(), 0);
+}
+
 TEST_F(WalletPoolTest, AddCurrency) {
     api::BitcoinLikeNetworkParameters params(
     "wonder_coin", {42}, {21}, {42, 42, 21, 21}, api::BitcoinLikeFeePolicy::PER_KBYTE, 0,
@@ -0,0 +1,201 @@
+/*
+ *
+ * synchronization_checkpoint_tests.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <thread>
+#include <UvThreadDispatcher.hpp>
+#include <gtest/gtest.h>
+#include "../BaseFixture.h"
+#include <api/Configuration.hpp>
+#include <wallet/common/synchronizers/AbstractBlockchainExplorerAccountSynchronizer.h>
+#include "ExplorerStorage.hpp"
+#include "HttpClientOnFakeExplorer.hpp"
+
+static const int32_t HALF_BATCH_SIZE = 5;
+static const std::string STATE_PREFERENCES = "AbstractBlockchainExplorerAccountSynchronizer";
+
+struct BitcoinLikeWalletSynchronizationCheckpoints : public BaseFixture {
+
+    void SetUp() override {
+        BaseFixture::SetUp();
+        explorer = std::make_shared<test::ExplorerStorage>();
+        backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getSqlite3Backend());
+        pool = WalletPool::newInstance(
+                "checkpoint_pool",
+                "test",
+                std::make_shared<test::HttpClientOnFakeExplorer>(explorer),
+                nullptr,
+                resolver,
+                printer,
+                dispatcher,
+                rng,
+                backend,
+                api::DynamicObject::newInstance(),
+                nullptr,
+                nullptr
+        );
+    }
+
+    void TearDown() override {
+        BaseFixture::TearDown();
+        pool = nullptr;
+        explorer = nullptr;
+    }
+
+    std::shared_ptr<BitcoinLikeAccount> newAccount(const std::string& walletName, int32_t checkpointPages) {
+        auto configuration = api::DynamicObject::newInstance();
+        configuration->putInt(api::Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE, HALF_BATCH_SIZE);
+        configuration->putInt(api::Configuration::SYNCHRONIZATION_CHECKPOINT_PAGES, checkpointPages);
+        configuration->putInt(api::Configuration::SYNCHRONIZATION_CHECKPOINT_INTERVAL, 3600);
+        auto wallet = uv::wait(pool->createWallet(walletName, "bitcoin", configuration));
+        return createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+    }
+
+    void synchronizeAccount(const std::shared_ptr<BitcoinLikeAccount>& account) {
+        auto bus = account->synchronize();
+        Promise<Unit> promise;
+        bus->subscribe(dispatcher->getSerialExecutionContext("worker"),
+                       make_receiver([=](const std::shared_ptr<api::Event>& event) mutable {
+                           if (event->getCode() == api::EventCode::SYNCHRONIZATION_STARTED)
+                               return;
+                           promise.success(unit);
+                       }));
+        uv::wait(promise.getFuture());
+    }
+
+    // Receive 1000 satoshis in block height on the receive address of the given index
+    void receive(const std::shared_ptr<BitcoinLikeAccount>& account, uint32_t addressIndex, uint32_t height) {
+        auto address = account->getKeychain()->getAllObservableAddressString(addressIndex, addressIndex).front();
+        explorer->addTransaction(fmt::format(
+            R"({{"hash": "tx{0}", "receive_at": "2015-06-22T15:58:30Z", "lock_time": 0, )"
+            R"("block": {{"hash": "block{0}", "height": {0}, "time": "2015-06-22T15:58:30Z"}}, )"
+            R"("inputs": [{{"input_index": 0, "output_hash": "prev{0}", "output_index": 0, "value": 2000, "address": "1Bmpme646SNGa1jjjYAfuijdyBNJXLGEh", "script_signature": "0000"}}], )"
+            R"("outputs": [{{"output_index": 0, "address": "{1}", "value": 1000, "script_hex": "0000"}}], "fees": 1000}})",
+            height, address));
+    }
+
+    size_t countOperations(const std::shared_ptr<BitcoinLikeAccount>& account) {
+        return uv::wait(std::dynamic_pointer_cast<OperationQuery>(account->queryOperations()->complete())->execute()).size();
+    }
+
+    Option<BlockchainExplorerAccountSynchronizationSavedState> getSavedState(const std::shared_ptr<Preferences>& preferences) {
+        return preferences->getObject<BlockchainExplorerAccountSynchronizationSavedState>("state");
+    }
+
+    BlockchainExplorerAccountSynchronizationSavedState newState(uint32_t blockHeight) {
+        BlockchainExplorerAccountSynchronizationSavedState state;
+        state.halfBatchSize = HALF_BATCH_SIZE;
+        BlockchainExplorerAccountSynchronizationBatchSavedState batch;
+        batch.blockHeight = blockHeight;
+        batch.blockHash = fmt::format("block{}", blockHeight);
+        state.batches.push_back(batch);
+        return state;
+    }
+
+    std::shared_ptr<test::ExplorerStorage> explorer;
+    std::shared_ptr<WalletPool> pool;
+};
+
+TEST_F(BitcoinLikeWalletSynchronizationCheckpoints, FlushesEveryMaxPages) {
+    auto preferences = newAccount("pages", 3)->getInternalPreferences()->getSubPreferences("checkpointer");
+    BlockchainExplorerAccountSynchronizationCheckpointer checkpointer(3, std::chrono::seconds(3600));
+
+    auto state = newState(1);
+    checkpointer.checkpoint(preferences, state);
+    state = newState(2);
+    checkpointer.checkpoint(preferences, state);
+    EXPECT_TRUE(getSavedState(preferences).isEmpty());
+
+    state = newState(3);
+    checkpointer.checkpoint(preferences, state);
+    ASSERT_TRUE(getSavedState(preferences).nonEmpty());
+    EXPECT_EQ(getSavedState(preferences).getValue().batches[0].blockHeight, 3);
+
+    // The page count starts over after a flush
+    state = newState(4);
+    checkpointer.checkpoint(preferences, state);
+    EXPECT_EQ(getSavedState(preferences).getValue().batches[0].blockHeight, 3);
+    checkpointer.flush(preferences, state);
+    EXPECT_EQ(getSavedState(preferences).getValue().batches[0].blockHeight, 4);
+}
+
+TEST_F(BitcoinLikeWalletSynchronizationCheckpoints, FlushesAfterMaxInterval) {
+    auto preferences = newAccount("interval", 100)->getInternalPreferences()->getSubPreferences("checkpointer");
+    BlockchainExplorerAccountSynchronizationCheckpointer checkpointer(100, std::chrono::seconds(1));
+
+    auto state = newState(1);
+    checkpointer.checkpoint(preferences, state);
+    EXPECT_TRUE(getSavedState(preferences).isEmpty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    state = newState(2);
+    checkpointer.checkpoint(preferences, state);
+    ASSERT_TRUE(getSavedState(preferences).nonEmpty());
+    EXPECT_EQ(getSavedState(preferences).getValue().batches[0].blockHeight, 2);
+}
+
+TEST_F(BitcoinLikeWalletSynchronizationCheckpoints, ResumesFromTheLastCheckpoint) {
+    auto account = newAccount("resume", 2);
+    auto preferences = account->getInternalPreferences()->getSubPreferences(STATE_PREFERENCES);
+    for (auto height = 1; height <= 5; height++) {
+        receive(account, height - 1, height);
+    }
+
+    // One transaction per page: pages 1 and 2 are checkpointed, page 3 is only saved by the flush on
+    // failure as the request of page 4 fails
+    explorer->setPageSize(1);
+    explorer->setFailingBlock("block3");
+    synchronizeAccount(account);
+
+    EXPECT_EQ(countOperations(account), 3);
+    auto state = getSavedState(preferences);
+    ASSERT_TRUE(state.nonEmpty());
+    EXPECT_EQ(state.getValue().batches[0].blockHeight, 3);
+
+    // Losing the unflushed page, as a crash before the flush on failure would, rewinds to the last checkpoint
+    state.getValue().batches[0].blockHeight = 2;
+    state.getValue().batches[0].blockHash = "block2";
+    preferences->editor()->putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", state.getValue())->commit();
+
+    // The page is fetched again and inserted without duplicates, the end of the synchronization flushes
+    // the last page even though it does not complete a checkpoint
+    auto requests = explorer->getRequestedBlocks().size();
+    explorer->setFailingBlock("");
+    synchronizeAccount(account);
+
+    const auto& requested = explorer->getRequestedBlocks();
+    EXPECT_NE(std::find(requested.begin() + requests, requested.end(), "block2"), requested.end());
+    EXPECT_EQ(std::find(requested.begin() + requests, requested.end(), "block1"), requested.end());
+    EXPECT_EQ(countOperations(account), 5);
+    state = getSavedState(preferences);
+    ASSERT_TRUE(state.nonEmpty());
+    EXPECT_EQ(state.getValue().batches[0].blockHeight, 5);
+    EXPECT_EQ(state.getValue().batches[0].blockHash, "block5");
+}
@@ -0,0 +1,208 @@
+/*
+ *
+ * synchronization_parallel_batches_tests.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <UvThreadDispatcher.hpp>
+#include <gtest/gtest.h>
+#include "../BaseFixture.h"
+#include <api/Configuration.hpp>
+#include <wallet/common/synchronizers/AbstractBlockchainExplorerAccountSynchronizer.h>
+#include "ExplorerStorage.hpp"
+#include "HttpClientOnFakeExplorer.hpp"
+
+// Receive addresses of a batch b are the indexes [b * HALF_BATCH_SIZE, (b + 1) * HALF_BATCH_SIZE)
+static const int32_t HALF_BATCH_SIZE = 5;
+
+struct BitcoinLikeWalletParallelBatchesSynchronization : public BaseFixture {
+
+    void SetUp() override {
+        BaseFixture::SetUp();
+        explorer = std::make_shared<test::ExplorerStorage>();
+        backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getSqlite3Backend());
+        pool = WalletPool::newInstance(
+                "parallel_batches_pool",
+                "test",
+                std::make_shared<test::HttpClientOnFakeExplorer>(explorer),
+                nullptr,
+                resolver,
+                printer,
+                dispatcher,
+                rng,
+                backend,
+                api::DynamicObject::newInstance(),
+                nullptr,
+                nullptr
+        );
+    }
+
+    void TearDown() override {
+        BaseFixture::TearDown();
+        pool = nullptr;
+        explorer = nullptr;
+    }
+
+    std::shared_ptr<BitcoinLikeAccount> newAccount(const std::string& walletName, int32_t maxParallelBatches) {
+        auto configuration = api::DynamicObject::newInstance();
+        configuration->putInt(api::Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE, HALF_BATCH_SIZE);
+        configuration->putInt(api::Configuration::SYNCHRONIZATION_MAX_PARALLEL_BATCHES, maxParallelBatches);
+        auto wallet = uv::wait(pool->createWallet(walletName, "bitcoin", configuration));
+        return createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+    }
+
+    void synchronizeAccount(const std::shared_ptr<BitcoinLikeAccount>& account) {
+        auto bus = account->synchronize();
+        Promise<Unit> promise;
+        bus->subscribe(dispatcher->getSerialExecutionContext("worker"),
+                       make_receiver([=](const std::shared_ptr<api::Event>& event) mutable {
+                           if (event->getCode() == api::EventCode::SYNCHRONIZATION_STARTED)
+                               return;
+                           promise.success(unit);
+                       }));
+        uv::wait(promise.getFuture());
+    }
+
+    // Receive 1000 satoshis in block height on the receive address of the given index
+    void receive(const std::shared_ptr<BitcoinLikeAccount>& account, uint32_t addressIndex, uint32_t height) {
+        auto address = account->getKeychain()->getAllObservableAddressString(addressIndex, addressIndex).front();
+        explorer->addTransaction(fmt::format(
+            R"({{"hash": "tx{0}", "receive_at": "2015-06-22T15:58:30Z", "lock_time": 0, )"
+            R"("block": {{"hash": "block{0}", "height": {0}, "time": "2015-06-22T15:58:30Z"}}, )"
+            R"("inputs": [{{"input_index": 0, "output_hash": "prev{0}", "output_index": 0, "value": 2000, "address": "1Bmpme646SNGa1jjjYAfuijdyBNJXLGEh", "script_signature": "0000"}}], )"
+            R"("outputs": [{{"output_index": 0, "address": "{1}", "value": 1000, "script_hex": "0000"}}], "fees": 1000}})",
+            height, address));
+    }
+
+    size_t countOperations(const std::shared_ptr<BitcoinLikeAccount>& account) {
+        return uv::wait(std::dynamic_pointer_cast<OperationQuery>(account->queryOperations()->complete())->execute()).size();
+    }
+
+    BlockchainExplorerAccountSynchronizationSavedState getSavedState(const std::shared_ptr<BitcoinLikeAccount>& account) {
+        return account->getInternalPreferences()
+                ->getSubPreferences("AbstractBlockchainExplorerAccountSynchronizer")
+                ->getObject<BlockchainExplorerAccountSynchronizationSavedState>("state")
+                .getValue();
+    }
+
+    std::shared_ptr<test::ExplorerStorage> explorer;
+    std::shared_ptr<WalletPool> pool;
+};
+
+TEST_F(BitcoinLikeWalletParallelBatchesSynchronization, DiscoversTheSameBatchesAsSerialSynchronization) {
+    auto serial = newAccount("serial", 1);
+    auto parallel = newAccount("parallel", 3);
+
+    // Batches 0 to 3 have transactions, batch 4 is the first empty one and ends the discovery
+    receive(serial, 1, 1);
+    receive(serial, 3, 2);
+    receive(serial, 6, 3);
+    receive(serial, 8, 4);
+    receive(serial, 12, 5);
+    receive(serial, 13, 6);
+    receive(serial, 17, 7);
+    // Batch 6 is discovered by the keychain but lies behind the empty batch 4, neither mode reaches it
+    receive(serial, 32, 8);
+
+    synchronizeAccount(serial);
+    synchronizeAccount(parallel);
+
+    EXPECT_EQ(countOperations(serial), 7);
+    EXPECT_EQ(countOperations(parallel), 7);
+    EXPECT_EQ(uv::wait(parallel->getBalance())->toLong(), uv::wait(serial->getBalance())->toLong());
+
+    auto serialState = getSavedState(serial);
+    auto parallelState = getSavedState(parallel);
+    const std::vector<uint32_t> heights {2, 4, 6, 7};
+    ASSERT_GE(serialState.batches.size(), heights.size());
+    ASSERT_GE(parallelState.batches.size(), heights.size());
+    for (auto batch = 0; batch < heights.size(); batch++) {
+        EXPECT_EQ(serialState.batches[batch].blockHeight, heights[batch]);
+        EXPECT_EQ(parallelState.batches[batch].blockHeight, heights[batch]);
+        EXPECT_EQ(parallelState.batches[batch].blockHash, fmt::format("block{}", heights[batch]));
+    }
+}
+
+TEST_F(BitcoinLikeWalletParallelBatchesSynchronization, SavesNoBatchStatePastTheGapLimit) {
+    auto serial = newAccount("serial", 1);
+    auto parallel = newAccount("parallel", 3);
+
+    // Batch 4 ends the discovery in the second window [3, 5], batch 5 is synchronized but not kept
+    receive(serial, 1, 1);
+    receive(serial, 6, 2);
+    receive(serial, 12, 3);
+    receive(serial, 17, 4);
+
+    synchronizeAccount(serial);
+    synchronizeAccount(parallel);
+
+    auto serialSize = getSavedState(serial).batches.size();
+    EXPECT_EQ(getSavedState(parallel).batches.size(), serialSize);
+
+    // Resuming counts the same known batches and stops at the same one
+    synchronizeAccount(parallel);
+    EXPECT_EQ(getSavedState(parallel).batches.size(), serialSize);
+    EXPECT_EQ(countOperations(parallel), 4);
+}
+
+TEST_F(BitcoinLikeWalletParallelBatchesSynchronization, KeepsBatchStatesOfAnInterruptedSynchronization) {
+    auto account = newAccount("interrupted", 3);
+
+    receive(account, 1, 1);
+    receive(account, 3, 2);
+    receive(account, 6, 3);
+    receive(account, 8, 4);
+    receive(account, 12, 5);
+    receive(account, 13, 6);
+    receive(account, 17, 7);
+
+    // One transaction per page: the explorer fails on the second page of batch 2, while batches 0 and 1
+    // of the same window complete
+    explorer->setPageSize(1);
+    explorer->setFailingBlock("block5");
+    synchronizeAccount(account);
+
+    EXPECT_EQ(countOperations(account), 5);
+    auto state = getSavedState(account);
+    ASSERT_GE(state.batches.size(), 3);
+    EXPECT_EQ(state.batches[0].blockHeight, 2);
+    EXPECT_EQ(state.batches[1].blockHeight, 4);
+    // Only the inserted page of the failing batch is saved
+    EXPECT_EQ(state.batches[2].blockHeight, 5);
+    EXPECT_EQ(state.batches[2].blockHash, "block5");
+
+    // Synchronization resumes from the saved states
+    explorer->setFailingBlock("");
+    synchronizeAccount(account);
+
+    EXPECT_EQ(countOperations(account), 7);
+    state = getSavedState(account);
+    ASSERT_GE(state.batches.size(), 4);
+    EXPECT_EQ(state.batches[2].blockHeight, 6);
+    EXPECT_EQ(state.batches[3].blockHeight, 7);
+}
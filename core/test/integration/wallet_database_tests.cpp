@@ -30,6 +30,18 @@
  */
 
 #include "BaseFixture.h"
+#include <wallet/bitcoin/database/BitcoinLikeKeychainDatabaseHelper.h>
+#include <wallet/common/database/AccountDatabaseHelper.h>
+#include <wallet/common/OperationCursor.h>
+#include <wallet/common/database/BlockDatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
+#include <wallet/common/database/AmountLimbs.hpp>
+#include <database/soci-number.h>
+#include <wallet/common/synchronizers/BlockchainReorganization.h>
+#include <utils/DateUtils.hpp>
+#include <wallet/bitcoin/database/BitcoinLikeTransactionDatabaseHelper.h>
+#include <limits>
+#include <set>
 
 static const std::string XPUB_1 = "xpub6EedcbfDs3pkzgqvoRxTW6P8NcCSaVbMQsb6xwCdEBzqZBronwY3Nte1Vjunza8f6eSMrYvbM5CMihGo6SbzpHxn4R5pvcr2ZbZ6wkDmgpy";
 
@@ -255,4 +267,494 @@ TEST_F(BitcoinWalletDatabaseTests, PutOperations) {
     ASSERT_EXPECTATION(2);
     ASSERT_EXPECTATION(3);
     ASSERT_EXPECTATION(4);
-}
\ No newline at end of file
+}
+TEST_F(BitcoinWalletDatabaseTests, KeychainAddressesAreStored) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    auto addresses = BitcoinLikeKeychainDatabaseHelper::getAddresses(sql, account->getAccountUid());
+    // Receive and change addresses from index 0 to 40 are derived when the account is created
+    EXPECT_EQ(addresses.size(), 82);
+    for (const auto& address : addresses) {
+        EXPECT_TRUE(account->getKeychain()->contains(address.address));
+        EXPECT_FALSE(address.publicKey.empty());
+    }
+}
+
+static std::set<std::pair<std::string, int>> materializedUTXOs(soci::session& sql, const std::string& accountUid) {
+    std::set<std::pair<std::string, int>> result;
+    soci::rowset<soci::row> rows = (sql.prepare << "SELECT transaction_uid, idx FROM bitcoin_utxos WHERE account_uid = :uid",
+            soci::use(accountUid));
+    for (auto& row : rows) {
+        result.emplace(row.get<std::string>(0), row.get<int>(1));
+    }
+    return result;
+}
+
+static std::set<std::pair<std::string, int>> unspentOutputs(soci::session& sql, const std::string& accountUid) {
+    std::set<std::pair<std::string, int>> result;
+    soci::rowset<soci::row> rows = (sql.prepare << "SELECT o.transaction_uid, o.idx FROM bitcoin_outputs AS o "
+            "LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid AND i.previous_output_idx = o.idx "
+            "WHERE o.account_uid = :uid AND i.previous_tx_uid IS NULL",
+            soci::use(accountUid));
+    for (auto& row : rows) {
+        result.emplace(row.get<std::string>(0), row.get<int>(1));
+    }
+    return result;
+}
+
+TEST_F(BitcoinWalletDatabaseTests, UTXOSetIsMaintained) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    {
+        std::vector<ledger::core::Operation> ops;
+        for (auto& tx : transactions) {
+            account->interpretTransaction(tx, ops, true);
+        }
+        account->bulkInsert(ops);
+    }
+
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    auto utxos = materializedUTXOs(sql, account->getAccountUid());
+    EXPECT_FALSE(utxos.empty());
+    EXPECT_EQ(utxos, unspentOutputs(sql, account->getAccountUid()));
+
+    // Rolling back the last block must give back the outputs it spent
+    int64_t lastHeight = 0;
+    for (auto& tx : transactions) {
+        if (tx.block.nonEmpty()) {
+            lastHeight = std::max<int64_t>(lastHeight, tx.block.getValue().height);
+        }
+    }
+    soci::rowset<std::string> rows = (sql.prepare << "SELECT uid FROM blocks WHERE height >= :height", soci::use(lastHeight));
+    std::vector<std::string> blocks(rows.begin(), rows.end());
+    {
+        soci::transaction tr(sql);
+        AccountDatabaseHelper::removeBlockOperation(sql, account->getAccountUid(), blocks);
+        tr.commit();
+    }
+    EXPECT_EQ(materializedUTXOs(sql, account->getAccountUid()), unspentOutputs(sql, account->getAccountUid()));
+}
+
+TEST_F(BitcoinWalletDatabaseTests, ReorganizationRollsBackAboveCommonAncestor) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    {
+        std::vector<ledger::core::Operation> ops;
+        for (auto& tx : transactions) {
+            account->interpretTransaction(tx, ops, true);
+        }
+        account->bulkInsert(ops);
+    }
+
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    auto currencyName = wallet->getCurrency().name;
+    auto blocks = BlockDatabaseHelper::getBlocksBelowHeight(sql, currencyName, std::numeric_limits<int64_t>::max());
+    ASSERT_GE(blocks.size(), 2);
+    for (size_t i = 1; i < blocks.size(); i++) {
+        EXPECT_GT(blocks[i - 1].height, blocks[i].height);
+    }
+
+    // Only the highest block was reorganized
+    auto forkHeight = blocks.front().height;
+    auto probes = 0;
+    auto ancestor = uv::wait(BlockchainReorganization::findCommonAncestor(blocks, [&] (const api::Block& block) {
+        probes += 1;
+        return Future<bool>::successful(block.height < forkHeight);
+    }));
+    ASSERT_TRUE(ancestor.nonEmpty());
+    EXPECT_EQ(ancestor.getValue().blockHash, blocks[1].blockHash);
+    EXPECT_LE(probes, 3);
+
+    std::vector<std::string> deleted;
+    {
+        soci::transaction tr(sql);
+        deleted = BlockchainReorganization::rollback(sql, account->getAccountUid(), currencyName, ancestor,
+                                                     &BitcoinLikeTransactionDatabaseHelper::eraseDataAboveHeight);
+        tr.commit();
+    }
+    EXPECT_FALSE(deleted.empty());
+    EXPECT_EQ(BlockDatabaseHelper::getLastBlock(sql, currencyName).getValue().blockHash, blocks[1].blockHash);
+    int remaining = 0;
+    sql << "SELECT COUNT(*) FROM operations AS op JOIN blocks AS b ON b.uid = op.block_uid "
+           "WHERE b.height >= :height", soci::use(forkHeight), soci::into(remaining);
+    EXPECT_EQ(remaining, 0);
+    EXPECT_EQ(materializedUTXOs(sql, account->getAccountUid()), unspentOutputs(sql, account->getAccountUid()));
+
+    // Nothing left in the chain
+    auto none = uv::wait(BlockchainReorganization::findCommonAncestor(blocks, [] (const api::Block&) {
+        return Future<bool>::successful(false);
+    }));
+    EXPECT_TRUE(none.isEmpty());
+}
+
+TEST_F(BitcoinWalletDatabaseTests, ReorganizationOnlyRollsBackTheSynchronizedAccount) {
+    auto pool = newDefaultPool();
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    // Two accounts of the same currency sharing the same blocks
+    std::vector<std::shared_ptr<BitcoinLikeAccount>> accounts;
+    for (auto walletName : {"wallet_1", "wallet_2"}) {
+        auto wallet = uv::wait(pool->createWallet(walletName, "bitcoin", api::DynamicObject::newInstance()));
+        auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+        std::vector<ledger::core::Operation> ops;
+        for (auto& tx : transactions) {
+            account->interpretTransaction(tx, ops, true);
+        }
+        account->bulkInsert(ops);
+        accounts.push_back(account);
+    }
+    auto& rolledBack = accounts[0];
+    auto& other = accounts[1];
+
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    auto currencyName = rolledBack->getWallet()->getCurrency().name;
+    auto blocks = BlockDatabaseHelper::getBlocksBelowHeight(sql, currencyName, std::numeric_limits<int64_t>::max());
+    ASSERT_GE(blocks.size(), 2);
+    auto forkHeight = blocks.front().height;
+    auto countOperationsAboveFork = [&] (const std::string& accountUid) {
+        int count = 0;
+        sql << "SELECT COUNT(*) FROM operations AS op JOIN blocks AS b ON b.uid = op.block_uid "
+               "WHERE op.account_uid = :uid AND b.height >= :height",
+               soci::use(accountUid), soci::use(forkHeight), soci::into(count);
+        return count;
+    };
+    auto otherOperations = countOperationsAboveFork(other->getAccountUid());
+    auto otherUTXOs = materializedUTXOs(sql, other->getAccountUid());
+    ASSERT_GT(otherOperations, 0);
+
+    std::vector<std::string> deleted;
+    {
+        soci::transaction tr(sql);
+        deleted = BlockchainReorganization::rollback(sql, rolledBack->getAccountUid(), currencyName,
+                                                     Option<api::Block>(blocks[1]),
+                                                     &BitcoinLikeTransactionDatabaseHelper::eraseDataAboveHeight);
+        tr.commit();
+    }
+    EXPECT_FALSE(deleted.empty());
+    EXPECT_EQ(countOperationsAboveFork(rolledBack->getAccountUid()), 0);
+    EXPECT_EQ(materializedUTXOs(sql, rolledBack->getAccountUid()), unspentOutputs(sql, rolledBack->getAccountUid()));
+
+    // The other account keeps its operations, its UTXOs and the block they refer to
+    EXPECT_EQ(countOperationsAboveFork(other->getAccountUid()), otherOperations);
+    EXPECT_EQ(materializedUTXOs(sql, other->getAccountUid()), otherUTXOs);
+    EXPECT_EQ(BlockDatabaseHelper::getLastBlock(sql, currencyName).getValue().blockHash, blocks.front().blockHash);
+
+    // Once the other account rolls back too, the block is gone
+    {
+        soci::transaction tr(sql);
+        BlockchainReorganization::rollback(sql, other->getAccountUid(), currencyName,
+                                           Option<api::Block>(blocks[1]),
+                                           &BitcoinLikeTransactionDatabaseHelper::eraseDataAboveHeight);
+        tr.commit();
+    }
+    EXPECT_EQ(countOperationsAboveFork(other->getAccountUid()), 0);
+    EXPECT_EQ(BlockDatabaseHelper::getLastBlock(sql, currencyName).getValue().blockHash, blocks[1].blockHash);
+}
+
+TEST_F(BitcoinWalletDatabaseTests, BalanceCheckpointsMatchOperations) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    std::vector<ledger::core::Operation> ops;
+    for (auto& tx : transactions) {
+        account->interpretTransaction(tx, ops, true);
+    }
+    account->bulkInsert(ops);
+
+    auto balanceAt = [&] (const std::chrono::system_clock::time_point& date) {
+        BigInt sum;
+        for (const auto& op : ops) {
+            if (op.date > date) {
+                continue;
+            }
+            if (op.type == api::OperationType::RECEIVE) {
+                sum = sum + op.amount;
+            } else if (op.type == api::OperationType::SEND) {
+                sum = sum - (op.amount + op.fees.getValueOr(BigInt::ZERO));
+            }
+        }
+        return sum;
+    };
+
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    auto uid = account->getAccountUid();
+    auto balance = BalanceCheckpointDatabaseHelper::getBalance(sql, uid);
+    ASSERT_TRUE(balance.nonEmpty());
+    EXPECT_EQ(balance.getValue().toString(), balanceAt(std::chrono::system_clock::time_point::max()).toString());
+
+    auto first = ops.front().date;
+    auto last = ops.front().date;
+    for (const auto& op : ops) {
+        first = std::min(first, op.date);
+        last = std::max(last, op.date);
+    }
+    // Period ends aligned on days, on hours, and falling exactly on an operation
+    std::vector<std::chrono::system_clock::time_point> starts = {
+            BalanceCheckpointDatabaseHelper::startOfDay(first) - std::chrono::hours(48),
+            first - std::chrono::hours(2) - std::chrono::minutes(31),
+            first - std::chrono::hours(2)
+    };
+    for (auto precision : {api::TimePeriod::HOUR, api::TimePeriod::DAY, api::TimePeriod::WEEK, api::TimePeriod::MONTH}) {
+        for (const auto& start : starts) {
+            auto end = last + std::chrono::hours(48);
+            auto history = BalanceCheckpointDatabaseHelper::getBalanceHistory(sql, uid, start, end, precision);
+            ASSERT_TRUE(history.nonEmpty());
+            auto point = start;
+            for (const auto& value : history.getValue()) {
+                point = DateUtils::incrementDate(point, precision);
+                EXPECT_EQ(value.toString(), balanceAt(point).toString());
+            }
+            EXPECT_GE(point, end);
+        }
+    }
+}
+
+static std::vector<std::pair<std::string, std::string>> balanceCheckpoints(soci::session& sql, const std::string& accountUid) {
+    std::vector<std::pair<std::string, std::string>> result;
+    soci::rowset<soci::row> rows = (sql.prepare << "SELECT day, balance_high, balance_low FROM balance_checkpoints "
+            "WHERE account_uid = :uid ORDER BY day", soci::use(accountUid));
+    for (auto& row : rows) {
+        auto balance = AmountLimbs::toBigInt(soci::get_number<int64_t>(row, 1), soci::get_number<int64_t>(row, 2));
+        result.emplace_back(row.get<std::string>(0), balance.toString());
+    }
+    return result;
+}
+
+TEST_F(BitcoinWalletDatabaseTests, BalanceCheckpointsAreUpdatedIncrementally) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    // Latest transactions first, every insert lands before the checkpoints already written
+    for (auto it = transactions.rbegin(); it != transactions.rend(); it++) {
+        std::vector<ledger::core::Operation> ops;
+        account->interpretTransaction(*it, ops, true);
+        account->bulkInsert(ops);
+    }
+
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    auto uid = account->getAccountUid();
+    auto checkpoints = balanceCheckpoints(sql, uid);
+    EXPECT_FALSE(checkpoints.empty());
+    {
+        soci::transaction tr(sql);
+        BalanceCheckpointDatabaseHelper::refresh(sql, uid, std::chrono::system_clock::time_point());
+        tr.commit();
+    }
+    EXPECT_EQ(balanceCheckpoints(sql, uid), checkpoints);
+
+    // Inserting the same operations again changes nothing
+    for (auto& tx : transactions) {
+        std::vector<ledger::core::Operation> ops;
+        account->interpretTransaction(tx, ops, true);
+        account->bulkInsert(ops);
+    }
+    EXPECT_EQ(balanceCheckpoints(sql, uid), checkpoints);
+}
+
+TEST_F(BitcoinWalletDatabaseTests, OperationKeysetPaginationAndCursor) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    {
+        std::vector<ledger::core::Operation> ops;
+        for (auto& tx : transactions) {
+            account->interpretTransaction(tx, ops, true);
+        }
+        account->bulkInsert(ops);
+    }
+
+    auto all = uv::wait(std::static_pointer_cast<OperationQuery>(
+            account->queryOperations()->after(std::chrono::system_clock::time_point(), ""))->execute());
+    ASSERT_EQ(all.size(), 5);
+
+    // Walk through the operations two by two
+    std::vector<std::string> paged;
+    Option<std::shared_ptr<api::Operation>> last;
+    while (true) {
+        auto query = account->queryOperations()->addOrder(api::OperationOrderKey::DATE, false)->limit(2);
+        if (last.nonEmpty()) {
+            query = query->after(last.getValue()->getDate(), last.getValue()->getUid());
+        }
+        auto page = uv::wait(std::static_pointer_cast<OperationQuery>(query)->execute());
+        if (page.empty()) {
+            break;
+        }
+        for (auto& op : page) {
+            paged.push_back(op->getUid());
+        }
+        last = page.back();
+    }
+    ASSERT_EQ(paged.size(), all.size());
+    for (auto i = 0; i < all.size(); i++) {
+        EXPECT_EQ(paged[i], all[i]->getUid());
+    }
+
+    // Stream them in reverse order
+    auto query = account->queryOperations()->addOrder(api::OperationOrderKey::DATE, true)
+            ->after(std::chrono::system_clock::now() + std::chrono::hours(24), "");
+    auto cursor = std::dynamic_pointer_cast<OperationCursor>(query->cursor(2));
+    std::vector<size_t> chunks;
+    std::vector<std::string> streamed;
+    while (true) {
+        auto chunk = uv::wait(cursor->next());
+        if (chunk.empty()) {
+            break;
+        }
+        chunks.push_back(chunk.size());
+        for (auto& op : chunk) {
+            streamed.push_back(op->getUid());
+        }
+    }
+    EXPECT_EQ(chunks, std::vector<size_t>({2, 2, 1}));
+    ASSERT_EQ(streamed.size(), all.size());
+    for (auto i = 0; i < all.size(); i++) {
+        EXPECT_EQ(streamed[i], all[all.size() - 1 - i]->getUid());
+    }
+
+    // Keyset pagination only applies to date ordered queries
+    auto amountQuery = account->queryOperations()->addOrder(api::OperationOrderKey::AMOUNT, false)
+            ->after(std::chrono::system_clock::time_point(), "");
+    EXPECT_THROW(uv::wait(std::static_pointer_cast<OperationQuery>(amountQuery)->execute()), Exception);
+}
+
+TEST_F(BitcoinWalletDatabaseTests, OrdersOperationsByAmountsWiderThanTheirLimbs) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    {
+        std::vector<ledger::core::Operation> ops;
+        for (auto& tx : transactions) {
+            account->interpretTransaction(tx, ops, true);
+        }
+        account->bulkInsert(ops);
+    }
+
+    auto all = uv::wait(std::static_pointer_cast<OperationQuery>(account->queryOperations()->complete())->execute());
+    ASSERT_GE(all.size(), 2);
+
+    // Two amounts too wide for the limbs, the shorter one is the smaller
+    const auto wide = BigInt::fromHex("0100000000000000000000000000");
+    const auto wider = BigInt::fromHex("010000000000000000000000000000");
+    {
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        auto wideHex = wide.toHexString();
+        auto widerHex = wider.toHexString();
+        auto wideUid = all[0]->getUid();
+        auto widerUid = all[1]->getUid();
+        sql << "UPDATE operations SET amount = :amount, amount_high = NULL, amount_low = NULL WHERE uid = :uid",
+                soci::use(widerHex), soci::use(widerUid);
+        sql << "UPDATE operations SET amount = :amount, amount_high = NULL, amount_low = NULL WHERE uid = :uid",
+                soci::use(wideHex), soci::use(wideUid);
+    }
+
+    auto ascending = uv::wait(std::static_pointer_cast<OperationQuery>(
+            account->queryOperations()->addOrder(api::OperationOrderKey::AMOUNT, false))->execute());
+    ASSERT_EQ(ascending.size(), all.size());
+    for (auto i = 1; i < ascending.size() - 2; i++) {
+        EXPECT_LE(ascending[i - 1]->getAmount()->toLong(), ascending[i]->getAmount()->toLong());
+    }
+    EXPECT_EQ(ascending[ascending.size() - 2]->getUid(), all[0]->getUid());
+    EXPECT_EQ(ascending[ascending.size() - 1]->getUid(), all[1]->getUid());
+
+    auto descending = uv::wait(std::static_pointer_cast<OperationQuery>(
+            account->queryOperations()->addOrder(api::OperationOrderKey::AMOUNT, true))->execute());
+    ASSERT_EQ(descending.size(), all.size());
+    EXPECT_EQ(descending[0]->getUid(), all[1]->getUid());
+    EXPECT_EQ(descending[1]->getUid(), all[0]->getUid());
+}
+
+TEST_F(BitcoinWalletDatabaseTests, BatchedTransactionReadsMatchSingleReads) {
+    auto pool = newDefaultPool();
+    auto wallet = uv::wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = std::dynamic_pointer_cast<BitcoinLikeAccount>(uv::wait(wallet->newAccountWithExtendedKeyInfo(P2PKH_MEDIUM_XPUB_INFO)));
+
+    std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+            *JSONUtils::parse<TransactionParser>(TX_1),
+            *JSONUtils::parse<TransactionParser>(TX_2),
+            *JSONUtils::parse<TransactionParser>(TX_3),
+            *JSONUtils::parse<TransactionParser>(TX_4)
+    };
+    {
+        std::vector<ledger::core::Operation> ops;
+        for (auto& tx : transactions) {
+            account->interpretTransaction(tx, ops, true);
+        }
+        account->bulkInsert(ops);
+    }
+
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    std::vector<std::pair<std::string, std::string>> keys;
+    for (auto& tx : transactions) {
+        keys.emplace_back(account->getAccountUid(), tx.hash);
+    }
+    auto batched = BitcoinLikeTransactionDatabaseHelper::getTransactionsByHashes(sql, keys);
+    ASSERT_EQ(batched.size(), transactions.size());
+    for (auto& tx : transactions) {
+        BitcoinLikeBlockchainExplorerTransaction single;
+        ASSERT_TRUE(BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, tx.hash, account->getAccountUid(), single));
+        auto& fromBatch = batched[BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(account->getAccountUid(), tx.hash)];
+        EXPECT_EQ(fromBatch.hash, single.hash);
+        EXPECT_EQ(fromBatch.block.nonEmpty(), single.block.nonEmpty());
+        ASSERT_EQ(fromBatch.inputs.size(), single.inputs.size());
+        for (auto i = 0; i < single.inputs.size(); i++) {
+            EXPECT_EQ(fromBatch.inputs[i].index, single.inputs[i].index);
+            EXPECT_EQ(fromBatch.inputs[i].previousTxHash.getValueOr(""), single.inputs[i].previousTxHash.getValueOr(""));
+        }
+        ASSERT_EQ(fromBatch.outputs.size(), single.outputs.size());
+        for (auto i = 0; i < single.outputs.size(); i++) {
+            EXPECT_EQ(fromBatch.outputs[i].index, single.outputs[i].index);
+            EXPECT_EQ(fromBatch.outputs[i].value.toString(), single.outputs[i].value.toString());
+        }
+    }
+}
@@ -1,28 +1,42 @@
-#pragma once
-#include <string>
-#include <vector>
-#include <unordered_set>
-#include <wallet/bitcoin/explorers/BitcoinLikeBlockchainExplorer.hpp>
-
-namespace ledger {
-    namespace core {
-        namespace test {
-            // This class simulate the work of Explorer for unit tests
-            class ExplorerStorage {
-            public:
-                void addTransaction(const std::string& jsonTransaction);
-
-                void removeTransaction(const std::string& hash);
-
-                std::vector<std::string> getTransactions(
-                    const std::vector<std::string>& addresses,
-                    const std::string& blockHash);
-
-                std::string getLastBlock();
-            private:
-                std::vector<std::pair<BitcoinLikeBlockchainExplorerTransaction, std::string>> _transactions;
-                std::vector<std::pair<BitcoinLikeBlockchainExplorerTransaction, std::string>> _memPool;
-            };
-        }
-    }
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <wallet/bitcoin/explorers/BitcoinLikeBlockchainExplorer.hpp>
+
+namespace ledger {
+    namespace core {
+        namespace test {
+            // This class simulate the work of Explorer for unit tests
+            class ExplorerStorage {
+            public:
+                void addTransaction(const std::string& jsonTransaction);
+
+                void removeTransaction(const std::string& hash);
+
+                std::vector<std::string> getTransactions(
+                    const std::vector<std::string>& addresses,
+                    const std::string& blockHash,
+                    bool* truncated = nullptr);
+
+                std::string getLastBlock();
+
+                // Limit the number of confirmed transactions per page, 0 means no limit
+                void setPageSize(size_t pageSize);
+
+                // Make requests resuming after the given block fail, an empty hash disables the failure
+                void setFailingBlock(const std::string& blockHash);
+                const std::string& getFailingBlock() const;
+
+                // Block hashes transaction pages were requested after, in request order ("" for the first page)
+                const std::vector<std::string>& getRequestedBlocks() const;
+            private:
+                std::vector<std::pair<BitcoinLikeBlockchainExplorerTransaction, std::string>> _transactions;
+                std::vector<std::pair<BitcoinLikeBlockchainExplorerTransaction, std::string>> _memPool;
+                size_t _pageSize = 0;
+                std::string _failingBlock;
+                std::vector<std::string> _requestedBlocks;
+            };
+        }
+    }
 }
\ No newline at end of file
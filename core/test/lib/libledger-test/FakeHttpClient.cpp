@@ -9,7 +9,7 @@ namespace ledger {
             void FakeHttpClient::execute(const std::shared_ptr<api::HttpRequest>& request) {
                 auto it = _behavior.find(request->getUrl());
                 if (it != _behavior.end()) {
-                    request->complete(it->second, std::experimental::nullopt);
+                    request->complete(std::make_shared<FakeUrlConnection>(it->second->getData()), std::experimental::nullopt);
                     return;
                 }
                 request->complete(std::shared_ptr<api::HttpUrlConnection>(), api::Error(api::ErrorCode::BLOCK_NOT_FOUND, "Block not found"));
@@ -15,7 +15,7 @@ namespace ledger {
             }
 
             FakeUrlConnection::FakeUrlConnection(const UrlConnectionData& data)
-                : _data(data) {};
+                : _data(data), _read(false) {};
 
             int32_t FakeUrlConnection::getStatusCode() {
                 return _data.statusCode;
@@ -30,10 +30,19 @@ namespace ledger {
             };
 
             api::HttpReadBodyResult FakeUrlConnection::readBody() {
+                // The whole body comes in the first chunk, the next one is empty to end it
+                if (_read) {
+                    return api::HttpReadBodyResult(std::experimental::nullopt, std::vector<uint8_t>());
+                }
+                _read = true;
                 std::vector<uint8_t> bindata((const uint8_t*)_data.body.data(), (const uint8_t*)_data.body.data() + _data.body.size());
                 api::HttpReadBodyResult result(std::experimental::nullopt, bindata);
                 return result;
             };
+
+            const UrlConnectionData& FakeUrlConnection::getData() const {
+                return _data;
+            }
         }
     }
 }
\ No newline at end of file
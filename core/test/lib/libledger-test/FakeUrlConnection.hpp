@@ -20,8 +20,10 @@ namespace ledger {
                 std::string getStatusText() override;
                 std::unordered_map<std::string, std::string> getHeaders() override;
                 api::HttpReadBodyResult readBody() override;
+                const UrlConnectionData& getData() const;
             private:
                 UrlConnectionData _data;
+                bool _read;
             };
         }
     }
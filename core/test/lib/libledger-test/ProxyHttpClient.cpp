@@ -14,7 +14,7 @@ namespace ledger {
                 auto it = _cache.find(request->getUrl());
                 if (it != _cache.end()) {
                     std::cout << "get response from cache : " << request->getUrl() << std::endl;
-                    request->complete(it->second, std::experimental::nullopt);
+                    request->complete(std::make_shared<FakeUrlConnection>(it->second->getData()), std::experimental::nullopt);
                     return;
                 }
                 _httpClient->execute(request);
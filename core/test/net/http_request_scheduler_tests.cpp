@@ -0,0 +1,551 @@
+/*
+ *
+ * http_request_scheduler_tests
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include <gtest/gtest.h>
+#include <deque>
+#include <ledger/core/net/HttpClient.hpp>
+#include <ledger/core/api/HttpReadBodyResult.hpp>
+#include <ledger/core/api/DurationMetric.hpp>
+#include <ledger/core/api/DurationMetrics.hpp>
+#include <ledger/core/api/Runnable.hpp>
+#include <ledger/core/api/PreferencesBackend.hpp>
+#include <ledger/core/api/PreferencesChange.hpp>
+#include <ledger/core/preferences/Preferences.hpp>
+#include <ledger/core/net/BufferedHttpUrlConnection.hpp>
+#include <map>
+#include <thread>
+
+using namespace ledger::core;
+
+namespace {
+    // Runs tasks, delayed or not, only when drained so that tests control the interleaving.
+    class QueueExecutionContext : public api::ExecutionContext {
+    public:
+        void execute(const std::shared_ptr<api::Runnable> &runnable) override {
+            _tasks.push_back(runnable);
+        }
+
+        void delay(const std::shared_ptr<api::Runnable> &runnable, int64_t millis) override {
+            _tasks.push_back(runnable);
+        }
+
+        void drain() {
+            while (!_tasks.empty()) {
+                auto task = _tasks.front();
+                _tasks.pop_front();
+                task->run();
+            }
+        }
+
+    private:
+        std::deque<std::shared_ptr<api::Runnable>> _tasks;
+    };
+
+    class StringUrlConnection : public api::HttpUrlConnection {
+    public:
+        StringUrlConnection(int32_t statusCode,
+                            const std::string &body,
+                            const std::unordered_map<std::string, std::string> &headers = {},
+                            size_t chunkSize = 0)
+            : _statusCode(statusCode), _body(body), _headers(headers), _chunkSize(chunkSize) {}
+
+        int32_t getStatusCode() override { return _statusCode; }
+        std::string getStatusText() override { return _statusCode == 200 ? "OK" : "Error"; }
+        std::unordered_map<std::string, std::string> getHeaders() override { return _headers; }
+
+        api::HttpReadBodyResult readBody() override {
+            auto size = _chunkSize == 0 ? _body.size() : std::min(_chunkSize, _body.size());
+            std::vector<uint8_t> data(_body.begin(), _body.begin() + size);
+            _body.erase(0, size);
+            return api::HttpReadBodyResult(std::experimental::nullopt, data);
+        }
+
+    private:
+        int32_t _statusCode;
+        std::string _body;
+        std::unordered_map<std::string, std::string> _headers;
+        size_t _chunkSize;
+    };
+
+    class CountingUrlConnection : public StringUrlConnection {
+    public:
+        using StringUrlConnection::StringUrlConnection;
+
+        api::HttpReadBodyResult readBody() override {
+            reads += 1;
+            return StringUrlConnection::readBody();
+        }
+
+        int reads = 0;
+    };
+
+    // Keeps requests pending until the test answers them.
+    class PendingHttpClient : public api::HttpClient {
+    public:
+        void execute(const std::shared_ptr<api::HttpRequest> &request) override {
+            requests.push_back(request);
+        }
+
+        void respond(size_t index,
+                     int32_t statusCode,
+                     const std::string &body,
+                     const std::unordered_map<std::string, std::string> &headers = {},
+                     size_t chunkSize = 0) {
+            requests[index]->complete(std::make_shared<StringUrlConnection>(statusCode, body, headers, chunkSize),
+                                      std::experimental::nullopt);
+        }
+
+        std::vector<std::shared_ptr<api::HttpRequest>> requests;
+    };
+
+    std::string readAll(const std::shared_ptr<api::HttpUrlConnection> &connection) {
+        std::string result;
+        while (true) {
+            auto chunk = connection->readBody();
+            if (!chunk.data || chunk.data->empty()) {
+                return result;
+            }
+            result.append(chunk.data->begin(), chunk.data->end());
+        }
+    }
+
+    class MemoryPreferencesBackend : public api::PreferencesBackend {
+    public:
+        std::experimental::optional<std::vector<uint8_t>> get(const std::vector<uint8_t> &key) override {
+            auto it = _values.find(key);
+            if (it == _values.end()) {
+                return std::experimental::nullopt;
+            }
+            return it->second;
+        }
+
+        bool commit(const std::vector<api::PreferencesChange> &changes) override {
+            commits += 1;
+            for (const auto& change : changes) {
+                if (change.type == api::PreferencesChangeType::PUT_TYPE) {
+                    _values[change.key] = change.value;
+                } else {
+                    _values.erase(change.key);
+                }
+            }
+            return true;
+        }
+
+        void setEncryption(const std::shared_ptr<api::RandomNumberGenerator> &, const std::string &) override {}
+        void unsetEncryption() override {}
+        bool resetEncryption(const std::shared_ptr<api::RandomNumberGenerator> &, const std::string &, const std::string &) override {
+            return true;
+        }
+        std::string getEncryptionSalt() override { return ""; }
+        void clear() override { _values.clear(); }
+
+        size_t size() const { return _values.size(); }
+
+        int commits = 0;
+
+    private:
+        std::map<std::vector<uint8_t>, std::vector<uint8_t>> _values;
+    };
+
+    int64_t counter(const std::string &name) {
+        auto metrics = api::DurationMetrics::getAllDurationMetrics();
+        auto it = metrics.find(name);
+        return it == metrics.end() ? 0 : it->second.count;
+    }
+}
+
+TEST(HttpRequestScheduler, LimitsRequestsInFlightPerHost) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://limit.test", engine, context, context);
+    HttpRequestScheduler::forUrl("http://limit.test")->setMaxConcurrentRequests(2);
+
+    std::vector<Future<std::shared_ptr<api::HttpUrlConnection>>> responses;
+    for (auto i = 0; i < 5; i++) {
+        responses.push_back(http.POST("/tx", std::vector<uint8_t>(1, (uint8_t)i))());
+    }
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 2);
+
+    for (size_t answered = 0; answered < 5; answered++) {
+        engine->respond(answered, 200, "ok");
+        context->drain();
+        EXPECT_EQ(engine->requests.size(), std::min<size_t>(5, answered + 3));
+    }
+    for (auto& response : responses) {
+        ASSERT_TRUE(response.isCompleted());
+        EXPECT_EQ(readAll(response.getValue().getValue().getValue()), "ok");
+    }
+    EXPECT_EQ(counter("HttpClient/http://limit.test/queued"), 3);
+}
+
+TEST(HttpRequestScheduler, SharesTheHostLimitBetweenClients) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient first("http://shared-limit.test", engine, context, context);
+    HttpClient second("http://shared-limit.test/api", engine, context, context);
+    HttpRequestScheduler::forUrl("http://shared-limit.test")->setMaxConcurrentRequests(2);
+
+    std::vector<Future<std::shared_ptr<api::HttpUrlConnection>>> responses;
+    for (auto i = 0; i < 3; i++) {
+        responses.push_back(first.POST("/tx", std::vector<uint8_t>(1, (uint8_t)i))());
+        responses.push_back(second.POST("/tx", std::vector<uint8_t>(1, (uint8_t)i))());
+    }
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 2);
+
+    for (size_t answered = 0; answered < 6; answered++) {
+        engine->respond(answered, 200, "ok");
+        context->drain();
+        EXPECT_EQ(engine->requests.size(), std::min<size_t>(6, answered + 3));
+    }
+    for (auto& response : responses) {
+        ASSERT_TRUE(response.isCompleted());
+        EXPECT_EQ(readAll(response.getValue().getValue().getValue()), "ok");
+    }
+}
+
+TEST(HttpRequestScheduler, IsTransparentByDefault) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://default.test", engine, context, context);
+
+    auto first = http.GET("/blocks/current")();
+    auto second = http.GET("/blocks/current")();
+    context->drain();
+    ASSERT_EQ(engine->requests.size(), 2);
+    engine->respond(0, 503, "busy");
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 2);
+    EXPECT_TRUE(first.getValue().getValue().isFailure());
+}
+
+TEST(HttpRequestScheduler, CoalescesIdenticalGets) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://coalesce.test", engine, context, context);
+    HttpRequestScheduler::Options options;
+    options.coalesceRequests = true;
+    http.setSchedulerOptions(options);
+
+    auto first = http.GET("/blocks/current")();
+    auto second = http.GET("/blocks/current")();
+    auto other = http.GET("/blocks/current", {{"X-Other", "1"}})();
+    context->drain();
+    ASSERT_EQ(engine->requests.size(), 2);
+    EXPECT_EQ(counter("HttpClient/http://coalesce.test/coalesced"), 1);
+
+    engine->respond(0, 200, "{\"height\": 42}");
+    engine->respond(1, 200, "{\"height\": 43}");
+    context->drain();
+    EXPECT_EQ(readAll(first.getValue().getValue().getValue()), "{\"height\": 42}");
+    EXPECT_EQ(readAll(second.getValue().getValue().getValue()), "{\"height\": 42}");
+    EXPECT_EQ(readAll(other.getValue().getValue().getValue()), "{\"height\": 43}");
+
+    // Once answered, the same request reaches the engine again.
+    http.GET("/blocks/current")();
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 3);
+}
+
+TEST(HttpRequestScheduler, RetriesGetsOnServerErrors) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://retry.test", engine, context, context);
+    HttpRequestScheduler::Options options;
+    options.maxRetries = 1;
+    http.setSchedulerOptions(options);
+
+    auto get = http.GET("/blocks/current")();
+    context->drain();
+    engine->respond(0, 503, "busy");
+    context->drain();
+    ASSERT_EQ(engine->requests.size(), 2);
+    engine->respond(1, 200, "ok");
+    context->drain();
+    EXPECT_EQ(readAll(get.getValue().getValue().getValue()), "ok");
+
+    auto failing = http.GET("/blocks/failing")();
+    context->drain();
+    engine->respond(2, 500, "down");
+    context->drain();
+    engine->respond(3, 500, "down");
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 4);
+    ASSERT_TRUE(failing.getValue().getValue().isFailure());
+    EXPECT_EQ(failing.getValue().getValue().getFailure().getErrorCode(), api::ErrorCode::UNABLE_TO_CONNECT_TO_HOST);
+
+    auto post = http.POST("/tx", std::vector<uint8_t>())();
+    context->drain();
+    engine->respond(4, 500, "down");
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 5);
+    EXPECT_TRUE(post.getValue().getValue().isFailure());
+}
+
+TEST(HttpRequestScheduler, HedgesSlowGets) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://hedge.test", engine, context, context);
+    HttpRequestScheduler::Options options;
+    options.hedgeDelayMs = 50;
+    http.setSchedulerOptions(options);
+
+    auto get = http.GET("/blocks/current")();
+    context->drain();
+    ASSERT_EQ(engine->requests.size(), 2);
+    engine->respond(1, 200, "hedged");
+    context->drain();
+    EXPECT_EQ(readAll(get.getValue().getValue().getValue()), "hedged");
+    engine->respond(0, 200, "late");
+    context->drain();
+    EXPECT_EQ(counter("HttpClient/http://hedge.test/hedged"), 1);
+}
+
+TEST(HttpCache, ServesImmutableResponsesWithoutRequest) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://cache.test", engine, context, context);
+    http.setCache(std::make_shared<HttpCache>(1024));
+
+    auto first = http.GET("/blocks/42").cache(HttpCachePolicy::immutable())();
+    context->drain();
+    ASSERT_EQ(engine->requests.size(), 1);
+    engine->respond(0, 200, "block 42");
+    context->drain();
+    EXPECT_EQ(readAll(first.getValue().getValue().getValue()), "block 42");
+
+    auto second = http.GET("/blocks/42").cache(HttpCachePolicy::immutable())();
+    ASSERT_TRUE(second.isCompleted());
+    EXPECT_EQ(readAll(second.getValue().getValue().getValue()), "block 42");
+    EXPECT_EQ(engine->requests.size(), 1);
+
+    // Endpoints not opting in always reach the engine.
+    http.GET("/blocks/42")();
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 2);
+}
+
+TEST(HttpCache, RevalidatesExpiredEntriesWithETag) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://etag.test", engine, context, context);
+    http.setCache(std::make_shared<HttpCache>(1024));
+    auto policy = HttpCachePolicy::ttl(std::chrono::milliseconds(1));
+
+    http.GET("/validators/val1").cache(policy)();
+    context->drain();
+    engine->respond(0, 200, "validator", {{"ETag", "\"v1\""}});
+    context->drain();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    auto revalidated = http.GET("/validators/val1").cache(policy)();
+    context->drain();
+    ASSERT_EQ(engine->requests.size(), 2);
+    EXPECT_EQ(engine->requests[1]->getHeaders()["If-None-Match"], "\"v1\"");
+    engine->respond(1, 304, "");
+    context->drain();
+    auto connection = revalidated.getValue().getValue().getValue();
+    EXPECT_EQ(connection->getStatusCode(), 200);
+    EXPECT_EQ(readAll(connection), "validator");
+}
+
+TEST(HttpCache, EvictsLeastRecentlyUsedEntries) {
+    HttpCache cache(64);
+    auto policy = HttpCachePolicy::immutable();
+    cache.put("GET a", std::make_shared<StringUrlConnection>(200, std::string(20, 'a')), policy);
+    cache.put("GET b", std::make_shared<StringUrlConnection>(200, std::string(20, 'b')), policy);
+    EXPECT_NE(cache.get("GET a"), nullptr);
+    cache.put("GET c", std::make_shared<StringUrlConnection>(200, std::string(20, 'c')), policy);
+    EXPECT_NE(cache.get("GET a"), nullptr);
+    EXPECT_EQ(cache.get("GET b"), nullptr);
+    EXPECT_NE(cache.get("GET c"), nullptr);
+    EXPECT_LE(cache.getSize(), 64);
+
+    // Entries larger than the cache are not kept.
+    cache.put("GET d", std::make_shared<StringUrlConnection>(200, std::string(100, 'd')), policy);
+    EXPECT_EQ(cache.get("GET d"), nullptr);
+}
+
+TEST(HttpCache, KeysOnAcceptAndCredentials) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://vary.test", engine, context, context);
+    http.setCache(std::make_shared<HttpCache>(1024));
+
+    http.GET("/blocks/42", {{"Accept", "application/json"}}).cache(HttpCachePolicy::immutable())();
+    context->drain();
+    engine->respond(0, 200, "json");
+    context->drain();
+
+    auto other = http.GET("/blocks/42", {{"Accept", "text/plain"}}).cache(HttpCachePolicy::immutable())();
+    context->drain();
+    ASSERT_EQ(engine->requests.size(), 2);
+    engine->respond(1, 200, "text");
+    context->drain();
+    EXPECT_EQ(readAll(other.getValue().getValue().getValue()), "text");
+
+    http.GET("/blocks/42", {{"Accept", "application/json"}, {"Authorization", "Bearer token"}}).cache(HttpCachePolicy::immutable())();
+    context->drain();
+    EXPECT_EQ(engine->requests.size(), 3);
+    EXPECT_EQ(HttpCache::keyOf("GET", "/a", {{"accept", "*/*"}, {"X-Trace", "1"}}),
+              HttpCache::keyOf("GET", "/a", {{"Accept", "*/*"}}));
+}
+
+TEST(HttpCache, BoundsTheDiskTier) {
+    auto backend = std::make_shared<MemoryPreferencesBackend>();
+    auto disk = std::make_shared<Preferences>(*backend, "http_cache");
+    auto policy = HttpCachePolicy::immutable();
+    {
+        HttpCache cache(1024, disk, 64);
+        cache.put("GET a", std::make_shared<StringUrlConnection>(200, std::string(20, 'a')), policy);
+        cache.put("GET b", std::make_shared<StringUrlConnection>(200, std::string(20, 'b')), policy);
+        cache.put("GET c", std::make_shared<StringUrlConnection>(200, std::string(20, 'c')), policy);
+        EXPECT_LE(cache.getDiskSize(), 64);
+    }
+    // A new cache only finds the most recent entries on disk, and keeps counting their size.
+    HttpCache cache(1024, disk, 64);
+    EXPECT_EQ(cache.get("GET a"), nullptr);
+    EXPECT_NE(cache.get("GET b"), nullptr);
+    EXPECT_NE(cache.get("GET c"), nullptr);
+    EXPECT_GT(cache.getDiskSize(), 0);
+    EXPECT_LE(cache.getDiskSize(), 64);
+    EXPECT_EQ(backend->size(), 3);
+}
+
+TEST(HttpCache, KeepsDiskWritesOffTheReadPath) {
+    auto backend = std::make_shared<MemoryPreferencesBackend>();
+    auto disk = std::make_shared<Preferences>(*backend, "http_cache");
+    auto policy = HttpCachePolicy::immutable();
+    {
+        HttpCache cache(1024, disk, 64);
+        cache.put("GET a", std::make_shared<StringUrlConnection>(200, std::string(20, 'a')), policy);
+        cache.put("GET b", std::make_shared<StringUrlConnection>(200, std::string(20, 'b')), policy);
+    }
+    HttpCache cache(1024, disk, 64);
+    auto commits = backend->commits;
+    EXPECT_NE(cache.get("GET a"), nullptr);
+    EXPECT_EQ(backend->commits, commits);
+
+    // Recency of the disk hit is persisted with the next store: b is evicted instead of a
+    cache.put("GET c", std::make_shared<StringUrlConnection>(200, std::string(20, 'c')), policy);
+    EXPECT_EQ(backend->commits, commits + 1);
+    HttpCache reopened(1024, disk, 64);
+    EXPECT_NE(reopened.get("GET a"), nullptr);
+    EXPECT_EQ(reopened.get("GET b"), nullptr);
+}
+
+TEST(HttpCache, ClearForgetsTheDiskTier) {
+    auto backend = std::make_shared<MemoryPreferencesBackend>();
+    auto disk = std::make_shared<Preferences>(*backend, "http_cache");
+    auto policy = HttpCachePolicy::immutable();
+    HttpCache cache(1024, disk, 64);
+    cache.put("GET a", std::make_shared<StringUrlConnection>(200, std::string(20, 'a')), policy);
+    auto entrySize = cache.getDiskSize();
+    cache.put("GET b", std::make_shared<StringUrlConnection>(200, std::string(20, 'b')), policy);
+    EXPECT_EQ(cache.getDiskSize(), 2 * entrySize);
+
+    // As done by WalletPool::freshResetAll
+    backend->clear();
+    cache.clear();
+    EXPECT_EQ(cache.getSize(), 0);
+    EXPECT_EQ(cache.getDiskSize(), 0);
+    cache.put("GET c", std::make_shared<StringUrlConnection>(200, std::string(20, 'c')), policy);
+    EXPECT_EQ(cache.getDiskSize(), entrySize);
+    EXPECT_EQ(backend->size(), 2);
+}
+
+TEST(HttpJsonStreaming, ParsesBodiesSplitInChunks) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://chunks.test", engine, context, context);
+
+    auto response = http.GET("/block").json();
+    context->drain();
+    engine->respond(0, 200, R"({"hash":"00ab","height":42,"txs":["a","b"]})", {}, 3);
+    context->drain();
+    auto document = std::get<1>(response.getValue().getValue().getValue());
+    ASSERT_TRUE(document->IsObject());
+    EXPECT_EQ(std::string((*document)["hash"].GetString()), "00ab");
+    EXPECT_EQ((*document)["height"].GetInt(), 42);
+    EXPECT_EQ((*document)["txs"].Size(), 2);
+}
+
+TEST(HttpJsonStreaming, StreamsArrayElementsOneByOne) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto engine = std::make_shared<PendingHttpClient>();
+    HttpClient http("http://stream.test", engine, context, context);
+
+    std::vector<std::string> hashes;
+    auto response = http.GET("/txs").streamJsonArray("txs", [&hashes] (const rapidjson::Value &tx) {
+        ASSERT_TRUE(tx.IsObject());
+        hashes.emplace_back(tx["hash"].GetString());
+    }, true);
+    context->drain();
+    engine->respond(0, 200, R"({"count":"2","txs":[{"hash":"a","msgs":[1,2]},{"hash":"b","msgs":[]}],"total_count":"5"})", {}, 7);
+    context->drain();
+
+    auto document = std::get<1>(response.getValue().getValue().getValue());
+    EXPECT_EQ(hashes, std::vector<std::string>({"a", "b"}));
+    ASSERT_TRUE((*document)["txs"].IsArray());
+    EXPECT_EQ((*document)["txs"].Size(), 0);
+    EXPECT_EQ(std::string((*document)["count"].GetString()), "2");
+    EXPECT_EQ(std::string((*document)["total_count"].GetString()), "5");
+
+    auto invalid = http.GET("/txs").streamJsonArray("txs", [] (const rapidjson::Value &) {});
+    context->drain();
+    engine->respond(1, 200, R"({"txs":[{"hash":)");
+    context->drain();
+    EXPECT_TRUE(invalid.getValue().getValue().isFailure());
+}
+
+TEST(HttpJsonStreaming, StopsReadingAtContentLength) {
+    const std::string body = R"({"height":42})";
+    auto connection = std::make_shared<CountingUrlConnection>(
+            200, body, std::unordered_map<std::string, std::string>{{"Content-Length", std::to_string(body.size())}}, 5);
+    HttpUrlConnectionInputStream is(connection);
+    rapidjson::Document document;
+    document.ParseStream<rapidjson::kParseStopWhenDoneFlag>(is);
+    ASSERT_FALSE(document.HasParseError());
+    EXPECT_EQ(document["height"].GetInt(), 42);
+    EXPECT_EQ(is.Take(), '\0');
+    // Three chunks, no trailing empty read
+    EXPECT_EQ(connection->reads, 3);
+}
+
+TEST(HttpJsonStreaming, BoundsBufferedBodies) {
+    auto chunked = std::make_shared<StringUrlConnection>(200, std::string(100, 'a'), std::unordered_map<std::string, std::string>{}, 10);
+    EXPECT_THROW(BufferedHttpUrlConnection::readAll(chunked, 64), Exception);
+    auto announced = std::make_shared<StringUrlConnection>(
+            200, std::string(100, 'a'), std::unordered_map<std::string, std::string>{{"Content-Length", "100"}});
+    EXPECT_THROW(BufferedHttpUrlConnection::readAll(announced, 64), Exception);
+    auto small = std::make_shared<StringUrlConnection>(200, std::string(10, 'a'), std::unordered_map<std::string, std::string>{}, 3);
+    EXPECT_EQ(BufferedHttpUrlConnection::readAll(small, 64).size(), 10);
+}
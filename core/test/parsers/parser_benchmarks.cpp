@@ -0,0 +1,165 @@
+/*
+ *
+ * parser_benchmarks.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <rapidjson/reader.h>
+#include <metrics/DurationsMap.hpp>
+#include <wallet/common/explorers/LedgerApiParser.hpp>
+#include <wallet/bitcoin/explorers/api/TransactionsBulkParser.hpp>
+#include <wallet/ethereum/explorers/api/EthereumLikeTransactionsBulkParser.h>
+#include "../fixtures/http_cache_LedgerApiBitcoinLikeBlockchainExplorerTests_GetTransactions.h"
+#include "../fixtures/http_cache_EthereumLikeWalletSynchronization_MediumXpubSynchronization_3.h"
+
+using namespace ledger::core;
+
+namespace {
+    const int ITERATIONS = 20;
+
+    long long elapsedMicroseconds(const std::chrono::steady_clock::time_point& start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Key tracking and routing as done by the parsers before LedgerApiKey: a string per key and comparison chains.
+    struct StringKeyHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, StringKeyHandler> {
+        bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+            lastKey = std::string(str, length);
+            if (lastKey == "block" || lastKey == "inputs" || lastKey == "outputs") {
+                routed += 1;
+            } else if (lastKey == "hash" || lastKey == "value" || lastKey == "address") {
+                matched += 1;
+            }
+            return true;
+        }
+
+        std::string lastKey;
+        int routed = 0;
+        int matched = 0;
+    };
+
+    struct EnumKeyHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, EnumKeyHandler> {
+        bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+            lastKey = LedgerApiKeys::fromString(str, length);
+            if (lastKey == LedgerApiKey::block || lastKey == LedgerApiKey::inputs || lastKey == LedgerApiKey::outputs) {
+                routed += 1;
+            } else if (lastKey == LedgerApiKey::hash || lastKey == LedgerApiKey::value || lastKey == LedgerApiKey::address) {
+                matched += 1;
+            }
+            return true;
+        }
+
+        LedgerApiKey lastKey = LedgerApiKey::NONE;
+        int routed = 0;
+        int matched = 0;
+    };
+
+    template <typename Handler>
+    long long timeKeys(const std::string& body, Handler& handler) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < ITERATIONS; i++) {
+            rapidjson::Reader reader;
+            rapidjson::StringStream is(body.c_str());
+            EXPECT_FALSE(reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(is, handler).IsError());
+        }
+        return elapsedMicroseconds(start);
+    }
+
+    template <typename Bulk, typename Parser>
+    long long timeBulk(const std::string& body, size_t& transactions) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < ITERATIONS; i++) {
+            LedgerApiParser<Bulk, Parser> parser;
+            parser.attach("OK", 200);
+            rapidjson::Reader reader;
+            rapidjson::StringStream is(body.c_str());
+            reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(is, parser);
+            auto result = parser.build();
+            EXPECT_TRUE(result.isRight());
+            transactions = result.isRight() ? result.getRight()->transactions.size() : 0;
+        }
+        return elapsedMicroseconds(start);
+    }
+}
+
+TEST(ParserBenchmarks, KeyDispatchOnRecordedPayloads) {
+    const auto& body = HTTP_CACHE_LedgerApiBitcoinLikeBlockchainExplorerTests_GetTransactions::BODY;
+    StringKeyHandler strings;
+    EnumKeyHandler enums;
+    auto stringTime = timeKeys(body, strings);
+    auto enumTime = timeKeys(body, enums);
+    EXPECT_EQ(strings.routed, enums.routed);
+    EXPECT_EQ(strings.matched, enums.matched);
+    std::cout << "[string keys] " << stringTime << "us for " << ITERATIONS << " BTC pages" << std::endl;
+    std::cout << "[enum keys] " << enumTime << "us for " << ITERATIONS << " BTC pages" << std::endl;
+}
+
+TEST(ParserBenchmarks, TransactionsBulkOnRecordedPayloads) {
+    size_t btcTransactions = 0;
+    auto btcTime = timeBulk<BitcoinLikeBlockchainExplorer::TransactionsBulk, TransactionsBulkParser>(
+            HTTP_CACHE_LedgerApiBitcoinLikeBlockchainExplorerTests_GetTransactions::BODY, btcTransactions);
+    size_t ethTransactions = 0;
+    auto ethTime = timeBulk<EthereumLikeBlockchainExplorer::TransactionsBulk, EthereumLikeTransactionsBulkParser>(
+            HTTP_CACHE_EthereumLikeWalletSynchronization_MediumXpubSynchronization_3::BODY, ethTransactions);
+    EXPECT_GT(btcTransactions, 0);
+    EXPECT_GT(ethTransactions, 0);
+    std::cout << "[BTC] " << btcTime << "us for " << ITERATIONS << " pages of " << btcTransactions << " transactions" << std::endl;
+    std::cout << "[ETH] " << ethTime << "us for " << ITERATIONS << " pages of " << ethTransactions << " transactions" << std::endl;
+}
+
+TEST(ParserBenchmarks, ArenaAllocationsOfBitcoinPages) {
+    const auto& body = HTTP_CACHE_LedgerApiBitcoinLikeBlockchainExplorerTests_GetTransactions::BODY;
+    {
+        LedgerApiParser<BitcoinLikeBlockchainExplorer::TransactionsBulk, TransactionsBulkParser> parser;
+        parser.attach("OK", 200);
+        rapidjson::Reader reader;
+        rapidjson::StringStream is(body.c_str());
+        reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(is, parser);
+        auto bulk = parser.build().getRight();
+        ASSERT_GT(bulk->transactions.size(), 0);
+        EXPECT_EQ(bulk->transactions.front().getArena(), bulk->arena.get());
+        BitcoinLikeBlockchainExplorerTransaction copy(bulk->transactions.front());
+        EXPECT_EQ(copy.getArena(), nullptr);
+        EXPECT_EQ(copy.inputs.size(), bulk->transactions.front().inputs.size());
+    }
+
+    auto allocationsBefore = DurationsMap::getInstance().getMetrics()["MonotonicArena/allocations"].count;
+    auto blocksBefore = DurationsMap::getInstance().getMetrics()["MonotonicArena/blocks"].count;
+    size_t transactions = 0;
+    timeBulk<BitcoinLikeBlockchainExplorer::TransactionsBulk, TransactionsBulkParser>(body, transactions);
+    auto metrics = DurationsMap::getInstance().getMetrics();
+    auto allocations = metrics["MonotonicArena/allocations"].count - allocationsBefore;
+    auto blocks = metrics["MonotonicArena/blocks"].count - blocksBefore;
+    EXPECT_LT(blocks, allocations);
+    std::cout << "[BTC arena] " << allocations << " allocations served by " << blocks << " heap blocks for "
+              << ITERATIONS << " pages" << std::endl;
+}
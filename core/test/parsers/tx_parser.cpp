@@ -14,18 +14,18 @@ struct TestBlock {
 struct TestParser : AbstractBlockParser<TestBlock> {
     typedef TestBlock Result;
 
-    TestParser(std::string& lastKey) : _lastKey(lastKey) {}
+    TestParser(LedgerApiKey& lastKey) : _lastKey(lastKey) {}
     ~TestParser() = default;
 
     bool Key(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
-        _lastKey = std::string(str, length);
+        _lastKey = LedgerApiKeys::fromString(str, length);
         return true;
     }
 
 protected:
-    std::string& _lastKey;
+    LedgerApiKey& _lastKey;
 
-    std::string& getLastKey() override {
+    LedgerApiKey& getLastKey() override {
         return _lastKey;
     }
 };
@@ -35,3 +35,13 @@ TEST(TXParser, NumbersAsStrings) {
     auto parsed = JSONUtils::parse<TestParser>(json);
     EXPECT_EQ(parsed->height, 12);
 }
+
+TEST(TXParser, LedgerApiKeys) {
+#define CHECK_LEDGER_API_KEY(name) EXPECT_EQ(LedgerApiKeys::fromString(#name, sizeof(#name) - 1), LedgerApiKey::name);
+    LEDGER_API_KEYS(CHECK_LEDGER_API_KEY)
+#undef CHECK_LEDGER_API_KEY
+    EXPECT_EQ(LedgerApiKeys::fromString("", 0), LedgerApiKey::NONE);
+    EXPECT_EQ(LedgerApiKeys::fromString("hashes", 6), LedgerApiKey::UNKNOWN);
+    EXPECT_EQ(LedgerApiKeys::fromString("has", 3), LedgerApiKey::UNKNOWN);
+    EXPECT_EQ(LedgerApiKeys::fromString("inputs", 5), LedgerApiKey::input);
+}
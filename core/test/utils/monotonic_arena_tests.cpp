@@ -0,0 +1,91 @@
+/*
+ *
+ * monotonic_arena_tests.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 16/10/2026.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include <gtest/gtest.h>
+#include <ledger/core/utils/MonotonicArena.hpp>
+#include <ledger/core/metrics/DurationsMap.hpp>
+#include <string>
+#include <vector>
+
+using namespace ledger::core;
+
+TEST(MonotonicArena, AllocatesAlignedMemoryFromFewBlocks) {
+    MonotonicArena arena(1024);
+    auto first = arena.allocate(3, 1);
+    auto second = arena.allocate(sizeof(uint64_t), alignof(uint64_t));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % alignof(uint64_t), 0);
+    EXPECT_GE(static_cast<uint8_t*>(second), static_cast<uint8_t*>(first) + 3);
+    for (auto i = 0; i < 100; i++) {
+        arena.allocate(16, 8);
+    }
+    EXPECT_EQ(arena.getAllocations(), 102);
+    EXPECT_EQ(arena.getBlocks(), 2);
+
+    // Oversized requests have their own block
+    arena.allocate(4096, 8);
+    EXPECT_EQ(arena.getBlocks(), 3);
+    arena.release();
+    EXPECT_EQ(arena.getAllocations(), 0);
+    EXPECT_EQ(arena.getBlocks(), 0);
+}
+
+TEST(MonotonicArena, ContainersCopiesAreHeapAllocated) {
+    typedef std::vector<std::string, ArenaAllocator<std::string>> Strings;
+    MonotonicArena arena;
+    Strings strings{ArenaAllocator<std::string>(&arena)};
+    for (auto i = 0; i < 10; i++) {
+        strings.push_back(std::to_string(i));
+    }
+    EXPECT_GT(arena.getAllocations(), 0);
+
+    Strings copy(strings);
+    EXPECT_EQ(copy.get_allocator().getArena(), nullptr);
+    Strings moved(std::move(strings));
+    EXPECT_EQ(moved.get_allocator().getArena(), &arena);
+
+    Strings assigned;
+    assigned = moved;
+    EXPECT_EQ(assigned.get_allocator().getArena(), nullptr);
+    EXPECT_EQ(assigned, copy);
+}
+
+TEST(MonotonicArena, ReleaseRecordsCounters) {
+    auto allocationsBefore = DurationsMap::getInstance().getMetrics()["MonotonicArena/allocations"].count;
+    auto blocksBefore = DurationsMap::getInstance().getMetrics()["MonotonicArena/blocks"].count;
+    {
+        MonotonicArena arena;
+        for (auto i = 0; i < 50; i++) {
+            arena.allocate(32, 8);
+        }
+    }
+    auto metrics = DurationsMap::getInstance().getMetrics();
+    EXPECT_EQ(metrics["MonotonicArena/allocations"].count - allocationsBefore, 50);
+    EXPECT_EQ(metrics["MonotonicArena/blocks"].count - blocksBefore, 1);
+}